@@ -100,6 +100,12 @@ namespace dawn::wire::server {
 
                         mProcs.{{as_varName(type.name, Name("release"))}}(obj->handle);
                     }
+                    {% if type.name.get() == "buffer" %}
+                        //* Destroy the Read/WriteHandles now instead of when the ID is reused so
+                        //* that the MemoryTransferService can reclaim their memory.
+                        obj->readHandle = nullptr;
+                        obj->writeHandle = nullptr;
+                    {% endif %}
                     {{type.name.CamelCase()}}Objects().Free(objectId);
                     return WireResult::Success;
                 }
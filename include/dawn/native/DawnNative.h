@@ -137,6 +137,13 @@ struct DAWN_NATIVE_EXPORT DawnInstanceDescriptor : wgpu::ChainedStruct {
     const char* const* additionalRuntimeSearchPaths;
     dawn::platform::Platform* platform = nullptr;
 
+    // If set, and the platform does not provide a CachingInterface, blobs such as compiled shaders
+    // and pipeline caches are persisted in this directory. The directory is created if it does not
+    // exist, and may only be used by one instance at a time. Only supported on POSIX platforms.
+    const char* blobCacheDirectory = nullptr;
+    // The maximum size, in bytes, of the blobs stored in blobCacheDirectory. Zero uses a default.
+    uint64_t blobCacheMaxSize = 0;
+
     // Equality operators, mostly for testing. Note that this tests
     // strict pointer-pointer equality if the struct contains member pointers.
     bool operator==(const DawnInstanceDescriptor& rhs) const;
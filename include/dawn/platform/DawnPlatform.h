@@ -78,12 +78,25 @@ class DAWN_PLATFORM_EXPORT WaitableEvent {
 
 using PostWorkerTaskCallback = void (*)(void* userdata);
 
+// Hint for the order in which a WorkerTaskPool should run the tasks posted to it. Background tasks
+// (for example pipeline compilations) only run when no Normal task is waiting.
+enum class WorkerTaskPriority {
+    Normal,
+    Background,
+};
+
 class DAWN_PLATFORM_EXPORT WorkerTaskPool {
   public:
     WorkerTaskPool() = default;
     virtual ~WorkerTaskPool() = default;
     virtual std::unique_ptr<WaitableEvent> PostWorkerTask(PostWorkerTaskCallback,
                                                           void* userdata) = 0;
+    // Same as PostWorkerTask but with a scheduling hint. The default implementation ignores the
+    // priority.
+    virtual std::unique_ptr<WaitableEvent> PostWorkerTaskWithPriority(
+        PostWorkerTaskCallback callback,
+        void* userdata,
+        WorkerTaskPriority priority);
 };
 
 // These features map to similarly named ones in src/chromium/src/gpu/config/gpu_finch_features.h
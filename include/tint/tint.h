@@ -35,6 +35,7 @@
 //                headers will need to be moved to include/tint/.
 
 #include "tint/api/common/binding_point.h"
+#include "tint/api/common/instrumentation.h"
 #include "tint/api/options/array_length_from_uniform.h"
 #include "tint/api/options/binding_remapper.h"
 #include "tint/api/options/external_texture.h"
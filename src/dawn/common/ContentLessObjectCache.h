@@ -28,6 +28,8 @@
 #ifndef SRC_DAWN_COMMON_CONTENTLESSOBJECTCACHE_H_
 #define SRC_DAWN_COMMON_CONTENTLESSOBJECTCACHE_H_
 
+#include <array>
+#include <cstdint>
 #include <mutex>
 #include <tuple>
 #include <type_traits>
@@ -72,6 +74,11 @@ using ContentLessObjectCacheKey =
 
 enum class KeyType : size_t { Pointer = 0, WeakRef = 1, ForErase = 2 };
 
+// Temporary Refs that are by-products of Promotes inside the EqualityFunc. See the comment on
+// ContentLessObjectCache::Shard::temporaryRefs.
+template <typename RefCountedT>
+using ContentLessObjectCacheTemporaryRefs = StackVector<Ref<RefCountedT>, 4>;
+
 template <typename RefCountedT>
 struct ContentLessObjectCacheHashVisitor {
     using BaseHashFunc = typename RefCountedT::HashFunc;
@@ -105,7 +112,8 @@ struct ContentLessObjectCacheKeyFuncs {
     };
 
     struct EqualityFunc {
-        explicit EqualityFunc(ContentLessObjectCache<RefCountedT>* cache) : mCache(cache) {}
+        explicit EqualityFunc(ContentLessObjectCacheTemporaryRefs<RefCountedT>** temporaryRefs)
+            : mTemporaryRefs(temporaryRefs) {}
 
         bool operator()(const ContentLessObjectCacheKey<RefCountedT>& a,
                         const ContentLessObjectCacheKey<RefCountedT>& b) const {
@@ -115,8 +123,8 @@ struct ContentLessObjectCacheKeyFuncs {
             //   (1) a == b, in which case that means we are destroying the last copy and must be
             //       valid because cached objects must uncache themselves before being completely
             //       destroyed.
-            //   (2) a != b, in which case the lock on the cache guarantees that the element in the
-            //       cache has not been erased yet and hence cannot have been destroyed.
+            //   (2) a != b, in which case the lock on the cache's shard guarantees that the element
+            //       in the cache has not been erased yet and hence cannot have been destroyed.
             bool erasing = std::holds_alternative<ForErase<RefCountedT>>(a) ||
                            std::holds_alternative<ForErase<RefCountedT>>(b);
 
@@ -157,20 +165,24 @@ struct ContentLessObjectCacheKeyFuncs {
             }
 
             if (aRef != nullptr) {
-                mCache->TrackTemporaryRef(std::move(aRef));
+                (**mTemporaryRefs)->push_back(std::move(aRef));
             }
             if (bRef != nullptr) {
-                mCache->TrackTemporaryRef(std::move(bRef));
+                (**mTemporaryRefs)->push_back(std::move(bRef));
             }
             return result;
         }
 
-        ContentLessObjectCache<RefCountedT>* mCache = nullptr;
+        // Points to the temporary Refs of the shard that owns the set using this EqualityFunc.
+        ContentLessObjectCacheTemporaryRefs<RefCountedT>** mTemporaryRefs = nullptr;
     };
 };
 
 }  // namespace detail
 
+// The cache is split into shards, chosen by the hash of the objects, that each have their own lock
+// so that threads creating different objects rarely contend. An object is always looked up,
+// inserted and erased in the same shard because its hash is immutable.
 template <typename RefCountedT>
 class ContentLessObjectCache {
     static_assert(std::is_base_of_v<detail::ContentLessObjectCacheableBase, RefCountedT>,
@@ -179,15 +191,10 @@ class ContentLessObjectCache {
                   "Type must be refcounted to use with ContentLessObjectCache.");
 
     using CacheKeyFuncs = detail::ContentLessObjectCacheKeyFuncs<RefCountedT>;
+    using TemporaryRefs = detail::ContentLessObjectCacheTemporaryRefs<RefCountedT>;
 
   public:
-    // Constructor needs to pass in 'this' to the EqualityFunc. Since the default bucket_count on
-    // sets is implementation defined, creating a temporary unused set to get the value. The actual
-    // type of the temporary does not matter.
-    ContentLessObjectCache()
-        : mCache(std::unordered_set<int>().bucket_count(),
-                 typename CacheKeyFuncs::HashFunc(),
-                 typename CacheKeyFuncs::EqualityFunc(this)) {}
+    ContentLessObjectCache() = default;
 
     // The dtor asserts that the cache is empty to aid in finding pointer leaks that can be
     // possible if the RefCountedT doesn't correctly implement the DeleteThis function to Uncache.
@@ -197,10 +204,11 @@ class ContentLessObjectCache {
     // inserted or existing object, and the second is a bool that is true if we inserted
     // `object` and false otherwise.
     std::pair<Ref<RefCountedT>, bool> Insert(RefCountedT* obj) {
-        return WithLockAndCleanup([&]() -> std::pair<Ref<RefCountedT>, bool> {
-            detail::WeakRefAndHash<RefCountedT> weakref =
-                std::make_pair(GetWeakRef(obj), typename RefCountedT::HashFunc()(obj));
-            auto [it, inserted] = mCache.insert(weakref);
+        size_t hash = typename RefCountedT::HashFunc()(obj);
+        Shard& shard = GetShard(hash);
+        return WithLockAndCleanup(shard, [&]() -> std::pair<Ref<RefCountedT>, bool> {
+            detail::WeakRefAndHash<RefCountedT> weakref = std::make_pair(GetWeakRef(obj), hash);
+            auto [it, inserted] = shard.set.insert(weakref);
             if (inserted) {
                 obj->mCache = this;
                 return {obj, inserted};
@@ -212,8 +220,8 @@ class ContentLessObjectCache {
                 if (ref != nullptr) {
                     return {ref, false};
                 } else {
-                    mCache.erase(it);
-                    auto result = mCache.insert(weakref);
+                    shard.set.erase(it);
+                    auto result = shard.set.insert(weakref);
                     DAWN_ASSERT(result.second);
                     obj->mCache = this;
                     return {obj, true};
@@ -224,9 +232,10 @@ class ContentLessObjectCache {
 
     // Returns a valid Ref<T> if we can Promote the underlying WeakRef. Returns nullptr otherwise.
     Ref<RefCountedT> Find(RefCountedT* blueprint) {
-        return WithLockAndCleanup([&]() -> Ref<RefCountedT> {
-            auto it = mCache.find(blueprint);
-            if (it != mCache.end()) {
+        Shard& shard = GetShard(typename RefCountedT::HashFunc()(blueprint));
+        return WithLockAndCleanup(shard, [&]() -> Ref<RefCountedT> {
+            auto it = shard.set.find(blueprint);
+            if (it != shard.set.end()) {
                 return std::get<detail::WeakRefAndHash<RefCountedT>>(*it).first.Promote();
             }
             return nullptr;
@@ -237,54 +246,80 @@ class ContentLessObjectCache {
     // modify the cache. Since Erase never Promotes any WeakRefs, it does not need to be wrapped by
     // a WithLockAndCleanup, and a simple lock is enough.
     void Erase(RefCountedT* obj) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto it = mCache.find(detail::ForErase<RefCountedT>(obj));
-        if (it == mCache.end()) {
+        Shard& shard = GetShard(typename RefCountedT::HashFunc()(obj));
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.set.find(detail::ForErase<RefCountedT>(obj));
+        if (it == shard.set.end()) {
             return;
         }
         obj->mCache = nullptr;
-        mCache.erase(it);
+        shard.set.erase(it);
     }
 
     // Returns true iff the cache is empty.
     bool Empty() {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mCache.empty();
+        for (Shard& shard : mShards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (!shard.set.empty()) {
+                return false;
+            }
+        }
+        return true;
     }
 
   private:
-    friend struct CacheKeyFuncs::EqualityFunc;
+    static constexpr size_t kShardCountLog2 = 4;
+    static constexpr size_t kShardCount = size_t(1) << kShardCountLog2;
+
+    struct Shard {
+        // The set's EqualityFunc needs a pointer to the shard's temporary Refs. Since the default
+        // bucket_count on sets is implementation defined, creating a temporary unused set to get
+        // the value. The actual type of the temporary does not matter.
+        Shard()
+            : set(std::unordered_set<int>().bucket_count(),
+                  typename CacheKeyFuncs::HashFunc(),
+                  typename CacheKeyFuncs::EqualityFunc(&temporaryRefs)) {}
+
+        std::mutex mutex;
+        std::unordered_set<detail::ContentLessObjectCacheKey<RefCountedT>,
+                           typename CacheKeyFuncs::HashFunc,
+                           typename CacheKeyFuncs::EqualityFunc>
+            set;
+
+        // The shard has a pointer to a StackVector of temporary Refs that are by-products of
+        // Promotes inside the EqualityFunc. These Refs need to outlive the EqualityFunc calls
+        // because otherwise, they could be the last living Ref of the object resulting in a
+        // re-entrant Erase call that deadlocks on the mutex. Since the default max_load_factor of
+        // most std::unordered_set implementations should be 1.0 (roughly 1 element per bucket), a
+        // StackVector of length 4 should be enough space in most cases. See dawn:1993 for more
+        // details.
+        TemporaryRefs* temporaryRefs = nullptr;
+    };
+
+    Shard& GetShard(size_t hash) {
+        // Mix the hash so that the shard doesn't only depend on the bits that also select the
+        // bucket in the shard's set.
+        uint64_t mixed = static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15;
+        return mShards[mixed >> (64 - kShardCountLog2)];
+    }
 
-    void TrackTemporaryRef(Ref<RefCountedT> ref) { (*mTemporaryRefs)->push_back(std::move(ref)); }
     template <typename F>
-    auto WithLockAndCleanup(F func) {
+    auto WithLockAndCleanup(Shard& shard, F func) {
         using RetType = decltype(func());
         RetType result;
 
         // Creates and owns a temporary StackVector that we point to internally to track Refs.
-        StackVector<Ref<RefCountedT>, 4> temps;
+        TemporaryRefs temps;
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mTemporaryRefs = &temps;
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.temporaryRefs = &temps;
             result = func();
-            mTemporaryRefs = nullptr;
+            shard.temporaryRefs = nullptr;
         }
         return result;
     }
 
-    std::mutex mMutex;
-    std::unordered_set<detail::ContentLessObjectCacheKey<RefCountedT>,
-                       typename CacheKeyFuncs::HashFunc,
-                       typename CacheKeyFuncs::EqualityFunc>
-        mCache;
-
-    // The cache has a pointer to a StackVector of temporary Refs that are by-products of Promotes
-    // inside the EqualityFunc. These Refs need to outlive the EqualityFunc calls because otherwise,
-    // they could be the last living Ref of the object resulting in a re-entrant Erase call that
-    // deadlocks on the mutex. Since the default max_load_factor of most std::unordered_set
-    // implementations should be 1.0 (roughly 1 element per bucket), a StackVector of length 4
-    // should be enough space in most cases. See dawn:1993 for more details.
-    StackVector<Ref<RefCountedT>, 4>* mTemporaryRefs = nullptr;
+    std::array<Shard, kShardCount> mShards;
 };
 
 }  // namespace dawn
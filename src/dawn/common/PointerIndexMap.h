@@ -0,0 +1,144 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_DAWN_COMMON_POINTERINDEXMAP_H_
+#define SRC_DAWN_COMMON_POINTERINDEXMAP_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+
+namespace dawn {
+
+// PointerIndexMap assigns dense indices to pointers, in the order in which they are first
+// inserted. It is meant to be paired with vectors that store per-pointer data at those indices,
+// which gives a map with a deterministic iteration order and without per-entry allocations.
+// Lookups use open addressing with linear probing in a single flat array of slots, which is
+// allocated on the first insertion and kept by Clear() so that it can be reused.
+template <typename T>
+class PointerIndexMap {
+  public:
+    static constexpr size_t kNotFound = ~size_t(0);
+
+    // Returns the index of `key` and whether it was newly inserted. New keys are given the index
+    // Size() had before the insertion.
+    std::pair<size_t, bool> Insert(const T* key) {
+        DAWN_ASSERT(key != nullptr);
+
+        // Keep the load factor at or below 1/2 so that probe sequences stay short.
+        if ((mSize + 1) * 2 > mSlots.size()) {
+            Grow();
+        }
+
+        size_t mask = mSlots.size() - 1;
+        for (size_t i = HashPointer(key) & mask;; i = (i + 1) & mask) {
+            Slot& slot = mSlots[i];
+            if (slot.key == key) {
+                return {slot.index, false};
+            }
+            if (slot.key == nullptr) {
+                slot.key = key;
+                slot.index = static_cast<uint32_t>(mSize);
+                return {mSize++, true};
+            }
+        }
+    }
+
+    // Returns the index of `key`, or kNotFound if it hasn't been inserted.
+    size_t Find(const T* key) const {
+        if (mSize == 0) {
+            return kNotFound;
+        }
+        size_t mask = mSlots.size() - 1;
+        for (size_t i = HashPointer(key) & mask;; i = (i + 1) & mask) {
+            const Slot& slot = mSlots[i];
+            if (slot.key == key) {
+                return slot.index;
+            }
+            if (slot.key == nullptr) {
+                return kNotFound;
+            }
+        }
+    }
+
+    size_t Size() const { return mSize; }
+    bool Empty() const { return mSize == 0; }
+
+    // Removes all the keys but keeps the slot storage.
+    void Clear() {
+        if (mSize == 0) {
+            return;
+        }
+        for (Slot& slot : mSlots) {
+            slot = {};
+        }
+        mSize = 0;
+    }
+
+  private:
+    struct Slot {
+        const T* key = nullptr;
+        uint32_t index = 0;
+    };
+
+    static constexpr size_t kInitialSlotCount = 16;
+
+    static size_t HashPointer(const T* key) {
+        // Fibonacci hashing. The low bits of pointers are mostly zero because of alignment, so
+        // take the high bits of the product which depend on all the bits of the pointer.
+        uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key)) *
+                        uint64_t(0x9E3779B97F4A7C15);
+        return static_cast<size_t>(hash >> 32);
+    }
+
+    void Grow() {
+        std::vector<Slot> oldSlots = std::exchange(
+            mSlots, std::vector<Slot>(std::max(kInitialSlotCount, mSlots.size() * 2)));
+        size_t mask = mSlots.size() - 1;
+        for (const Slot& oldSlot : oldSlots) {
+            if (oldSlot.key == nullptr) {
+                continue;
+            }
+            size_t i = HashPointer(oldSlot.key) & mask;
+            while (mSlots[i].key != nullptr) {
+                i = (i + 1) & mask;
+            }
+            mSlots[i] = oldSlot;
+        }
+    }
+
+    std::vector<Slot> mSlots;
+    size_t mSize = 0;
+};
+
+}  // namespace dawn
+
+#endif  // SRC_DAWN_COMMON_POINTERINDEXMAP_H_
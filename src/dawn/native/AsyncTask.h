@@ -35,11 +35,7 @@
 
 #include "dawn/common/Ref.h"
 #include "dawn/common/RefCounted.h"
-
-namespace dawn::platform {
-class WaitableEvent;
-class WorkerTaskPool;
-}  // namespace dawn::platform
+#include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native {
 
@@ -54,7 +50,9 @@ class AsyncTaskManager {
   public:
     explicit AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool);
 
-    void PostTask(AsyncTask asyncTask);
+    void PostTask(AsyncTask asyncTask,
+                  dawn::platform::WorkerTaskPriority priority =
+                      dawn::platform::WorkerTaskPriority::Normal);
     void WaitAllPendingTasks();
     bool HasPendingTasks();
 
@@ -27,6 +27,8 @@
 
 #include "dawn/native/BindGroup.h"
 
+#include <algorithm>
+
 #include "dawn/common/Assert.h"
 #include "dawn/common/Math.h"
 #include "dawn/common/ityp_bitset.h"
@@ -479,6 +481,8 @@ BindGroupBase::BindGroupBase(DeviceBase* device,
                                                     mBindingData.bufferData[bindingIndex].size;
                                             });
 
+    ComputeResourceUsage();
+
     GetObjectTrackingList()->Track(this);
 }
 
@@ -501,6 +505,85 @@ void BindGroupBase::DeleteThis() {
     ApiObjectBase::DeleteThis();
 }
 
+void BindGroupBase::ComputeResourceUsage() {
+    const BindGroupLayoutInternalBase* layout = GetLayout();
+    for (BindingIndex bindingIndex{0}; bindingIndex < layout->GetBindingCount(); ++bindingIndex) {
+        const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+
+        switch (bindingInfo.bindingType) {
+            case BindingInfoType::Buffer: {
+                wgpu::BufferUsage usage = wgpu::BufferUsage::None;
+                switch (bindingInfo.buffer.type) {
+                    case wgpu::BufferBindingType::Uniform:
+                        usage = wgpu::BufferUsage::Uniform;
+                        break;
+                    case wgpu::BufferBindingType::Storage:
+                        usage = wgpu::BufferUsage::Storage;
+                        break;
+                    case kInternalStorageBufferBinding:
+                        usage = kInternalStorageBuffer;
+                        break;
+                    case wgpu::BufferBindingType::ReadOnlyStorage:
+                        usage = kReadOnlyStorageBuffer;
+                        break;
+                    case wgpu::BufferBindingType::Undefined:
+                        DAWN_UNREACHABLE();
+                }
+
+                BufferBase* buffer = GetBindingAsBufferBinding(bindingIndex).buffer;
+                auto it = std::find(mResourceUsage.buffers.begin(), mResourceUsage.buffers.end(),
+                                    buffer);
+                if (it == mResourceUsage.buffers.end()) {
+                    mResourceUsage.buffers.push_back(buffer);
+                    mResourceUsage.bufferUsages.push_back(usage);
+                } else {
+                    mResourceUsage.bufferUsages[it - mResourceUsage.buffers.begin()] |= usage;
+                }
+                break;
+            }
+
+            case BindingInfoType::Texture: {
+                TextureViewBase* view = GetBindingAsTextureView(bindingIndex);
+                wgpu::TextureUsage usage =
+                    bindingInfo.texture.sampleType == kInternalResolveAttachmentSampleType
+                        ? kResolveAttachmentLoadingUsage
+                        : wgpu::TextureUsage::TextureBinding;
+                mResourceUsage.textures.push_back(
+                    {view->GetTexture(), view->GetSubresourceRange(), usage, true});
+                break;
+            }
+
+            case BindingInfoType::StorageTexture: {
+                TextureViewBase* view = GetBindingAsTextureView(bindingIndex);
+                wgpu::TextureUsage usage = wgpu::TextureUsage::None;
+                switch (bindingInfo.storageTexture.access) {
+                    case wgpu::StorageTextureAccess::WriteOnly:
+                        usage = kWriteOnlyStorageTexture;
+                        break;
+                    case wgpu::StorageTextureAccess::ReadWrite:
+                        usage = wgpu::TextureUsage::StorageBinding;
+                        break;
+                    case wgpu::StorageTextureAccess::ReadOnly:
+                        usage = kReadOnlyStorageTexture;
+                        break;
+                    case wgpu::StorageTextureAccess::Undefined:
+                        DAWN_UNREACHABLE();
+                }
+                mResourceUsage.textures.push_back(
+                    {view->GetTexture(), view->GetSubresourceRange(), usage, false});
+                break;
+            }
+
+            case BindingInfoType::ExternalTexture:
+                DAWN_UNREACHABLE();
+                break;
+
+            case BindingInfoType::Sampler:
+                break;
+        }
+    }
+}
+
 BindGroupBase::BindGroupBase(DeviceBase* device, ObjectBase::ErrorTag tag, const char* label)
     : ApiObjectBase(device, tag, label), mBindingData() {}
 
@@ -570,6 +653,11 @@ const std::vector<Ref<ExternalTextureBase>>& BindGroupBase::GetBoundExternalText
     return mBoundExternalTextures;
 }
 
+const BindGroupResourceUsage& BindGroupBase::GetResourceUsage() const {
+    DAWN_ASSERT(!IsError());
+    return mResourceUsage;
+}
+
 void BindGroupBase::ForEachUnverifiedBufferBindingIndex(
     std::function<void(BindingIndex, uint32_t)> fn) const {
     ForEachUnverifiedBufferBindingIndexImpl(GetLayout(), fn);
@@ -37,6 +37,7 @@
 #include "dawn/native/Error.h"
 #include "dawn/native/Forward.h"
 #include "dawn/native/ObjectBase.h"
+#include "dawn/native/Subresource.h"
 #include "dawn/native/UsageValidationMode.h"
 
 #include "dawn/native/dawn_platform.h"
@@ -55,6 +56,25 @@ struct BufferBinding {
     uint64_t size;
 };
 
+// The resources of a bind group and how they are used, computed once when the bind group is
+// created so that passes can track them without walking the bindings every time the group is set.
+struct BindGroupResourceUsage {
+    struct TextureRangeUsage {
+        TextureBase* texture;
+        SubresourceRange range;
+        wgpu::TextureUsage usage;
+        // Whether the texture is bound as a sampled texture, as opposed to a storage texture.
+        bool sampled;
+    };
+
+    // Each buffer is listed once, with the union of its usages in the bind group.
+    std::vector<BufferBase*> buffers;
+    std::vector<wgpu::BufferUsage> bufferUsages;
+
+    // One entry per texture binding, as texture views may cover different subresources.
+    std::vector<TextureRangeUsage> textures;
+};
+
 class BindGroupBase : public ApiObjectBase {
   public:
     static BindGroupBase* MakeError(DeviceBase* device, const char* label);
@@ -71,6 +91,7 @@ class BindGroupBase : public ApiObjectBase {
     TextureViewBase* GetBindingAsTextureView(BindingIndex bindingIndex);
     const ityp::span<uint32_t, uint64_t>& GetUnverifiedBufferSizes() const;
     const std::vector<Ref<ExternalTextureBase>>& GetBoundExternalTextures() const;
+    const BindGroupResourceUsage& GetResourceUsage() const;
 
     void ForEachUnverifiedBufferBindingIndex(std::function<void(BindingIndex, uint32_t)> fn) const;
 
@@ -104,12 +125,16 @@ class BindGroupBase : public ApiObjectBase {
     BindGroupBase(DeviceBase* device, ObjectBase::ErrorTag tag, const char* label);
     void DeleteThis() override;
 
+    void ComputeResourceUsage();
+
     Ref<BindGroupLayoutBase> mLayout;
     BindGroupLayoutInternalBase::BindingDataPointers mBindingData;
 
     // TODO(dawn:1293): Store external textures in
     // BindGroupLayoutBase::BindingDataPointers::bindings
     std::vector<Ref<ExternalTextureBase>> mBoundExternalTextures;
+
+    BindGroupResourceUsage mResourceUsage;
 };
 
 }  // namespace dawn::native
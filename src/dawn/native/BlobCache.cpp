@@ -28,10 +28,12 @@
 #include "dawn/native/BlobCache.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Version_autogen.h"
 #include "dawn/native/CacheKey.h"
+#include "dawn/native/FileBlobStore.h"
 #include "dawn/native/Instance.h"
 #include "dawn/platform/DawnPlatform.h"
 
@@ -40,12 +42,25 @@ namespace dawn::native {
 BlobCache::BlobCache(dawn::platform::CachingInterface* cachingInterface)
     : mCache(cachingInterface) {}
 
+BlobCache::BlobCache(std::unique_ptr<FileBlobStore> fileStore) : mFileStore(std::move(fileStore)) {}
+
+BlobCache::~BlobCache() = default;
+
 Blob BlobCache::Load(const CacheKey& key) {
+    if (mFileStore != nullptr) {
+        DAWN_ASSERT(ValidateCacheKey(key));
+        return mFileStore->Load(key.data(), key.size());
+    }
     std::lock_guard<std::mutex> lock(mMutex);
     return LoadInternal(key);
 }
 
 void BlobCache::Store(const CacheKey& key, size_t valueSize, const void* value) {
+    if (mFileStore != nullptr) {
+        DAWN_ASSERT(ValidateCacheKey(key));
+        mFileStore->Store(key.data(), key.size(), value, valueSize);
+        return;
+    }
     std::lock_guard<std::mutex> lock(mMutex);
     StoreInternal(key, valueSize, value);
 }
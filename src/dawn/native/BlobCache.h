@@ -28,6 +28,7 @@
 #ifndef SRC_DAWN_NATIVE_BLOBCACHE_H_
 #define SRC_DAWN_NATIVE_BLOBCACHE_H_
 
+#include <memory>
 #include <mutex>
 
 #include "dawn/common/Platform.h"
@@ -41,13 +42,17 @@ class CachingInterface;
 namespace dawn::native {
 
 class CacheKey;
+class FileBlobStore;
 class InstanceBase;
 
 // This class should always be thread-safe because it may be called asynchronously. Its purpose
-// is to wrap the CachingInterface provided via a platform.
+// is to wrap the CachingInterface provided via a platform, or Dawn's built-in FileBlobStore.
 class BlobCache {
   public:
     explicit BlobCache(dawn::platform::CachingInterface* cachingInterface = nullptr);
+    // The FileBlobStore is thread-safe, so loads and stores to it are not serialized.
+    explicit BlobCache(std::unique_ptr<FileBlobStore> fileStore);
+    ~BlobCache();
 
     // Returns empty blob if the key is not found in the cache.
     Blob Load(const CacheKey& key);
@@ -77,7 +82,8 @@ class BlobCache {
 
     // Protects thread safety of access to mCache.
     std::mutex mMutex;
-    dawn::platform::CachingInterface* mCache;
+    dawn::platform::CachingInterface* mCache = nullptr;
+    std::unique_ptr<FileBlobStore> mFileStore;
 };
 
 }  // namespace dawn::native
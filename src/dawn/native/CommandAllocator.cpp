@@ -34,9 +34,22 @@
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Math.h"
+#include "dawn/native/CommandBlockPool.h"
 
 namespace dawn::native {
 
+namespace {
+
+void FreeBlock(const BlockDef& block) {
+    if (block.pool != nullptr) {
+        block.pool->Release(block.block, block.size);
+    } else {
+        free(block.block);
+    }
+}
+
+}  // anonymous namespace
+
 // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
 CommandIterator::CommandIterator() {
@@ -116,7 +129,7 @@ void CommandIterator::MakeEmptyAsDataWasDestroyed() {
     }
 
     for (BlockDef& block : mBlocks) {
-        free(block.block);
+        FreeBlock(block);
     }
     mBlocks.clear();
     Reset();
@@ -141,12 +154,18 @@ CommandAllocator::CommandAllocator() {
     ResetPointers();
 }
 
+CommandAllocator::CommandAllocator(CommandBlockPool* pool) : mPool(pool) {
+    ResetPointers();
+}
+
 CommandAllocator::~CommandAllocator() {
     Reset();
 }
 
 CommandAllocator::CommandAllocator(CommandAllocator&& other)
-    : mBlocks(std::move(other.mBlocks)), mLastAllocationSize(other.mLastAllocationSize) {
+    : mBlocks(std::move(other.mBlocks)),
+      mLastAllocationSize(other.mLastAllocationSize),
+      mPool(other.mPool) {
     other.mBlocks.clear();
     if (!other.IsEmpty()) {
         mCurrentPtr = other.mCurrentPtr;
@@ -162,6 +181,7 @@ CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
     if (!other.IsEmpty()) {
         std::swap(mBlocks, other.mBlocks);
         mLastAllocationSize = other.mLastAllocationSize;
+        mPool = other.mPool;
         mCurrentPtr = other.mCurrentPtr;
         mEndPtr = other.mEndPtr;
     }
@@ -171,7 +191,7 @@ CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
 
 void CommandAllocator::Reset() {
     for (BlockDef& block : mBlocks) {
-        free(block.block);
+        FreeBlock(block);
     }
     mBlocks.clear();
     mLastAllocationSize = kDefaultBaseAllocationSize;
@@ -220,14 +240,17 @@ bool CommandAllocator::GetNewBlock(size_t minimumSize) {
     // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
     mLastAllocationSize = std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
 
-    uint8_t* block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
+    // The pool may return a larger block than requested, use all of it.
+    size_t blockSize = mLastAllocationSize;
+    uint8_t* block = mPool != nullptr ? mPool->Allocate(mLastAllocationSize, &blockSize)
+                                      : static_cast<uint8_t*>(malloc(mLastAllocationSize));
     if (DAWN_UNLIKELY(block == nullptr)) {
         return false;
     }
 
-    mBlocks.push_back({mLastAllocationSize, block});
+    mBlocks.push_back({blockSize, block, mPool});
     mCurrentPtr = AlignPtr(block, alignof(uint32_t));
-    mEndPtr = block + mLastAllocationSize;
+    mEndPtr = block + blockSize;
     return true;
 }
 
@@ -66,11 +66,15 @@ namespace dawn::native {
 // and must tell the CommandIterator when the allocated commands have been processed for
 // deletion.
 
+class CommandBlockPool;
+
 // These are the lists of blocks, should not be used directly, only through CommandAllocator
 // and CommandIterator
 struct BlockDef {
     size_t size;
     uint8_t* block;
+    // The pool the block must be returned to, or nullptr if it was allocated with malloc.
+    CommandBlockPool* pool = nullptr;
 };
 using CommandBlocks = std::vector<BlockDef>;
 
@@ -163,9 +167,13 @@ class CommandIterator : public NonCopyable {
 class CommandAllocator : public NonCopyable {
   public:
     CommandAllocator();
+    // Allocates the blocks from |pool| instead of the heap. The pool must outlive the blocks,
+    // including after they are moved to a CommandIterator.
+    explicit CommandAllocator(CommandBlockPool* pool);
     ~CommandAllocator();
 
-    // NOTE: A moved-from CommandAllocator is reset to its initial empty state.
+    // NOTE: A moved-from CommandAllocator is reset to its initial empty state and keeps
+    // allocating from the same pool.
     CommandAllocator(CommandAllocator&&);
     CommandAllocator& operator=(CommandAllocator&&);
 
@@ -267,6 +275,7 @@ class CommandAllocator : public NonCopyable {
 
     CommandBlocks mBlocks;
     size_t mLastAllocationSize = kDefaultBaseAllocationSize;
+    CommandBlockPool* mPool = nullptr;
 
     // Data used for the block range at initialization so that the first call to Allocate sees
     // there is not enough space and calls GetNewBlock. This avoids having to special case the
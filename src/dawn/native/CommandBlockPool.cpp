@@ -0,0 +1,159 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "dawn/native/CommandBlockPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::native {
+
+namespace {
+
+// Threads are assigned shards round-robin the first time they use any pool.
+std::atomic<uint32_t> sNextShardIndex{0};
+thread_local uint32_t tShardIndex = sNextShardIndex.fetch_add(1, std::memory_order_relaxed);
+
+}  // anonymous namespace
+
+CommandBlockPool::CommandBlockPool() : CommandBlockPool(Descriptor{}) {}
+
+CommandBlockPool::CommandBlockPool(const Descriptor& descriptor)
+    : mSizeClasses(descriptor.sizeClasses),
+      mMaxRetainedBytes(descriptor.maxRetainedBytes),
+      mMaxBlocksPerShard(descriptor.maxBlocksPerShard) {
+    DAWN_ASSERT(std::is_sorted(mSizeClasses.begin(), mSizeClasses.end()));
+    for (FreeLists& shard : mShards) {
+        shard.blocks.resize(mSizeClasses.size());
+    }
+    mOverflow.blocks.resize(mSizeClasses.size());
+}
+
+CommandBlockPool::~CommandBlockPool() {
+    auto FreeAll = [](FreeLists& lists) {
+        for (std::vector<uint8_t*>& blocks : lists.blocks) {
+            for (uint8_t* block : blocks) {
+                free(block);
+            }
+        }
+    };
+    for (FreeLists& shard : mShards) {
+        FreeAll(shard);
+    }
+    FreeAll(mOverflow);
+}
+
+uint8_t* CommandBlockPool::Allocate(size_t minimumSize, size_t* blockSize) {
+    size_t sizeClassIndex = GetSizeClassIndex(minimumSize);
+    if (sizeClassIndex == kNotPooled) {
+        *blockSize = minimumSize;
+        return static_cast<uint8_t*>(malloc(minimumSize));
+    }
+    *blockSize = mSizeClasses[sizeClassIndex];
+
+    uint8_t* block = TakeBlock(GetShardForCurrentThread(), sizeClassIndex);
+    if (block == nullptr) {
+        block = TakeBlock(mOverflow, sizeClassIndex);
+    }
+    if (block != nullptr) {
+        mRetainedBytes.fetch_sub(*blockSize, std::memory_order_relaxed);
+        mHits.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    mMisses.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<uint8_t*>(malloc(*blockSize));
+}
+
+void CommandBlockPool::Release(uint8_t* block, size_t blockSize) {
+    size_t sizeClassIndex = GetSizeClassIndex(blockSize);
+    if (sizeClassIndex == kNotPooled) {
+        free(block);
+        return;
+    }
+    DAWN_ASSERT(mSizeClasses[sizeClassIndex] == blockSize);
+
+    // Reserve the space in the budget before adding the block to a list so that concurrent
+    // releases can't exceed it.
+    uint64_t previousRetainedBytes = mRetainedBytes.fetch_add(blockSize, std::memory_order_relaxed);
+    if (previousRetainedBytes + blockSize > mMaxRetainedBytes) {
+        mRetainedBytes.fetch_sub(blockSize, std::memory_order_relaxed);
+        free(block);
+        return;
+    }
+
+    {
+        FreeLists& shard = GetShardForCurrentThread();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::vector<uint8_t*>& blocks = shard.blocks[sizeClassIndex];
+        if (blocks.size() < mMaxBlocksPerShard) {
+            blocks.push_back(block);
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mOverflow.mutex);
+    mOverflow.blocks[sizeClassIndex].push_back(block);
+}
+
+CommandBlockPool::Stats CommandBlockPool::GetStats() const {
+    Stats stats;
+    stats.hits = mHits.load(std::memory_order_relaxed);
+    stats.misses = mMisses.load(std::memory_order_relaxed);
+    stats.retainedBytes = mRetainedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t CommandBlockPool::GetSizeClassIndex(size_t size) const {
+    for (size_t i = 0; i < mSizeClasses.size(); ++i) {
+        if (size <= mSizeClasses[i]) {
+            return i;
+        }
+    }
+    return kNotPooled;
+}
+
+CommandBlockPool::FreeLists& CommandBlockPool::GetShardForCurrentThread() {
+    return mShards[tShardIndex % kShardCount];
+}
+
+// static
+uint8_t* CommandBlockPool::TakeBlock(FreeLists& lists, size_t sizeClassIndex) {
+    std::lock_guard<std::mutex> lock(lists.mutex);
+    std::vector<uint8_t*>& blocks = lists.blocks[sizeClassIndex];
+    if (blocks.empty()) {
+        return nullptr;
+    }
+    uint8_t* block = blocks.back();
+    blocks.pop_back();
+    return block;
+}
+
+}  // namespace dawn::native
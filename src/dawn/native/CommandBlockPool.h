@@ -0,0 +1,112 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_DAWN_NATIVE_COMMANDBLOCKPOOL_H_
+#define SRC_DAWN_NATIVE_COMMANDBLOCKPOOL_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "dawn/common/NonCopyable.h"
+
+namespace dawn::native {
+
+// CommandBlockPool recycles the memory blocks used by CommandAllocator so that encoding a frame
+// doesn't malloc and free the same blocks over and over. Blocks are grouped by size class and
+// kept in free lists that are sharded per thread: each thread uses the same shard so the common
+// case is an uncontended lock, and blocks that don't fit in a full shard go to a global overflow
+// list shared by all the threads. Blocks larger than the largest size class aren't pooled.
+//
+// The pool must outlive all the blocks allocated from it.
+class CommandBlockPool : public NonMovable {
+  public:
+    struct Descriptor {
+        // The sizes of the pooled blocks, in increasing order.
+        std::vector<size_t> sizeClasses = {4096, 8192, 16384};
+        // The maximum number of bytes kept in the free lists. Blocks released when the pool
+        // already retains that many bytes are freed.
+        size_t maxRetainedBytes = 16 * 1024 * 1024;
+        // The maximum number of blocks of each size class kept in each thread's shard before
+        // they go to the global overflow list.
+        size_t maxBlocksPerShard = 32;
+    };
+
+    struct Stats {
+        // The number of allocations served from the free lists.
+        uint64_t hits = 0;
+        // The number of allocations that had to allocate new memory.
+        uint64_t misses = 0;
+        // The number of bytes currently held in the free lists.
+        uint64_t retainedBytes = 0;
+    };
+
+    CommandBlockPool();
+    explicit CommandBlockPool(const Descriptor& descriptor);
+    ~CommandBlockPool();
+
+    // Returns a block of at least |minimumSize| bytes and stores its actual size in |blockSize|,
+    // or nullptr if the allocation failed.
+    uint8_t* Allocate(size_t minimumSize, size_t* blockSize);
+    // Returns a block previously returned by Allocate, with the size it returned.
+    void Release(uint8_t* block, size_t blockSize);
+
+    Stats GetStats() const;
+
+  private:
+    static constexpr size_t kShardCount = 8;
+    static constexpr size_t kNotPooled = ~size_t(0);
+
+    struct FreeLists {
+        std::mutex mutex;
+        // One list per size class.
+        std::vector<std::vector<uint8_t*>> blocks;
+    };
+
+    size_t GetSizeClassIndex(size_t size) const;
+    FreeLists& GetShardForCurrentThread();
+    static uint8_t* TakeBlock(FreeLists& lists, size_t sizeClassIndex);
+
+    const std::vector<size_t> mSizeClasses;
+    const size_t mMaxRetainedBytes;
+    const size_t mMaxBlocksPerShard;
+
+    std::array<FreeLists, kShardCount> mShards;
+    FreeLists mOverflow;
+
+    std::atomic<uint64_t> mHits{0};
+    std::atomic<uint64_t> mMisses{0};
+    std::atomic<uint64_t> mRetainedBytes{0};
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_COMMANDBLOCKPOOL_H_
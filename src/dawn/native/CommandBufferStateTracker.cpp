@@ -524,7 +524,10 @@ void CommandBufferStateTracker::RecomputeLazyAspects(ValidationAspects aspects)
     if (aspects[VALIDATION_ASPECT_BIND_GROUPS]) {
         bool matches = true;
 
-        for (BindGroupIndex i : IterateBitSet(mLastPipelineLayout->GetBindGroupLayoutsMask())) {
+        // Only check the bind groups that changed since they were last found compatible with
+        // the current pipeline.
+        for (BindGroupIndex i : IterateBitSet(mLastPipelineLayout->GetBindGroupLayoutsMask() &
+                                              ~mCompatibleBindGroups)) {
             if (mBindgroups[i] == nullptr ||
                 mLastPipelineLayout->GetBindGroupLayout(i) != mBindgroups[i]->GetLayout() ||
                 FindFirstUndersizedBuffer(mBindgroups[i]->GetUnverifiedBufferSizes(),
@@ -533,9 +536,10 @@ void CommandBufferStateTracker::RecomputeLazyAspects(ValidationAspects aspects)
                 matches = false;
                 break;
             }
+            mCompatibleBindGroups.set(i);
         }
 
-        if (matches) {
+        if (matches && mLastPipelineLayout->MayHaveWritableBindingAliasing()) {
             // Continue checking if there is writable storage buffer binding aliasing or not
             if (FindStorageBufferBindingAliasing<bool>(mLastPipelineLayout, mBindgroups,
                                                        mDynamicOffsets)) {
@@ -751,12 +755,18 @@ void CommandBufferStateTracker::SetRenderPipeline(RenderPipelineBase* pipeline)
 
 void CommandBufferStateTracker::UnsetBindGroup(BindGroupIndex index) {
     mBindgroups[index] = nullptr;
+    mCompatibleBindGroups.reset(index);
     mAspects.reset(VALIDATION_ASPECT_BIND_GROUPS);
 }
 void CommandBufferStateTracker::SetBindGroup(BindGroupIndex index,
                                              BindGroupBase* bindgroup,
                                              uint32_t dynamicOffsetCount,
                                              const uint32_t* dynamicOffsets) {
+    // Setting the same bind group again doesn't change its compatibility with the pipeline, but
+    // new dynamic offsets can still introduce aliasing so the aspect is always recomputed.
+    if (mBindgroups[index] != bindgroup) {
+        mCompatibleBindGroups.reset(index);
+    }
     mBindgroups[index] = bindgroup;
     mDynamicOffsets[index].assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
     mAspects.reset(VALIDATION_ASPECT_BIND_GROUPS);
@@ -783,6 +793,7 @@ void CommandBufferStateTracker::SetPipelineCommon(PipelineBase* pipeline) {
     mLastPipeline = pipeline;
     mLastPipelineLayout = pipeline != nullptr ? pipeline->GetLayout() : nullptr;
     mMinBufferSizes = pipeline != nullptr ? &pipeline->GetMinBufferSizes() : nullptr;
+    mCompatibleBindGroups.reset();
 
     mAspects.set(VALIDATION_ASPECT_PIPELINE);
 
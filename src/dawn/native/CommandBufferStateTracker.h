@@ -93,6 +93,9 @@ class CommandBufferStateTracker {
     ValidationAspects mAspects;
 
     ityp::array<BindGroupIndex, BindGroupBase*, kMaxBindGroups> mBindgroups = {};
+    // The bind groups that are known to match the layout and minimum buffer sizes of the current
+    // pipeline, so that they don't need to be checked again when another group changes.
+    ityp::bitset<BindGroupIndex, kMaxBindGroups> mCompatibleBindGroups;
     ityp::array<BindGroupIndex, std::vector<uint32_t>, kMaxBindGroups> mDynamicOffsets = {};
     ityp::bitset<VertexBufferSlot, kMaxVertexBuffers> mVertexBufferSlotsUsed;
     bool mIndexBufferSet = false;
@@ -62,6 +62,30 @@ namespace dawn::native {
 
 namespace {
 
+// Returns true if BeginRenderPass(descriptor) may create resources on the device: implicit MSAA
+// textures for render-to-single-sampled attachments, or temporary resources for the render pass
+// workarounds.
+bool BeginRenderPassMayCreateResources(const DeviceBase* device,
+                                       const RenderPassDescriptor* descriptor) {
+    if (device->IsToggleEnabled(Toggle::ResolveMultipleAttachmentInSeparatePasses) ||
+        device->IsToggleEnabled(Toggle::AlwaysResolveIntoZeroLevelAndLayer) ||
+        device->IsToggleEnabled(Toggle::ApplyClearBigIntegerColorValueWithDraw)) {
+        return true;
+    }
+    if (descriptor == nullptr) {
+        return false;
+    }
+    for (uint32_t i = 0; i < descriptor->colorAttachmentCount; ++i) {
+        const DawnRenderPassColorAttachmentRenderToSingleSampled* msaaRenderToSingleSampledDesc =
+            nullptr;
+        FindInChain(descriptor->colorAttachments[i].nextInChain, &msaaRenderToSingleSampledDesc);
+        if (msaaRenderToSingleSampledDesc != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
 MaybeError ValidateB2BCopyAlignment(uint64_t dataSize, uint64_t srcOffset, uint64_t dstOffset) {
     // Copy size must be a multiple of 4 bytes on macOS.
     DAWN_INVALID_IF(dataSize % 4 != 0, "Copy size (%u) is not a multiple of 4.", dataSize);
@@ -895,6 +919,7 @@ ObjectType CommandEncoder::GetType() const {
 }
 
 void CommandEncoder::DestroyImpl() {
+    std::lock_guard<std::mutex> lock(mFinishMutex);
     mEncodingContext.Destroy();
 }
 
@@ -926,15 +951,13 @@ void CommandEncoder::TrackQueryAvailability(QuerySetBase* querySet, uint32_t que
 // Implementation of the API's command recording methods
 
 ComputePassEncoder* CommandEncoder::APIBeginComputePass(const ComputePassDescriptor* descriptor) {
-    // This function will create new object, need to lock the Device.
-    auto deviceLock(GetDevice()->GetScopedLock());
-
+    // Beginning a compute pass only creates the pass encoder and records errors in the encoding
+    // context, neither of which needs the device lock.
     return BeginComputePass(descriptor).Detach();
 }
 
 Ref<ComputePassEncoder> CommandEncoder::BeginComputePass(const ComputePassDescriptor* descriptor) {
     DeviceBase* device = GetDevice();
-    DAWN_ASSERT(device->IsLockedByCurrentThreadIfNeeded());
 
     bool success = mEncodingContext.TryEncode(
         this,
@@ -986,15 +1009,18 @@ Ref<ComputePassEncoder> CommandEncoder::BeginComputePass(const ComputePassDescri
 }
 
 RenderPassEncoder* CommandEncoder::APIBeginRenderPass(const RenderPassDescriptor* descriptor) {
-    // This function will create new object, need to lock the Device.
-    auto deviceLock(GetDevice()->GetScopedLock());
+    // This function may create new resources for implicit MSAA attachments and render pass
+    // workarounds, in which case the device needs to be locked.
+    auto deviceLock(
+        GetDevice()->GetScopedLockIf(BeginRenderPassMayCreateResources(GetDevice(), descriptor)));
 
     return BeginRenderPass(descriptor).Detach();
 }
 
 Ref<RenderPassEncoder> CommandEncoder::BeginRenderPass(const RenderPassDescriptor* descriptor) {
     DeviceBase* device = GetDevice();
-    DAWN_ASSERT(device->IsLockedByCurrentThreadIfNeeded());
+    DAWN_ASSERT(!BeginRenderPassMayCreateResources(device, descriptor) ||
+                device->IsLockedByCurrentThreadIfNeeded());
 
     RenderPassResourceUsageTracker usageTracker;
 
@@ -2011,11 +2037,15 @@ void CommandEncoder::APIWriteTimestamp(QuerySetBase* querySet, uint32_t queryInd
 }
 
 CommandBufferBase* CommandEncoder::APIFinish(const CommandBufferDescriptor* descriptor) {
-    // This function will create new object, need to lock the Device.
-    auto deviceLock(GetDevice()->GetScopedLock());
-
+    // Finishing only validates the encoder's own state and wraps its commands in a command
+    // buffer, so the device is only locked if there is an error to report. mFinishMutex is
+    // released before that since it must not be held while acquiring the device lock.
+    ResultOrError<Ref<CommandBufferBase>> result = [&]() {
+        std::lock_guard<std::mutex> lock(mFinishMutex);
+        return Finish(descriptor);
+    }();
     Ref<CommandBufferBase> commandBuffer;
-    if (GetDevice()->ConsumedError(Finish(descriptor), &commandBuffer)) {
+    if (GetDevice()->ConsumedErrorAndLockIfNeeded(std::move(result), &commandBuffer)) {
         CommandBufferBase* errorCommandBuffer =
             CommandBufferBase::MakeError(GetDevice(), descriptor ? descriptor->label : nullptr);
         errorCommandBuffer->SetEncoderLabel(this->GetLabel());
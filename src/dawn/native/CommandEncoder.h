@@ -28,6 +28,7 @@
 #ifndef SRC_DAWN_NATIVE_COMMANDENCODER_H_
 #define SRC_DAWN_NATIVE_COMMANDENCODER_H_
 
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -147,6 +148,10 @@ class CommandEncoder final : public ApiObjectBase {
     MaybeError ValidateFinish() const;
 
     EncodingContext mEncodingContext;
+    // Finish runs without the device lock, so this serializes it with DestroyImpl, which is
+    // called from another thread when the device is destroyed. It must never be held while
+    // acquiring the device lock.
+    std::mutex mFinishMutex;
     std::set<BufferBase*> mTopLevelBuffers;
     std::set<TextureBase*> mTopLevelTextures;
     std::set<QuerySetBase*> mUsedQuerySets;
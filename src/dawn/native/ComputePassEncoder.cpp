@@ -167,6 +167,8 @@ ObjectType ComputePassEncoder::GetType() const {
 
 void ComputePassEncoder::APIEnd() {
     if (mEnded && IsValidationEnabled()) {
+        // Pass encoders run without the device lock, so lock it to report the error.
+        auto deviceLock(GetDevice()->GetScopedLock());
         GetDevice()->HandleError(DAWN_VALIDATION_ERROR("%s was already ended.", this));
         return;
     }
@@ -94,7 +94,10 @@ void CreateComputePipelineAsyncTask::RunAsync(
     TRACE_EVENT_FLOW_BEGIN1(device->GetPlatform(), General,
                             "CreateComputePipelineAsyncTask::RunAsync", task.get(), "label",
                             eventLabel);
-    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+    // Pipeline compilations are long running, post them as background work so they don't delay
+    // other async tasks.
+    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask),
+                                            dawn::platform::WorkerTaskPriority::Background);
 }
 
 CreateRenderPipelineAsyncTask::CreateRenderPipelineAsyncTask(
@@ -150,6 +153,7 @@ void CreateRenderPipelineAsyncTask::RunAsync(std::unique_ptr<CreateRenderPipelin
     TRACE_EVENT_FLOW_BEGIN1(device->GetPlatform(), General,
                             "CreateRenderPipelineAsyncTask::RunAsync", task.get(), "label",
                             eventLabel);
-    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask),
+                                            dawn::platform::WorkerTaskPriority::Background);
 }
 }  // namespace dawn::native
@@ -42,6 +42,7 @@
 #include "dawn/native/BlobCache.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/ChainUtils.h"
+#include "dawn/native/CommandBlockPool.h"
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CompilationMessages.h"
@@ -290,6 +291,7 @@ MaybeError DeviceBase::Initialize(Ref<QueueBase> defaultQueue) {
 #endif  // DAWN_ENABLE_ASSERTS
 
     mCaches = std::make_unique<DeviceBase::Caches>();
+    mCommandBlockPool = std::make_unique<CommandBlockPool>();
     mErrorScopeStack = std::make_unique<ErrorScopeStack>();
     mDynamicUploader = std::make_unique<DynamicUploader>(this);
     mCallbackTaskManager = AcquireRef(new CallbackTaskManager());
@@ -302,7 +304,7 @@ MaybeError DeviceBase::Initialize(Ref<QueueBase> defaultQueue) {
 
     // Starting from now the backend can start doing reentrant calls so the device is marked as
     // alive.
-    mState = State::Alive;
+    mState.store(State::Alive, std::memory_order_release);
 
     DAWN_TRY_ASSIGN(mEmptyBindGroupLayout, CreateEmptyBindGroupLayout());
     DAWN_TRY_ASSIGN(mEmptyPipelineLayout, CreateEmptyPipelineLayout());
@@ -442,7 +444,7 @@ void DeviceBase::DestroyObjects() {
 
 void DeviceBase::Destroy() {
     // Skip if we are already destroyed.
-    if (mState == State::Destroyed) {
+    if (mState.load(std::memory_order_acquire) == State::Destroyed) {
         return;
     }
 
@@ -456,7 +458,7 @@ void DeviceBase::Destroy() {
     // from Tick() whether or not there is any more pending work.
 
     // Skip handling device facilities if they haven't even been created (or failed doing so)
-    if (mState != State::BeingCreated) {
+    if (mState.load(std::memory_order_acquire) != State::BeingCreated) {
         // The device is being destroyed so it will be lost, call the application callback.
         if (mDeviceLostCallback != nullptr) {
             mCallbackTaskManager->AddCallbackTask(
@@ -472,7 +474,7 @@ void DeviceBase::Destroy() {
     }
 
     // Disconnect the device, depending on which state we are currently in.
-    switch (mState) {
+    switch (mState.load(std::memory_order_acquire)) {
         case State::BeingCreated:
             // The GPU timeline was never started so we don't have to wait.
             break;
@@ -501,7 +503,7 @@ void DeviceBase::Destroy() {
             break;
     }
 
-    if (mState != State::BeingCreated) {
+    if (mState.load(std::memory_order_acquire) != State::BeingCreated) {
         // The GPU timeline is finished.
         DAWN_ASSERT(mQueue->GetCompletedCommandSerial() == GetLastSubmittedCommandSerial());
 
@@ -518,7 +520,7 @@ void DeviceBase::Destroy() {
     // At this point GPU operations are always finished, so we are in the disconnected state.
     // Note that currently this state change is required because some of the backend
     // implementations of DestroyImpl checks that we are disconnected before doing work.
-    mState = State::Disconnected;
+    mState.store(State::Disconnected, std::memory_order_release);
 
     // Note: mQueue is not released here since the application may still get it after calling
     // Destroy() via APIGetQueue.
@@ -536,7 +538,7 @@ void DeviceBase::Destroy() {
     DestroyImpl();
 
     mCaches = nullptr;
-    mState = State::Destroyed;
+    mState.store(State::Destroyed, std::memory_order_release);
 }
 
 void DeviceBase::APIDestroy() {
@@ -560,7 +562,7 @@ void DeviceBase::HandleError(std::unique_ptr<ErrorData> error,
         InternalErrorType::Validation | InternalErrorType::DeviceLost | additionalAllowedErrors;
 
     if (type == InternalErrorType::DeviceLost) {
-        mState = State::Disconnected;
+        mState.store(State::Disconnected, std::memory_order_release);
 
         // If the ErrorInjector is enabled, then the device loss might be fake and the device
         // still be executing commands. Force a wait for idle in this case, with State being
@@ -581,16 +583,14 @@ void DeviceBase::HandleError(std::unique_ptr<ErrorData> error,
 
         // Move away from the Alive state so that the application cannot use this device
         // anymore.
-        // TODO(crbug.com/dawn/831): Do we need atomics for this to become visible to other
-        // threads in a multithreaded scenario?
-        mState = State::BeingDisconnected;
+        mState.store(State::BeingDisconnected, std::memory_order_release);
 
         // Ignore errors so that we can continue with destruction
         // Assume all commands are complete after WaitForIdleForDestruction (because they were)
         IgnoreErrors(mQueue->WaitForIdleForDestruction());
         IgnoreErrors(TickImpl());
         mQueue->AssumeCommandsComplete();
-        mState = State::Disconnected;
+        mState.store(State::Disconnected, std::memory_order_release);
 
         // Now everything is as if the device was lost.
         type = InternalErrorType::DeviceLost;
@@ -651,8 +651,10 @@ void DeviceBase::APISetLoggingCallback(wgpu::LoggingCallback callback, void* use
     if (IsLost()) {
         return;
     }
-    mLoggingCallback = callback;
-    mLoggingUserdata = userdata;
+    mLoggingCallback.Use([&](auto loggingCallback) {
+        loggingCallback->callback = callback;
+        loggingCallback->userdata = userdata;
+    });
 }
 
 void DeviceBase::APISetUncapturedErrorCallback(wgpu::ErrorCallback callback, void* userdata) {
@@ -751,12 +753,12 @@ MaybeError DeviceBase::ValidateObject(const ApiObjectBase* object) const {
 }
 
 MaybeError DeviceBase::ValidateIsAlive() const {
-    DAWN_INVALID_IF(mState != State::Alive, "%s is lost.", this);
+    DAWN_INVALID_IF(mState.load(std::memory_order_acquire) != State::Alive, "%s is lost.", this);
     return {};
 }
 
 void DeviceBase::APIForceLoss(wgpu::DeviceLostReason reason, const char* message) {
-    if (mState != State::Alive) {
+    if (mState.load(std::memory_order_acquire) != State::Alive) {
         return;
     }
     // Note that since we are passing None as the allowedErrors, an additional message will be
@@ -766,12 +768,13 @@ void DeviceBase::APIForceLoss(wgpu::DeviceLostReason reason, const char* message
 }
 
 DeviceBase::State DeviceBase::GetState() const {
-    return mState;
+    return mState.load(std::memory_order_acquire);
 }
 
 bool DeviceBase::IsLost() const {
-    DAWN_ASSERT(mState != State::BeingCreated);
-    return mState != State::Alive;
+    State state = mState.load(std::memory_order_acquire);
+    DAWN_ASSERT(state != State::BeingCreated);
+    return state != State::Alive;
 }
 
 ApiObjectList* DeviceBase::GetObjectTrackingList(ObjectType type) {
@@ -1086,8 +1089,8 @@ BufferBase* DeviceBase::APICreateBuffer(const BufferDescriptor* descriptor) {
 }
 CommandEncoder* DeviceBase::APICreateCommandEncoder(const CommandEncoderDescriptor* descriptor) {
     Ref<CommandEncoder> result;
-    if (ConsumedError(CreateCommandEncoder(descriptor), &result,
-                      "calling %s.CreateCommandEncoder(%s).", this, descriptor)) {
+    if (ConsumedErrorAndLockIfNeeded(CreateCommandEncoder(descriptor), &result,
+                                     "calling %s.CreateCommandEncoder(%s).", this, descriptor)) {
         return CommandEncoder::MakeError(this, descriptor ? descriptor->label : nullptr);
     }
     return result.Detach();
@@ -1198,8 +1201,9 @@ void DeviceBase::APICreateRenderPipelineAsync(const RenderPipelineDescriptor* de
 RenderBundleEncoder* DeviceBase::APICreateRenderBundleEncoder(
     const RenderBundleEncoderDescriptor* descriptor) {
     Ref<RenderBundleEncoder> result;
-    if (ConsumedError(CreateRenderBundleEncoder(descriptor), &result,
-                      "calling %s.CreateRenderBundleEncoder(%s).", this, descriptor)) {
+    if (ConsumedErrorAndLockIfNeeded(CreateRenderBundleEncoder(descriptor), &result,
+                                     "calling %s.CreateRenderBundleEncoder(%s).", this,
+                                     descriptor)) {
         return RenderBundleEncoder::MakeError(this, descriptor ? descriptor->label : nullptr);
     }
     return result.Detach();
@@ -1511,7 +1515,7 @@ void DeviceBase::EmitDeprecationWarning(const std::string& message) {
 }
 
 void DeviceBase::EmitWarningOnce(const std::string& message) {
-    if (mWarnings.insert(message).second) {
+    if (mWarnings->insert(message).second) {
         this->EmitLog(WGPULoggingType_Warning, message.c_str());
     }
 }
@@ -1521,12 +1525,15 @@ void DeviceBase::EmitLog(const char* message) {
 }
 
 void DeviceBase::EmitLog(WGPULoggingType loggingType, const char* message) {
-    if (mLoggingCallback != nullptr) {
-        // Use the thread-safe CallbackTaskManager routine
-        std::unique_ptr<LoggingCallbackTask> callbackTask = std::make_unique<LoggingCallbackTask>(
-            mLoggingCallback, loggingType, message, mLoggingUserdata);
-        mCallbackTaskManager->AddCallbackTask(std::move(callbackTask));
-    }
+    mLoggingCallback.Use([&](auto loggingCallback) {
+        if (loggingCallback->callback != nullptr) {
+            // Use the thread-safe CallbackTaskManager routine
+            std::unique_ptr<LoggingCallbackTask> callbackTask =
+                std::make_unique<LoggingCallbackTask>(loggingCallback->callback, loggingType,
+                                                      message, loggingCallback->userdata);
+            mCallbackTaskManager->AddCallbackTask(std::move(callbackTask));
+        }
+    });
 }
 
 bool DeviceBase::APIGetLimits(SupportedLimits* limits) const {
@@ -1965,6 +1972,10 @@ AsyncTaskManager* DeviceBase::GetAsyncTaskManager() const {
     return mAsyncTaskManager.get();
 }
 
+CommandBlockPool* DeviceBase::GetCommandBlockPool() const {
+    return mCommandBlockPool.get();
+}
+
 CallbackTaskManager* DeviceBase::GetCallbackTaskManager() const {
     return mCallbackTaskManager.Get();
 }
@@ -2168,6 +2179,10 @@ Mutex::AutoLock DeviceBase::GetScopedLock() {
     return Mutex::AutoLock(mMutex.Get());
 }
 
+Mutex::AutoLock DeviceBase::GetScopedLockIf(bool needsLock) {
+    return Mutex::AutoLock(needsLock ? mMutex.Get() : nullptr);
+}
+
 bool DeviceBase::IsLockedByCurrentThreadIfNeeded() const {
     return mMutex == nullptr || mMutex->IsLockedByCurrentThread();
 }
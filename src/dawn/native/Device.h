@@ -28,6 +28,7 @@
 #ifndef SRC_DAWN_NATIVE_DEVICE_H_
 #define SRC_DAWN_NATIVE_DEVICE_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -36,6 +37,7 @@
 
 #include "dawn/common/ContentLessObjectCache.h"
 #include "dawn/common/Mutex.h"
+#include "dawn/common/MutexProtected.h"
 #include "dawn/native/CacheKey.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/ComputePipeline.h"
@@ -60,6 +62,7 @@ class WorkerTaskPool;
 
 namespace dawn::native {
 class AsyncTaskManager;
+class CommandBlockPool;
 class AttachmentState;
 class AttachmentStateBlueprint;
 class Blob;
@@ -169,6 +172,43 @@ class DeviceBase : public RefCountedWithExternalCount {
                              args...);
     }
 
+    // Variants of ConsumedError for entry points that run without the device lock ("no autolock"
+    // in dawn.json). Handling an error touches the device's state (error scopes, callbacks), so
+    // the device is locked, but only when there is an error to handle.
+    template <typename... Args>
+    [[nodiscard]] bool ConsumedErrorAndLockIfNeeded(MaybeError maybeError,
+                                                    const char* formatStr,
+                                                    const Args&... args) {
+        if (DAWN_LIKELY(maybeError.IsSuccess())) {
+            return false;
+        }
+        auto deviceLock(GetScopedLock());
+        return ConsumedError(std::move(maybeError), formatStr, args...);
+    }
+
+    template <typename T>
+    [[nodiscard]] bool ConsumedErrorAndLockIfNeeded(ResultOrError<T> resultOrError, T* result) {
+        if (DAWN_LIKELY(resultOrError.IsSuccess())) {
+            *result = resultOrError.AcquireSuccess();
+            return false;
+        }
+        auto deviceLock(GetScopedLock());
+        return ConsumedError(std::move(resultOrError), result);
+    }
+
+    template <typename T, typename... Args>
+    [[nodiscard]] bool ConsumedErrorAndLockIfNeeded(ResultOrError<T> resultOrError,
+                                                    T* result,
+                                                    const char* formatStr,
+                                                    const Args&... args) {
+        if (DAWN_LIKELY(resultOrError.IsSuccess())) {
+            *result = resultOrError.AcquireSuccess();
+            return false;
+        }
+        auto deviceLock(GetScopedLock());
+        return ConsumedError(std::move(resultOrError), result, formatStr, args...);
+    }
+
     MaybeError ValidateObject(const ApiObjectBase* object) const;
 
     InstanceBase* GetInstance() const;
@@ -413,6 +453,7 @@ class DeviceBase : public RefCountedWithExternalCount {
     const CombinedLimits& GetLimits() const;
 
     AsyncTaskManager* GetAsyncTaskManager() const;
+    CommandBlockPool* GetCommandBlockPool() const;
     CallbackTaskManager* GetCallbackTaskManager() const;
     dawn::platform::WorkerTaskPool* GetWorkerTaskPool() const;
 
@@ -456,6 +497,9 @@ class DeviceBase : public RefCountedWithExternalCount {
     // This lock won't guarantee the wrapped mutex will be alive if the Device is deleted before the
     // AutoLock. It would crash if such thing happens.
     [[nodiscard]] Mutex::AutoLock GetScopedLock();
+    // Same as GetScopedLock() but only locks the device if |needsLock| is true. This is used by
+    // entry points that run without the device lock and only need it on their slow paths.
+    [[nodiscard]] Mutex::AutoLock GetScopedLockIf(bool needsLock);
 
     // This method returns true if Feature::ImplicitDeviceSynchronization is turned on and the
     // device is locked by current thread. This method is only enabled when DAWN_ENABLE_ASSERTS is
@@ -571,12 +615,20 @@ class DeviceBase : public RefCountedWithExternalCount {
     wgpu::ErrorCallback mUncapturedErrorCallback = nullptr;
     void* mUncapturedErrorUserdata = nullptr;
 
-    wgpu::LoggingCallback mLoggingCallback = nullptr;
-    void* mLoggingUserdata = nullptr;
+    // Logs can be emitted from encoders which don't hold the device lock, so the logging callback
+    // and its userdata are protected by their own mutex.
+    struct LoggingCallback {
+        wgpu::LoggingCallback callback = nullptr;
+        void* userdata = nullptr;
+    };
+    MutexProtected<LoggingCallback> mLoggingCallback;
 
     wgpu::DeviceLostCallback mDeviceLostCallback = nullptr;
     void* mDeviceLostUserdata = nullptr;
 
+    // Declared before the objects that can hold command blocks so that it is destroyed after them.
+    std::unique_ptr<CommandBlockPool> mCommandBlockPool;
+
     std::unique_ptr<ErrorScopeStack> mErrorScopeStack;
 
     Ref<AdapterBase> mAdapter;
@@ -598,9 +650,13 @@ class DeviceBase : public RefCountedWithExternalCount {
     struct DeprecationWarnings;
     std::unique_ptr<DeprecationWarnings> mDeprecationWarnings;
 
-    std::unordered_set<std::string> mWarnings;
+    // Warnings can be emitted from encoders which don't hold the device lock, so the set of
+    // already emitted warnings is protected by its own mutex.
+    MutexProtected<std::unordered_set<std::string>> mWarnings;
 
-    State mState = State::BeingCreated;
+    // Read without the device lock by the "no autolock" encoder entry points (IsLost and
+    // ValidateIsAlive), so it is atomic and written with release / read with acquire ordering.
+    std::atomic<State> mState{State::BeingCreated};
 
     PerObjectType<ApiObjectList> mObjectLists;
 
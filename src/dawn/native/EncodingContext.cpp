@@ -41,6 +41,7 @@ EncodingContext::EncodingContext(DeviceBase* device, const ApiObjectBase* initia
     : mDevice(device),
       mTopLevelEncoder(initialEncoder),
       mCurrentEncoder(initialEncoder),
+      mPendingCommands(device->GetCommandBlockPool()),
       mDestroyed(device->IsLost()) {}
 
 EncodingContext::~EncodingContext() {
@@ -147,18 +148,14 @@ MaybeError EncodingContext::ExitRenderPass(const ApiObjectBase* passEncoder,
         //       so swap back the renderCommands to ensure that they are not leaked.
         CommandAllocator renderCommands = std::move(mPendingCommands);
 
-        // The below function might create new resources. Device must already be locked via
-        // renderpassEncoder's APIEnd().
+        // The below function might create new resources. If there are indirect draws to
+        // validate, the device must already be locked via renderpassEncoder's APIEnd().
         // TODO(crbug.com/dawn/1618): In future, all temp resources should be created at
         // Command Submit time, so the locking would be removed from here at that point.
-        {
-            DAWN_ASSERT(mDevice->IsLockedByCurrentThreadIfNeeded());
-
-            DAWN_TRY_WITH_CLEANUP(
-                EncodeIndirectDrawValidationCommands(mDevice, commandEncoder, &usageTracker,
-                                                     &indirectDrawMetadata),
-                { mPendingCommands = std::move(renderCommands); });
-        }
+        DAWN_TRY_WITH_CLEANUP(
+            EncodeIndirectDrawValidationCommands(mDevice, commandEncoder, &usageTracker,
+                                                 &indirectDrawMetadata),
+            { mPendingCommands = std::move(renderCommands); });
 
         CommitCommands(std::move(mPendingCommands));
         CommitCommands(std::move(renderCommands));
@@ -138,6 +138,12 @@ static constexpr FeatureEnumAndInfo kFeatureInfo[] = {
      {"Public API methods (except encoding) will have implicit device synchronization. So they "
       "will be safe to be used on multiple threads.",
       "https://bugs.chromium.org/p/dawn/issues/detail?id=1662", FeatureInfo::FeatureState::Stable}},
+    {Feature::RenderPassSubEncoders,
+     {"Support splitting a render pass into sub-encoders that can be recorded concurrently on "
+      "different threads and are merged in creation order when the pass ends.",
+      "https://dawn.googlesource.com/dawn/+/refs/heads/main/docs/dawn/features/"
+      "render_pass_sub_encoders.md",
+      FeatureInfo::FeatureState::Experimental}},
     {Feature::SurfaceCapabilities,
      {"Support querying Surface's capabilities such as supported usage flags. This feature also "
       "enables swap chain to be created with usage other than RenderAttachment.",
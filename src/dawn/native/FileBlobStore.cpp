@@ -0,0 +1,583 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "dawn/native/FileBlobStore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Log.h"
+#include "dawn/common/Math.h"
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dawn::native {
+
+#if DAWN_PLATFORM_IS(POSIX)
+
+namespace {
+
+// "DAWNBLB1" when read as little endian.
+constexpr uint64_t kFileMagic = 0x31424c424e574144;
+// "BLOB" when read as little endian.
+constexpr uint32_t kRecordMagic = 0x424f4c42;
+constexpr size_t kRecordAlignment = 8;
+
+struct FileHeader {
+    uint64_t magic;
+    uint64_t reserved;
+};
+
+// Each record is a RecordHeader, followed by the key, the value, and padding to kRecordAlignment.
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t keySize;
+    uint64_t valueSize;
+    uint64_t keyHash;
+    // Hash of the value, seeded with the key hash and value size.
+    uint64_t checksum;
+};
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+    constexpr uint64_t kMultiplier = 0x9e3779b97f4a7c15;
+    auto mix = [](uint64_t v) {
+        v *= kMultiplier;
+        return v ^ (v >> 32);
+    };
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed ^ mix(size);
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        hash = (hash ^ mix(word)) * kMultiplier;
+    }
+    if (size > 0) {
+        uint64_t word = 0;
+        memcpy(&word, bytes, size);
+        hash = (hash ^ mix(word)) * kMultiplier;
+    }
+    return mix(hash ^ (hash >> 29));
+}
+
+uint64_t HashKey(const void* key, size_t keySize) {
+    return HashBytes(key, keySize, 0);
+}
+
+uint64_t Checksum(uint64_t keyHash, const void* value, uint64_t valueSize) {
+    return HashBytes(value, valueSize, keyHash ^ valueSize);
+}
+
+uint64_t GetRecordSize(uint64_t keySize, uint64_t valueSize) {
+    return Align(sizeof(RecordHeader) + keySize + valueSize, kRecordAlignment);
+}
+
+// Writes all of `size` bytes at `offset`, retrying on interruptions and partial writes.
+bool WriteAll(int fd, const void* data, uint64_t size, uint64_t offset) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t written = pwrite(fd, bytes, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<uint64_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+    return true;
+}
+
+}  // anonymous namespace
+
+// A shard is a single append-only file of records with the index of its live records. All its
+// methods are thread-safe.
+class FileBlobStore::Shard {
+  public:
+    Shard(std::string path, uint64_t maxSize) : mPath(std::move(path)), mMaxSize(maxSize) {
+        DAWN_ASSERT(mMaxSize > sizeof(FileHeader));
+    }
+
+    ~Shard() { Close(); }
+
+    // Opens or creates the shard file and indexes its records. Returns false if the file cannot
+    // be used.
+    bool Open() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // A temporary file left by a compaction that did not complete is never valid.
+        unlink(GetTemporaryPath().c_str());
+
+        mFd = open(mPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (mFd < 0) {
+            return false;
+        }
+        struct stat fileStat;
+        if (fstat(mFd, &fileStat) != 0) {
+            Close();
+            return false;
+        }
+        mFileSize = static_cast<uint64_t>(fileStat.st_size);
+
+        FileHeader header;
+        if (mFileSize < sizeof(header) || !MapFile()) {
+            return Reset();
+        }
+        memcpy(&header, mMapping, sizeof(header));
+        if (header.magic != kFileMagic) {
+            return Reset();
+        }
+        ReadRecords();
+        if (mFd < 0) {
+            return false;
+        }
+        // The size budget may be smaller than when the file was written.
+        if (mFileSize > mMaxSize) {
+            Compact();
+        }
+        return mFd >= 0;
+    }
+
+    Blob Load(uint64_t keyHash, const void* key, size_t keySize) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = Find(keyHash, key, keySize);
+        if (it == mIndex.end()) {
+            return Blob();
+        }
+        it->second.lastUse = ++mClock;
+
+        RecordHeader header = GetRecordHeader(it->second.offset);
+        Blob result = CreateBlob(header.valueSize);
+        memcpy(result.Data(), mMapping + it->second.offset + sizeof(RecordHeader) + keySize,
+               header.valueSize);
+        return result;
+    }
+
+    void Store(uint64_t keyHash,
+               const void* key,
+               size_t keySize,
+               const void* value,
+               size_t valueSize) {
+        const uint64_t recordSize = GetRecordSize(keySize, valueSize);
+        if (keySize > std::numeric_limits<uint32_t>::max() ||
+            recordSize > mMaxSize - sizeof(FileHeader)) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mFd < 0) {
+            return;
+        }
+
+        // Don't append a copy of a value that is already stored.
+        auto it = Find(keyHash, key, keySize);
+        if (it != mIndex.end()) {
+            RecordHeader header = GetRecordHeader(it->second.offset);
+            if (header.valueSize == valueSize &&
+                memcmp(mMapping + it->second.offset + sizeof(RecordHeader) + keySize, value,
+                       valueSize) == 0) {
+                it->second.lastUse = ++mClock;
+                return;
+            }
+        }
+
+        RecordHeader header = {};
+        header.magic = kRecordMagic;
+        header.keySize = static_cast<uint32_t>(keySize);
+        header.valueSize = valueSize;
+        header.keyHash = keyHash;
+        header.checksum = Checksum(keyHash, value, valueSize);
+
+        std::vector<uint8_t> record(recordSize, 0);
+        memcpy(record.data(), &header, sizeof(header));
+        memcpy(record.data() + sizeof(header), key, keySize);
+        memcpy(record.data() + sizeof(header) + keySize, value, valueSize);
+
+        const uint64_t offset = mFileSize;
+        if (!WriteAll(mFd, record.data(), recordSize, offset)) {
+            // Drop whatever part of the record was written.
+            if (ftruncate(mFd, static_cast<off_t>(offset)) != 0) {
+                Close();
+            }
+            return;
+        }
+        mFileSize += recordSize;
+        if (!MapFile()) {
+            Close();
+            return;
+        }
+
+        Entry entry = {offset, recordSize, ++mClock};
+        if (it != mIndex.end()) {
+            it->second = entry;
+        } else {
+            mIndex.emplace(keyHash, entry);
+        }
+
+        if (mFileSize > mMaxSize) {
+            Compact();
+        }
+    }
+
+    size_t GetEntryCount() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mIndex.size();
+    }
+
+    uint64_t GetFileSize() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mFileSize;
+    }
+
+  private:
+    struct Entry {
+        uint64_t offset;
+        uint64_t recordSize;
+        // The value of mClock when the entry was last loaded or stored.
+        uint64_t lastUse;
+    };
+    // Maps key hashes to entries. Keys are compared against the file to resolve hash collisions.
+    using Index = std::unordered_multimap<uint64_t, Entry>;
+
+    std::string GetTemporaryPath() const { return mPath + ".tmp"; }
+
+    RecordHeader GetRecordHeader(uint64_t offset) const {
+        RecordHeader header;
+        memcpy(&header, mMapping + offset, sizeof(header));
+        return header;
+    }
+
+    Index::iterator Find(uint64_t keyHash, const void* key, size_t keySize) {
+        auto range = mIndex.equal_range(keyHash);
+        for (auto it = range.first; it != range.second; ++it) {
+            uint64_t offset = it->second.offset;
+            if (GetRecordHeader(offset).keySize == keySize &&
+                memcmp(mMapping + offset + sizeof(RecordHeader), key, keySize) == 0) {
+                return it;
+            }
+        }
+        return mIndex.end();
+    }
+
+    // Makes sure that the whole file is mapped. The mapping is larger than the file so that it
+    // does not need to be recreated for every store: the file is at most one record larger than
+    // mMaxSize before it is compacted.
+    bool MapFile() {
+        if (mFileSize <= mMappingSize) {
+            return true;
+        }
+        Unmap();
+        size_t mappingSize = static_cast<size_t>(std::max(mFileSize, 2 * mMaxSize));
+        void* mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, mFd, 0);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+        mMapping = static_cast<const uint8_t*>(mapping);
+        mMappingSize = mappingSize;
+        return true;
+    }
+
+    void Unmap() {
+        if (mMapping != nullptr) {
+            munmap(const_cast<uint8_t*>(mMapping), mMappingSize);
+            mMapping = nullptr;
+            mMappingSize = 0;
+        }
+    }
+
+    void Close() {
+        Unmap();
+        if (mFd >= 0) {
+            close(mFd);
+            mFd = -1;
+        }
+        mIndex.clear();
+    }
+
+    // Indexes the valid records of the file, and truncates the file after the last one. Records
+    // are in the order they were stored, so later records replace earlier ones with the same key.
+    void ReadRecords() {
+        uint64_t offset = sizeof(FileHeader);
+        while (mFileSize - offset >= sizeof(RecordHeader)) {
+            RecordHeader header = GetRecordHeader(offset);
+            if (header.magic != kRecordMagic || header.valueSize > mFileSize) {
+                break;
+            }
+            uint64_t recordSize = GetRecordSize(header.keySize, header.valueSize);
+            if (recordSize > mFileSize - offset) {
+                break;
+            }
+            const uint8_t* key = mMapping + offset + sizeof(RecordHeader);
+            if (HashKey(key, header.keySize) != header.keyHash ||
+                Checksum(header.keyHash, key + header.keySize, header.valueSize) !=
+                    header.checksum) {
+                break;
+            }
+
+            Entry entry = {offset, recordSize, ++mClock};
+            auto it = Find(header.keyHash, key, header.keySize);
+            if (it != mIndex.end()) {
+                it->second = entry;
+            } else {
+                mIndex.emplace(header.keyHash, entry);
+            }
+            offset += recordSize;
+        }
+
+        if (offset != mFileSize) {
+            // The end of the file was not completely written, or is corrupted.
+            if (ftruncate(mFd, static_cast<off_t>(offset)) != 0) {
+                Close();
+                return;
+            }
+            mFileSize = offset;
+        }
+    }
+
+    // Removes all the records from the file. Returns false and closes the file on failure.
+    bool Reset() {
+        mIndex.clear();
+        FileHeader header = {kFileMagic, 0};
+        if (ftruncate(mFd, 0) != 0 || !WriteAll(mFd, &header, sizeof(header), 0)) {
+            Close();
+            return false;
+        }
+        mFileSize = sizeof(header);
+        if (!MapFile()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    // Rewrites the most recently used records to a new file, keeping it under 3/4 of mMaxSize,
+    // and replaces the shard file with it. The rename is atomic, so the shard file is always
+    // either the old or the new one.
+    void Compact() {
+        std::vector<Index::iterator> entries;
+        entries.reserve(mIndex.size());
+        for (auto it = mIndex.begin(); it != mIndex.end(); ++it) {
+            entries.push_back(it);
+        }
+        std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+            return a->second.lastUse > b->second.lastUse;
+        });
+
+        const uint64_t targetSize = mMaxSize / 4 * 3;
+        uint64_t newSize = sizeof(FileHeader);
+        size_t keptCount = 0;
+        for (; keptCount < entries.size(); ++keptCount) {
+            uint64_t recordSize = entries[keptCount]->second.recordSize;
+            if (newSize + recordSize > targetSize) {
+                break;
+            }
+            newSize += recordSize;
+        }
+        // Write the records from least to most recently used, so that the order in which they are
+        // read back when the shard is opened matches their recency.
+        std::reverse(entries.begin(), entries.begin() + keptCount);
+
+        const std::string temporaryPath = GetTemporaryPath();
+        int fd = open(temporaryPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        bool success = fd >= 0;
+
+        Index newIndex;
+        FileHeader header = {kFileMagic, 0};
+        uint64_t offset = 0;
+        if (success) {
+            success = WriteAll(fd, &header, sizeof(header), offset);
+            offset += sizeof(header);
+        }
+        for (size_t i = 0; success && i < keptCount; ++i) {
+            const auto& [keyHash, entry] = *entries[i];
+            success = WriteAll(fd, mMapping + entry.offset, entry.recordSize, offset);
+            newIndex.emplace(keyHash, Entry{offset, entry.recordSize, entry.lastUse});
+            offset += entry.recordSize;
+        }
+        success = success && fsync(fd) == 0 && rename(temporaryPath.c_str(), mPath.c_str()) == 0;
+
+        if (!success) {
+            if (fd >= 0) {
+                close(fd);
+                unlink(temporaryPath.c_str());
+            }
+            // Stay within the size budget by dropping all the records.
+            Reset();
+            return;
+        }
+
+        Close();
+        mFd = fd;
+        mFileSize = offset;
+        mIndex = std::move(newIndex);
+        if (!MapFile()) {
+            Close();
+        }
+    }
+
+    std::mutex mMutex;
+    const std::string mPath;
+    const uint64_t mMaxSize;
+    int mFd = -1;
+    const uint8_t* mMapping = nullptr;
+    size_t mMappingSize = 0;
+    uint64_t mFileSize = 0;
+    uint64_t mClock = 0;
+    Index mIndex;
+};
+
+// static
+std::unique_ptr<FileBlobStore> FileBlobStore::Create(const std::string& directory,
+                                                     uint64_t maxSize) {
+    if (maxSize == 0) {
+        maxSize = kDefaultMaxSize;
+    }
+    maxSize = std::max(maxSize, kMinMaxSize);
+
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        dawn::WarningLog() << "Could not create the blob cache directory " << directory << ".";
+        return nullptr;
+    }
+
+    int lockFd = open((directory + "/lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (lockFd < 0) {
+        dawn::WarningLog() << "Could not open the blob cache directory " << directory << ".";
+        return nullptr;
+    }
+    if (flock(lockFd, LOCK_EX | LOCK_NB) != 0) {
+        close(lockFd);
+        dawn::WarningLog() << "The blob cache directory " << directory << " is already in use.";
+        return nullptr;
+    }
+
+    std::unique_ptr<FileBlobStore> store(new FileBlobStore(lockFd));
+    for (size_t i = 0; i < kShardCount; ++i) {
+        std::string path = directory + "/blobs" + std::to_string(i);
+        store->mShards[i] = std::make_unique<Shard>(std::move(path), maxSize / kShardCount);
+        if (!store->mShards[i]->Open()) {
+            dawn::WarningLog() << "Could not open the blob cache directory " << directory << ".";
+            return nullptr;
+        }
+    }
+    return store;
+}
+
+FileBlobStore::FileBlobStore(int lockFd) : mLockFd(lockFd) {}
+
+FileBlobStore::~FileBlobStore() {
+    for (auto& shard : mShards) {
+        shard = nullptr;
+    }
+    // Closing the file releases the lock on the directory.
+    close(mLockFd);
+}
+
+Blob FileBlobStore::Load(const void* key, size_t keySize) {
+    uint64_t keyHash = HashKey(key, keySize);
+    return GetShard(keyHash)->Load(keyHash, key, keySize);
+}
+
+void FileBlobStore::Store(const void* key, size_t keySize, const void* value, size_t valueSize) {
+    DAWN_ASSERT(value != nullptr);
+    DAWN_ASSERT(valueSize > 0);
+    uint64_t keyHash = HashKey(key, keySize);
+    GetShard(keyHash)->Store(keyHash, key, keySize, value, valueSize);
+}
+
+size_t FileBlobStore::GetEntryCountForTesting() {
+    size_t count = 0;
+    for (auto& shard : mShards) {
+        count += shard->GetEntryCount();
+    }
+    return count;
+}
+
+uint64_t FileBlobStore::GetFileSizeForTesting() {
+    uint64_t size = 0;
+    for (auto& shard : mShards) {
+        size += shard->GetFileSize();
+    }
+    return size;
+}
+
+FileBlobStore::Shard* FileBlobStore::GetShard(uint64_t keyHash) {
+    // Use the high bits, which are independent of the bits used by the shard's hash map.
+    return mShards[(keyHash >> 32) % kShardCount].get();
+}
+
+#else  // DAWN_PLATFORM_IS(POSIX)
+
+class FileBlobStore::Shard {};
+
+// static
+std::unique_ptr<FileBlobStore> FileBlobStore::Create(const std::string& directory,
+                                                     uint64_t maxSize) {
+    dawn::WarningLog() << "The blob cache directory is not supported on this platform.";
+    return nullptr;
+}
+
+FileBlobStore::FileBlobStore(int lockFd) : mLockFd(lockFd) {}
+
+FileBlobStore::~FileBlobStore() = default;
+
+Blob FileBlobStore::Load(const void* key, size_t keySize) {
+    return Blob();
+}
+
+void FileBlobStore::Store(const void* key, size_t keySize, const void* value, size_t valueSize) {}
+
+size_t FileBlobStore::GetEntryCountForTesting() {
+    return 0;
+}
+
+uint64_t FileBlobStore::GetFileSizeForTesting() {
+    return 0;
+}
+
+FileBlobStore::Shard* FileBlobStore::GetShard(uint64_t keyHash) {
+    return nullptr;
+}
+
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+}  // namespace dawn::native
@@ -0,0 +1,96 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_DAWN_NATIVE_FILEBLOBSTORE_H_
+#define SRC_DAWN_NATIVE_FILEBLOBSTORE_H_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "dawn/native/Blob.h"
+
+namespace dawn::native {
+
+// FileBlobStore is a persistent, thread-safe store of blobs in a directory on disk. It is used as
+// the backend of the BlobCache when the instance is given a cache directory and the platform does
+// not provide its own CachingInterface.
+//
+// Blobs are spread over a fixed number of shards chosen by a hash of their key. Each shard is an
+// append-only file that is memory-mapped for loads, with its own lock and in-memory hash index,
+// so that concurrent loads and stores rarely contend. Records are checksummed and partially
+// written records are discarded when a shard is opened, so a crash can only lose the blobs that
+// were being stored. When a shard grows over its share of the size budget, it is compacted by
+// writing its most recently used blobs to a new file that atomically replaces the old one.
+//
+// A directory can only be used by a single FileBlobStore at a time, including across processes.
+class FileBlobStore {
+  public:
+    static constexpr size_t kShardCount = 16;
+    static constexpr uint64_t kDefaultMaxSize = 256 * 1024 * 1024;
+    // Smaller budgets would leave the shards without room for their file header and records.
+    static constexpr uint64_t kMinMaxSize = kShardCount * 1024;
+
+    // Opens the store in `directory`, creating the directory if needed. The total size of the
+    // shard files is kept under `maxSize` bytes, or kDefaultMaxSize if it is zero, and `maxSize` is
+    // raised to at least kMinMaxSize. Returns nullptr if the store cannot be opened, for example if
+    // the directory is in use or the platform is not supported.
+    static std::unique_ptr<FileBlobStore> Create(const std::string& directory, uint64_t maxSize);
+
+    ~FileBlobStore();
+
+    FileBlobStore(const FileBlobStore&) = delete;
+    FileBlobStore& operator=(const FileBlobStore&) = delete;
+
+    // Returns an empty blob if the key is not found.
+    Blob Load(const void* key, size_t keySize);
+
+    // Stores the value, replacing any previous value for the key. Values larger than a shard's
+    // share of the size budget are not stored.
+    void Store(const void* key, size_t keySize, const void* value, size_t valueSize);
+
+    // Returns the number of blobs in the store.
+    size_t GetEntryCountForTesting();
+    // Returns the total size of the shard files, in bytes.
+    uint64_t GetFileSizeForTesting();
+
+  private:
+    class Shard;
+
+    explicit FileBlobStore(int lockFd);
+
+    Shard* GetShard(uint64_t keyHash);
+
+    int mLockFd;
+    std::array<std::unique_ptr<Shard>, kShardCount> mShards;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_FILEBLOBSTORE_H_
@@ -38,6 +38,7 @@
 #include "dawn/native/ChainUtils.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/ErrorData.h"
+#include "dawn/native/FileBlobStore.h"
 #include "dawn/native/Surface.h"
 #include "dawn/native/Toggles.h"
 #include "dawn/native/ValidationUtils_autogen.h"
@@ -181,6 +182,10 @@ MaybeError InstanceBase::Initialize(const InstanceDescriptor* descriptor) {
         for (uint32_t i = 0; i < dawnDesc->additionalRuntimeSearchPathsCount; ++i) {
             mRuntimeSearchPaths.push_back(dawnDesc->additionalRuntimeSearchPaths[i]);
         }
+        if (dawnDesc->blobCacheDirectory != nullptr) {
+            mBlobCacheDirectory = dawnDesc->blobCacheDirectory;
+        }
+        mBlobCacheMaxSize = dawnDesc->blobCacheMaxSize;
     }
     // Default paths to search are next to the shared library, next to the executable, and
     // no path (just libvulkan.so).
@@ -432,7 +437,18 @@ void InstanceBase::SetPlatform(dawn::platform::Platform* platform) {
     } else {
         mPlatform = platform;
     }
-    mBlobCache = std::make_unique<BlobCache>(GetCachingInterface(platform));
+
+    // The platform's caching interface takes precedence over the built-in file store.
+    dawn::platform::CachingInterface* cachingInterface = GetCachingInterface(platform);
+    if (cachingInterface == nullptr && !mBlobCacheDirectory.empty()) {
+        // Release the previous cache first, as the file store locks its directory.
+        mBlobCache = nullptr;
+        if (auto fileStore = FileBlobStore::Create(mBlobCacheDirectory, mBlobCacheMaxSize)) {
+            mBlobCache = std::make_unique<BlobCache>(std::move(fileStore));
+            return;
+        }
+    }
+    mBlobCache = std::make_unique<BlobCache>(cachingInterface);
 }
 
 void InstanceBase::SetPlatformForTesting(dawn::platform::Platform* platform) {
@@ -199,6 +199,8 @@ class InstanceBase final : public RefCountedWithExternalCount {
 
     dawn::platform::Platform* mPlatform = nullptr;
     std::unique_ptr<dawn::platform::Platform> mDefaultPlatform;
+    std::string mBlobCacheDirectory;
+    uint64_t mBlobCacheMaxSize = 0;
     std::unique_ptr<BlobCache> mBlobCache;
     BlobCache mPassthroughBlobCache;
 
@@ -59,12 +59,17 @@ DeviceBase* ObjectBase::GetDevice() const {
 }
 
 void ApiObjectList::Track(ApiObjectBase* object) {
-    if (mMarkedDestroyed) {
-        object->DestroyImpl();
-        return;
+    // Objects can be tracked without the device lock (e.g. encoders), so the destroyed flag must
+    // be checked under mMutex. Otherwise an object could be prepended after Destroy() moved the
+    // list out and would never be destroyed.
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mMarkedDestroyed) {
+            mObjects.Prepend(object);
+            return;
+        }
     }
-    std::lock_guard<std::mutex> lock(mMutex);
-    mObjects.Prepend(object);
+    object->DestroyImpl();
 }
 
 bool ApiObjectList::Untrack(ApiObjectBase* object) {
@@ -78,8 +78,8 @@ class ApiObjectList {
     void Destroy();
 
   private:
-    // Boolean used to mark the list so that on subsequent calls to Untrack, we don't need to
-    // reaquire the lock, and Track on new objects immediately destroys them.
+    // Boolean used to mark the list so that Track on new objects immediately destroys them.
+    // Guarded by mMutex.
     bool mMarkedDestroyed = false;
     std::mutex mMutex;
     LinkedList<ApiObjectBase> mObjects;
@@ -51,6 +51,7 @@ using TextureSubresourceUsage = SubresourceStorage<wgpu::TextureUsage>;
 // Which resources are used by a synchronization scope and how they are used. The command
 // buffer validation pre-computes this information so that backends with explicit barriers
 // don't have to re-compute it.
+// Each resource is listed once, in the order in which it was first used in the scope.
 struct SyncScopeResourceUsage {
     std::vector<BufferBase*> buffers;
     std::vector<wgpu::BufferUsage> bufferUsages;
@@ -76,10 +77,11 @@ struct ComputePassResourceUsage {
 
     std::vector<SyncScopeResourceUsage> dispatchUsages;
 
-    // All the resources referenced by this compute pass for validation in Queue::Submit.
-    std::set<BufferBase*> referencedBuffers;
-    std::set<TextureBase*> referencedTextures;
-    std::set<ExternalTextureBase*> referencedExternalTextures;
+    // All the resources referenced by this compute pass for validation in Queue::Submit, each
+    // listed once in the order in which they were first referenced.
+    std::vector<BufferBase*> referencedBuffers;
+    std::vector<TextureBase*> referencedTextures;
+    std::vector<ExternalTextureBase*> referencedExternalTextures;
 };
 
 // Contains all the resource usage data for a render pass.
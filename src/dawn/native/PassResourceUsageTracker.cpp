@@ -48,9 +48,12 @@ SyncScopeUsageTracker::~SyncScopeUsageTracker() = default;
 SyncScopeUsageTracker& SyncScopeUsageTracker::operator=(SyncScopeUsageTracker&&) = default;
 
 void SyncScopeUsageTracker::BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage) {
-    // std::map's operator[] will create the key and return 0 if the key didn't exist
-    // before.
-    mBufferUsages[buffer] |= usage;
+    auto [index, inserted] = mBufferIndices.Insert(buffer);
+    if (inserted) {
+        mUsage.buffers.push_back(buffer);
+        mUsage.bufferUsages.push_back(wgpu::BufferUsage::None);
+    }
+    mUsage.bufferUsages[index] |= usage;
 }
 
 void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::TextureUsage usage) {
@@ -60,13 +63,7 @@ void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::Textu
 void SyncScopeUsageTracker::TextureRangeUsedAs(TextureBase* texture,
                                                const SubresourceRange& range,
                                                wgpu::TextureUsage usage) {
-    // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-    // wgpu::TextureUsage::None)
-    auto it = mTextureUsages.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-    TextureSubresourceUsage& textureUsage = it.first->second;
+    TextureSubresourceUsage& textureUsage = GetOrAddTextureUsage(texture);
 
     textureUsage.Update(range, [usage](const SubresourceRange&, wgpu::TextureUsage* storedUsage) {
         // TODO(crbug.com/dawn/1001): Consider optimizing to have fewer branches.
@@ -89,15 +86,9 @@ void SyncScopeUsageTracker::TextureRangeUsedAs(TextureBase* texture,
 void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
     TextureBase* texture,
     const TextureSubresourceUsage& textureUsage) {
-    // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-    // wgpu::TextureUsage::None)
-    auto it = mTextureUsages.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-    TextureSubresourceUsage* passTextureUsage = &it.first->second;
-
-    passTextureUsage->Merge(
+    TextureSubresourceUsage& passTextureUsage = GetOrAddTextureUsage(texture);
+
+    passTextureUsage.Merge(
         textureUsage, [](const SubresourceRange&, wgpu::TextureUsage* storedUsage,
                          const wgpu::TextureUsage& addedUsage) {
             DAWN_ASSERT((addedUsage & wgpu::TextureUsage::RenderAttachment) == 0);
@@ -105,102 +96,48 @@ void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
         });
 }
 
-void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
-    for (BindingIndex bindingIndex{0}; bindingIndex < group->GetLayout()->GetBindingCount();
-         ++bindingIndex) {
-        const BindingInfo& bindingInfo = group->GetLayout()->GetBindingInfo(bindingIndex);
-
-        switch (bindingInfo.bindingType) {
-            case BindingInfoType::Buffer: {
-                BufferBase* buffer = group->GetBindingAsBufferBinding(bindingIndex).buffer;
-                switch (bindingInfo.buffer.type) {
-                    case wgpu::BufferBindingType::Uniform:
-                        BufferUsedAs(buffer, wgpu::BufferUsage::Uniform);
-                        break;
-                    case wgpu::BufferBindingType::Storage:
-                        BufferUsedAs(buffer, wgpu::BufferUsage::Storage);
-                        break;
-                    case kInternalStorageBufferBinding:
-                        BufferUsedAs(buffer, kInternalStorageBuffer);
-                        break;
-                    case wgpu::BufferBindingType::ReadOnlyStorage:
-                        BufferUsedAs(buffer, kReadOnlyStorageBuffer);
-                        break;
-                    case wgpu::BufferBindingType::Undefined:
-                        DAWN_UNREACHABLE();
-                }
-                break;
-            }
-
-            case BindingInfoType::Texture: {
-                TextureViewBase* view = group->GetBindingAsTextureView(bindingIndex);
-                switch (bindingInfo.texture.sampleType) {
-                    case kInternalResolveAttachmentSampleType:
-                        TextureViewUsedAs(view, kResolveAttachmentLoadingUsage);
-                        break;
-                    default:
-                        TextureViewUsedAs(view, wgpu::TextureUsage::TextureBinding);
-                        break;
-                }
-                break;
-            }
-
-            case BindingInfoType::StorageTexture: {
-                TextureViewBase* view = group->GetBindingAsTextureView(bindingIndex);
-                switch (bindingInfo.storageTexture.access) {
-                    case wgpu::StorageTextureAccess::WriteOnly:
-                        TextureViewUsedAs(view, kWriteOnlyStorageTexture);
-                        break;
-                    case wgpu::StorageTextureAccess::ReadWrite:
-                        TextureViewUsedAs(view, wgpu::TextureUsage::StorageBinding);
-                        break;
-                    case wgpu::StorageTextureAccess::ReadOnly:
-                        TextureViewUsedAs(view, kReadOnlyStorageTexture);
-                        break;
-                    case wgpu::StorageTextureAccess::Undefined:
-                        DAWN_UNREACHABLE();
-                }
-                break;
-            }
-
-            case BindingInfoType::ExternalTexture:
-                DAWN_UNREACHABLE();
-                break;
-
-            case BindingInfoType::Sampler:
-                break;
-        }
-    }
-
-    for (const Ref<ExternalTextureBase>& externalTexture : group->GetBoundExternalTextures()) {
-        mExternalTextureUsages.insert(externalTexture.Get());
+TextureSubresourceUsage& SyncScopeUsageTracker::GetOrAddTextureUsage(TextureBase* texture) {
+    auto [index, inserted] = mTextureIndices.Insert(texture);
+    if (inserted) {
+        // Create a new TextureSubresourceUsage for that texture, initially filled with
+        // wgpu::TextureUsage::None.
+        mUsage.textures.push_back(texture);
+        mUsage.textureUsages.emplace_back(texture->GetFormat().aspects, texture->GetArrayLayers(),
+                                          texture->GetNumMipLevels(), wgpu::TextureUsage::None);
     }
+    return mUsage.textureUsages[index];
 }
 
-SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
-    SyncScopeResourceUsage result;
-    result.buffers.reserve(mBufferUsages.size());
-    result.bufferUsages.reserve(mBufferUsages.size());
-    result.textures.reserve(mTextureUsages.size());
-    result.textureUsages.reserve(mTextureUsages.size());
-
-    for (auto& [buffer, usage] : mBufferUsages) {
-        result.buffers.push_back(buffer);
-        result.bufferUsages.push_back(usage);
+void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
+    // The usages of a bind group never change, so merging it again, for example when it is set
+    // for every draw of a render pass, has no effect.
+    if (!mBindGroupIndices.Insert(group).second) {
+        return;
     }
 
-    for (auto& [texture, usage] : mTextureUsages) {
-        result.textures.push_back(texture);
-        result.textureUsages.push_back(std::move(usage));
+    const BindGroupResourceUsage& usage = group->GetResourceUsage();
+    for (size_t i = 0; i < usage.buffers.size(); ++i) {
+        BufferUsedAs(usage.buffers[i], usage.bufferUsages[i]);
+    }
+    for (const BindGroupResourceUsage::TextureRangeUsage& texture : usage.textures) {
+        TextureRangeUsedAs(texture.texture, texture.range, texture.usage);
     }
 
-    for (auto* const it : mExternalTextureUsages) {
-        result.externalTextures.push_back(it);
+    for (const Ref<ExternalTextureBase>& externalTexture : group->GetBoundExternalTextures()) {
+        if (mExternalTextureIndices.Insert(externalTexture.Get()).second) {
+            mUsage.externalTextures.push_back(externalTexture.Get());
+        }
     }
+}
+
+SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
+    SyncScopeResourceUsage result = std::move(mUsage);
+    mUsage = {};
 
-    mBufferUsages.clear();
-    mTextureUsages.clear();
-    mExternalTextureUsages.clear();
+    mBufferIndices.Clear();
+    mTextureIndices.Clear();
+    mExternalTextureIndices.Clear();
+    mBindGroupIndices.Clear();
 
     return result;
 }
@@ -214,35 +151,30 @@ void ComputePassResourceUsageTracker::AddDispatch(SyncScopeResourceUsage scope)
 }
 
 void ComputePassResourceUsageTracker::AddReferencedBuffer(BufferBase* buffer) {
-    mUsage.referencedBuffers.insert(buffer);
+    if (mReferencedBufferIndices.Insert(buffer).second) {
+        mUsage.referencedBuffers.push_back(buffer);
+    }
 }
 
 void ComputePassResourceUsageTracker::AddResourcesReferencedByBindGroup(BindGroupBase* group) {
-    for (BindingIndex index{0}; index < group->GetLayout()->GetBindingCount(); ++index) {
-        const BindingInfo& bindingInfo = group->GetLayout()->GetBindingInfo(index);
-
-        switch (bindingInfo.bindingType) {
-            case BindingInfoType::Buffer: {
-                mUsage.referencedBuffers.insert(group->GetBindingAsBufferBinding(index).buffer);
-                break;
-            }
-
-            case BindingInfoType::Texture: {
-                mUsage.referencedTextures.insert(
-                    group->GetBindingAsTextureView(index)->GetTexture());
-                break;
-            }
-
-            case BindingInfoType::ExternalTexture:
-                DAWN_UNREACHABLE();
-            case BindingInfoType::StorageTexture:
-            case BindingInfoType::Sampler:
-                break;
+    if (!mReferencedBindGroupIndices.Insert(group).second) {
+        return;
+    }
+
+    const BindGroupResourceUsage& usage = group->GetResourceUsage();
+    for (BufferBase* buffer : usage.buffers) {
+        AddReferencedBuffer(buffer);
+    }
+    for (const BindGroupResourceUsage::TextureRangeUsage& texture : usage.textures) {
+        if (texture.sampled && mReferencedTextureIndices.Insert(texture.texture).second) {
+            mUsage.referencedTextures.push_back(texture.texture);
         }
     }
 
     for (const Ref<ExternalTextureBase>& externalTexture : group->GetBoundExternalTextures()) {
-        mUsage.referencedExternalTextures.insert(externalTexture.Get());
+        if (mReferencedExternalTextureIndices.Insert(externalTexture.Get()).second) {
+            mUsage.referencedExternalTextures.push_back(externalTexture.Get());
+        }
     }
 }
 
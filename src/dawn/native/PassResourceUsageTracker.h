@@ -29,9 +29,9 @@
 #define SRC_DAWN_NATIVE_PASSRESOURCEUSAGETRACKER_H_
 
 #include <map>
-#include <set>
 #include <vector>
 
+#include "dawn/common/PointerIndexMap.h"
 #include "dawn/native/PassResourceUsage.h"
 
 #include "dawn/native/dawn_platform.h"
@@ -47,6 +47,9 @@ class TextureBase;
 using QueryAvailabilityMap = std::map<QuerySetBase*, std::vector<bool>>;
 
 // Helper class to build SyncScopeResourceUsages
+//
+// Resources are stored directly in the SyncScopeResourceUsage vectors in the order in which they
+// are first used, and PointerIndexMaps find the entry of a resource that is used again.
 class SyncScopeUsageTracker {
   public:
     SyncScopeUsageTracker();
@@ -63,16 +66,22 @@ class SyncScopeUsageTracker {
     void AddRenderBundleTextureUsage(TextureBase* texture,
                                      const TextureSubresourceUsage& textureUsage);
 
-    // Walks the bind groups and tracks all its resources.
+    // Tracks all the resources of the bind group, using the usages precomputed by the bind group.
+    // Bind groups that were already added since the last AcquireSyncScopeUsage() are skipped.
     void AddBindGroup(BindGroupBase* group);
 
     // Returns the per-pass usage for use by backends for APIs with explicit barriers.
     SyncScopeResourceUsage AcquireSyncScopeUsage();
 
   private:
-    std::map<BufferBase*, wgpu::BufferUsage> mBufferUsages;
-    std::map<TextureBase*, TextureSubresourceUsage> mTextureUsages;
-    std::set<ExternalTextureBase*> mExternalTextureUsages;
+    // Returns the usage of `texture`, adding it with no usage if it isn't tracked yet.
+    TextureSubresourceUsage& GetOrAddTextureUsage(TextureBase* texture);
+
+    SyncScopeResourceUsage mUsage;
+    PointerIndexMap<BufferBase> mBufferIndices;
+    PointerIndexMap<TextureBase> mTextureIndices;
+    PointerIndexMap<ExternalTextureBase> mExternalTextureIndices;
+    PointerIndexMap<BindGroupBase> mBindGroupIndices;
 };
 
 // Helper class to build ComputePassResourceUsages
@@ -89,6 +98,10 @@ class ComputePassResourceUsageTracker {
 
   private:
     ComputePassResourceUsage mUsage;
+    PointerIndexMap<BufferBase> mReferencedBufferIndices;
+    PointerIndexMap<TextureBase> mReferencedTextureIndices;
+    PointerIndexMap<ExternalTextureBase> mReferencedExternalTextureIndices;
+    PointerIndexMap<BindGroupBase> mReferencedBindGroupIndices;
 };
 
 // Helper class to build RenderPassResourceUsages
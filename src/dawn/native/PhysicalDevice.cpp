@@ -51,6 +51,7 @@ MaybeError PhysicalDeviceBase::Initialize() {
     EnableFeature(Feature::DawnNative);
     EnableFeature(Feature::DawnInternalUsages);
     EnableFeature(Feature::ImplicitDeviceSynchronization);
+    EnableFeature(Feature::RenderPassSubEncoders);
     EnableFeature(Feature::ChromiumExperimentalReadWriteStorageTexture);
     InitializeSupportedFeaturesImpl();
 
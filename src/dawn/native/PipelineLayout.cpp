@@ -106,6 +106,26 @@ PipelineLayoutBase::PipelineLayoutBase(DeviceBase* device,
         mMask.set(group);
     }
 
+    // Count the writable storage bindings to know whether draws and dispatches need to check
+    // the bind groups for aliasing writable bindings.
+    uint32_t writableStorageBufferCount = 0;
+    uint32_t writableStorageTextureCount = 0;
+    for (BindGroupIndex group : IterateBitSet(mMask)) {
+        const BindGroupLayoutInternalBase* bgl = GetBindGroupLayout(group);
+        for (BindingIndex bindingIndex{0}; bindingIndex < bgl->GetBindingCount(); ++bindingIndex) {
+            const BindingInfo& bindingInfo = bgl->GetBindingInfo(bindingIndex);
+            if (bindingInfo.bindingType == BindingInfoType::Buffer &&
+                bindingInfo.buffer.type == wgpu::BufferBindingType::Storage) {
+                writableStorageBufferCount++;
+            } else if (bindingInfo.bindingType == BindingInfoType::StorageTexture &&
+                       bindingInfo.storageTexture.access != wgpu::StorageTextureAccess::ReadOnly) {
+                writableStorageTextureCount++;
+            }
+        }
+    }
+    mMayHaveWritableBindingAliasing =
+        writableStorageBufferCount > 1 || writableStorageTextureCount > 1;
+
     // Gather the PLS information.
     const PipelineLayoutPixelLocalStorage* pls = nullptr;
     FindInChain(descriptor->nextInChain, &pls);
@@ -441,6 +461,10 @@ bool PipelineLayoutBase::HasAnyStorageAttachments() const {
     return false;
 }
 
+bool PipelineLayoutBase::MayHaveWritableBindingAliasing() const {
+    return mMayHaveWritableBindingAliasing;
+}
+
 BindGroupLayoutMask PipelineLayoutBase::InheritedGroupsMask(const PipelineLayoutBase* other) const {
     DAWN_ASSERT(!IsError());
     return {(1 << static_cast<uint32_t>(GroupsInheritUpTo(other))) - 1u};
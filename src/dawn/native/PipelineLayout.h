@@ -88,6 +88,10 @@ class PipelineLayoutBase : public ApiObjectBase,
     bool HasPixelLocalStorage() const;
     const std::vector<wgpu::TextureFormat>& GetStorageAttachmentSlots() const;
     bool HasAnyStorageAttachments() const;
+    // Returns false if the layout has fewer than two writable storage buffer bindings and fewer
+    // than two writable storage texture bindings, in which case bind groups used with it can
+    // never have aliasing writable bindings.
+    bool MayHaveWritableBindingAliasing() const;
 
     // Utility functions to compute inherited bind groups.
     // Returns the inherited bind groups as a mask.
@@ -111,6 +115,7 @@ class PipelineLayoutBase : public ApiObjectBase,
     BindGroupLayoutArray mBindGroupLayouts;
     BindGroupLayoutMask mMask;
     bool mHasPLS = false;
+    bool mMayHaveWritableBindingAliasing = false;
     std::vector<wgpu::TextureFormat> mStorageAttachmentSlots;
 };
 
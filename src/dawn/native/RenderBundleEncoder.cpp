@@ -121,6 +121,21 @@ RenderBundleEncoder::RenderBundleEncoder(DeviceBase* device,
     GetObjectTrackingList()->Track(this);
 }
 
+RenderBundleEncoder::RenderBundleEncoder(DeviceBase* device,
+                                         Ref<AttachmentState> attachmentState,
+                                         bool depthReadOnly,
+                                         bool stencilReadOnly)
+    : RenderEncoderBase(device,
+                        nullptr,
+                        &mBundleEncodingContext,
+                        std::move(attachmentState),
+                        depthReadOnly,
+                        stencilReadOnly),
+      mBundleEncodingContext(device, this),
+      mIsRenderPassSubEncoder(true) {
+    GetObjectTrackingList()->Track(this);
+}
+
 RenderBundleEncoder::RenderBundleEncoder(DeviceBase* device, ErrorTag errorTag, const char* label)
     : RenderEncoderBase(device, &mBundleEncodingContext, errorTag, label),
       mBundleEncodingContext(device, this) {}
@@ -137,6 +152,16 @@ Ref<RenderBundleEncoder> RenderBundleEncoder::Create(
     return AcquireRef(new RenderBundleEncoder(device, descriptor));
 }
 
+// static
+Ref<RenderBundleEncoder> RenderBundleEncoder::CreateForRenderPass(
+    DeviceBase* device,
+    Ref<AttachmentState> attachmentState,
+    bool depthReadOnly,
+    bool stencilReadOnly) {
+    return AcquireRef(new RenderBundleEncoder(device, std::move(attachmentState), depthReadOnly,
+                                              stencilReadOnly));
+}
+
 // static
 RenderBundleEncoder* RenderBundleEncoder::MakeError(DeviceBase* device, const char* label) {
     return new RenderBundleEncoder(device, ObjectBase::kError, label);
@@ -151,10 +176,16 @@ CommandIterator RenderBundleEncoder::AcquireCommands() {
 }
 
 RenderBundleBase* RenderBundleEncoder::APIFinish(const RenderBundleDescriptor* descriptor) {
+    ResultOrError<RenderBundleBase*> finishResult =
+        mIsRenderPassSubEncoder
+            ? DAWN_VALIDATION_ERROR(
+                  "%s is a render pass sub-encoder and is finished when its pass ends.", this)
+            : FinishImpl(descriptor);
     RenderBundleBase* result = nullptr;
 
-    if (GetDevice()->ConsumedError(FinishImpl(descriptor), &result, "calling %s.Finish(%s).", this,
-                                   descriptor)) {
+    // Render bundle encoders run without the device lock, so only lock it to report errors.
+    if (GetDevice()->ConsumedErrorAndLockIfNeeded(std::move(finishResult), &result,
+                                                  "calling %s.Finish(%s).", this, descriptor)) {
         RenderBundleBase* errorRenderBundle =
             RenderBundleBase::MakeError(GetDevice(), descriptor ? descriptor->label : nullptr);
         errorRenderBundle->SetEncoderLabel(this->GetLabel());
@@ -164,6 +195,17 @@ RenderBundleBase* RenderBundleEncoder::APIFinish(const RenderBundleDescriptor* d
     return result;
 }
 
+ResultOrError<Ref<RenderBundleBase>> RenderBundleEncoder::FinishForRenderPass() {
+    DAWN_ASSERT(mIsRenderPassSubEncoder);
+    RenderBundleBase* result = nullptr;
+    DAWN_TRY_ASSIGN(result, FinishImpl(nullptr));
+    return AcquireRef(result);
+}
+
+bool RenderBundleEncoder::HasIndirectDrawsToValidate() {
+    return !mIndirectDrawMetadata.GetIndexedIndirectBufferValidationInfo()->empty();
+}
+
 ResultOrError<RenderBundleBase*> RenderBundleEncoder::FinishImpl(
     const RenderBundleDescriptor* descriptor) {
     // Even if mBundleEncodingContext.Finish() validation fails, calling it will mutate the
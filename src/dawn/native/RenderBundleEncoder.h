@@ -43,16 +43,30 @@ class RenderBundleEncoder final : public RenderEncoderBase {
   public:
     static Ref<RenderBundleEncoder> Create(DeviceBase* device,
                                            const RenderBundleEncoderDescriptor* descriptor);
+    // Creates a sub-encoder of a render pass. It records into its own encoding context so that it
+    // can be used on another thread than the pass, and is finished by the pass when it ends.
+    static Ref<RenderBundleEncoder> CreateForRenderPass(DeviceBase* device,
+                                                        Ref<AttachmentState> attachmentState,
+                                                        bool depthReadOnly,
+                                                        bool stencilReadOnly);
     static RenderBundleEncoder* MakeError(DeviceBase* device, const char* label);
 
     ObjectType GetType() const override;
 
     RenderBundleBase* APIFinish(const RenderBundleDescriptor* descriptor);
 
+    // Finishes a render pass sub-encoder into a bundle that the pass executes.
+    ResultOrError<Ref<RenderBundleBase>> FinishForRenderPass();
+    bool HasIndirectDrawsToValidate();
+
     CommandIterator AcquireCommands();
 
   private:
     RenderBundleEncoder(DeviceBase* device, const RenderBundleEncoderDescriptor* descriptor);
+    RenderBundleEncoder(DeviceBase* device,
+                        Ref<AttachmentState> attachmentState,
+                        bool depthReadOnly,
+                        bool stencilReadOnly);
     RenderBundleEncoder(DeviceBase* device, ErrorTag errorTag, const char* label);
 
     void DestroyImpl() override;
@@ -61,6 +75,7 @@ class RenderBundleEncoder final : public RenderEncoderBase {
     MaybeError ValidateFinish(const RenderPassResourceUsage& usages) const;
 
     EncodingContext mBundleEncodingContext;
+    bool mIsRenderPassSubEncoder = false;
 };
 
 }  // namespace dawn::native
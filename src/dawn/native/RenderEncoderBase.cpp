@@ -79,6 +79,12 @@ const AttachmentState* RenderEncoderBase::GetAttachmentState() const {
     return mAttachmentState.Get();
 }
 
+Ref<AttachmentState> RenderEncoderBase::GetAttachmentStateRef() const {
+    DAWN_ASSERT(!IsError());
+    DAWN_ASSERT(mAttachmentState != nullptr);
+    return mAttachmentState;
+}
+
 bool RenderEncoderBase::IsDepthReadOnly() const {
     DAWN_ASSERT(!IsError());
     return mDepthReadOnly;
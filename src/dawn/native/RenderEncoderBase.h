@@ -87,6 +87,8 @@ class RenderEncoderBase : public ProgrammableEncoder {
 
     void DestroyImpl() override;
 
+    Ref<AttachmentState> GetAttachmentStateRef() const;
+
     CommandBufferStateTracker mCommandBufferState;
     RenderPassResourceUsageTracker mUsageTracker;
     IndirectDrawMetadata mIndirectDrawMetadata;
@@ -41,6 +41,7 @@
 #include "dawn/native/ObjectType_autogen.h"
 #include "dawn/native/QuerySet.h"
 #include "dawn/native/RenderBundle.h"
+#include "dawn/native/RenderBundleEncoder.h"
 #include "dawn/native/RenderPipeline.h"
 
 namespace dawn::native {
@@ -152,13 +153,29 @@ void RenderPassEncoder::TrackQueryAvailability(QuerySetBase* querySet, uint32_t
 }
 
 void RenderPassEncoder::APIEnd() {
-    // The encoding context might create additional resources, so we need to lock the device.
-    auto deviceLock(GetDevice()->GetScopedLock());
+    // The device only needs to be locked if ending the pass reports an error directly to the
+    // device, encodes indirect draw validation, or runs a workaround's end callback, all of
+    // which might touch the device's state or create additional resources.
+    auto deviceLock(GetDevice()->GetScopedLockIf(EndRequiresDeviceLock()));
     End();
 }
 
+bool RenderPassEncoder::EndRequiresDeviceLock() {
+    if (mEnded || mEndCallback != nullptr ||
+        !mIndirectDrawMetadata.GetIndexedIndirectBufferValidationInfo()->empty()) {
+        return true;
+    }
+    // The indirect draws of sub-encoders are validated by this pass when they are merged in.
+    for (const Ref<RenderBundleEncoder>& subEncoder : mSubEncoders) {
+        if (subEncoder->HasIndirectDrawsToValidate()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void RenderPassEncoder::End() {
-    DAWN_ASSERT(GetDevice()->IsLockedByCurrentThreadIfNeeded());
+    DAWN_ASSERT(!EndRequiresDeviceLock() || GetDevice()->IsLockedByCurrentThreadIfNeeded());
 
     if (mEnded && IsValidationEnabled()) {
         GetDevice()->HandleError(DAWN_VALIDATION_ERROR("%s was already ended.", this));
@@ -170,6 +187,8 @@ void RenderPassEncoder::End() {
     mEncodingContext->TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
+            DAWN_TRY(MergeSubEncoders(allocator));
+
             if (IsValidationEnabled()) {
                 DAWN_TRY(ValidateProgrammableEncoderEnd());
 
@@ -334,36 +353,95 @@ void RenderPassEncoder::APIExecuteBundles(uint32_t count, RenderBundleBase* cons
                 }
             }
 
-            mCommandBufferState = CommandBufferStateTracker{};
+            EncodeExecuteBundles(allocator, count, renderBundles);
+
+            return {};
+        },
+        "encoding %s.ExecuteBundles(%u, ...).", this, count);
+}
+
+void RenderPassEncoder::EncodeExecuteBundles(CommandAllocator* allocator,
+                                             uint32_t count,
+                                             RenderBundleBase* const* renderBundles) {
+    mCommandBufferState = CommandBufferStateTracker{};
 
-            ExecuteBundlesCmd* cmd =
-                allocator->Allocate<ExecuteBundlesCmd>(Command::ExecuteBundles);
-            cmd->count = count;
+    ExecuteBundlesCmd* cmd = allocator->Allocate<ExecuteBundlesCmd>(Command::ExecuteBundles);
+    cmd->count = count;
 
-            Ref<RenderBundleBase>* bundles = allocator->AllocateData<Ref<RenderBundleBase>>(count);
-            for (uint32_t i = 0; i < count; ++i) {
-                bundles[i] = renderBundles[i];
+    Ref<RenderBundleBase>* bundles = allocator->AllocateData<Ref<RenderBundleBase>>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        bundles[i] = renderBundles[i];
 
-                const RenderPassResourceUsage& usages = bundles[i]->GetResourceUsage();
-                for (uint32_t j = 0; j < usages.buffers.size(); ++j) {
-                    mUsageTracker.BufferUsedAs(usages.buffers[j], usages.bufferUsages[j]);
-                }
+        const RenderPassResourceUsage& usages = bundles[i]->GetResourceUsage();
+        for (uint32_t j = 0; j < usages.buffers.size(); ++j) {
+            mUsageTracker.BufferUsedAs(usages.buffers[j], usages.bufferUsages[j]);
+        }
 
-                for (uint32_t j = 0; j < usages.textures.size(); ++j) {
-                    mUsageTracker.AddRenderBundleTextureUsage(usages.textures[j],
-                                                              usages.textureUsages[j]);
-                }
+        for (uint32_t j = 0; j < usages.textures.size(); ++j) {
+            mUsageTracker.AddRenderBundleTextureUsage(usages.textures[j], usages.textureUsages[j]);
+        }
 
-                if (IsValidationEnabled()) {
-                    mIndirectDrawMetadata.AddBundle(renderBundles[i]);
-                }
+        if (IsValidationEnabled()) {
+            mIndirectDrawMetadata.AddBundle(renderBundles[i]);
+        }
 
-                mDrawCount += bundles[i]->GetDrawCount();
+        mDrawCount += bundles[i]->GetDrawCount();
+    }
+}
+
+RenderBundleEncoder* RenderPassEncoder::APICreateSubEncoder() {
+    Ref<RenderBundleEncoder> subEncoder;
+    mEncodingContext->TryEncode(
+        this,
+        [&](CommandAllocator*) -> MaybeError {
+            if (IsValidationEnabled()) {
+                DAWN_INVALID_IF(!GetDevice()->HasFeature(Feature::RenderPassSubEncoders),
+                                "%s feature is not enabled.",
+                                ToAPI(Feature::RenderPassSubEncoders));
+                DAWN_INVALID_IF(GetAttachmentState()->HasPixelLocalStorage(),
+                                "%s uses pixel local storage, which sub-encoders don't support.",
+                                this);
             }
 
+            subEncoder = RenderBundleEncoder::CreateForRenderPass(
+                GetDevice(), GetAttachmentStateRef(), IsDepthReadOnly(), IsStencilReadOnly());
+            mSubEncoders.push_back(subEncoder);
             return {};
         },
-        "encoding %s.ExecuteBundles(%u, ...).", this, count);
+        "encoding %s.CreateSubEncoder().", this);
+
+    if (subEncoder == nullptr) {
+        return RenderBundleEncoder::MakeError(GetDevice(), nullptr);
+    }
+    return subEncoder.Detach();
+}
+
+MaybeError RenderPassEncoder::MergeSubEncoders(CommandAllocator* allocator) {
+    if (mSubEncoders.empty()) {
+        return {};
+    }
+
+    // Finish the sub-encoders in creation order, regardless of the order in which the threads
+    // recording them completed, so that the pass's commands are deterministic.
+    std::vector<Ref<RenderBundleBase>> bundles;
+    bundles.reserve(mSubEncoders.size());
+    for (size_t i = 0; i < mSubEncoders.size(); ++i) {
+        Ref<RenderBundleBase> bundle;
+        DAWN_TRY_ASSIGN_CONTEXT(bundle, mSubEncoders[i]->FinishForRenderPass(),
+                                "finishing sub-encoder %u (%s) of %s.", i, mSubEncoders[i].Get(),
+                                this);
+        bundles.push_back(std::move(bundle));
+    }
+    mSubEncoders.clear();
+
+    std::vector<RenderBundleBase*> renderBundles;
+    renderBundles.reserve(bundles.size());
+    for (const Ref<RenderBundleBase>& bundle : bundles) {
+        renderBundles.push_back(bundle.Get());
+    }
+    EncodeExecuteBundles(allocator, static_cast<uint32_t>(renderBundles.size()),
+                         renderBundles.data());
+    return {};
 }
 
 void RenderPassEncoder::APIBeginOcclusionQuery(uint32_t queryIndex) {
@@ -37,6 +37,7 @@
 namespace dawn::native {
 
 class RenderBundleBase;
+class RenderBundleEncoder;
 
 class RenderPassEncoder final : public RenderEncoderBase {
   public:
@@ -80,6 +81,8 @@ class RenderPassEncoder final : public RenderEncoderBase {
 
     void APIPixelLocalStorageBarrier();
 
+    RenderBundleEncoder* APICreateSubEncoder();
+
     // Internal code that already locked the device should call this method instead of
     // APIEnd() to avoid the device being locked again.
     void End();
@@ -107,6 +110,16 @@ class RenderPassEncoder final : public RenderEncoderBase {
 
     void TrackQueryAvailability(QuerySetBase* querySet, uint32_t queryIndex);
 
+    // Encodes the execution of render bundles which were already validated against this pass.
+    void EncodeExecuteBundles(CommandAllocator* allocator,
+                              uint32_t count,
+                              RenderBundleBase* const* renderBundles);
+    MaybeError MergeSubEncoders(CommandAllocator* allocator);
+
+    // Returns true if End() may touch the device's state, in which case APIEnd() locks the
+    // device. Ending a pass in the common case only touches the encoder's own state.
+    bool EndRequiresDeviceLock();
+
     // For render and compute passes, the encoding context is borrowed from the command encoder.
     // Keep a reference to the encoder to make sure the context isn't freed.
     Ref<CommandEncoder> mCommandEncoder;
@@ -123,6 +136,10 @@ class RenderPassEncoder final : public RenderEncoderBase {
     uint64_t mMaxDrawCount = 50000000;
 
     std::function<void()> mEndCallback;
+
+    // The sub-encoders created by CreateSubEncoder(), in creation order. They are finished and
+    // their commands executed in this order when the pass ends, after the pass's own commands.
+    std::vector<Ref<RenderBundleEncoder>> mSubEncoders;
 };
 
 }  // namespace dawn::native
@@ -995,6 +995,7 @@ MaybeError ValidateAndParseShaderModule(DeviceBase* device,
     DAWN_ASSERT(moduleType != wgpu::SType::Invalid);
 
     ScopedTintICEHandler scopedICEHandler(device);
+    ScopedTintTracing scopedTintTracing(device->GetPlatform());
 
     // Multiple paths may use a WGSL descriptor so declare it here now.
     const ShaderModuleWGSLDescriptor* wgslDesc = nullptr;
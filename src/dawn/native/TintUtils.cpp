@@ -32,6 +32,8 @@
 #include "dawn/native/Pipeline.h"
 #include "dawn/native/PipelineLayout.h"
 #include "dawn/native/RenderPipeline.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
 
 #include "tint/tint.h"
 
@@ -156,6 +158,39 @@ ScopedTintICEHandler::~ScopedTintICEHandler() {
     tlDevice = nullptr;
 }
 
+// Forwards tint phases to the tracing platform. Tint phase names have static storage duration, as
+// required by the trace event macros.
+class ScopedTintTracing::Listener final : public tint::Instrumentation::Listener {
+  public:
+    explicit Listener(platform::Platform* platform) : mPlatform(platform) {}
+
+    void OnPhaseBegin(const char* name) override { TRACE_EVENT_BEGIN0(mPlatform, General, name); }
+
+    void OnPhaseEnd(const tint::Instrumentation::Phase& phase) override {
+        TRACE_EVENT_END2(mPlatform, General, phase.name, "allocatedBytes",
+                         static_cast<uint64_t>(phase.allocated_bytes), "nodes",
+                         static_cast<uint64_t>(phase.nodes));
+    }
+
+  private:
+    platform::Platform* mPlatform;
+};
+
+ScopedTintTracing::ScopedTintTracing(platform::Platform* platform) {
+    if (!*platform::tracing::GetTraceCategoryEnabledFlag(platform,
+                                                         platform::TraceCategory::General)) {
+        return;
+    }
+    mListener = std::make_unique<Listener>(platform);
+    tint::Instrumentation::Config config;
+    config.record_phases = false;
+    config.listener = mListener.get();
+    mInstrumentation.emplace(config);
+    mScope.emplace(*mInstrumentation);
+}
+
+ScopedTintTracing::~ScopedTintTracing() = default;
+
 tint::ExternalTextureOptions BuildExternalTextureTransformBindings(
     const PipelineLayoutBase* layout) {
     tint::ExternalTextureOptions options;
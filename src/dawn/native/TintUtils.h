@@ -29,6 +29,8 @@
 #define SRC_DAWN_NATIVE_TINTUTILS_H_
 
 #include <functional>
+#include <memory>
+#include <optional>
 
 #include "dawn/common/NonCopyable.h"
 #include "dawn/native/IntegerTypes.h"
@@ -36,6 +38,10 @@
 
 #include "tint/tint.h"
 
+namespace dawn::platform {
+class Platform;
+}  // namespace dawn::platform
+
 namespace dawn::native {
 
 class DeviceBase;
@@ -54,6 +60,23 @@ class ScopedTintICEHandler : public NonCopyable {
     ScopedTintICEHandler(ScopedTintICEHandler&&) = delete;
 };
 
+// Indicates that for the lifetime of this object the phases that tint runs on this thread, such as
+// parsing, resolving, each transform and printing, should be emitted as trace events to the given
+// platform. Does nothing if the General trace category is disabled.
+class ScopedTintTracing : public NonCopyable {
+  public:
+    explicit ScopedTintTracing(platform::Platform* platform);
+    ~ScopedTintTracing();
+
+  private:
+    ScopedTintTracing(ScopedTintTracing&&) = delete;
+
+    class Listener;
+    std::unique_ptr<Listener> mListener;
+    std::optional<tint::Instrumentation> mInstrumentation;
+    std::optional<tint::Instrumentation::Scope> mScope;
+};
+
 tint::ExternalTextureOptions BuildExternalTextureTransformBindings(
     const PipelineLayoutBase* layout);
 
@@ -84,6 +84,7 @@ ResultOrError<d3d::CompiledShader> ShaderModule::Compile(
     DAWN_ASSERT(!IsError());
 
     ScopedTintICEHandler scopedICEHandler(device);
+    ScopedTintTracing scopedTintTracing(device->GetPlatform());
     const EntryPointMetadata& entryPoint = GetEntryPoint(programmableStage.entryPoint);
 
     d3d::D3DCompilationRequest req = {};
@@ -116,6 +116,7 @@ ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(
     uint32_t sampleMask,
     const RenderPipeline* renderPipeline) {
     ScopedTintICEHandler scopedICEHandler(device);
+    ScopedTintTracing scopedTintTracing(device->GetPlatform());
 
     std::ostringstream errorStream;
     errorStream << "Tint MSL failure:" << std::endl;
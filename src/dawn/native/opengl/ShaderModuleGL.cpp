@@ -173,6 +173,7 @@ ResultOrError<GLuint> ShaderModule::CompileShader(
     tint::TextureBuiltinsFromUniformOptions::BindingPointToFieldAndOffset* bindingPointToData)
     const {
     TRACE_EVENT0(GetDevice()->GetPlatform(), General, "TranslateToGLSL");
+    ScopedTintTracing scopedTintTracing(GetDevice()->GetPlatform());
 
     const OpenGLVersion& version = ToBackend(GetDevice())->GetGL().GetVersion();
 
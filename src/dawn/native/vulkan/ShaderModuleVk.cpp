@@ -208,6 +208,7 @@ ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
     DAWN_ASSERT(IsAlive());
 
     ScopedTintICEHandler scopedICEHandler(GetDevice());
+    ScopedTintTracing scopedTintTracing(GetDevice()->GetPlatform());
 
     // Check to see if we have the handle and spirv cached already.
     auto cacheKey = TransformedShaderModuleCacheKey{layout, programmableStage.entryPoint.c_str(),
@@ -27,77 +27,182 @@
 
 #include "dawn/platform/WorkerThread.h"
 
-#include <condition_variable>
-#include <functional>
-#include <thread>
+#include <algorithm>
+#include <utility>
 
 #include "dawn/common/Assert.h"
+#include "dawn/common/RefCounted.h"
+
+namespace dawn::platform {
 
 namespace {
 
-class AsyncWaitableEventImpl {
-  public:
-    AsyncWaitableEventImpl() : mIsComplete(false) {}
+// The pool and the worker index of the current thread, if it is a worker thread. Used to post
+// tasks created by other tasks to the local queue of the worker.
+thread_local const AsyncWorkerThreadPool* tCurrentPool = nullptr;
+thread_local uint32_t tCurrentWorkerIndex = 0;
 
-    void Wait() {
-        std::unique_lock<std::mutex> lock(mMutex);
-        mCondition.wait(lock, [this] { return mIsComplete; });
-    }
+}  // anonymous namespace
 
-    bool IsComplete() {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mIsComplete;
-    }
+// A task and its completion state in a single allocation. It is referenced both by the queue it
+// is in and by the WaitableEvent returned to the caller, which can outlive the other.
+class AsyncWorkerThreadPool::Task final : public RefCounted {
+  public:
+    Task(PostWorkerTaskCallback callback, void* userdata)
+        : mCallback(callback), mUserdata(userdata) {}
 
-    void MarkAsComplete() {
+    void Run() {
+        mCallback(mUserdata);
         {
             std::lock_guard<std::mutex> lock(mMutex);
-            mIsComplete = true;
+            mIsComplete.store(true, std::memory_order_release);
         }
         mCondition.notify_all();
     }
 
+    void Wait() {
+        if (IsComplete()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] { return IsComplete(); });
+    }
+
+    bool IsComplete() const { return mIsComplete.load(std::memory_order_acquire); }
+
   private:
+    ~Task() override = default;
+
+    PostWorkerTaskCallback mCallback;
+    void* mUserdata;
+
+    std::atomic<bool> mIsComplete{false};
     std::mutex mMutex;
     std::condition_variable mCondition;
-    bool mIsComplete;
 };
 
-class AsyncWaitableEvent final : public dawn::platform::WaitableEvent {
+class AsyncWorkerThreadPool::TaskEvent final : public WaitableEvent {
   public:
-    AsyncWaitableEvent() : mWaitableEventImpl(std::make_shared<AsyncWaitableEventImpl>()) {}
+    explicit TaskEvent(Ref<Task> task) : mTask(std::move(task)) {}
 
-    void Wait() override { mWaitableEventImpl->Wait(); }
+    void Wait() override { mTask->Wait(); }
 
-    bool IsComplete() override { return mWaitableEventImpl->IsComplete(); }
-
-    std::shared_ptr<AsyncWaitableEventImpl> GetWaitableEventImpl() const {
-        return mWaitableEventImpl;
-    }
+    bool IsComplete() override { return mTask->IsComplete(); }
 
   private:
-    std::shared_ptr<AsyncWaitableEventImpl> mWaitableEventImpl;
+    Ref<Task> mTask;
 };
 
-}  // anonymous namespace
+AsyncWorkerThreadPool::AsyncWorkerThreadPool(uint32_t threadCount)
+    : mThreadCount(threadCount != 0 ? threadCount
+                                    : std::max(1u, std::thread::hardware_concurrency())) {
+    mQueues.reserve(mThreadCount);
+    for (uint32_t i = 0; i < mThreadCount; ++i) {
+        mQueues.push_back(std::make_unique<WorkerQueues>());
+    }
+}
 
-namespace dawn::platform {
+AsyncWorkerThreadPool::~AsyncWorkerThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStopping = true;
+    }
+    mSleepCondition.notify_all();
+
+    // The workers drain all the queues before exiting.
+    for (std::thread& worker : mWorkers) {
+        worker.join();
+    }
+    DAWN_ASSERT(mQueuedTaskCount.load() == 0);
+}
+
+uint32_t AsyncWorkerThreadPool::GetThreadCount() const {
+    return mThreadCount;
+}
 
-std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
-    dawn::platform::PostWorkerTaskCallback callback,
+std::unique_ptr<WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
+    PostWorkerTaskCallback callback,
     void* userdata) {
-    std::unique_ptr<AsyncWaitableEvent> waitableEvent = std::make_unique<AsyncWaitableEvent>();
+    return PostWorkerTaskWithPriority(callback, userdata, WorkerTaskPriority::Normal);
+}
+
+std::unique_ptr<WaitableEvent> AsyncWorkerThreadPool::PostWorkerTaskWithPriority(
+    PostWorkerTaskCallback callback,
+    void* userdata,
+    WorkerTaskPriority priority) {
+    EnsureWorkersStarted();
+
+    Ref<Task> task = AcquireRef(new Task(callback, userdata));
+    auto event = std::make_unique<TaskEvent>(task);
+
+    // Tasks posted from one of our workers stay local to it, others are spread over all the
+    // workers.
+    uint32_t queueIndex = tCurrentPool == this
+                              ? tCurrentWorkerIndex
+                              : mNextQueue.fetch_add(1, std::memory_order_relaxed) % mThreadCount;
+    size_t priorityIndex = static_cast<size_t>(priority);
+    DAWN_ASSERT(priorityIndex < kPriorityCount);
+    {
+        WorkerQueues* queues = mQueues[queueIndex].get();
+        std::lock_guard<std::mutex> lock(queues->mutex);
+        queues->tasks[priorityIndex].push_back(std::move(task));
+    }
 
-    std::function<void()> doTask = [callback, userdata,
-                                    waitableEventImpl = waitableEvent->GetWaitableEventImpl()] {
-        callback(userdata);
-        waitableEventImpl->MarkAsComplete();
-    };
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mQueuedTaskCount.fetch_add(1);
+    }
+    mSleepCondition.notify_one();
 
-    std::thread thread(doTask);
-    thread.detach();
+    return event;
+}
 
-    return waitableEvent;
+void AsyncWorkerThreadPool::EnsureWorkersStarted() {
+    std::call_once(mStartWorkersFlag, [this] {
+        mWorkers.reserve(mThreadCount);
+        for (uint32_t i = 0; i < mThreadCount; ++i) {
+            mWorkers.emplace_back(&AsyncWorkerThreadPool::WorkerMain, this, i);
+        }
+    });
+}
+
+void AsyncWorkerThreadPool::WorkerMain(uint32_t workerIndex) {
+    tCurrentPool = this;
+    tCurrentWorkerIndex = workerIndex;
+
+    while (true) {
+        Ref<Task> task = FindTask(workerIndex);
+        if (task != nullptr) {
+            task->Run();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mSleepCondition.wait(lock, [this] { return mStopping || mQueuedTaskCount.load() > 0; });
+        if (mStopping && mQueuedTaskCount.load() == 0) {
+            return;
+        }
+    }
+}
+
+Ref<AsyncWorkerThreadPool::Task> AsyncWorkerThreadPool::FindTask(uint32_t workerIndex) {
+    // Look at all the queues for a priority before moving to the next one, starting with the
+    // worker's own queue. Both the owner and the thieves take the oldest task to keep tasks
+    // roughly in submission order.
+    for (size_t priorityIndex = 0; priorityIndex < kPriorityCount; ++priorityIndex) {
+        for (uint32_t i = 0; i < mThreadCount; ++i) {
+            WorkerQueues* queues = mQueues[(workerIndex + i) % mThreadCount].get();
+            std::lock_guard<std::mutex> lock(queues->mutex);
+            std::deque<Ref<Task>>& tasks = queues->tasks[priorityIndex];
+            if (!tasks.empty()) {
+                Ref<Task> task = std::move(tasks.front());
+                tasks.pop_front();
+                mQueuedTaskCount.fetch_sub(1);
+                return task;
+            }
+        }
+    }
+    return nullptr;
 }
 
 }  // namespace dawn::platform
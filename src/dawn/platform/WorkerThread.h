@@ -28,18 +28,70 @@
 #ifndef SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 #define SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "dawn/common/NonCopyable.h"
+#include "dawn/common/Ref.h"
 #include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::platform {
 
-class AsyncWorkerThreadPool : public dawn::platform::WorkerTaskPool, public NonCopyable {
+// A fixed-size pool of worker threads. Each worker owns a queue per priority, tasks posted from a
+// worker go to its own queue and idle workers steal from the queues of the others. Workers are
+// started lazily on the first posted task so that devices that never use async work don't pay
+// for them. All the tasks that were posted are run before the pool is destroyed.
+class DAWN_PLATFORM_EXPORT AsyncWorkerThreadPool : public dawn::platform::WorkerTaskPool,
+                                                   public NonCopyable {
   public:
+    // A |threadCount| of 0 means one worker per hardware thread.
+    explicit AsyncWorkerThreadPool(uint32_t threadCount = 0);
+    ~AsyncWorkerThreadPool() override;
+
     std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
         dawn::platform::PostWorkerTaskCallback callback,
         void* userdata) override;
+    std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTaskWithPriority(
+        dawn::platform::PostWorkerTaskCallback callback,
+        void* userdata,
+        dawn::platform::WorkerTaskPriority priority) override;
+
+    uint32_t GetThreadCount() const;
+
+  private:
+    class Task;
+    class TaskEvent;
+
+    static constexpr size_t kPriorityCount = 2;
+
+    struct WorkerQueues {
+        std::mutex mutex;
+        std::deque<Ref<Task>> tasks[kPriorityCount];
+    };
+
+    void EnsureWorkersStarted();
+    void WorkerMain(uint32_t workerIndex);
+    Ref<Task> FindTask(uint32_t workerIndex);
+
+    const uint32_t mThreadCount;
+    std::vector<std::unique_ptr<WorkerQueues>> mQueues;
+
+    std::once_flag mStartWorkersFlag;
+    std::vector<std::thread> mWorkers;
+    std::atomic<uint32_t> mNextQueue{0};
+
+    // Number of tasks enqueued and not yet picked up by a worker. Sleeping workers are woken up
+    // through mSleepCondition when it becomes non-zero.
+    std::atomic<int64_t> mQueuedTaskCount{0};
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondition;
+    bool mStopping = false;
 };
 
 }  // namespace dawn::platform
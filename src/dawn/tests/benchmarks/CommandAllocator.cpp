@@ -0,0 +1,121 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "dawn/native/CommandAllocator.h"
+#include "dawn/native/CommandBlockPool.h"
+
+namespace dawn::native {
+namespace {
+
+// Commands roughly the size of the SetBindGroup and Draw commands of a render pass.
+enum class CommandType {
+    SetBindGroup,
+    Draw,
+};
+
+struct SetBindGroupCmd {
+    uint32_t index;
+    void* group;
+    uint32_t dynamicOffsetCount;
+};
+
+struct DrawCmd {
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t firstInstance;
+};
+
+// Encodes a frame of state.range(0) encoders with state.range(1) draws each, then iterates over
+// the commands and frees them like a submitted command buffer. The Pooled variant allocates the
+// blocks from a CommandBlockPool like the command encoders of a device.
+template <bool kPooled>
+void EncodeFrame(benchmark::State& state) {
+    CommandBlockPool pool;
+    const size_t encoderCount = state.range(0);
+    const size_t drawCount = state.range(1);
+
+    for (auto _ : state) {
+        std::vector<CommandAllocator> allocators;
+        allocators.reserve(encoderCount);
+        for (size_t i = 0; i < encoderCount; ++i) {
+            allocators.emplace_back(kPooled ? &pool : nullptr);
+            CommandAllocator& allocator = allocators.back();
+            for (size_t j = 0; j < drawCount; ++j) {
+                SetBindGroupCmd* setBindGroup =
+                    allocator.Allocate<SetBindGroupCmd>(CommandType::SetBindGroup);
+                setBindGroup->index = 0;
+                setBindGroup->group = nullptr;
+                setBindGroup->dynamicOffsetCount = 1;
+                *allocator.AllocateData<uint32_t>(1) = static_cast<uint32_t>(j);
+
+                DrawCmd* draw = allocator.Allocate<DrawCmd>(CommandType::Draw);
+                draw->vertexCount = 3;
+                draw->instanceCount = 1;
+                draw->firstVertex = 0;
+                draw->firstInstance = 0;
+            }
+        }
+
+        CommandIterator commands;
+        commands.AcquireCommandBlocks(std::move(allocators));
+        CommandType type;
+        uint64_t vertexCount = 0;
+        while (commands.NextCommandId(&type)) {
+            switch (type) {
+                case CommandType::SetBindGroup: {
+                    SetBindGroupCmd* cmd = commands.NextCommand<SetBindGroupCmd>();
+                    commands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    break;
+                }
+                case CommandType::Draw:
+                    vertexCount += commands.NextCommand<DrawCmd>()->vertexCount;
+                    break;
+            }
+        }
+        benchmark::DoNotOptimize(vertexCount);
+        commands.MakeEmptyAsDataWasDestroyed();
+    }
+
+    state.SetItemsProcessed(state.iterations() * encoderCount * drawCount);
+    CommandBlockPool::Stats stats = pool.GetStats();
+    if (stats.hits + stats.misses != 0) {
+        state.counters["hit_rate"] = double(stats.hits) / double(stats.hits + stats.misses);
+        state.counters["retained_KiB"] = double(stats.retainedBytes) / 1024.0;
+    }
+}
+BENCHMARK_TEMPLATE(EncodeFrame, false)->Args({1, 5000})->Args({16, 300});
+BENCHMARK_TEMPLATE(EncodeFrame, true)->Args({1, 5000})->Args({16, 300});
+
+}  // namespace
+}  // namespace dawn::native
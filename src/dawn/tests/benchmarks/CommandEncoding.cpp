@@ -0,0 +1,201 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <array>
+#include <vector>
+
+#include "dawn/tests/benchmarks/NullDeviceSetup.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/TestUtils.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+// Benchmarks for encoding command buffers on multiple threads of the same device. Command encoders
+// and pass encoders don't take the device lock in the common case, so the throughput of encoding
+// should scale with the number of threads.
+class CommandEncoding : public NullDeviceBenchmarkFixture {
+  private:
+    wgpu::DeviceDescriptor GetDeviceDescriptor() const override {
+        // Render pass sub-encoders are an experimental feature.
+        static const char* kAllowUnsafeAPIs = "allow_unsafe_apis";
+        static wgpu::DawnTogglesDescriptor togglesDesc = [] {
+            wgpu::DawnTogglesDescriptor desc;
+            desc.enabledToggles = &kAllowUnsafeAPIs;
+            desc.enabledToggleCount = 1;
+            return desc;
+        }();
+
+        wgpu::DeviceDescriptor deviceDesc = {};
+        deviceDesc.nextInChain = &togglesDesc;
+        deviceDesc.requiredFeatures = kRequiredFeatures.data();
+        deviceDesc.requiredFeatureCount = kRequiredFeatures.size();
+        return deviceDesc;
+    }
+
+    static constexpr std::array<wgpu::FeatureName, 2> kRequiredFeatures = {
+        wgpu::FeatureName::ImplicitDeviceSynchronization,
+        wgpu::FeatureName::RenderPassSubEncoders,
+    };
+};
+
+// The resources used by the draws of the benchmarks below.
+struct DrawResources {
+    wgpu::RenderPipeline pipeline;
+    wgpu::BindGroup bindGroup;
+    wgpu::TextureView attachment;
+};
+
+DrawResources CreateDrawResources(const wgpu::Device& device) {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<uniform> u : vec4f;
+        @vertex fn vs() -> @builtin(position) vec4f {
+            return u;
+        }
+        @fragment fn fs() -> @location(0) vec4f {
+            return u;
+        })");
+    utils::ComboRenderPipelineDescriptor pipelineDesc;
+    pipelineDesc.vertex.module = module;
+    pipelineDesc.vertex.entryPoint = "vs";
+    pipelineDesc.cFragment.module = module;
+    pipelineDesc.cFragment.entryPoint = "fs";
+    pipelineDesc.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+
+    DrawResources resources;
+    resources.pipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+    wgpu::Buffer buffer = utils::CreateBufferFromData(device, wgpu::BufferUsage::Uniform,
+                                                      {0.0f, 0.0f, 0.0f, 0.0f});
+    resources.bindGroup =
+        utils::MakeBindGroup(device, resources.pipeline.GetBindGroupLayout(0), {{0, buffer}});
+
+    wgpu::TextureDescriptor attachmentDesc = {};
+    attachmentDesc.size = {4, 4, 1};
+    attachmentDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    attachmentDesc.usage = wgpu::TextureUsage::RenderAttachment;
+    resources.attachment = device.CreateTexture(&attachmentDesc).CreateView();
+    return resources;
+}
+
+// Submits the last command buffer encoded by a benchmark. Encoding errors are only reported to
+// the fixture's uncaptured error callback, which fails the benchmark, once the device is ticked.
+void SubmitAndCheckForErrors(const wgpu::Device& device, const wgpu::CommandBuffer& commands) {
+    device.GetQueue().Submit(1, &commands);
+    device.Tick();
+}
+
+// Each thread repeatedly encodes and finishes a command buffer containing a single render pass
+// with state.range(0) draws that each set a bind group.
+BENCHMARK_DEFINE_F(CommandEncoding, RenderPass)
+(benchmark::State& state) {
+    DrawResources resources = CreateDrawResources(device);
+    utils::ComboRenderPassDescriptor renderPass({resources.attachment});
+
+    const int64_t numDraws = state.range(0);
+    wgpu::CommandBuffer commands;
+    for (auto _ : state) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(resources.pipeline);
+        for (int64_t i = 0; i < numDraws; ++i) {
+            pass.SetBindGroup(0, resources.bindGroup);
+            pass.Draw(3);
+        }
+        pass.End();
+        commands = encoder.Finish();
+    }
+    state.SetItemsProcessed(state.iterations() * numDraws);
+
+    SubmitAndCheckForErrors(device, commands);
+}
+BENCHMARK_REGISTER_F(CommandEncoding, RenderPass)
+    ->Arg(1)
+    ->Arg(1000)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(8)
+    ->Threads(16);
+
+// Encodes a single render pass with 100k draws that each set a bind group. The draws are split
+// between state.range(0) sub-encoders of the pass which are each recorded on their own thread, or
+// recorded directly in the pass if state.range(0) is 0.
+BENCHMARK_DEFINE_F(CommandEncoding, RenderPassSubEncoders)
+(benchmark::State& state) {
+    DrawResources resources = CreateDrawResources(device);
+    utils::ComboRenderPassDescriptor renderPass({resources.attachment});
+
+    constexpr uint32_t kNumDraws = 100000;
+    const uint32_t numSubEncoders = static_cast<uint32_t>(state.range(0));
+    wgpu::CommandBuffer commands;
+    for (auto _ : state) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        if (numSubEncoders == 0) {
+            pass.SetPipeline(resources.pipeline);
+            for (uint32_t i = 0; i < kNumDraws; ++i) {
+                pass.SetBindGroup(0, resources.bindGroup);
+                pass.Draw(3);
+            }
+        } else {
+            std::vector<wgpu::RenderBundleEncoder> subEncoders(numSubEncoders);
+            for (wgpu::RenderBundleEncoder& subEncoder : subEncoders) {
+                subEncoder = pass.CreateSubEncoder();
+            }
+            utils::RunInParallel(numSubEncoders, [&](uint32_t index) {
+                const wgpu::RenderBundleEncoder& subEncoder = subEncoders[index];
+                subEncoder.SetPipeline(resources.pipeline);
+                for (uint32_t i = index; i < kNumDraws; i += numSubEncoders) {
+                    subEncoder.SetBindGroup(0, resources.bindGroup);
+                    subEncoder.Draw(3);
+                }
+            });
+        }
+        pass.End();
+        commands = encoder.Finish();
+    }
+    state.SetItemsProcessed(state.iterations() * kNumDraws);
+
+    SubmitAndCheckForErrors(device, commands);
+}
+BENCHMARK_REGISTER_F(CommandEncoding, RenderPassSubEncoders)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace dawn
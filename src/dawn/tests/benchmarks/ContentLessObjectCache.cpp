@@ -0,0 +1,139 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+
+#include "dawn/common/ContentLessObjectCache.h"
+#include "dawn/common/HashUtils.h"
+
+namespace dawn {
+namespace {
+
+class CacheableT : public RefCounted, public ContentLessObjectCacheable<CacheableT> {
+  public:
+    explicit CacheableT(uint64_t value) : mValue(value) {}
+
+    struct HashFunc {
+        size_t operator()(const CacheableT* x) const {
+            size_t hash = 0;
+            HashCombine(&hash, x->mValue);
+            return hash;
+        }
+    };
+
+    struct EqualityFunc {
+        bool operator()(const CacheableT* l, const CacheableT* r) const {
+            return l->mValue == r->mValue;
+        }
+    };
+
+  private:
+    void DeleteThis() override {
+        Uncache();
+        RefCounted::DeleteThis();
+    }
+
+    uint64_t mValue;
+};
+
+using Cache = ContentLessObjectCache<CacheableT>;
+
+constexpr uint64_t kNumCachedObjects = 1024;
+
+// Shared by all the threads of a benchmark run. Objects are keyed by the thread index so that the
+// threads create distinct objects.
+Cache* gCache = nullptr;
+std::vector<Ref<CacheableT>>* gCachedObjects = nullptr;
+
+void SetUpCache(const benchmark::State&) {
+    gCache = new Cache();
+    gCachedObjects = new std::vector<Ref<CacheableT>>();
+    for (uint64_t i = 0; i < kNumCachedObjects; i++) {
+        gCachedObjects->push_back(AcquireRef(new CacheableT(i)));
+        gCache->Insert(gCachedObjects->back().Get());
+    }
+}
+
+void TearDownCache(const benchmark::State&) {
+    delete gCachedObjects;
+    gCachedObjects = nullptr;
+    delete gCache;
+    gCache = nullptr;
+}
+
+// Looking up objects that are already in the cache, like recreating the same sampler.
+void FindCached(benchmark::State& state) {
+    uint64_t i = state.thread_index();
+    for (auto _ : state) {
+        CacheableT blueprint(i++ % kNumCachedObjects);
+        benchmark::DoNotOptimize(gCache->Find(&blueprint));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(FindCached)
+    ->Setup(SetUpCache)
+    ->Teardown(TearDownCache)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+// Inserting an object equivalent to one that is already cached, which returns the cached object.
+void InsertCached(benchmark::State& state) {
+    uint64_t i = state.thread_index();
+    for (auto _ : state) {
+        Ref<CacheableT> object = AcquireRef(new CacheableT(i++ % kNumCachedObjects));
+        benchmark::DoNotOptimize(gCache->Insert(object.Get()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(InsertCached)
+    ->Setup(SetUpCache)
+    ->Teardown(TearDownCache)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+// Inserting new objects that are released right away, which erases them from the cache.
+void InsertUnique(benchmark::State& state) {
+    uint64_t i = (uint64_t(state.thread_index()) + 1) << 32;
+    for (auto _ : state) {
+        Ref<CacheableT> object = AcquireRef(new CacheableT(i++));
+        benchmark::DoNotOptimize(gCache->Insert(object.Get()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(InsertUnique)
+    ->Setup(SetUpCache)
+    ->Teardown(TearDownCache)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+}  // namespace
+}  // namespace dawn
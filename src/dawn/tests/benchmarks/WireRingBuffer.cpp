@@ -0,0 +1,159 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "dawn/utils/SharedMemoryRingBuffer.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+
+namespace dawn::utils {
+namespace {
+
+constexpr size_t kRingCapacity = 1 << 20;
+
+// Reads the first word of each command like a server reading the command header.
+class ChecksumHandler : public dawn::wire::CommandHandler {
+  public:
+    explicit ChecksumHandler(size_t commandSize) : mCommandSize(commandSize) {}
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        for (size_t offset = 0; offset + mCommandSize <= size; offset += mCommandSize) {
+            mChecksum += *reinterpret_cast<const volatile uint32_t*>(commands + offset);
+        }
+        return commands + size;
+    }
+
+    uint64_t GetChecksum() const { return mChecksum; }
+
+  private:
+    size_t mCommandSize;
+    uint64_t mChecksum = 0;
+};
+
+// Serializes commands of state.range(0) bytes and flushes every state.range(1) commands.
+template <typename Serializer>
+void SerializeCommands(benchmark::State& state, Serializer* serializer) {
+    const size_t commandSize = state.range(0);
+    const size_t commandsPerFlush = state.range(1);
+    for (auto _ : state) {
+        for (size_t i = 0; i < commandsPerFlush; ++i) {
+            char* command = static_cast<char*>(serializer->GetCmdSpace(commandSize));
+            memset(command, 1, commandSize);
+        }
+        serializer->Flush();
+    }
+    state.SetItemsProcessed(state.iterations() * commandsPerFlush);
+    state.SetBytesProcessed(state.iterations() * commandsPerFlush * commandSize);
+}
+
+// The commands are handled synchronously on the client thread when it flushes, as a baseline.
+void Throughput_TerribleCommandBuffer(benchmark::State& state) {
+    ChecksumHandler handler(state.range(0));
+    TerribleCommandBuffer serializer(&handler);
+    SerializeCommands(state, &serializer);
+    benchmark::DoNotOptimize(handler.GetChecksum());
+}
+BENCHMARK(Throughput_TerribleCommandBuffer)->Args({32, 1})->Args({32, 64})->Args({256, 64});
+
+// The commands are handled by a server thread while the client keeps serializing.
+void Throughput_SharedMemoryRingBuffer(benchmark::State& state) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(kRingCapacity);
+    ChecksumHandler handler(state.range(0));
+    std::thread server([&] {
+        RingBufferCommandReceiver receiver(ring.get(), &handler);
+        while (receiver.WaitForCommands()) {
+            receiver.HandleCommands();
+        }
+    });
+
+    RingBufferCommandSerializer serializer(ring.get());
+    SerializeCommands(state, &serializer);
+    ring->Close();
+    server.join();
+    benchmark::DoNotOptimize(handler.GetChecksum());
+}
+BENCHMARK(Throughput_SharedMemoryRingBuffer)
+    ->Args({32, 1})
+    ->Args({32, 64})
+    ->Args({256, 64})
+    ->UseRealTime();
+
+// Answers each batch of commands with a reply on the return ring.
+class EchoHandler : public dawn::wire::CommandHandler {
+  public:
+    explicit EchoHandler(RingBufferCommandSerializer* replies) : mReplies(replies) {}
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        uint32_t* reply = static_cast<uint32_t*>(mReplies->GetCmdSpace(sizeof(uint32_t)));
+        *reply = *reinterpret_cast<const volatile uint32_t*>(commands);
+        mReplies->Flush();
+        return commands + size;
+    }
+
+  private:
+    RingBufferCommandSerializer* mReplies;
+};
+
+// Round trip of a command from the client thread to the server thread and of its reply back,
+// like a client waiting for a callback.
+void Latency_SharedMemoryRingBuffer(benchmark::State& state) {
+    std::unique_ptr<SharedMemoryRingBuffer> commandRing =
+        SharedMemoryRingBuffer::Create(kRingCapacity);
+    std::unique_ptr<SharedMemoryRingBuffer> replyRing =
+        SharedMemoryRingBuffer::Create(kRingCapacity);
+
+    std::thread server([&] {
+        RingBufferCommandSerializer replies(replyRing.get());
+        EchoHandler handler(&replies);
+        RingBufferCommandReceiver receiver(commandRing.get(), &handler);
+        while (receiver.WaitForCommands()) {
+            receiver.HandleCommands();
+        }
+    });
+
+    RingBufferCommandSerializer serializer(commandRing.get());
+    ChecksumHandler replyHandler(sizeof(uint32_t));
+    RingBufferCommandReceiver replyReceiver(replyRing.get(), &replyHandler);
+    uint32_t serial = 0;
+    for (auto _ : state) {
+        *static_cast<uint32_t*>(serializer.GetCmdSpace(sizeof(uint32_t))) = serial++;
+        serializer.Flush();
+        replyReceiver.WaitForCommands();
+        replyReceiver.HandleCommands();
+    }
+    commandRing->Close();
+    server.join();
+    benchmark::DoNotOptimize(replyHandler.GetChecksum());
+}
+BENCHMARK(Latency_SharedMemoryRingBuffer)->UseRealTime();
+
+}  // anonymous namespace
+}  // namespace dawn::utils
@@ -0,0 +1,124 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/WorkerThread.h"
+
+namespace dawn {
+namespace {
+
+// The previous implementation of the WorkerTaskPool that spawns and detaches a thread for each
+// task, kept here as a baseline.
+class ThreadPerTaskPool : public platform::WorkerTaskPool {
+  public:
+    std::unique_ptr<platform::WaitableEvent> PostWorkerTask(
+        platform::PostWorkerTaskCallback callback,
+        void* userdata) override {
+        auto event = std::make_unique<Event>();
+        std::thread([callback, userdata, state = event->state] {
+            callback(userdata);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->isComplete = true;
+            }
+            state->condition.notify_all();
+        }).detach();
+        return event;
+    }
+
+  private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool isComplete = false;
+    };
+
+    class Event : public platform::WaitableEvent {
+      public:
+        void Wait() override {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->condition.wait(lock, [this] { return state->isComplete; });
+        }
+        bool IsComplete() override {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            return state->isComplete;
+        }
+
+        std::shared_ptr<State> state = std::make_shared<State>();
+    };
+};
+
+using FixedSizePool = platform::AsyncWorkerThreadPool;
+
+void SmallTask(void* userdata) {
+    static_cast<std::atomic<uint64_t>*>(userdata)->fetch_add(1, std::memory_order_relaxed);
+}
+
+// Time between posting a single task and seeing it complete.
+template <typename Pool>
+void TaskLatency(benchmark::State& state) {
+    Pool pool;
+    std::atomic<uint64_t> counter{0};
+    for (auto _ : state) {
+        pool.PostWorkerTask(SmallTask, &counter)->Wait();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(TaskLatency, ThreadPerTaskPool);
+BENCHMARK_TEMPLATE(TaskLatency, FixedSizePool);
+
+// Posts a burst of tasks and waits for all of them, like a level streaming a batch of
+// CreateRenderPipelineAsync calls.
+template <typename Pool>
+void TaskThroughput(benchmark::State& state) {
+    Pool pool;
+    std::atomic<uint64_t> counter{0};
+    std::vector<std::unique_ptr<platform::WaitableEvent>> events(state.range(0));
+    for (auto _ : state) {
+        for (auto& event : events) {
+            event = pool.PostWorkerTask(SmallTask, &counter);
+        }
+        for (auto& event : events) {
+            event->Wait();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(TaskThroughput, ThreadPerTaskPool)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(TaskThroughput, FixedSizePool)->Arg(16)->Arg(256);
+
+}  // namespace
+}  // namespace dawn
@@ -25,6 +25,7 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
@@ -670,6 +671,125 @@ TEST_P(MultithreadEncodingTests, ComputePassEncodersInParallel) {
     }
 }
 
+// Test that encoders used on several threads at once can all report errors to the device. Encoders
+// don't hold the device lock, so they only take it when there is an error to handle.
+TEST_P(MultithreadEncodingTests, EncodingErrorsInParallel) {
+    DAWN_TEST_UNSUPPORTED_IF(HasToggleEnabled("skip_validation"));
+
+    constexpr uint32_t kNumThreads = 10;
+
+    device.PushErrorScope(wgpu::ErrorFilter::Validation);
+
+    utils::RunInParallel(kNumThreads, [=](uint32_t) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.End();
+        // Ending the pass a second time is reported directly to the device.
+        pass.End();
+
+        // Finishing with an unbalanced debug group is reported when finishing the encoder.
+        encoder.PushDebugGroup("Unbalanced");
+        encoder.Finish();
+    });
+
+    std::atomic<bool> errorThrown(false);
+    device.PopErrorScope(
+        [](WGPUErrorType type, char const* message, void* userdata) {
+            EXPECT_EQ(type, WGPUErrorType_Validation);
+            auto error = static_cast<std::atomic<bool>*>(userdata);
+            *error = true;
+        },
+        &errorThrown);
+    device.Tick();
+    EXPECT_TRUE(errorThrown.load());
+}
+
+class MultithreadRenderPassSubEncoderTests : public MultithreadTests {
+  protected:
+    std::vector<wgpu::FeatureName> GetRequiredFeatures() override {
+        std::vector<wgpu::FeatureName> requiredFeatures = MultithreadTests::GetRequiredFeatures();
+        if (SupportsFeatures({wgpu::FeatureName::RenderPassSubEncoders})) {
+            requiredFeatures.push_back(wgpu::FeatureName::RenderPassSubEncoders);
+        }
+        return requiredFeatures;
+    }
+
+    void SetUp() override {
+        MultithreadTests::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(!SupportsFeatures({wgpu::FeatureName::RenderPassSubEncoders}));
+    }
+};
+
+// Test that the sub-encoders of a render pass can be recorded in parallel, and that their commands
+// are executed in creation order after the pass's own commands.
+TEST_P(MultithreadRenderPassSubEncoderTests, SubEncodersInParallel) {
+    constexpr uint32_t kRTSize = 4;
+    constexpr uint32_t kNumThreads = 8;
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<uniform> color : vec4f;
+
+        @vertex fn vs(@builtin(vertex_index) VertexIndex : u32) -> @builtin(position) vec4f {
+            var pos = array(
+                vec2f(-1.0, -1.0),
+                vec2f( 3.0, -1.0),
+                vec2f(-1.0,  3.0));
+            return vec4f(pos[VertexIndex], 0.0, 1.0);
+        }
+
+        @fragment fn fs() -> @location(0) vec4f {
+            return color;
+        })");
+    utils::ComboRenderPipelineDescriptor pipelineDesc;
+    pipelineDesc.vertex.module = module;
+    pipelineDesc.vertex.entryPoint = "vs";
+    pipelineDesc.cFragment.module = module;
+    pipelineDesc.cFragment.entryPoint = "fs";
+    pipelineDesc.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+    wgpu::RenderPipeline pipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+    auto MakeColorBindGroup = [&](const std::array<float, 4>& color) {
+        wgpu::Buffer buffer = utils::CreateBufferFromData(device, color.data(), sizeof(color),
+                                                          wgpu::BufferUsage::Uniform);
+        return utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer}});
+    };
+    wgpu::BindGroup red = MakeColorBindGroup({1.0f, 0.0f, 0.0f, 1.0f});
+    wgpu::BindGroup green = MakeColorBindGroup({0.0f, 1.0f, 0.0f, 1.0f});
+    wgpu::BindGroup blue = MakeColorBindGroup({0.0f, 0.0f, 1.0f, 1.0f});
+
+    wgpu::Texture renderTarget =
+        CreateTexture(kRTSize, kRTSize, wgpu::TextureFormat::RGBA8Unorm,
+                      wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopySrc);
+    utils::ComboRenderPassDescriptor renderPass({renderTarget.CreateView()});
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+
+    std::vector<wgpu::RenderBundleEncoder> subEncoders(kNumThreads);
+    for (uint32_t i = 0; i < kNumThreads; ++i) {
+        subEncoders[i] = pass.CreateSubEncoder();
+    }
+
+    // Only the last created sub-encoder draws green, regardless of which thread finishes last.
+    utils::RunInParallel(kNumThreads, [=, &subEncoders](uint32_t index) {
+        subEncoders[index].SetPipeline(pipeline);
+        subEncoders[index].SetBindGroup(0, index == kNumThreads - 1 ? green : red);
+        subEncoders[index].Draw(3);
+    });
+
+    // Commands recorded directly in the pass execute before the sub-encoders' commands.
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, blue);
+    pass.Draw(3);
+    pass.End();
+
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+    queue.Submit(1, &commandBuffer);
+
+    EXPECT_TEXTURE_EQ(utils::RGBA8::kGreen, renderTarget, {0, 0});
+    EXPECT_TEXTURE_EQ(utils::RGBA8::kGreen, renderTarget, {kRTSize - 1, kRTSize - 1});
+}
+
 class MultithreadTextureCopyTests : public MultithreadTests {
   protected:
     void SetUp() override {
@@ -1391,6 +1511,14 @@ DAWN_INSTANTIATE_TEST(MultithreadEncodingTests,
                       VulkanBackend(),
                       VulkanBackend({"always_resolve_into_zero_level_and_layer"}));
 
+DAWN_INSTANTIATE_TEST(MultithreadRenderPassSubEncoderTests,
+                      D3D11Backend(),
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      OpenGLESBackend(),
+                      VulkanBackend());
+
 DAWN_INSTANTIATE_TEST(
     MultithreadTextureCopyTests,
     D3D11Backend(),
@@ -0,0 +1,160 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <array>
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumDraws = 5000;
+constexpr uint32_t kNumBindGroups = 4;
+
+constexpr char kShader[] = R"(
+        @group(0) @binding(0) var<uniform> u0 : vec4f;
+        @group(0) @binding(1) var t0 : texture_2d<f32>;
+        @group(1) @binding(0) var<uniform> u1 : vec4f;
+        @group(1) @binding(1) var t1 : texture_2d<f32>;
+        @group(2) @binding(0) var<uniform> u2 : vec4f;
+        @group(2) @binding(1) var t2 : texture_2d<f32>;
+        @group(3) @binding(0) var<uniform> u3 : vec4f;
+        @group(3) @binding(1) var t3 : texture_2d<f32>;
+
+        @vertex fn vs() -> @builtin(position) vec4f {
+            return vec4f(0.0, 0.0, 0.0, 1.0);
+        }
+
+        @fragment fn fs() -> @location(0) vec4f {
+            let texel = textureLoad(t0, vec2u(), 0) + textureLoad(t1, vec2u(), 0) +
+                        textureLoad(t2, vec2u(), 0) + textureLoad(t3, vec2u(), 0);
+            return u0 + u1 + u2 + u3 + texel;
+        })";
+
+struct EncodeDrawParams : AdapterTestParam {
+    EncodeDrawParams(const AdapterTestParam& param,
+                     uint32_t numBindGroupSetsIn,
+                     uint32_t numRenderPassesIn)
+        : AdapterTestParam(param),
+          numBindGroupSets(numBindGroupSetsIn),
+          numRenderPasses(numRenderPassesIn) {}
+    // The number of distinct sets of bind groups that the draws cycle through.
+    uint32_t numBindGroupSets;
+    // The number of render passes that the draws are split across.
+    uint32_t numRenderPasses;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const EncodeDrawParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_bindGroupSets_" << param.numBindGroupSets;
+    ostream << "_renderPasses_" << param.numRenderPasses;
+    return ostream;
+}
+
+// Test the CPU cost of encoding render passes with many draws that each set 4 bind groups, which
+// is dominated by the tracking of the resources used by the passes. Run on the null backend, the
+// result is the frontend encoding and validation cost per draw.
+class EncodeDrawPerf : public DawnPerfTestWithParams<EncodeDrawParams> {
+  public:
+    EncodeDrawPerf() : DawnPerfTestWithParams(kNumDraws, 1) {}
+    ~EncodeDrawPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<EncodeDrawParams>::SetUp();
+
+        wgpu::TextureDescriptor textureDesc;
+        textureDesc.size = {4, 4, 1};
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDesc.usage = wgpu::TextureUsage::TextureBinding;
+
+        wgpu::TextureDescriptor attachmentDesc = textureDesc;
+        attachmentDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        mAttachment = device.CreateTexture(&attachmentDesc).CreateView();
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        wgpu::ShaderModule module = utils::CreateShaderModule(device, kShader);
+        pipelineDesc.vertex.module = module;
+        pipelineDesc.vertex.entryPoint = "vs";
+        pipelineDesc.cFragment.module = module;
+        pipelineDesc.cFragment.entryPoint = "fs";
+        pipelineDesc.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        // Each set of bind groups uses its own buffers and textures.
+        for (uint32_t set = 0; set < GetParam().numBindGroupSets; set++) {
+            std::array<wgpu::BindGroup, kNumBindGroups> bindGroups;
+            for (uint32_t group = 0; group < kNumBindGroups; group++) {
+                wgpu::Buffer buffer = utils::CreateBufferFromData(
+                    device, wgpu::BufferUsage::Uniform, {0.0f, 0.0f, 0.0f, 0.0f});
+                wgpu::TextureView view = device.CreateTexture(&textureDesc).CreateView();
+                bindGroups[group] = utils::MakeBindGroup(
+                    device, mPipeline.GetBindGroupLayout(group), {{0, buffer}, {1, view}});
+            }
+            mBindGroupSets.push_back(std::move(bindGroups));
+        }
+    }
+
+  private:
+    void Step() override {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        utils::ComboRenderPassDescriptor renderPass({mAttachment});
+        uint32_t drawsPerPass = kNumDraws / GetParam().numRenderPasses;
+        unsigned int draw = 0;
+        for (uint32_t passIndex = 0; passIndex < GetParam().numRenderPasses; passIndex++) {
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+            pass.SetPipeline(mPipeline);
+            for (uint32_t i = 0; i < drawsPerPass; i++, draw++) {
+                const auto& bindGroups = mBindGroupSets[draw % mBindGroupSets.size()];
+                for (uint32_t group = 0; group < kNumBindGroups; group++) {
+                    pass.SetBindGroup(group, bindGroups[group]);
+                }
+                pass.Draw(3);
+            }
+            pass.End();
+        }
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::TextureView mAttachment;
+    wgpu::RenderPipeline mPipeline;
+    std::vector<std::array<wgpu::BindGroup, kNumBindGroups>> mBindGroupSets;
+};
+
+TEST_P(EncodeDrawPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(EncodeDrawPerf, {NullBackend()}, {1, 16, 256}, {1, 100});
+
+}  // anonymous namespace
+}  // namespace dawn
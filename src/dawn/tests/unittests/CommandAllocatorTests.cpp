@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "dawn/native/CommandAllocator.h"
+#include "dawn/native/CommandBlockPool.h"
 #include "gtest/gtest.h"
 
 namespace dawn::native {
@@ -513,4 +514,118 @@ TEST(CommandAllocator, AcquireCommandBlocks) {
     iterator.MakeEmptyAsDataWasDestroyed();
 }
 
+// Test that blocks allocated from a pool are returned to it and reused by later allocators.
+TEST(CommandAllocator, BlocksAreRecycledThroughPool) {
+    CommandBlockPool pool;
+
+    auto EncodeAndFree = [&pool](size_t drawCount) {
+        CommandAllocator allocator(&pool);
+        for (size_t i = 0; i < drawCount; ++i) {
+            CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+            draw->first = static_cast<uint32_t>(i);
+            draw->count = 3;
+        }
+
+        CommandIterator iterator(std::move(allocator));
+        CommandType type;
+        size_t seenDraws = 0;
+        while (iterator.NextCommandId(&type)) {
+            ASSERT_EQ(type, CommandType::Draw);
+            CommandDraw* draw = iterator.NextCommand<CommandDraw>();
+            ASSERT_EQ(draw->first, seenDraws);
+            seenDraws++;
+        }
+        ASSERT_EQ(seenDraws, drawCount);
+        iterator.MakeEmptyAsDataWasDestroyed();
+    };
+
+    // The first encoding allocates all its blocks.
+    EncodeAndFree(10000);
+    CommandBlockPool::Stats stats = pool.GetStats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_GT(stats.misses, 0u);
+    EXPECT_GT(stats.retainedBytes, 0u);
+
+    // The same encoding again is served entirely from the free lists.
+    uint64_t firstMisses = stats.misses;
+    EncodeAndFree(10000);
+    stats = pool.GetStats();
+    EXPECT_EQ(stats.hits, firstMisses);
+    EXPECT_EQ(stats.misses, firstMisses);
+}
+
+// Test that a CommandAllocator that is reset or moved from keeps using its pool.
+TEST(CommandAllocator, PoolIsKeptAfterResetAndMove) {
+    CommandBlockPool pool;
+    CommandAllocator allocator(&pool);
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    allocator.Reset();
+    EXPECT_EQ(pool.GetStats().misses, 1u);
+
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    EXPECT_EQ(pool.GetStats().hits, 1u);
+
+    CommandAllocator other = std::move(allocator);
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    EXPECT_EQ(pool.GetStats().misses, 2u);
+
+    CommandIterator iterator;
+    std::vector<CommandAllocator> allocators;
+    allocators.push_back(std::move(allocator));
+    allocators.push_back(std::move(other));
+    iterator.AcquireCommandBlocks(std::move(allocators));
+    iterator.MakeEmptyAsDataWasDestroyed();
+    EXPECT_EQ(pool.GetStats().retainedBytes, 2 * 4096u);
+}
+
+// Test that commands larger than the largest size class bypass the pool.
+TEST(CommandAllocator, LargeBlocksAreNotPooled) {
+    CommandBlockPool pool;
+    {
+        CommandAllocator allocator(&pool);
+        allocator.Allocate<CommandBig>(CommandType::Big);
+        CommandIterator iterator(std::move(allocator));
+        iterator.MakeEmptyAsDataWasDestroyed();
+    }
+    CommandBlockPool::Stats stats = pool.GetStats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_EQ(stats.retainedBytes, 0u);
+}
+
+// Test the size classes and the retained memory cap of the pool.
+TEST(CommandBlockPool, SizeClassesAndCap) {
+    CommandBlockPool::Descriptor descriptor;
+    descriptor.sizeClasses = {1024, 4096};
+    descriptor.maxRetainedBytes = 4096 + 1024;
+    descriptor.maxBlocksPerShard = 1;
+    CommandBlockPool pool(descriptor);
+
+    size_t size;
+    uint8_t* small = pool.Allocate(100, &size);
+    EXPECT_EQ(size, 1024u);
+    uint8_t* medium = pool.Allocate(1025, &size);
+    EXPECT_EQ(size, 4096u);
+    uint8_t* medium2 = pool.Allocate(4096, &size);
+    EXPECT_EQ(size, 4096u);
+    uint8_t* large = pool.Allocate(5000, &size);
+    EXPECT_EQ(size, 5000u);
+    EXPECT_EQ(pool.GetStats().misses, 3u);
+
+    pool.Release(large, 5000);
+    pool.Release(small, 1024);
+    pool.Release(medium, 4096);
+    EXPECT_EQ(pool.GetStats().retainedBytes, 4096u + 1024u);
+
+    // The pool is full so this block is freed.
+    pool.Release(medium2, 4096);
+    EXPECT_EQ(pool.GetStats().retainedBytes, 4096u + 1024u);
+
+    uint8_t* reused = pool.Allocate(2000, &size);
+    EXPECT_EQ(reused, medium);
+    EXPECT_EQ(pool.GetStats().hits, 1u);
+    EXPECT_EQ(pool.GetStats().retainedBytes, 1024u);
+    pool.Release(reused, size);
+}
+
 }  // namespace dawn::native
@@ -162,6 +162,27 @@ TEST(ContentLessObjectCacheTest, EraseDuplicate) {
     EXPECT_FALSE(cache.Empty());
 }
 
+// The cache is only empty once every object, whatever its hash, has been erased.
+TEST(ContentLessObjectCacheTest, EraseMany) {
+    constexpr size_t kNumObjects = 256;
+    ContentLessObjectCache<CacheableT> cache;
+    std::vector<Ref<CacheableT>> objects;
+    for (size_t i = 0; i < kNumObjects; i++) {
+        objects.push_back(AcquireRef(new CacheableT(i)));
+        objects.back()->SetDeleteFn([&](CacheableT* x) { cache.Erase(x); });
+        EXPECT_TRUE(cache.Insert(objects.back().Get()).second);
+    }
+
+    for (size_t i = 0; i < kNumObjects; i++) {
+        EXPECT_FALSE(cache.Empty());
+        CacheableT blueprint(i);
+        EXPECT_EQ(cache.Find(&blueprint).Get(), objects[i].Get());
+        objects[i] = nullptr;
+        EXPECT_EQ(cache.Find(&blueprint).Get(), nullptr);
+    }
+    EXPECT_TRUE(cache.Empty());
+}
+
 // Inserting and finding elements should respect the results from the insert call.
 TEST(ContentLessObjectCacheTest, InsertingAndFinding) {
     constexpr size_t kNumObjects = 100;
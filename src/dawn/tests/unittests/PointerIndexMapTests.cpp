@@ -0,0 +1,95 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <vector>
+
+#include "dawn/common/PointerIndexMap.h"
+#include "gtest/gtest.h"
+
+namespace dawn {
+namespace {
+
+// Test that keys are given dense indices in insertion order, and that inserting a key again
+// returns its existing index.
+TEST(PointerIndexMap, Insert) {
+    int values[3];
+    PointerIndexMap<int> map;
+    ASSERT_TRUE(map.Empty());
+
+    EXPECT_EQ(map.Insert(&values[2]), std::make_pair(size_t(0), true));
+    EXPECT_EQ(map.Insert(&values[0]), std::make_pair(size_t(1), true));
+    EXPECT_EQ(map.Insert(&values[2]), std::make_pair(size_t(0), false));
+    EXPECT_EQ(map.Insert(&values[1]), std::make_pair(size_t(2), true));
+    EXPECT_EQ(map.Insert(&values[0]), std::make_pair(size_t(1), false));
+    EXPECT_EQ(map.Size(), 3u);
+}
+
+// Test Find on present and missing keys.
+TEST(PointerIndexMap, Find) {
+    int values[2];
+    PointerIndexMap<int> map;
+    EXPECT_EQ(map.Find(&values[0]), PointerIndexMap<int>::kNotFound);
+
+    map.Insert(&values[1]);
+    EXPECT_EQ(map.Find(&values[1]), 0u);
+    EXPECT_EQ(map.Find(&values[0]), PointerIndexMap<int>::kNotFound);
+}
+
+// Test that the map keeps all its keys when it grows past its initial storage.
+TEST(PointerIndexMap, Grow) {
+    std::vector<int> values(1000);
+    PointerIndexMap<int> map;
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(map.Insert(&values[i]), std::make_pair(i, true));
+    }
+    EXPECT_EQ(map.Size(), values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(map.Find(&values[i]), i);
+        EXPECT_EQ(map.Insert(&values[i]), std::make_pair(i, false));
+    }
+}
+
+// Test that Clear removes all the keys and that the map can be reused.
+TEST(PointerIndexMap, Clear) {
+    std::vector<int> values(100);
+    PointerIndexMap<int> map;
+    for (int& value : values) {
+        map.Insert(&value);
+    }
+
+    map.Clear();
+    EXPECT_TRUE(map.Empty());
+    EXPECT_EQ(map.Find(&values[0]), PointerIndexMap<int>::kNotFound);
+
+    EXPECT_EQ(map.Insert(&values[50]), std::make_pair(size_t(0), true));
+    EXPECT_EQ(map.Insert(&values[0]), std::make_pair(size_t(1), true));
+    EXPECT_EQ(map.Size(), 2u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,248 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dawn/utils/SharedMemoryRingBuffer.h"
+#include "gtest/gtest.h"
+
+namespace dawn::utils {
+namespace {
+
+// A CommandHandler that records the commands it receives, and how they were batched.
+class RecordingHandler : public dawn::wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        if (mFail) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            mBytes.push_back(static_cast<char>(commands[i]));
+        }
+        mBatchCount++;
+        return commands + size;
+    }
+
+    std::vector<char> mBytes;
+    size_t mBatchCount = 0;
+    bool mFail = false;
+};
+
+// Serializes |size| bytes, all with the value |value|.
+bool WriteCommand(RingBufferCommandSerializer* serializer, size_t size, char value) {
+    void* space = serializer->GetCmdSpace(size);
+    if (space == nullptr) {
+        return false;
+    }
+    memset(space, value, size);
+    return true;
+}
+
+// The capacity must be a power of two of at least 4096.
+TEST(SharedMemoryRingBufferTests, Create) {
+    EXPECT_EQ(SharedMemoryRingBuffer::Create(1024), nullptr);
+    EXPECT_EQ(SharedMemoryRingBuffer::Create(4096 + 8), nullptr);
+
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(4096);
+    ASSERT_NE(ring, nullptr);
+    EXPECT_EQ(ring->GetCapacity(), 4096u);
+    EXPECT_GE(ring->GetFd(), 0);
+    EXPECT_FALSE(ring->IsClosed());
+}
+
+// Commands are only visible to the receiver once they are flushed, and the commands serialized
+// between two flushes are handled as a single batch.
+TEST(SharedMemoryRingBufferTests, FlushPublishesBatch) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(4096);
+    RecordingHandler handler;
+    RingBufferCommandSerializer serializer(ring.get());
+    RingBufferCommandReceiver receiver(ring.get(), &handler);
+
+    ASSERT_TRUE(WriteCommand(&serializer, 12, 'a'));
+    ASSERT_TRUE(WriteCommand(&serializer, 20, 'b'));
+    EXPECT_TRUE(receiver.HandleCommands());
+    EXPECT_EQ(handler.mBatchCount, 0u);
+
+    EXPECT_TRUE(serializer.Flush());
+    EXPECT_TRUE(receiver.WaitForCommands());
+    EXPECT_TRUE(receiver.HandleCommands());
+    EXPECT_EQ(handler.mBatchCount, 1u);
+
+    std::vector<char> expected(12, 'a');
+    expected.insert(expected.end(), 20, 'b');
+    EXPECT_EQ(handler.mBytes, expected);
+}
+
+// Allocations larger than the maximum allocation size fail.
+TEST(SharedMemoryRingBufferTests, MaximumAllocationSize) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(4096);
+    RingBufferCommandSerializer serializer(ring.get());
+
+    size_t maxSize = serializer.GetMaximumAllocationSize();
+    EXPECT_EQ(serializer.GetCmdSpace(maxSize + 1), nullptr);
+    EXPECT_NE(serializer.GetCmdSpace(maxSize), nullptr);
+}
+
+// Commands of varying sizes keep their content when they wrap around the end of the ring.
+TEST(SharedMemoryRingBufferTests, WrapAround) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(4096);
+    RecordingHandler handler;
+    RingBufferCommandSerializer serializer(ring.get());
+    RingBufferCommandReceiver receiver(ring.get(), &handler);
+
+    std::vector<char> expected;
+    for (size_t i = 0; i < 200; ++i) {
+        size_t size = 1 + (i * 37) % 700;
+        char value = static_cast<char>(i);
+        ASSERT_TRUE(WriteCommand(&serializer, size, value));
+        expected.insert(expected.end(), size, value);
+        if (i % 3 == 0) {
+            ASSERT_TRUE(serializer.Flush());
+            ASSERT_TRUE(receiver.HandleCommands());
+        }
+    }
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(receiver.HandleCommands());
+    EXPECT_EQ(handler.mBytes, expected);
+}
+
+// A producer that is faster than the consumer blocks until space is freed, and no command is
+// lost or reordered.
+TEST(SharedMemoryRingBufferTests, Backpressure) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(4096);
+    RecordingHandler handler;
+    RingBufferCommandReceiver receiver(ring.get(), &handler);
+
+    constexpr size_t kCommandCount = 20000;
+    std::thread producer([&] {
+        RingBufferCommandSerializer serializer(ring.get());
+        for (size_t i = 0; i < kCommandCount; ++i) {
+            uint32_t* command = static_cast<uint32_t*>(serializer.GetCmdSpace(sizeof(uint32_t)));
+            ASSERT_NE(command, nullptr);
+            *command = static_cast<uint32_t>(i);
+            if (i % 64 == 0) {
+                serializer.Flush();
+            }
+        }
+        serializer.Flush();
+        ring->Close();
+    });
+
+    while (receiver.WaitForCommands()) {
+        ASSERT_TRUE(receiver.HandleCommands());
+    }
+    producer.join();
+
+    ASSERT_EQ(handler.mBytes.size(), kCommandCount * sizeof(uint32_t));
+    for (size_t i = 0; i < kCommandCount; ++i) {
+        uint32_t value;
+        memcpy(&value, &handler.mBytes[i * sizeof(uint32_t)], sizeof(uint32_t));
+        ASSERT_EQ(value, i);
+    }
+}
+
+// The ring buffer can be imported from its file descriptor, and both mappings see the same
+// commands.
+TEST(SharedMemoryRingBufferTests, Import) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(8192);
+    std::unique_ptr<SharedMemoryRingBuffer> imported =
+        SharedMemoryRingBuffer::Import(dup(ring->GetFd()));
+    ASSERT_NE(imported, nullptr);
+    EXPECT_EQ(imported->GetCapacity(), 8192u);
+
+    RecordingHandler handler;
+    RingBufferCommandSerializer serializer(ring.get());
+    RingBufferCommandReceiver receiver(imported.get(), &handler);
+    ASSERT_TRUE(WriteCommand(&serializer, 100, 'x'));
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(receiver.HandleCommands());
+    EXPECT_EQ(handler.mBytes, std::vector<char>(100, 'x'));
+
+    imported->Close();
+    EXPECT_TRUE(ring->IsClosed());
+}
+
+// File descriptors that don't contain a ring buffer are rejected.
+TEST(SharedMemoryRingBufferTests, ImportInvalid) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    EXPECT_EQ(SharedMemoryRingBuffer::Import(fds[0]), nullptr);
+    close(fds[1]);
+}
+
+// A failure of the handler closes the ring buffer, which makes the serializer fail.
+TEST(SharedMemoryRingBufferTests, HandlerFailureCloses) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(4096);
+    RecordingHandler handler;
+    handler.mFail = true;
+    RingBufferCommandSerializer serializer(ring.get());
+    RingBufferCommandReceiver receiver(ring.get(), &handler);
+
+    ASSERT_TRUE(WriteCommand(&serializer, 16, 'a'));
+    ASSERT_TRUE(serializer.Flush());
+    EXPECT_FALSE(receiver.HandleCommands());
+    EXPECT_TRUE(ring->IsClosed());
+    EXPECT_EQ(serializer.GetCmdSpace(16), nullptr);
+    EXPECT_FALSE(serializer.Flush());
+}
+
+// Closing the ring buffer wakes up a receiver waiting for commands.
+TEST(SharedMemoryRingBufferTests, CloseWakesReceiver) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(4096);
+    RecordingHandler handler;
+    RingBufferCommandReceiver receiver(ring.get(), &handler);
+
+    std::thread consumer([&] { EXPECT_FALSE(receiver.WaitForCommands()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ring->Close();
+    consumer.join();
+}
+
+// Closing the ring buffer wakes up a serializer waiting for space.
+TEST(SharedMemoryRingBufferTests, CloseWakesSerializer) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(4096);
+    RingBufferCommandSerializer serializer(ring.get());
+
+    std::thread producer([&] {
+        size_t size = serializer.GetMaximumAllocationSize();
+        while (WriteCommand(&serializer, size, 'a')) {
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ring->Close();
+    producer.join();
+}
+
+}  // anonymous namespace
+}  // namespace dawn::utils
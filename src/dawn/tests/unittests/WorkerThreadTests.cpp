@@ -0,0 +1,193 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// WorkerThreadTests:
+//     Tests for the fixed-size worker pool returned by Platform::CreateWorkerTaskPool().
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/WorkerThread.h"
+#include "gtest/gtest.h"
+
+namespace dawn {
+namespace {
+
+using platform::AsyncWorkerThreadPool;
+using platform::WaitableEvent;
+using platform::WorkerTaskPriority;
+
+void IncrementCounter(void* userdata) {
+    static_cast<std::atomic<uint32_t>*>(userdata)->fetch_add(1);
+}
+
+// A task that blocks its worker until Open() is called.
+class Gate {
+  public:
+    static void Run(void* userdata) {
+        Gate* gate = static_cast<Gate*>(userdata);
+        std::unique_lock<std::mutex> lock(gate->mMutex);
+        gate->mCondition.wait(lock, [gate] { return gate->mIsOpen; });
+    }
+
+    void Open() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mIsOpen = true;
+        }
+        mCondition.notify_all();
+    }
+
+  private:
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mIsOpen = false;
+};
+
+// Records the order in which tasks run.
+struct OrderRecorder {
+    std::mutex mutex;
+    std::vector<uint32_t> order;
+};
+
+struct OrderedTask {
+    OrderRecorder* recorder;
+    uint32_t id;
+
+    static void Run(void* userdata) {
+        OrderedTask* task = static_cast<OrderedTask*>(userdata);
+        std::lock_guard<std::mutex> lock(task->recorder->mutex);
+        task->recorder->order.push_back(task->id);
+    }
+};
+
+// Test that the default platform creates a pool with at least one worker.
+TEST(WorkerThreadTests, DefaultThreadCount) {
+    AsyncWorkerThreadPool pool;
+    EXPECT_GE(pool.GetThreadCount(), 1u);
+
+    AsyncWorkerThreadPool singleThreadPool(1);
+    EXPECT_EQ(singleThreadPool.GetThreadCount(), 1u);
+}
+
+// Test that many more tasks than workers all run to completion.
+TEST(WorkerThreadTests, ManyTasks) {
+    AsyncWorkerThreadPool pool(4);
+    std::atomic<uint32_t> counter{0};
+
+    constexpr uint32_t kTaskCount = 1000;
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        events.push_back(pool.PostWorkerTask(IncrementCounter, &counter));
+    }
+    for (auto& event : events) {
+        event->Wait();
+        EXPECT_TRUE(event->IsComplete());
+    }
+    EXPECT_EQ(counter.load(), kTaskCount);
+}
+
+// Test that the WaitableEvent can be waited on after the task has already completed and that the
+// pool runs the pending tasks before being destroyed.
+TEST(WorkerThreadTests, DestructionRunsPendingTasks) {
+    std::atomic<uint32_t> counter{0};
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    {
+        AsyncWorkerThreadPool pool(2);
+        for (uint32_t i = 0; i < 100; ++i) {
+            events.push_back(pool.PostWorkerTask(IncrementCounter, &counter));
+        }
+    }
+    EXPECT_EQ(counter.load(), 100u);
+    for (auto& event : events) {
+        EXPECT_TRUE(event->IsComplete());
+        event->Wait();
+    }
+}
+
+// Test that tasks posted from a worker task are run.
+TEST(WorkerThreadTests, PostFromWorker) {
+    AsyncWorkerThreadPool pool(2);
+    std::atomic<uint32_t> counter{0};
+
+    struct Context {
+        AsyncWorkerThreadPool* pool;
+        std::atomic<uint32_t>* counter;
+        std::unique_ptr<WaitableEvent> innerEvent;
+    } context = {&pool, &counter, nullptr};
+
+    std::unique_ptr<WaitableEvent> outerEvent = pool.PostWorkerTask(
+        [](void* userdata) {
+            Context* context = static_cast<Context*>(userdata);
+            context->innerEvent = context->pool->PostWorkerTask(IncrementCounter, context->counter);
+        },
+        &context);
+    outerEvent->Wait();
+    context.innerEvent->Wait();
+    EXPECT_EQ(counter.load(), 1u);
+}
+
+// Test that Normal tasks run before Background tasks that were posted before them.
+TEST(WorkerThreadTests, NormalPriorityRunsFirst) {
+    AsyncWorkerThreadPool pool(1);
+
+    // Block the only worker so that the following tasks are all queued when it picks the next one.
+    Gate gate;
+    std::unique_ptr<WaitableEvent> gateEvent = pool.PostWorkerTask(Gate::Run, &gate);
+
+    OrderRecorder recorder;
+    OrderedTask background0 = {&recorder, 0};
+    OrderedTask background1 = {&recorder, 1};
+    OrderedTask normal2 = {&recorder, 2};
+    OrderedTask normal3 = {&recorder, 3};
+
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    events.push_back(pool.PostWorkerTaskWithPriority(OrderedTask::Run, &background0,
+                                                     WorkerTaskPriority::Background));
+    events.push_back(pool.PostWorkerTaskWithPriority(OrderedTask::Run, &background1,
+                                                     WorkerTaskPriority::Background));
+    events.push_back(
+        pool.PostWorkerTaskWithPriority(OrderedTask::Run, &normal2, WorkerTaskPriority::Normal));
+    events.push_back(pool.PostWorkerTask(OrderedTask::Run, &normal3));
+
+    gate.Open();
+    for (auto& event : events) {
+        event->Wait();
+    }
+    gateEvent->Wait();
+
+    EXPECT_EQ(recorder.order, std::vector<uint32_t>({2, 3, 0, 1}));
+}
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,253 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dawn/common/Platform.h"
+#include "dawn/native/FileBlobStore.h"
+#include "gtest/gtest.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace dawn::native {
+namespace {
+
+#if DAWN_PLATFORM_IS(POSIX)
+
+class FileBlobStoreTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        const char* tmp = getenv("TMPDIR");
+        std::string pattern = std::string(tmp != nullptr ? tmp : "/tmp") + "/dawn_blobs_XXXXXX";
+        ASSERT_NE(mkdtemp(pattern.data()), nullptr);
+        mDirectory = pattern;
+    }
+
+    void TearDown() override {
+        if (DIR* dir = opendir(mDirectory.c_str())) {
+            while (dirent* entry = readdir(dir)) {
+                if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+                    unlink((mDirectory + "/" + entry->d_name).c_str());
+                }
+            }
+            closedir(dir);
+        }
+        rmdir(mDirectory.c_str());
+    }
+
+    void Store(FileBlobStore* store, const std::string& key, const std::string& value) {
+        store->Store(key.data(), key.size(), value.data(), value.size());
+    }
+
+    std::string Load(FileBlobStore* store, const std::string& key) {
+        Blob blob = store->Load(key.data(), key.size());
+        return std::string(reinterpret_cast<const char*>(blob.Data()), blob.Size());
+    }
+
+    // Appends `size` bytes to each of the shard files.
+    void AppendToShardFiles(size_t size) {
+        std::vector<char> data(size, 'x');
+        for (size_t i = 0; i < FileBlobStore::kShardCount; ++i) {
+            std::string path = mDirectory + "/blobs" + std::to_string(i);
+            int fd = open(path.c_str(), O_WRONLY | O_APPEND);
+            ASSERT_GE(fd, 0);
+            ASSERT_EQ(write(fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+            close(fd);
+        }
+    }
+
+    std::string mDirectory;
+};
+
+// Test that stored values can be loaded, and that missing keys load empty blobs.
+TEST_F(FileBlobStoreTests, StoreAndLoad) {
+    auto store = FileBlobStore::Create(mDirectory, 0);
+    ASSERT_NE(store, nullptr);
+
+    EXPECT_TRUE(store->Load("missing", 7).Empty());
+    Store(store.get(), "key1", "value1");
+    Store(store.get(), "key2", "value2");
+    EXPECT_EQ(Load(store.get(), "key1"), "value1");
+    EXPECT_EQ(Load(store.get(), "key2"), "value2");
+    EXPECT_EQ(store->GetEntryCountForTesting(), 2u);
+}
+
+// Test that storing a key again replaces its value, and that storing the same value again does not
+// grow the files.
+TEST_F(FileBlobStoreTests, Replace) {
+    auto store = FileBlobStore::Create(mDirectory, 0);
+    ASSERT_NE(store, nullptr);
+
+    Store(store.get(), "key", "value1");
+    uint64_t size = store->GetFileSizeForTesting();
+    Store(store.get(), "key", "value1");
+    EXPECT_EQ(store->GetFileSizeForTesting(), size);
+
+    Store(store.get(), "key", "a longer value");
+    EXPECT_EQ(Load(store.get(), "key"), "a longer value");
+    EXPECT_EQ(store->GetEntryCountForTesting(), 1u);
+}
+
+// Test that values persist when the store is reopened.
+TEST_F(FileBlobStoreTests, Persistence) {
+    {
+        auto store = FileBlobStore::Create(mDirectory, 0);
+        ASSERT_NE(store, nullptr);
+        Store(store.get(), "key1", "value1");
+        Store(store.get(), "key2", "value2");
+        Store(store.get(), "key1", "value3");
+    }
+
+    auto store = FileBlobStore::Create(mDirectory, 0);
+    ASSERT_NE(store, nullptr);
+    EXPECT_EQ(store->GetEntryCountForTesting(), 2u);
+    EXPECT_EQ(Load(store.get(), "key1"), "value3");
+    EXPECT_EQ(Load(store.get(), "key2"), "value2");
+}
+
+// Test that a directory can only be used by one store at a time.
+TEST_F(FileBlobStoreTests, DirectoryInUse) {
+    auto store = FileBlobStore::Create(mDirectory, 0);
+    ASSERT_NE(store, nullptr);
+    EXPECT_EQ(FileBlobStore::Create(mDirectory, 0), nullptr);
+
+    store = nullptr;
+    EXPECT_NE(FileBlobStore::Create(mDirectory, 0), nullptr);
+}
+
+// Test that partially written records at the end of the files are discarded on open.
+TEST_F(FileBlobStoreTests, PartialRecordsAreDiscarded) {
+    uint64_t size = 0;
+    {
+        auto store = FileBlobStore::Create(mDirectory, 0);
+        ASSERT_NE(store, nullptr);
+        for (int i = 0; i < 64; ++i) {
+            Store(store.get(), "key" + std::to_string(i), "value" + std::to_string(i));
+        }
+        size = store->GetFileSizeForTesting();
+    }
+    AppendToShardFiles(13);
+
+    auto store = FileBlobStore::Create(mDirectory, 0);
+    ASSERT_NE(store, nullptr);
+    EXPECT_EQ(store->GetFileSizeForTesting(), size);
+    EXPECT_EQ(store->GetEntryCountForTesting(), 64u);
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_EQ(Load(store.get(), "key" + std::to_string(i)), "value" + std::to_string(i));
+    }
+
+    // New records are appended after the last valid one.
+    Store(store.get(), "new key", "new value");
+    store = nullptr;
+    store = FileBlobStore::Create(mDirectory, 0);
+    ASSERT_NE(store, nullptr);
+    EXPECT_EQ(Load(store.get(), "new key"), "new value");
+    EXPECT_EQ(store->GetEntryCountForTesting(), 65u);
+}
+
+// Test that the files stay within the size budget, evicting the least recently used values.
+TEST_F(FileBlobStoreTests, EvictsLeastRecentlyUsed) {
+    constexpr uint64_t kMaxSize = FileBlobStore::kShardCount * 4096;
+    auto store = FileBlobStore::Create(mDirectory, kMaxSize);
+    ASSERT_NE(store, nullptr);
+
+    const std::string value(500, 'v');
+    Store(store.get(), "recent", value);
+    for (int i = 0; i < 1000; ++i) {
+        Store(store.get(), "key" + std::to_string(i), value);
+        ASSERT_EQ(Load(store.get(), "recent"), value);
+        ASSERT_LE(store->GetFileSizeForTesting(), kMaxSize);
+    }
+    EXPECT_LT(store->GetEntryCountForTesting(), 1000u);
+    EXPECT_EQ(Load(store.get(), "key999"), value);
+    EXPECT_TRUE(store->Load("key0", 4).Empty());
+
+    // Values that don't fit in a shard are not stored.
+    Store(store.get(), "big", std::string(4096, 'b'));
+    EXPECT_TRUE(store->Load("big", 3).Empty());
+
+    // Reopening with a smaller budget evicts values.
+    store = nullptr;
+    store = FileBlobStore::Create(mDirectory, kMaxSize / 2);
+    ASSERT_NE(store, nullptr);
+    EXPECT_LE(store->GetFileSizeForTesting(), kMaxSize / 2);
+}
+
+// Test that budgets too small to hold the shards' file headers are raised to the minimum, and still
+// bound the size of the files and of the stored values.
+TEST_F(FileBlobStoreTests, SmallMaxSize) {
+    auto store = FileBlobStore::Create(mDirectory, FileBlobStore::kShardCount);
+    ASSERT_NE(store, nullptr);
+
+    Store(store.get(), "big", std::string(FileBlobStore::kMinMaxSize, 'b'));
+    EXPECT_TRUE(store->Load("big", 3).Empty());
+
+    const std::string value(100, 'v');
+    for (int i = 0; i < 1000; ++i) {
+        Store(store.get(), "key" + std::to_string(i), value);
+        ASSERT_LE(store->GetFileSizeForTesting(), FileBlobStore::kMinMaxSize);
+    }
+    EXPECT_EQ(Load(store.get(), "key999"), value);
+}
+
+// Test loads and stores from multiple threads.
+TEST_F(FileBlobStoreTests, Concurrency) {
+    auto store = FileBlobStore::Create(mDirectory, 0);
+    ASSERT_NE(store, nullptr);
+
+    constexpr int kThreadCount = 4;
+    constexpr int kKeyCount = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kKeyCount; ++i) {
+                std::string key = std::to_string(t) + "-" + std::to_string(i);
+                Store(store.get(), key, "value" + key);
+                EXPECT_EQ(Load(store.get(), key), "value" + key);
+                // Also read the values written by the other threads.
+                Load(store.get(), std::to_string((t + 1) % kThreadCount) + "-" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(store->GetEntryCountForTesting(), static_cast<size_t>(kThreadCount * kKeyCount));
+}
+
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+}  // namespace
+}  // namespace dawn::native
@@ -0,0 +1,357 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "dawn/native/PipelineLayout.h"
+#include "dawn/tests/unittests/validation/ValidationTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+// Tests that the bind group validation done before draws stays correct when the compatibility of
+// the bind groups with the current pipeline is remembered across draws.
+class BindGroupStateTrackingValidationTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+
+        mVsModule = utils::CreateShaderModule(device, R"(
+            @vertex fn main() -> @builtin(position) vec4f {
+                return vec4f();
+            })");
+
+        mStorageLayout =
+            utils::MakeBindGroupLayout(device, {{0, wgpu::ShaderStage::Fragment,
+                                                 wgpu::BufferBindingType::Storage}});
+        mUniformLayout =
+            utils::MakeBindGroupLayout(device, {{0, wgpu::ShaderStage::Fragment,
+                                                 wgpu::BufferBindingType::Uniform}});
+        mReadOnlyStorageLayout =
+            utils::MakeBindGroupLayout(device, {{0, wgpu::ShaderStage::Fragment,
+                                                 wgpu::BufferBindingType::ReadOnlyStorage}});
+    }
+
+    wgpu::Buffer CreateBuffer(uint64_t size = 1024) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::Uniform;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    // Creates a bind group with a single buffer binding of a new buffer.
+    wgpu::BindGroup CreateBindGroup(const wgpu::BindGroupLayout& layout, uint64_t size = 256) {
+        return utils::MakeBindGroup(device, layout, {{0, CreateBuffer(), 0, size}});
+    }
+
+    wgpu::RenderPipeline CreateRenderPipeline(std::vector<wgpu::BindGroupLayout> bgls,
+                                              const char* fragmentShader = R"(
+            @fragment fn main() {
+            })") {
+        utils::ComboRenderPipelineDescriptor descriptor;
+        descriptor.layout = utils::MakePipelineLayout(device, std::move(bgls));
+        descriptor.vertex.module = mVsModule;
+        descriptor.cFragment.module = utils::CreateShaderModule(device, fragmentShader);
+        descriptor.cTargets[0].writeMask = wgpu::ColorWriteMask::None;
+        return device.CreateRenderPipeline(&descriptor);
+    }
+
+    bool MayHaveWritableBindingAliasing(std::vector<wgpu::BindGroupLayout> bgls) {
+        wgpu::PipelineLayout layout = utils::MakePipelineLayout(device, std::move(bgls));
+        return native::FromAPI(layout.Get())->MayHaveWritableBindingAliasing();
+    }
+
+    wgpu::ShaderModule mVsModule;
+    wgpu::BindGroupLayout mStorageLayout;
+    wgpu::BindGroupLayout mUniformLayout;
+    wgpu::BindGroupLayout mReadOnlyStorageLayout;
+};
+
+// Test that replacing a bind group with one of an incompatible layout after a successful draw
+// makes the next draw fail.
+TEST_F(BindGroupStateTrackingValidationTest, IncompatibleBindGroupAfterDraw) {
+    wgpu::RenderPipeline pipeline = CreateRenderPipeline({mStorageLayout, mUniformLayout});
+    wgpu::BindGroup group0 = CreateBindGroup(mStorageLayout);
+    wgpu::BindGroup group1 = CreateBindGroup(mUniformLayout);
+    wgpu::BindGroup otherGroup1 = CreateBindGroup(mUniformLayout);
+    wgpu::BindGroup incompatibleGroup1 = CreateBindGroup(mReadOnlyStorageLayout);
+
+    PlaceholderRenderPass renderPass(device);
+
+    // Control case: replacing the group with a compatible one is valid.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, group0);
+        pass.SetBindGroup(1, group1);
+        pass.Draw(3);
+        pass.SetBindGroup(1, otherGroup1);
+        pass.Draw(3);
+        pass.End();
+        encoder.Finish();
+    }
+
+    // Replacing the group with an incompatible one makes the next draw fail.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, group0);
+        pass.SetBindGroup(1, group1);
+        pass.Draw(3);
+        pass.SetBindGroup(1, incompatibleGroup1);
+        pass.Draw(3);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // Setting the compatible group back before drawing is valid again.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, group0);
+        pass.SetBindGroup(1, group1);
+        pass.Draw(3);
+        pass.SetBindGroup(1, incompatibleGroup1);
+        pass.SetBindGroup(1, group1);
+        pass.Draw(3);
+        pass.End();
+        encoder.Finish();
+    }
+}
+
+// Test that setting the same bind group again with dynamic offsets that make its writable bindings
+// alias makes the next draw fail, even though the bind group itself is still compatible.
+TEST_F(BindGroupStateTrackingValidationTest, SameBindGroupWithAliasingDynamicOffsets) {
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Storage, true},
+                 {1, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Storage, true}});
+    wgpu::RenderPipeline pipeline = CreateRenderPipeline({layout});
+
+    wgpu::Buffer buffer = CreateBuffer();
+    wgpu::BindGroup group =
+        utils::MakeBindGroup(device, layout, {{0, buffer, 0, 16}, {1, buffer, 0, 16}});
+
+    constexpr std::array<uint32_t, 2> kOffsets = {0, 256};
+    constexpr std::array<uint32_t, 2> kOtherOffsets = {256, 512};
+    constexpr std::array<uint32_t, 2> kAliasingOffsets = {256, 256};
+
+    PlaceholderRenderPass renderPass(device);
+
+    // Control case: new dynamic offsets that don't alias are valid.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, group, kOffsets.size(), kOffsets.data());
+        pass.Draw(3);
+        pass.SetBindGroup(0, group, kOtherOffsets.size(), kOtherOffsets.data());
+        pass.Draw(3);
+        pass.End();
+        encoder.Finish();
+    }
+
+    // New dynamic offsets that alias make the next draw fail.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, group, kOffsets.size(), kOffsets.data());
+        pass.Draw(3);
+        pass.SetBindGroup(0, group, kAliasingOffsets.size(), kAliasingOffsets.data());
+        pass.Draw(3);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+}
+
+// Test that setting a new pipeline checks every bind group again, including the ones that were
+// already found compatible with the previous pipeline.
+TEST_F(BindGroupStateTrackingValidationTest, NewPipelineChecksEveryBindGroup) {
+    wgpu::BindGroup group0 = CreateBindGroup(mStorageLayout);
+    wgpu::BindGroup group1 = CreateBindGroup(mUniformLayout);
+
+    PlaceholderRenderPass renderPass(device);
+
+    // The new pipeline's layout doesn't match the unchanged group 1.
+    {
+        wgpu::RenderPipeline pipeline = CreateRenderPipeline({mStorageLayout, mUniformLayout});
+        wgpu::RenderPipeline otherPipeline =
+            CreateRenderPipeline({mStorageLayout, mReadOnlyStorageLayout});
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, group0);
+        pass.SetBindGroup(1, group1);
+        pass.Draw(3);
+        pass.SetPipeline(otherPipeline);
+        pass.Draw(3);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // The new pipeline requires a larger binding than the unchanged group 0 has.
+    {
+        wgpu::RenderPipeline pipeline = CreateRenderPipeline({mStorageLayout});
+        wgpu::RenderPipeline largerPipeline = CreateRenderPipeline({mStorageLayout}, R"(
+            @group(0) @binding(0) var<storage, read_write> a : array<vec4f, 16>;
+            @fragment fn main() {
+                a[0] = vec4f();
+            })");
+        wgpu::BindGroup smallGroup0 = CreateBindGroup(mStorageLayout, 16);
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, smallGroup0);
+        pass.Draw(3);
+        pass.SetPipeline(largerPipeline);
+        pass.Draw(3);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // The new pipeline uses a group that aliases with the unchanged group 0.
+    {
+        wgpu::Buffer buffer = CreateBuffer();
+        wgpu::BindGroup aliasingGroup0 =
+            utils::MakeBindGroup(device, mStorageLayout, {{0, buffer, 0, 16}});
+        wgpu::BindGroup aliasingGroup1 =
+            utils::MakeBindGroup(device, mStorageLayout, {{0, buffer, 0, 16}});
+        wgpu::RenderPipeline pipeline = CreateRenderPipeline({mStorageLayout});
+        wgpu::RenderPipeline twoGroupPipeline =
+            CreateRenderPipeline({mStorageLayout, mStorageLayout});
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, aliasingGroup0);
+        pass.SetBindGroup(1, aliasingGroup1);
+        pass.Draw(3);
+        pass.SetPipeline(twoGroupPipeline);
+        pass.Draw(3);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // Control case: setting a pipeline with the same layouts is valid.
+    {
+        wgpu::RenderPipeline pipeline = CreateRenderPipeline({mStorageLayout, mUniformLayout});
+        wgpu::RenderPipeline otherPipeline = CreateRenderPipeline({mStorageLayout, mUniformLayout});
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, group0);
+        pass.SetBindGroup(1, group1);
+        pass.Draw(3);
+        pass.SetPipeline(otherPipeline);
+        pass.Draw(3);
+        pass.End();
+        encoder.Finish();
+    }
+}
+
+// Test that only layouts with at least two writable storage buffer bindings or two writable
+// storage texture bindings need to check for aliasing.
+TEST_F(BindGroupStateTrackingValidationTest, MayHaveWritableBindingAliasing) {
+    wgpu::BindGroupLayout storageTextureLayout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::StorageTextureAccess::WriteOnly,
+                  wgpu::TextureFormat::R32Float}});
+
+    // No writable bindings.
+    EXPECT_FALSE(MayHaveWritableBindingAliasing({}));
+    EXPECT_FALSE(MayHaveWritableBindingAliasing({mUniformLayout, mReadOnlyStorageLayout}));
+
+    // A single writable binding.
+    EXPECT_FALSE(MayHaveWritableBindingAliasing({mStorageLayout}));
+    EXPECT_FALSE(MayHaveWritableBindingAliasing({storageTextureLayout}));
+    EXPECT_FALSE(MayHaveWritableBindingAliasing({mStorageLayout, mReadOnlyStorageLayout}));
+
+    // One writable binding of each kind can't alias.
+    EXPECT_FALSE(MayHaveWritableBindingAliasing({mStorageLayout, storageTextureLayout}));
+
+    // Two or more writable bindings of the same kind, in the same group or in different groups.
+    wgpu::BindGroupLayout twoStorageLayout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Storage},
+                 {1, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Storage}});
+    EXPECT_TRUE(MayHaveWritableBindingAliasing({twoStorageLayout}));
+    EXPECT_TRUE(MayHaveWritableBindingAliasing({mStorageLayout, mStorageLayout}));
+    EXPECT_TRUE(MayHaveWritableBindingAliasing({mStorageLayout, mUniformLayout, mStorageLayout}));
+    EXPECT_TRUE(MayHaveWritableBindingAliasing({storageTextureLayout, storageTextureLayout}));
+}
+
+// Test that draws with layouts that skip the aliasing check are still valid, while layouts with
+// two writable bindings still report aliasing.
+TEST_F(BindGroupStateTrackingValidationTest, AliasingCheckedOnlyWithMultipleWritableBindings) {
+    wgpu::Buffer buffer = CreateBuffer();
+    wgpu::BindGroup storageGroup =
+        utils::MakeBindGroup(device, mStorageLayout, {{0, buffer, 0, 16}});
+    wgpu::BindGroup otherStorageGroup =
+        utils::MakeBindGroup(device, mStorageLayout, {{0, buffer, 0, 16}});
+    wgpu::BindGroup uniformGroup = CreateBindGroup(mUniformLayout);
+
+    PlaceholderRenderPass renderPass(device);
+
+    // A single writable binding never aliases.
+    {
+        wgpu::RenderPipeline pipeline = CreateRenderPipeline({mStorageLayout, mUniformLayout});
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, storageGroup);
+        pass.SetBindGroup(1, uniformGroup);
+        pass.Draw(3);
+        pass.End();
+        encoder.Finish();
+    }
+
+    // Two writable bindings of the same buffer range alias.
+    {
+        wgpu::RenderPipeline pipeline = CreateRenderPipeline({mStorageLayout, mStorageLayout});
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, storageGroup);
+        pass.SetBindGroup(1, otherStorageGroup);
+        pass.Draw(3);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,276 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "dawn/tests/unittests/validation/ValidationTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+class RenderPassSubEncoderDisabledTest : public ValidationTest {};
+
+// Check that creating a sub-encoder is disallowed without the feature.
+TEST_F(RenderPassSubEncoderDisabledTest, CreateSubEncoderNotAllowed) {
+    utils::BasicRenderPass rp = utils::CreateBasicRenderPass(device, 1, 1);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+    pass.CreateSubEncoder();
+    pass.End();
+    ASSERT_DEVICE_ERROR(encoder.Finish());
+}
+
+class RenderPassSubEncoderTest : public ValidationTest {
+  protected:
+    WGPUDevice CreateTestDevice(native::Adapter dawnAdapter,
+                                wgpu::DeviceDescriptor descriptor) override {
+        wgpu::FeatureName requiredFeatures[1] = {wgpu::FeatureName::RenderPassSubEncoders};
+        descriptor.requiredFeatures = requiredFeatures;
+        descriptor.requiredFeatureCount = 1;
+        return dawnAdapter.CreateDevice(&descriptor);
+    }
+
+    void SetUp() override {
+        ValidationTest::SetUp();
+
+        wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var<storage, read_write> ssbo : array<f32>;
+
+            @vertex fn vs(@location(0) pos : vec4f) -> @builtin(position) vec4f {
+                return pos;
+            }
+
+            @fragment fn fs() -> @location(0) vec4f {
+                ssbo[0] = 1.0;
+                return vec4f();
+            })");
+
+        utils::ComboRenderPipelineDescriptor descriptor;
+        descriptor.vertex.module = module;
+        descriptor.vertex.entryPoint = "vs";
+        descriptor.vertex.bufferCount = 1;
+        descriptor.cBuffers[0].arrayStride = 4 * sizeof(float);
+        descriptor.cBuffers[0].attributeCount = 1;
+        descriptor.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+        descriptor.cFragment.module = module;
+        descriptor.cFragment.entryPoint = "fs";
+        pipeline = device.CreateRenderPipeline(&descriptor);
+
+        vertexBuffer = CreateBuffer(wgpu::BufferUsage::Vertex);
+        storageBuffer = CreateBuffer(wgpu::BufferUsage::Storage);
+        vertexStorageBuffer = CreateBuffer(wgpu::BufferUsage::Vertex | wgpu::BufferUsage::Storage);
+
+        bindGroup =
+            utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, storageBuffer}});
+        vertexStorageBindGroup = utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0),
+                                                      {{0, vertexStorageBuffer}});
+    }
+
+    wgpu::Buffer CreateBuffer(wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = 64;
+        descriptor.usage = usage;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    void RecordDraw(const wgpu::RenderBundleEncoder& encoder,
+                    const wgpu::BindGroup& group,
+                    const wgpu::Buffer& vertices) {
+        encoder.SetPipeline(pipeline);
+        encoder.SetBindGroup(0, group);
+        encoder.SetVertexBuffer(0, vertices);
+        encoder.Draw(3);
+    }
+
+    wgpu::RenderPipeline pipeline;
+    wgpu::Buffer vertexBuffer;
+    wgpu::Buffer storageBuffer;
+    wgpu::Buffer vertexStorageBuffer;
+    wgpu::BindGroup bindGroup;
+    wgpu::BindGroup vertexStorageBindGroup;
+};
+
+// Test that sub-encoders can record draws that are merged into the pass.
+TEST_F(RenderPassSubEncoderTest, Success) {
+    utils::BasicRenderPass rp = utils::CreateBasicRenderPass(device, 1, 1);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+    std::vector<wgpu::RenderBundleEncoder> subEncoders;
+    for (uint32_t i = 0; i < 3; ++i) {
+        subEncoders.push_back(pass.CreateSubEncoder());
+    }
+    for (const wgpu::RenderBundleEncoder& subEncoder : subEncoders) {
+        RecordDraw(subEncoder, bindGroup, vertexBuffer);
+    }
+    pass.End();
+    encoder.Finish();
+}
+
+// Test that the pass's state isn't inherited by sub-encoders.
+TEST_F(RenderPassSubEncoderTest, StateNotInherited) {
+    utils::BasicRenderPass rp = utils::CreateBasicRenderPass(device, 1, 1);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup);
+    pass.SetVertexBuffer(0, vertexBuffer);
+    wgpu::RenderBundleEncoder subEncoder = pass.CreateSubEncoder();
+    subEncoder.Draw(3);
+    pass.End();
+    ASSERT_DEVICE_ERROR(encoder.Finish());
+}
+
+// Test that sub-encoders can't be finished by the application.
+TEST_F(RenderPassSubEncoderTest, FinishNotAllowed) {
+    utils::BasicRenderPass rp = utils::CreateBasicRenderPass(device, 1, 1);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+    wgpu::RenderBundleEncoder subEncoder = pass.CreateSubEncoder();
+    RecordDraw(subEncoder, bindGroup, vertexBuffer);
+    ASSERT_DEVICE_ERROR(subEncoder.Finish());
+
+    // The sub-encoder is still merged into the pass.
+    pass.End();
+    encoder.Finish();
+}
+
+// Test that the sub-encoders of a pass are validated together as a single synchronization scope.
+TEST_F(RenderPassSubEncoderTest, UsagesValidatedAsSinglePass) {
+    utils::BasicRenderPass rp = utils::CreateBasicRenderPass(device, 1, 1);
+
+    // Control case: different buffers are used as storage and vertex buffers.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+        RecordDraw(pass.CreateSubEncoder(), bindGroup, vertexBuffer);
+        RecordDraw(pass.CreateSubEncoder(), vertexStorageBindGroup, vertexBuffer);
+        pass.End();
+        encoder.Finish();
+    }
+
+    // Error case: a buffer is written as storage in one sub-encoder and read as a vertex buffer in
+    // another.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+        RecordDraw(pass.CreateSubEncoder(), bindGroup, vertexStorageBuffer);
+        RecordDraw(pass.CreateSubEncoder(), vertexStorageBindGroup, vertexBuffer);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // Error case: the conflicting usages are split between the pass and a sub-encoder.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+        RecordDraw(pass.CreateSubEncoder(), vertexStorageBindGroup, vertexBuffer);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, bindGroup);
+        pass.SetVertexBuffer(0, vertexStorageBuffer);
+        pass.Draw(3);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+}
+
+// Test that an error in a sub-encoder is reported when its pass ends.
+TEST_F(RenderPassSubEncoderTest, ErrorInSubEncoder) {
+    utils::BasicRenderPass rp = utils::CreateBasicRenderPass(device, 1, 1);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+    RecordDraw(pass.CreateSubEncoder(), bindGroup, vertexBuffer);
+    wgpu::RenderBundleEncoder subEncoder = pass.CreateSubEncoder();
+    subEncoder.PushDebugGroup("Unbalanced");
+    pass.End();
+    ASSERT_DEVICE_ERROR(encoder.Finish());
+}
+
+// Test that the draws of sub-encoders count towards the pass's maxDrawCount.
+TEST_F(RenderPassSubEncoderTest, MaxDrawCount) {
+    utils::BasicRenderPass rp = utils::CreateBasicRenderPass(device, 1, 1);
+    wgpu::RenderPassDescriptorMaxDrawCount maxDrawCount;
+    maxDrawCount.maxDrawCount = 2;
+    rp.renderPassInfo.nextInChain = &maxDrawCount;
+
+    // Control case: the number of draws is equal to maxDrawCount.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+        RecordDraw(pass.CreateSubEncoder(), bindGroup, vertexBuffer);
+        RecordDraw(pass.CreateSubEncoder(), bindGroup, vertexBuffer);
+        pass.End();
+        encoder.Finish();
+    }
+
+    // Error case: the pass and its sub-encoders draw more than maxDrawCount times.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+        RecordDraw(pass.CreateSubEncoder(), bindGroup, vertexBuffer);
+        RecordDraw(pass.CreateSubEncoder(), bindGroup, vertexBuffer);
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, bindGroup);
+        pass.SetVertexBuffer(0, vertexBuffer);
+        pass.Draw(3);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+}
+
+// Test that sub-encoders can't be used after their pass ended.
+TEST_F(RenderPassSubEncoderTest, UseAfterPassEnded) {
+    utils::BasicRenderPass rp = utils::CreateBasicRenderPass(device, 1, 1);
+
+    // Error case: recording in a sub-encoder after the pass ended.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+        wgpu::RenderBundleEncoder subEncoder = pass.CreateSubEncoder();
+        pass.End();
+        ASSERT_DEVICE_ERROR(subEncoder.Draw(3));
+        encoder.Finish();
+    }
+
+    // Error case: creating a sub-encoder after the pass ended.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&rp.renderPassInfo);
+        pass.End();
+        pass.CreateSubEncoder();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -648,6 +648,58 @@ TEST_F(ResourceUsageTrackingTest, BufferWithMultipleSetBindGroupsOnSameIndex) {
     }
 }
 
+// Test that setting the same bind group many times in a render pass is tracked only once, and
+// that a conflict introduced after the repeated group is still detected.
+TEST_F(ResourceUsageTrackingTest, BufferWithSameBindGroupSetRepeatedly) {
+    wgpu::Buffer buffer = CreateBuffer(4, wgpu::BufferUsage::Storage | wgpu::BufferUsage::Index);
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::ReadOnlyStorage}});
+    wgpu::BindGroup bg = utils::MakeBindGroup(device, bgl, {{0, buffer}});
+
+    wgpu::BindGroupLayout writeBGL = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Storage}});
+    wgpu::BindGroup writeBG = utils::MakeBindGroup(device, writeBGL, {{0, buffer}});
+
+    PlaceholderRenderPass PlaceholderRenderPass(device);
+
+    // Repeated read-only uses of the same bind group and the index buffer are allowed.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&PlaceholderRenderPass);
+        pass.SetIndexBuffer(buffer, wgpu::IndexFormat::Uint32);
+        for (uint32_t i = 0; i < 4; ++i) {
+            pass.SetBindGroup(i % 2, bg);
+        }
+        pass.End();
+        encoder.Finish();
+    }
+
+    // A writable binding of the buffer after the repeated bind group is still a conflict.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&PlaceholderRenderPass);
+        for (uint32_t i = 0; i < 4; ++i) {
+            pass.SetBindGroup(0, bg);
+        }
+        pass.SetBindGroup(1, writeBG);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // The same bind group used in a later pass is tracked again for that pass.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&PlaceholderRenderPass);
+        pass.SetBindGroup(0, bg);
+        pass.End();
+        pass = encoder.BeginRenderPass(&PlaceholderRenderPass);
+        pass.SetBindGroup(0, writeBG);
+        pass.SetBindGroup(1, bg);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+}
+
 // Test that it is invalid to have resource usage conflicts even when all bindings are not
 // visible to the programmable pass where it is used.
 TEST_F(ResourceUsageTrackingTest, BufferUsageConflictBetweenInvisibleStagesInBindGroup) {
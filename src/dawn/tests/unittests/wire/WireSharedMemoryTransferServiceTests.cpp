@@ -0,0 +1,353 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "dawn/tests/unittests/wire/WireTest.h"
+#include "dawn/utils/SharedMemory.h"
+#include "dawn/utils/SharedMemoryTransferService.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn::wire {
+namespace {
+
+using testing::_;
+using testing::InvokeWithoutArgs;
+using testing::Return;
+
+constexpr size_t kSharedMemorySize = 64 * 1024;
+
+bool IsInSharedMemory(const utils::SharedMemory* memory, const void* pointer) {
+    const uint8_t* data = static_cast<const uint8_t*>(pointer);
+    return data >= memory->GetData() && data < memory->GetData() + memory->GetSize();
+}
+
+// Tests of buffer mapping through the wire with the shared memory transfer services.
+class WireSharedMemoryTransferServiceTests : public WireTest {
+  public:
+    client::MemoryTransferService* GetClientMemoryTransferService() override {
+        return mClientService.get();
+    }
+    server::MemoryTransferService* GetServerMemoryTransferService() override {
+        return mServerService.get();
+    }
+
+    void SetUp() override {
+        mSharedMemory = utils::SharedMemory::Create(kSharedMemorySize);
+        ASSERT_NE(mSharedMemory, nullptr);
+        mClientService = utils::CreateSharedMemoryClientTransferService(mSharedMemory.get());
+        mServerService = utils::CreateSharedMemoryServerTransferService(mSharedMemory.get());
+        WireTest::SetUp();
+    }
+
+    void TearDown() override {
+        WireTest::TearDown();
+        mClientService = nullptr;
+        mServerService = nullptr;
+        mSharedMemory = nullptr;
+    }
+
+    // Creates a buffer and the API buffer it is backed by.
+    std::pair<WGPUBuffer, WGPUBuffer> CreateBuffer(WGPUBufferUsageFlags usage, uint64_t size) {
+        WGPUBufferDescriptor descriptor = {};
+        descriptor.size = size;
+        descriptor.usage = usage;
+        WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+
+        WGPUBuffer apiBuffer = api.GetNewBuffer();
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+        FlushClient();
+        return {buffer, apiBuffer};
+    }
+
+    // Maps the buffer for reading, with |apiData| as the content of the API buffer, and returns
+    // the mapped pointer.
+    const void* MapRead(WGPUBuffer buffer, WGPUBuffer apiBuffer, uint64_t size, void* apiData) {
+        wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, size, nullptr, nullptr);
+        EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Read, 0, size, _, _))
+            .WillOnce(InvokeWithoutArgs([&] {
+                api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
+            }));
+        EXPECT_CALL(api, BufferGetConstMappedRange(apiBuffer, 0, size)).WillOnce(Return(apiData));
+        FlushClient();
+        FlushServer();
+        return wgpuBufferGetConstMappedRange(buffer, 0, size);
+    }
+
+    void Release(WGPUBuffer buffer, WGPUBuffer apiBuffer) {
+        wgpuBufferRelease(buffer);
+        EXPECT_CALL(api, BufferRelease(apiBuffer));
+        FlushClient();
+    }
+
+    std::unique_ptr<utils::SharedMemory> mSharedMemory;
+    std::unique_ptr<client::MemoryTransferService> mClientService;
+    std::unique_ptr<server::MemoryTransferService> mServerService;
+};
+
+// The data of a read mapping is written by the server directly into the shared memory.
+TEST_F(WireSharedMemoryTransferServiceTests, MapRead) {
+    constexpr uint64_t kSize = 1024;
+    auto [buffer, apiBuffer] = CreateBuffer(WGPUBufferUsage_MapRead, kSize);
+
+    std::vector<uint8_t> apiData(kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+        apiData[i] = static_cast<uint8_t>(i * 7);
+    }
+    const void* mapped = MapRead(buffer, apiBuffer, kSize, apiData.data());
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_TRUE(IsInSharedMemory(mSharedMemory.get(), mapped));
+    EXPECT_EQ(memcmp(mapped, apiData.data(), kSize), 0);
+
+    wgpuBufferUnmap(buffer);
+    EXPECT_CALL(api, BufferUnmap(apiBuffer));
+    FlushClient();
+}
+
+// The data of a write mapping is read by the server directly from the shared memory.
+TEST_F(WireSharedMemoryTransferServiceTests, MapWrite) {
+    constexpr uint64_t kSize = 1024;
+    auto [buffer, apiBuffer] = CreateBuffer(WGPUBufferUsage_MapWrite, kSize);
+
+    std::vector<uint8_t> apiData(kSize, 0xFF);
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kSize, nullptr, nullptr);
+    EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kSize, _, _))
+        .WillOnce(InvokeWithoutArgs([&] {
+            api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
+        }));
+    EXPECT_CALL(api, BufferGetMappedRange(apiBuffer, 0, kSize)).WillOnce(Return(apiData.data()));
+    FlushClient();
+    FlushServer();
+
+    uint8_t* mapped = static_cast<uint8_t*>(wgpuBufferGetMappedRange(buffer, 0, kSize));
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_TRUE(IsInSharedMemory(mSharedMemory.get(), mapped));
+    EXPECT_EQ(mapped[0], 0u);
+    for (size_t i = 0; i < kSize; ++i) {
+        mapped[i] = static_cast<uint8_t>(i * 3);
+    }
+
+    wgpuBufferUnmap(buffer);
+    EXPECT_CALL(api, BufferUnmap(apiBuffer));
+    FlushClient();
+    for (size_t i = 0; i < kSize; ++i) {
+        ASSERT_EQ(apiData[i], static_cast<uint8_t>(i * 3));
+    }
+}
+
+// Buffers that don't fit in the shared memory fall back to copying their data through the wire.
+TEST_F(WireSharedMemoryTransferServiceTests, FallbackWhenFull) {
+    constexpr uint64_t kSize = 2 * kSharedMemorySize;
+    auto [buffer, apiBuffer] = CreateBuffer(WGPUBufferUsage_MapRead, kSize);
+
+    std::vector<uint8_t> apiData(kSize, 42);
+    const void* mapped = MapRead(buffer, apiBuffer, kSize, apiData.data());
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_FALSE(IsInSharedMemory(mSharedMemory.get(), mapped));
+    EXPECT_EQ(memcmp(mapped, apiData.data(), kSize), 0);
+}
+
+// The shared memory of a buffer is reused once the buffer is released on both sides.
+TEST_F(WireSharedMemoryTransferServiceTests, ReuseReleasedMemory) {
+    constexpr uint64_t kSize = kSharedMemorySize / 2;
+    std::vector<uint8_t> apiData(kSize, 1);
+    for (int i = 0; i < 4; ++i) {
+        auto [buffer, apiBuffer] = CreateBuffer(WGPUBufferUsage_MapRead, kSize);
+        const void* mapped = MapRead(buffer, apiBuffer, kSize, apiData.data());
+        EXPECT_TRUE(IsInSharedMemory(mSharedMemory.get(), mapped));
+        Release(buffer, apiBuffer);
+    }
+}
+
+// Helpers to exchange messages with the server process of the multi-process test.
+bool WriteMessage(int fd, const std::vector<uint8_t>& message) {
+    uint64_t size = message.size();
+    return write(fd, &size, sizeof(size)) == sizeof(size) &&
+           write(fd, message.data(), message.size()) == static_cast<ssize_t>(message.size());
+}
+
+bool ReadFully(int fd, void* data, size_t size) {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        ssize_t result = read(fd, bytes, size);
+        if (result <= 0) {
+            return false;
+        }
+        bytes += result;
+        size -= static_cast<size_t>(result);
+    }
+    return true;
+}
+
+bool ReadMessage(int fd, std::vector<uint8_t>* message) {
+    uint64_t size;
+    if (!ReadFully(fd, &size, sizeof(size))) {
+        return false;
+    }
+    message->resize(size);
+    return ReadFully(fd, message->data(), size);
+}
+
+// The server process: maps the shared memory, receives the data written by the client through a
+// write handle, then sends it back reversed through a read handle.
+int RunServerProcess(int sharedMemoryFd, int fromClient, int toClient) {
+    std::unique_ptr<utils::SharedMemory> memory = utils::SharedMemory::Import(sharedMemoryFd);
+    if (memory == nullptr) {
+        return 1;
+    }
+    std::unique_ptr<server::MemoryTransferService> service =
+        utils::CreateSharedMemoryServerTransferService(memory.get());
+
+    std::vector<uint8_t> writeCreateInfo;
+    std::vector<uint8_t> writeUpdateInfo;
+    std::vector<uint8_t> readCreateInfo;
+    if (!ReadMessage(fromClient, &writeCreateInfo) || !ReadMessage(fromClient, &writeUpdateInfo) ||
+        !ReadMessage(fromClient, &readCreateInfo)) {
+        return 2;
+    }
+
+    server::MemoryTransferService::WriteHandle* writeHandle = nullptr;
+    server::MemoryTransferService::ReadHandle* readHandle = nullptr;
+    if (!service->DeserializeWriteHandle(writeCreateInfo.data(), writeCreateInfo.size(),
+                                         &writeHandle) ||
+        !service->DeserializeReadHandle(readCreateInfo.data(), readCreateInfo.size(),
+                                        &readHandle)) {
+        return 3;
+    }
+
+    uint64_t size;
+    if (!ReadFully(fromClient, &size, sizeof(size))) {
+        return 4;
+    }
+    std::vector<uint8_t> bufferData(size);
+    writeHandle->SetTarget(bufferData.data());
+    writeHandle->SetDataLength(size);
+    if (!writeHandle->DeserializeDataUpdate(writeUpdateInfo.data(), writeUpdateInfo.size(), 0,
+                                            size)) {
+        return 5;
+    }
+
+    std::vector<uint8_t> reversed(bufferData.rbegin(), bufferData.rend());
+    std::vector<uint8_t> readUpdateInfo(readHandle->SizeOfSerializeDataUpdate(0, size));
+    readHandle->SerializeDataUpdate(reversed.data(), 0, size, readUpdateInfo.data());
+    delete writeHandle;
+    delete readHandle;
+    if (!WriteMessage(toClient, readUpdateInfo)) {
+        return 6;
+    }
+    return 0;
+}
+
+// Transfers data between a client and a server in separate processes that map the same shared
+// memory. No data goes through the pipes that act as the command stream, and the blocks released
+// by the server process can be reused by the client.
+TEST(SharedMemoryTransferServiceMultiProcessTests, TransferData) {
+    constexpr size_t kSize = 1024 * 1024;
+    std::unique_ptr<utils::SharedMemory> memory = utils::SharedMemory::Create(4 * kSize);
+    ASSERT_NE(memory, nullptr);
+    std::unique_ptr<client::MemoryTransferService> service =
+        utils::CreateSharedMemoryClientTransferService(memory.get());
+
+    int toServer[2];
+    int toClient[2];
+    ASSERT_EQ(pipe(toServer), 0);
+    ASSERT_EQ(pipe(toClient), 0);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        close(toServer[1]);
+        close(toClient[0]);
+        _exit(RunServerProcess(dup(memory->GetFd()), toServer[0], toClient[1]));
+    }
+    close(toServer[0]);
+    close(toClient[1]);
+
+    std::unique_ptr<client::MemoryTransferService::WriteHandle> writeHandle(
+        service->CreateWriteHandle(kSize));
+    std::unique_ptr<client::MemoryTransferService::ReadHandle> readHandle(
+        service->CreateReadHandle(kSize));
+    ASSERT_NE(writeHandle, nullptr);
+    ASSERT_NE(readHandle, nullptr);
+
+    uint8_t* writeData = static_cast<uint8_t*>(writeHandle->GetData());
+    for (size_t i = 0; i < kSize; ++i) {
+        writeData[i] = static_cast<uint8_t>(i % 251);
+    }
+
+    std::vector<uint8_t> writeCreateInfo(writeHandle->SerializeCreateSize());
+    writeHandle->SerializeCreate(writeCreateInfo.data());
+    std::vector<uint8_t> writeUpdateInfo(writeHandle->SizeOfSerializeDataUpdate(0, kSize));
+    writeHandle->SerializeDataUpdate(writeUpdateInfo.data(), 0, kSize);
+    std::vector<uint8_t> readCreateInfo(readHandle->SerializeCreateSize());
+    readHandle->SerializeCreate(readCreateInfo.data());
+    EXPECT_TRUE(writeUpdateInfo.empty());
+
+    uint64_t size = kSize;
+    ASSERT_TRUE(WriteMessage(toServer[1], writeCreateInfo));
+    ASSERT_TRUE(WriteMessage(toServer[1], writeUpdateInfo));
+    ASSERT_TRUE(WriteMessage(toServer[1], readCreateInfo));
+    ASSERT_EQ(write(toServer[1], &size, sizeof(size)), static_cast<ssize_t>(sizeof(size)));
+
+    std::vector<uint8_t> readUpdateInfo;
+    ASSERT_TRUE(ReadMessage(toClient[0], &readUpdateInfo));
+    EXPECT_TRUE(readUpdateInfo.empty());
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    ASSERT_TRUE(readHandle->DeserializeDataUpdate(readUpdateInfo.data(), readUpdateInfo.size(),
+                                                  0, kSize));
+    const uint8_t* readData = static_cast<const uint8_t*>(readHandle->GetData());
+    for (size_t i = 0; i < kSize; ++i) {
+        ASSERT_EQ(readData[i], static_cast<uint8_t>((kSize - 1 - i) % 251));
+    }
+
+    // Both handles were released by the server process, so all of the shared memory can be
+    // allocated again once the client releases them.
+    writeHandle = nullptr;
+    readHandle = nullptr;
+    std::unique_ptr<client::MemoryTransferService::ReadHandle> largeHandle(
+        service->CreateReadHandle(3 * kSize));
+    ASSERT_NE(largeHandle, nullptr);
+    EXPECT_TRUE(IsInSharedMemory(memory.get(), largeHandle->GetData()));
+
+    close(toServer[1]);
+    close(toClient[0]);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
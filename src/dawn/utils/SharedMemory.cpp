@@ -0,0 +1,100 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "dawn/utils/SharedMemory.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+
+namespace dawn::utils {
+
+// static
+std::unique_ptr<SharedMemory> SharedMemory::Create(size_t size) {
+    if (size == 0) {
+        return nullptr;
+    }
+
+    int fd = static_cast<int>(syscall(SYS_memfd_create, "dawn_shared_memory", MFD_CLOEXEC));
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemory>(new SharedMemory(fd, mapping, size));
+}
+
+// static
+std::unique_ptr<SharedMemory> SharedMemory::Import(int fd) {
+    struct stat fdStat;
+    if (fstat(fd, &fdStat) != 0 || fdStat.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(fdStat.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemory>(new SharedMemory(fd, mapping, size));
+}
+
+SharedMemory::SharedMemory(int fd, void* mapping, size_t size)
+    : mFd(fd), mMapping(mapping), mSize(size) {}
+
+SharedMemory::~SharedMemory() {
+    munmap(mMapping, mSize);
+    close(mFd);
+}
+
+int SharedMemory::GetFd() const {
+    return mFd;
+}
+
+size_t SharedMemory::GetSize() const {
+    return mSize;
+}
+
+uint8_t* SharedMemory::GetData() const {
+    return static_cast<uint8_t*>(mMapping);
+}
+
+}  // namespace dawn::utils
@@ -0,0 +1,69 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORY_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace dawn::utils {
+
+// A region of memory backed by a memfd that can be mapped by several processes. The region is
+// zero-initialized when it is created.
+class SharedMemory {
+  public:
+    // Creates a shared memory region of |size| bytes. Returns nullptr on failure.
+    static std::unique_ptr<SharedMemory> Create(size_t size);
+
+    // Maps the shared memory region of the file descriptor |fd|, which is typically the result
+    // of GetFd() in another process. Takes ownership of |fd|. Returns nullptr on failure.
+    static std::unique_ptr<SharedMemory> Import(int fd);
+
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    // The file descriptor of the region, to be sent to the other processes.
+    int GetFd() const;
+    size_t GetSize() const;
+    uint8_t* GetData() const;
+
+  private:
+    SharedMemory(int fd, void* mapping, size_t size);
+
+    int mFd;
+    void* mMapping;
+    size_t mSize;
+};
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORY_H_
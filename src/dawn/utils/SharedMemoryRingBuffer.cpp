@@ -0,0 +1,404 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "dawn/utils/SharedMemoryRingBuffer.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <climits>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "dawn/common/Math.h"
+
+namespace dawn::utils {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x474e4952;  // "RING"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kMinCapacity = 4096;
+constexpr size_t kMaxCapacity = size_t(1) << 30;
+constexpr size_t kHeaderSize = 256;
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kRecordAlignment = 8;
+
+// How many times a side polls the other before going to sleep.
+constexpr uint32_t kSpinCount = 128;
+
+// Commands are published as records. A record of commands is the batch of commands serialized
+// between two publications. A padding record fills the end of the ring when the next record
+// doesn't fit before it.
+enum RecordKind : uint32_t {
+    Commands = 1,
+    Padding = 2,
+};
+
+struct RecordHeader {
+    uint32_t size;
+    uint32_t kind;
+};
+static_assert(sizeof(RecordHeader) == kRecordAlignment);
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+// The futexes are not private to the process as the ring buffer can be shared between processes.
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, nullptr, nullptr,
+            0);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// Waits until |predicate| returns true or |closed| is set. |waiting| tells the other side that
+// this side sleeps on the |event| futex.
+template <typename Predicate>
+void WaitFor(std::atomic<uint32_t>* waiting,
+             std::atomic<uint32_t>* event,
+             const std::atomic<uint32_t>* closed,
+             Predicate predicate) {
+    for (uint32_t i = 0; i < kSpinCount; ++i) {
+        if (predicate() || closed->load(std::memory_order_acquire)) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    while (true) {
+        uint32_t eventValue = event->load(std::memory_order_acquire);
+        waiting->store(1, std::memory_order_relaxed);
+        // Pairs with the fence in WakeUp so that either this side sees the update of the other
+        // side, or the other side sees that this side is waiting.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (predicate() || closed->load(std::memory_order_acquire)) {
+            waiting->store(0, std::memory_order_relaxed);
+            return;
+        }
+        FutexWait(event, eventValue);
+        waiting->store(0, std::memory_order_relaxed);
+    }
+}
+
+// Wakes up the other side if it sleeps on |event|. Only costs a system call if it does.
+void WakeUp(std::atomic<uint32_t>* waiting, std::atomic<uint32_t>* event) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting->load(std::memory_order_relaxed) != 0) {
+        event->fetch_add(1, std::memory_order_release);
+        FutexWakeAll(event);
+    }
+}
+
+}  // anonymous namespace
+
+// The header at the start of the shared memory, followed by the data of the ring. The members
+// written by the producer and by the consumer are on separate cache lines.
+struct SharedMemoryRingBuffer::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    std::atomic<uint32_t> closed;
+
+    // The offset up to which the producer has published records.
+    alignas(kCacheLineSize) std::atomic<uint64_t> writeOffset;
+    // Bumped by the producer to wake up the consumer.
+    std::atomic<uint32_t> writeEvent;
+    std::atomic<uint32_t> producerWaiting;
+
+    // The offset up to which the consumer has handled records.
+    alignas(kCacheLineSize) std::atomic<uint64_t> readOffset;
+    // Bumped by the consumer to wake up the producer.
+    std::atomic<uint32_t> readEvent;
+    std::atomic<uint32_t> consumerWaiting;
+};
+
+// static
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::Create(size_t capacity) {
+    static_assert(sizeof(Header) <= kHeaderSize);
+    if (capacity < kMinCapacity || capacity > kMaxCapacity || !IsPowerOfTwo(capacity)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SharedMemory> memory = SharedMemory::Create(kHeaderSize + capacity);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    Header* header = new (memory->GetData()) Header();
+    header->magic = kMagic;
+    header->version = kVersion;
+    header->capacity = capacity;
+    return std::unique_ptr<SharedMemoryRingBuffer>(new SharedMemoryRingBuffer(std::move(memory)));
+}
+
+// static
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::Import(int fd) {
+    std::unique_ptr<SharedMemory> memory = SharedMemory::Import(fd);
+    if (memory == nullptr || memory->GetSize() < kHeaderSize) {
+        return nullptr;
+    }
+
+    // The constructor reads the capacity only once, so the other process can't change it after
+    // it has been validated.
+    size_t size = memory->GetSize();
+    auto ring =
+        std::unique_ptr<SharedMemoryRingBuffer>(new SharedMemoryRingBuffer(std::move(memory)));
+    const Header* header = ring->GetHeader();
+    if (header->magic != kMagic || header->version != kVersion ||
+        ring->mCapacity < kMinCapacity || ring->mCapacity > kMaxCapacity ||
+        !IsPowerOfTwo(ring->mCapacity) || kHeaderSize + ring->mCapacity != size) {
+        return nullptr;
+    }
+    return ring;
+}
+
+SharedMemoryRingBuffer::SharedMemoryRingBuffer(std::unique_ptr<SharedMemory> memory)
+    : mMemory(std::move(memory)),
+      mCapacity(static_cast<size_t>(GetHeader()->capacity)) {}
+
+SharedMemoryRingBuffer::~SharedMemoryRingBuffer() = default;
+
+int SharedMemoryRingBuffer::GetFd() const {
+    return mMemory->GetFd();
+}
+
+size_t SharedMemoryRingBuffer::GetCapacity() const {
+    return mCapacity;
+}
+
+void SharedMemoryRingBuffer::Close() {
+    Header* header = GetHeader();
+    header->closed.store(1, std::memory_order_release);
+    header->writeEvent.fetch_add(1, std::memory_order_release);
+    header->readEvent.fetch_add(1, std::memory_order_release);
+    FutexWakeAll(&header->writeEvent);
+    FutexWakeAll(&header->readEvent);
+}
+
+bool SharedMemoryRingBuffer::IsClosed() const {
+    return GetHeader()->closed.load(std::memory_order_acquire) != 0;
+}
+
+SharedMemoryRingBuffer::Header* SharedMemoryRingBuffer::GetHeader() const {
+    return reinterpret_cast<Header*>(mMemory->GetData());
+}
+
+char* SharedMemoryRingBuffer::GetData() const {
+    return reinterpret_cast<char*>(mMemory->GetData()) + kHeaderSize;
+}
+
+// RingBufferCommandSerializer
+
+RingBufferCommandSerializer::RingBufferCommandSerializer(SharedMemoryRingBuffer* ring)
+    : mRing(ring) {
+    SharedMemoryRingBuffer::Header* header = mRing->GetHeader();
+    mWriteOffset = header->writeOffset.load(std::memory_order_relaxed);
+    mReadOffset = header->readOffset.load(std::memory_order_acquire);
+}
+
+RingBufferCommandSerializer::~RingBufferCommandSerializer() = default;
+
+size_t RingBufferCommandSerializer::GetMaximumAllocationSize() const {
+    // Leave room to keep serializing commands while the consumer handles a large batch.
+    return mRing->GetCapacity() / 2;
+}
+
+void* RingBufferCommandSerializer::GetCmdSpace(size_t size) {
+    if (size > GetMaximumAllocationSize() || mRing->IsClosed()) {
+        return nullptr;
+    }
+
+    const size_t capacity = mRing->GetCapacity();
+    char* data = mRing->GetData();
+    size_t position = mWriteOffset & (capacity - 1);
+
+    // Append the commands to the current batch if they fit contiguously and there is space for
+    // them without waiting. Otherwise publish the batch and start a new one.
+    if (mHasBatch) {
+        size_t batchEnd = position + sizeof(RecordHeader) + mBatchSize;
+        if (size <= capacity - batchEnd) {
+            uint64_t recordEnd = mWriteOffset + Align(sizeof(RecordHeader) + mBatchSize + size,
+                                                      kRecordAlignment);
+            if (recordEnd - mReadOffset > capacity) {
+                mReadOffset = mRing->GetHeader()->readOffset.load(std::memory_order_acquire);
+            }
+            if (recordEnd - mReadOffset <= capacity) {
+                mBatchSize += size;
+                return data + batchEnd;
+            }
+        }
+        Publish();
+        position = mWriteOffset & (capacity - 1);
+    }
+
+    // Pad the end of the ring if the commands don't fit before it.
+    if (sizeof(RecordHeader) + size > capacity - position) {
+        size_t paddingSize = capacity - position;
+        if (!WaitForSpace(paddingSize)) {
+            return nullptr;
+        }
+        RecordHeader* padding = reinterpret_cast<RecordHeader*>(data + position);
+        padding->size = static_cast<uint32_t>(paddingSize);
+        padding->kind = RecordKind::Padding;
+        mWriteOffset += paddingSize;
+        mRing->GetHeader()->writeOffset.store(mWriteOffset, std::memory_order_release);
+        position = 0;
+    }
+
+    if (!WaitForSpace(sizeof(RecordHeader) + size)) {
+        return nullptr;
+    }
+    mHasBatch = true;
+    mBatchSize = size;
+    return data + position + sizeof(RecordHeader);
+}
+
+bool RingBufferCommandSerializer::Flush() {
+    Publish();
+    SharedMemoryRingBuffer::Header* header = mRing->GetHeader();
+    WakeUp(&header->consumerWaiting, &header->writeEvent);
+    return !mRing->IsClosed();
+}
+
+void RingBufferCommandSerializer::Publish() {
+    if (!mHasBatch) {
+        return;
+    }
+    const size_t capacity = mRing->GetCapacity();
+    RecordHeader* record =
+        reinterpret_cast<RecordHeader*>(mRing->GetData() + (mWriteOffset & (capacity - 1)));
+    record->size = static_cast<uint32_t>(mBatchSize);
+    record->kind = RecordKind::Commands;
+    mWriteOffset += Align(sizeof(RecordHeader) + mBatchSize, kRecordAlignment);
+    mRing->GetHeader()->writeOffset.store(mWriteOffset, std::memory_order_release);
+    mHasBatch = false;
+    mBatchSize = 0;
+}
+
+bool RingBufferCommandSerializer::WaitForSpace(size_t size) {
+    const size_t capacity = mRing->GetCapacity();
+    const uint64_t end = mWriteOffset + Align(size, kRecordAlignment);
+    SharedMemoryRingBuffer::Header* header = mRing->GetHeader();
+    auto HasSpace = [&] {
+        mReadOffset = header->readOffset.load(std::memory_order_acquire);
+        return end - mReadOffset <= capacity;
+    };
+    if (end - mReadOffset <= capacity || HasSpace()) {
+        return true;
+    }
+
+    // Space is only freed by the consumer handling the published records, make sure it is awake.
+    WakeUp(&header->consumerWaiting, &header->writeEvent);
+    WaitFor(&header->producerWaiting, &header->readEvent, &header->closed, HasSpace);
+    return !mRing->IsClosed();
+}
+
+// RingBufferCommandReceiver
+
+RingBufferCommandReceiver::RingBufferCommandReceiver(SharedMemoryRingBuffer* ring,
+                                                     dawn::wire::CommandHandler* handler)
+    : mRing(ring), mHandler(handler) {
+    mReadOffset = mRing->GetHeader()->readOffset.load(std::memory_order_relaxed);
+}
+
+RingBufferCommandReceiver::~RingBufferCommandReceiver() = default;
+
+bool RingBufferCommandReceiver::HandleCommands() {
+    const size_t capacity = mRing->GetCapacity();
+    const volatile char* data = mRing->GetData();
+    SharedMemoryRingBuffer::Header* header = mRing->GetHeader();
+
+    // The producer may be in another process, validate everything read from the shared memory.
+    uint64_t writeOffset = header->writeOffset.load(std::memory_order_acquire);
+    if (writeOffset - mReadOffset > capacity || writeOffset % kRecordAlignment != 0) {
+        mRing->Close();
+        return false;
+    }
+
+    while (mReadOffset != writeOffset) {
+        size_t position = mReadOffset & (capacity - 1);
+        size_t available = capacity - position;
+        const volatile RecordHeader* record =
+            reinterpret_cast<const volatile RecordHeader*>(data + position);
+        uint32_t recordSize = record->size;
+        uint32_t recordKind = record->kind;
+
+        size_t consumed = 0;
+        switch (recordKind) {
+            case RecordKind::Padding:
+                consumed = recordSize == available ? available : 0;
+                break;
+            case RecordKind::Commands:
+                if (recordSize <= available - sizeof(RecordHeader)) {
+                    consumed = Align(sizeof(RecordHeader) + recordSize, kRecordAlignment);
+                }
+                break;
+            default:
+                break;
+        }
+        if (consumed == 0 || consumed > writeOffset - mReadOffset) {
+            mRing->Close();
+            return false;
+        }
+
+        if (recordKind == RecordKind::Commands &&
+            mHandler->HandleCommands(data + position + sizeof(RecordHeader), recordSize) ==
+                nullptr) {
+            mRing->Close();
+            return false;
+        }
+
+        // Free the space of each record as soon as it is handled so that a blocked producer can
+        // make progress while the next records are handled.
+        mReadOffset += consumed;
+        header->readOffset.store(mReadOffset, std::memory_order_release);
+        WakeUp(&header->producerWaiting, &header->readEvent);
+    }
+    return true;
+}
+
+bool RingBufferCommandReceiver::WaitForCommands() {
+    if (!HasCommands()) {
+        SharedMemoryRingBuffer::Header* header = mRing->GetHeader();
+        WaitFor(&header->consumerWaiting, &header->writeEvent, &header->closed,
+                [&] { return HasCommands(); });
+    }
+    return HasCommands();
+}
+
+bool RingBufferCommandReceiver::HasCommands() const {
+    return mRing->GetHeader()->writeOffset.load(std::memory_order_acquire) != mReadOffset;
+}
+
+}  // namespace dawn::utils
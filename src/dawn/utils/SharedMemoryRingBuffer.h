@@ -0,0 +1,144 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORYRINGBUFFER_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORYRINGBUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "dawn/utils/SharedMemory.h"
+#include "dawn/wire/Wire.h"
+
+namespace dawn::utils {
+
+// A single-producer, single-consumer ring buffer of wire commands in shared memory. The memory is
+// backed by a memfd so that the ring can be mapped by another process with Import(), but the
+// producer and the consumer may also be two threads of the same process.
+//
+// The producer serializes commands in place in the ring with a RingBufferCommandSerializer and
+// the consumer hands them to a CommandHandler straight from the ring with a
+// RingBufferCommandReceiver, so commands are never copied. Commands are published in batches:
+// the consumer only sees them when the serializer is flushed, or when it runs out of contiguous
+// space. The producer blocks when the ring is full until the consumer frees space. A side that
+// has nothing to do spins briefly, then sleeps on a futex, and is only woken up by the other side
+// when it is actually sleeping.
+class SharedMemoryRingBuffer {
+  public:
+    // Creates a ring buffer with |capacity| bytes of space for commands. |capacity| must be a
+    // power of two of at least 4096. Returns nullptr on failure.
+    static std::unique_ptr<SharedMemoryRingBuffer> Create(size_t capacity);
+
+    // Maps the ring buffer of the shared memory file descriptor |fd|, which is typically the
+    // result of GetFd() in another process. Takes ownership of |fd|. Returns nullptr if |fd|
+    // does not contain a valid ring buffer.
+    static std::unique_ptr<SharedMemoryRingBuffer> Import(int fd);
+
+    ~SharedMemoryRingBuffer();
+
+    SharedMemoryRingBuffer(const SharedMemoryRingBuffer&) = delete;
+    SharedMemoryRingBuffer& operator=(const SharedMemoryRingBuffer&) = delete;
+
+    // The file descriptor of the shared memory, to be sent to the process at the other end.
+    int GetFd() const;
+    size_t GetCapacity() const;
+
+    // Closes the ring buffer on both ends and wakes up any side that is waiting. Commands that
+    // are already published may still be received.
+    void Close();
+    bool IsClosed() const;
+
+  private:
+    friend class RingBufferCommandSerializer;
+    friend class RingBufferCommandReceiver;
+
+    struct Header;
+
+    explicit SharedMemoryRingBuffer(std::unique_ptr<SharedMemory> memory);
+
+    Header* GetHeader() const;
+    char* GetData() const;
+
+    std::unique_ptr<SharedMemory> mMemory;
+    size_t mCapacity;
+};
+
+// A CommandSerializer that writes commands directly into a SharedMemoryRingBuffer.
+class RingBufferCommandSerializer : public dawn::wire::CommandSerializer {
+  public:
+    explicit RingBufferCommandSerializer(SharedMemoryRingBuffer* ring);
+    ~RingBufferCommandSerializer() override;
+
+    size_t GetMaximumAllocationSize() const override;
+    void* GetCmdSpace(size_t size) override;
+    bool Flush() override;
+
+  private:
+    // Makes the commands of the current batch visible to the consumer, without waking it up.
+    void Publish();
+    // Waits until |size| bytes past the write offset are free. Returns false if the ring buffer
+    // is closed.
+    bool WaitForSpace(size_t size);
+
+    SharedMemoryRingBuffer* mRing;
+    // The offset up to which records have been published. Offsets grow monotonically and are
+    // wrapped by the capacity of the ring to get positions.
+    uint64_t mWriteOffset = 0;
+    // The last read offset loaded from the consumer.
+    uint64_t mReadOffset = 0;
+    // The size of the commands of the current, unpublished batch, which starts at mWriteOffset.
+    size_t mBatchSize = 0;
+    bool mHasBatch = false;
+};
+
+// Reads the commands published in a SharedMemoryRingBuffer and forwards them to a CommandHandler.
+class RingBufferCommandReceiver {
+  public:
+    RingBufferCommandReceiver(SharedMemoryRingBuffer* ring, dawn::wire::CommandHandler* handler);
+    ~RingBufferCommandReceiver();
+
+    // Handles all the commands published so far, without blocking. Returns false if the ring
+    // buffer contains invalid data or if the handler fails; the ring buffer is closed then.
+    bool HandleCommands();
+
+    // Blocks until commands are published. Returns false if the ring buffer is closed and all
+    // the published commands have been handled.
+    bool WaitForCommands();
+
+  private:
+    bool HasCommands() const;
+
+    SharedMemoryRingBuffer* mRing;
+    dawn::wire::CommandHandler* mHandler;
+    uint64_t mReadOffset = 0;
+};
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORYRINGBUFFER_H_
@@ -0,0 +1,497 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "dawn/utils/SharedMemoryTransferService.h"
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Alloc.h"
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
+namespace dawn::utils {
+
+namespace {
+
+// Blocks of the shared memory start with a header, followed by the data of the handle.
+constexpr size_t kBlockAlignment = 64;
+constexpr size_t kBlockHeaderSize = kBlockAlignment;
+
+struct BlockHeader {
+    // Set by the client when it sends the handle to the server, cleared by the server when it
+    // destroys its handle.
+    std::atomic<uint32_t> usedByServer;
+};
+static_assert(sizeof(BlockHeader) <= kBlockHeaderSize);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+enum class HandleKind : uint32_t {
+    // The data is copied through the command stream.
+    Inline = 0,
+    // The data is in the block at |offset| of the shared memory.
+    Shared = 1,
+};
+
+// The creation info of the handles sent to the server.
+struct SerializedHandle {
+    HandleKind kind;
+    uint32_t padding;
+    uint64_t offset;
+    uint64_t size;
+};
+
+BlockHeader* GetBlockHeader(SharedMemory* memory, uint64_t dataOffset) {
+    return reinterpret_cast<BlockHeader*>(memory->GetData() + dataOffset - kBlockHeaderSize);
+}
+
+// Returns true if the range [offset, offset + size) is within a data of |dataSize| bytes.
+bool IsInRange(size_t offset, size_t size, size_t dataSize) {
+    return offset <= dataSize && size <= dataSize - offset;
+}
+
+// Allocates the blocks of the shared memory on the client side.
+class BlockAllocator {
+  public:
+    explicit BlockAllocator(SharedMemory* memory) : mMemory(memory) {
+        size_t size = mMemory->GetSize() / kBlockAlignment * kBlockAlignment;
+        if (size > 0) {
+            mFreeBlocks.emplace(0, size);
+        }
+    }
+
+    // Returns the offset of the data of a new block of |size| bytes, or std::nullopt if the
+    // shared memory is full.
+    std::optional<uint64_t> Allocate(size_t size) {
+        if (size > mMemory->GetSize()) {
+            return std::nullopt;
+        }
+        uint64_t blockSize = kBlockHeaderSize + Align(uint64_t(size), kBlockAlignment);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            for (auto it = mFreeBlocks.begin(); it != mFreeBlocks.end(); ++it) {
+                auto [offset, freeSize] = *it;
+                if (freeSize < blockSize) {
+                    continue;
+                }
+                mFreeBlocks.erase(it);
+                if (freeSize > blockSize) {
+                    mFreeBlocks.emplace(offset + blockSize, freeSize - blockSize);
+                }
+                uint64_t dataOffset = offset + kBlockHeaderSize;
+                GetBlockHeader(mMemory, dataOffset)->usedByServer.store(0);
+                return dataOffset;
+            }
+            if (!ReclaimServerBlocks()) {
+                break;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Frees the block of |size| bytes at |dataOffset| as soon as the server doesn't use it.
+    void Release(uint64_t dataOffset, size_t size) {
+        uint64_t blockSize = kBlockHeaderSize + Align(uint64_t(size), kBlockAlignment);
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (GetBlockHeader(mMemory, dataOffset)->usedByServer.load(std::memory_order_acquire)) {
+            mServerBlocks.emplace_back(dataOffset, blockSize);
+        } else {
+            Free(dataOffset - kBlockHeaderSize, blockSize);
+        }
+    }
+
+  private:
+    // Frees the blocks released by the server. Returns true if any block was freed.
+    bool ReclaimServerBlocks() {
+        bool freed = false;
+        for (size_t i = 0; i < mServerBlocks.size();) {
+            auto [dataOffset, blockSize] = mServerBlocks[i];
+            if (GetBlockHeader(mMemory, dataOffset)->usedByServer.load(std::memory_order_acquire)) {
+                ++i;
+                continue;
+            }
+            Free(dataOffset - kBlockHeaderSize, blockSize);
+            mServerBlocks[i] = mServerBlocks.back();
+            mServerBlocks.pop_back();
+            freed = true;
+        }
+        return freed;
+    }
+
+    // Adds a block to the free list, merging it with its free neighbours.
+    void Free(uint64_t offset, uint64_t size) {
+        auto next = mFreeBlocks.lower_bound(offset);
+        if (next != mFreeBlocks.end() && offset + size == next->first) {
+            size += next->second;
+            next = mFreeBlocks.erase(next);
+        }
+        if (next != mFreeBlocks.begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset) {
+                previous->second += size;
+                return;
+            }
+        }
+        mFreeBlocks.emplace(offset, size);
+    }
+
+    SharedMemory* mMemory;
+    std::mutex mMutex;
+    // Free blocks by offset.
+    std::map<uint64_t, uint64_t> mFreeBlocks;
+    // Blocks released by the client that the server may still use, as (data offset, block size).
+    std::vector<std::pair<uint64_t, uint64_t>> mServerBlocks;
+};
+
+// The storage of a client handle, either a block of the shared memory or an inline allocation.
+class ClientStorage {
+  public:
+    ClientStorage(SharedMemory* memory,
+                  BlockAllocator* allocator,
+                  std::optional<uint64_t> offset,
+                  std::unique_ptr<uint8_t[]> inlineData,
+                  size_t size)
+        : mMemory(memory),
+          mAllocator(allocator),
+          mOffset(offset),
+          mInlineData(std::move(inlineData)),
+          mSize(size) {}
+
+    ~ClientStorage() {
+        if (mOffset) {
+            mAllocator->Release(*mOffset, mSize);
+        }
+    }
+
+    ClientStorage(const ClientStorage&) = delete;
+    ClientStorage& operator=(const ClientStorage&) = delete;
+
+    bool IsShared() const { return mOffset.has_value(); }
+
+    uint8_t* GetData() const {
+        return mOffset ? mMemory->GetData() + *mOffset : mInlineData.get();
+    }
+
+    size_t GetSize() const { return mSize; }
+
+    void SerializeCreate(void* serializePointer) {
+        SerializedHandle handle = {};
+        if (mOffset) {
+            // The server owns the block too from now on.
+            GetBlockHeader(mMemory, *mOffset)->usedByServer.store(1, std::memory_order_release);
+            handle.kind = HandleKind::Shared;
+            handle.offset = *mOffset;
+        } else {
+            handle.kind = HandleKind::Inline;
+        }
+        handle.size = mSize;
+        memcpy(serializePointer, &handle, sizeof(handle));
+    }
+
+  private:
+    SharedMemory* mMemory;
+    BlockAllocator* mAllocator;
+    std::optional<uint64_t> mOffset;
+    std::unique_ptr<uint8_t[]> mInlineData;
+    size_t mSize;
+};
+
+class ClientTransferService : public dawn::wire::client::MemoryTransferService {
+    class ReadHandleImpl : public ReadHandle {
+      public:
+        explicit ReadHandleImpl(std::unique_ptr<ClientStorage> storage)
+            : mStorage(std::move(storage)) {}
+        ~ReadHandleImpl() override = default;
+
+        size_t SerializeCreateSize() override { return sizeof(SerializedHandle); }
+
+        void SerializeCreate(void* serializePointer) override {
+            mStorage->SerializeCreate(serializePointer);
+        }
+
+        const void* GetData() override { return mStorage->GetData(); }
+
+        bool DeserializeDataUpdate(const void* deserializePointer,
+                                   size_t deserializeSize,
+                                   size_t offset,
+                                   size_t size) override {
+            if (!IsInRange(offset, size, mStorage->GetSize())) {
+                return false;
+            }
+            // The server wrote the data directly in the shared memory, unless the range doesn't
+            // fit in the block the client told it about.
+            if (deserializeSize == 0 && (mStorage->IsShared() || size == 0)) {
+                return true;
+            }
+            if (deserializeSize != size || deserializePointer == nullptr) {
+                return false;
+            }
+            memcpy(mStorage->GetData() + offset, deserializePointer, size);
+            return true;
+        }
+
+      private:
+        std::unique_ptr<ClientStorage> mStorage;
+    };
+
+    class WriteHandleImpl : public WriteHandle {
+      public:
+        explicit WriteHandleImpl(std::unique_ptr<ClientStorage> storage)
+            : mStorage(std::move(storage)) {}
+        ~WriteHandleImpl() override = default;
+
+        size_t SerializeCreateSize() override { return sizeof(SerializedHandle); }
+
+        void SerializeCreate(void* serializePointer) override {
+            mStorage->SerializeCreate(serializePointer);
+        }
+
+        void* GetData() override { return mStorage->GetData(); }
+
+        size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override {
+            DAWN_ASSERT(IsInRange(offset, size, mStorage->GetSize()));
+            return mStorage->IsShared() ? 0 : size;
+        }
+
+        void SerializeDataUpdate(void* serializePointer, size_t offset, size_t size) override {
+            DAWN_ASSERT(IsInRange(offset, size, mStorage->GetSize()));
+            // The server reads the data directly from the shared memory.
+            if (!mStorage->IsShared()) {
+                DAWN_ASSERT(serializePointer != nullptr);
+                memcpy(serializePointer, mStorage->GetData() + offset, size);
+            }
+        }
+
+      private:
+        std::unique_ptr<ClientStorage> mStorage;
+    };
+
+  public:
+    explicit ClientTransferService(SharedMemory* memory) : mMemory(memory), mAllocator(memory) {}
+    ~ClientTransferService() override = default;
+
+    ReadHandle* CreateReadHandle(size_t size) override {
+        std::unique_ptr<ClientStorage> storage = AllocateStorage(size);
+        if (!storage) {
+            return nullptr;
+        }
+        return new ReadHandleImpl(std::move(storage));
+    }
+
+    WriteHandle* CreateWriteHandle(size_t size) override {
+        std::unique_ptr<ClientStorage> storage = AllocateStorage(size);
+        if (!storage) {
+            return nullptr;
+        }
+        memset(storage->GetData(), 0, size);
+        return new WriteHandleImpl(std::move(storage));
+    }
+
+  private:
+    std::unique_ptr<ClientStorage> AllocateStorage(size_t size) {
+        if (std::optional<uint64_t> offset = mAllocator.Allocate(size)) {
+            return std::make_unique<ClientStorage>(mMemory, &mAllocator, offset, nullptr, size);
+        }
+        // Fall back to an inline allocation when the shared memory is full.
+        auto inlineData = std::unique_ptr<uint8_t[]>(AllocNoThrow<uint8_t>(size));
+        if (!inlineData) {
+            return nullptr;
+        }
+        return std::make_unique<ClientStorage>(mMemory, &mAllocator, std::nullopt,
+                                               std::move(inlineData), size);
+    }
+
+    SharedMemory* mMemory;
+    BlockAllocator mAllocator;
+};
+
+class ServerTransferService : public dawn::wire::server::MemoryTransferService {
+    // The block of a server handle. The offset and size come from the client and are validated
+    // against the size of the shared memory before use.
+    class ServerBlock {
+      public:
+        ServerBlock(SharedMemory* memory, const SerializedHandle& handle)
+            : mMemory(handle.kind == HandleKind::Shared ? memory : nullptr),
+              mOffset(handle.offset),
+              mSize(handle.size) {}
+
+        ~ServerBlock() {
+            if (mMemory != nullptr) {
+                GetBlockHeader(mMemory, mOffset)->usedByServer.store(0, std::memory_order_release);
+            }
+        }
+
+        ServerBlock(const ServerBlock&) = delete;
+        ServerBlock& operator=(const ServerBlock&) = delete;
+
+        // Returns the shared data for the range [offset, offset + size) of the mapping, or
+        // nullptr if the data must be copied inline.
+        uint8_t* GetSharedData(size_t offset, size_t size) const {
+            if (mMemory == nullptr || !IsInRange(offset, size, mSize)) {
+                return nullptr;
+            }
+            return mMemory->GetData() + mOffset + offset;
+        }
+
+      private:
+        SharedMemory* mMemory;
+        uint64_t mOffset;
+        uint64_t mSize;
+    };
+
+    class ReadHandleImpl : public ReadHandle {
+      public:
+        ReadHandleImpl(SharedMemory* memory, const SerializedHandle& handle)
+            : mBlock(memory, handle) {}
+        ~ReadHandleImpl() override = default;
+
+        size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override {
+            return mBlock.GetSharedData(offset, size) != nullptr ? 0 : size;
+        }
+
+        void SerializeDataUpdate(const void* data,
+                                 size_t offset,
+                                 size_t size,
+                                 void* serializePointer) override {
+            if (size == 0) {
+                return;
+            }
+            DAWN_ASSERT(data != nullptr);
+            uint8_t* sharedData = mBlock.GetSharedData(offset, size);
+            if (sharedData != nullptr) {
+                memcpy(sharedData, data, size);
+            } else {
+                DAWN_ASSERT(serializePointer != nullptr);
+                memcpy(serializePointer, data, size);
+            }
+        }
+
+      private:
+        ServerBlock mBlock;
+    };
+
+    class WriteHandleImpl : public WriteHandle {
+      public:
+        WriteHandleImpl(SharedMemory* memory, const SerializedHandle& handle)
+            : mBlock(memory, handle), mIsShared(handle.kind == HandleKind::Shared) {}
+        ~WriteHandleImpl() override = default;
+
+        bool DeserializeDataUpdate(const void* deserializePointer,
+                                   size_t deserializeSize,
+                                   size_t offset,
+                                   size_t size) override {
+            if (mTargetData == nullptr || !IsInRange(offset, size, mDataLength)) {
+                return false;
+            }
+            const void* source = deserializePointer;
+            if (mIsShared) {
+                source = mBlock.GetSharedData(offset, size);
+                if (deserializeSize != 0 || source == nullptr) {
+                    return false;
+                }
+            } else if (deserializeSize != size || source == nullptr) {
+                return false;
+            }
+            memcpy(static_cast<uint8_t*>(mTargetData) + offset, source, size);
+            return true;
+        }
+
+      private:
+        ServerBlock mBlock;
+        bool mIsShared;
+    };
+
+  public:
+    explicit ServerTransferService(SharedMemory* memory) : mMemory(memory) {}
+    ~ServerTransferService() override = default;
+
+    bool DeserializeReadHandle(const void* deserializePointer,
+                               size_t deserializeSize,
+                               ReadHandle** readHandle) override {
+        DAWN_ASSERT(readHandle != nullptr);
+        SerializedHandle handle;
+        if (!Deserialize(deserializePointer, deserializeSize, &handle)) {
+            return false;
+        }
+        *readHandle = new ReadHandleImpl(mMemory, handle);
+        return true;
+    }
+
+    bool DeserializeWriteHandle(const void* deserializePointer,
+                                size_t deserializeSize,
+                                WriteHandle** writeHandle) override {
+        DAWN_ASSERT(writeHandle != nullptr);
+        SerializedHandle handle;
+        if (!Deserialize(deserializePointer, deserializeSize, &handle)) {
+            return false;
+        }
+        *writeHandle = new WriteHandleImpl(mMemory, handle);
+        return true;
+    }
+
+  private:
+    bool Deserialize(const void* deserializePointer,
+                     size_t deserializeSize,
+                     SerializedHandle* handle) const {
+        if (deserializeSize != sizeof(SerializedHandle) || deserializePointer == nullptr) {
+            return false;
+        }
+        memcpy(handle, deserializePointer, sizeof(SerializedHandle));
+        switch (handle->kind) {
+            case HandleKind::Inline:
+                return true;
+            case HandleKind::Shared:
+                return handle->offset >= kBlockHeaderSize &&
+                       handle->offset % kBlockAlignment == 0 &&
+                       IsInRange(handle->offset, handle->size, mMemory->GetSize());
+        }
+        return false;
+    }
+
+    SharedMemory* mMemory;
+};
+
+}  // anonymous namespace
+
+std::unique_ptr<dawn::wire::client::MemoryTransferService>
+CreateSharedMemoryClientTransferService(SharedMemory* memory) {
+    return std::make_unique<ClientTransferService>(memory);
+}
+
+std::unique_ptr<dawn::wire::server::MemoryTransferService>
+CreateSharedMemoryServerTransferService(SharedMemory* memory) {
+    return std::make_unique<ServerTransferService>(memory);
+}
+
+}  // namespace dawn::utils
@@ -0,0 +1,62 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
+
+#include <memory>
+
+#include "dawn/utils/SharedMemory.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn::utils {
+
+// MemoryTransferServices that place the mapping memory of buffers in a SharedMemory region mapped
+// by both the client and the server. The server copies the data of read mappings straight into
+// the region and reads the data of write mappings straight from it, so no data goes through the
+// command stream.
+//
+// The client allocates a block of the region for each Read/WriteHandle. The server marks the
+// block as released in the region when it destroys its handle, and the client only reuses the
+// block once both handles are destroyed, so the server never sees the data of another buffer.
+// When the region is full, the handles fall back to copying the data through the command stream
+// like the inline services.
+
+// Creates the client side service. |memory| must outlive the service.
+std::unique_ptr<dawn::wire::client::MemoryTransferService>
+CreateSharedMemoryClientTransferService(SharedMemory* memory);
+
+// Creates the server side service. |memory| must be the region of the client side service, and
+// must outlive the service.
+std::unique_ptr<dawn::wire::server::MemoryTransferService>
+CreateSharedMemoryServerTransferService(SharedMemory* memory);
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
@@ -42,6 +42,8 @@ include(api/options/BUILD.cmake)
 # Kind:      lib
 ################################################################################
 tint_add_target(tint_api lib
+  api/compile_cache.cc
+  api/compile_cache.h
   api/tint.cc
   api/tint.h
 )
@@ -118,3 +120,90 @@ if(TINT_BUILD_WGSL_WRITER)
     tint_lang_wgsl_writer
   )
 endif(TINT_BUILD_WGSL_WRITER)
+
+################################################################################
+# Target:    tint_api_test
+# Kind:      test
+################################################################################
+tint_add_target(tint_api_test test
+  api/compile_cache_test.cc
+)
+
+tint_target_add_dependencies(tint_api_test test
+  tint_api
+  tint_api_common
+  tint_api_options
+  tint_lang_core
+  tint_lang_core_constant
+  tint_lang_core_ir
+  tint_lang_core_type
+  tint_lang_hlsl_writer_common
+  tint_lang_spirv_reader_common
+  tint_lang_wgsl
+  tint_lang_wgsl_ast
+  tint_lang_wgsl_program
+  tint_lang_wgsl_sem
+  tint_utils_containers
+  tint_utils_diagnostic
+  tint_utils_ice
+  tint_utils_id
+  tint_utils_macros
+  tint_utils_math
+  tint_utils_memory
+  tint_utils_reflection
+  tint_utils_result
+  tint_utils_rtti
+  tint_utils_symbol
+  tint_utils_text
+  tint_utils_traits
+)
+
+tint_target_add_external_dependencies(tint_api_test test
+  "gtest"
+  "thread"
+)
+
+if(TINT_BUILD_GLSL_WRITER)
+  tint_target_add_dependencies(tint_api_test test
+    tint_lang_glsl_writer
+    tint_lang_glsl_writer_common
+  )
+endif(TINT_BUILD_GLSL_WRITER)
+
+if(TINT_BUILD_HLSL_WRITER)
+  tint_target_add_dependencies(tint_api_test test
+    tint_lang_hlsl_writer
+  )
+endif(TINT_BUILD_HLSL_WRITER)
+
+if(TINT_BUILD_MSL_WRITER)
+  tint_target_add_dependencies(tint_api_test test
+    tint_lang_msl_writer
+    tint_lang_msl_writer_common
+  )
+endif(TINT_BUILD_MSL_WRITER)
+
+if(TINT_BUILD_SPV_READER)
+  tint_target_add_dependencies(tint_api_test test
+    tint_lang_spirv_reader
+  )
+endif(TINT_BUILD_SPV_READER)
+
+if(TINT_BUILD_SPV_WRITER)
+  tint_target_add_dependencies(tint_api_test test
+    tint_lang_spirv_writer
+    tint_lang_spirv_writer_common
+  )
+endif(TINT_BUILD_SPV_WRITER)
+
+if(TINT_BUILD_WGSL_READER)
+  tint_target_add_dependencies(tint_api_test test
+    tint_lang_wgsl_reader
+  )
+endif(TINT_BUILD_WGSL_READER)
+
+if(TINT_BUILD_WGSL_WRITER)
+  tint_target_add_dependencies(tint_api_test test
+    tint_lang_wgsl_writer
+  )
+endif(TINT_BUILD_WGSL_WRITER)
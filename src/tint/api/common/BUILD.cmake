@@ -40,14 +40,32 @@
 ################################################################################
 tint_add_target(tint_api_common lib
   api/common/binding_point.h
-  api/common/common.cc
+  api/common/instrumentation.cc
+  api/common/instrumentation.h
   api/common/override_id.h
 )
 
 tint_target_add_dependencies(tint_api_common lib
   tint_utils_macros
   tint_utils_math
+  tint_utils_memory
   tint_utils_reflection
   tint_utils_text
   tint_utils_traits
 )
+
+tint_add_target(tint_api_common_test test
+  api/common/instrumentation_test.cc
+)
+
+tint_target_add_dependencies(tint_api_common_test test
+  tint_api_common
+  tint_utils_macros
+  tint_utils_math
+  tint_utils_memory
+)
+
+tint_target_add_external_dependencies(tint_api_common_test test
+  "gtest"
+  "thread"
+)
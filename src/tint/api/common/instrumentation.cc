@@ -0,0 +1,205 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/api/common/instrumentation.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "tint/utils/text/string_stream.h"
+
+namespace tint {
+namespace {
+
+/// Writes @p str to @p out as a quoted JSON string
+void EmitString(StringStream& out, const char* str) {
+    out << "\"";
+    for (const char* c = str; *c; c++) {
+        switch (*c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    out << "?";
+                } else {
+                    out << *c;
+                }
+                break;
+        }
+    }
+    out << "\"";
+}
+
+/// Writes @p duration to @p out as a decimal number of microseconds, which is the unit used by the
+/// Chrome trace event format.
+void EmitMicroseconds(StringStream& out, std::chrono::nanoseconds duration) {
+    auto ns = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+    auto frac = ns % 1000;
+    out << (ns / 1000) << "." << (frac / 100) << ((frac / 10) % 10) << (frac % 10);
+}
+
+}  // namespace
+
+Instrumentation::Listener::~Listener() = default;
+
+Instrumentation::Scope::Scope(Instrumentation& instrumentation) : prev_(CurrentThread()) {
+    auto& state = CurrentThread();
+    if (state.instrumentation != &instrumentation) {
+        state.instrumentation = &instrumentation;
+        state.thread = instrumentation.next_thread_++;
+        state.depth = 0;
+    }
+}
+
+Instrumentation::Scope::~Scope() {
+    CurrentThread() = prev_;
+}
+
+Instrumentation::PhaseScope::PhaseScope(const char* name) {
+    auto& state = CurrentThread();
+    if (!state.instrumentation) {
+        return;
+    }
+    instrumentation_ = state.instrumentation;
+    name_ = name;
+    state.depth++;
+    if (auto* listener = instrumentation_->config_.listener) {
+        listener->OnPhaseBegin(name);
+    }
+    allocation_stats_ = ThreadAllocationStats();
+    start_ = std::chrono::steady_clock::now();
+}
+
+Instrumentation::PhaseScope::~PhaseScope() {
+    if (!instrumentation_) {
+        return;
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto& allocation_stats = ThreadAllocationStats();
+    auto& state = CurrentThread();
+    state.depth--;
+
+    Phase phase;
+    phase.name = name_;
+    phase.thread = state.thread;
+    phase.depth = state.depth;
+    phase.start = start_ - instrumentation_->epoch_;
+    phase.duration = end - start_;
+    phase.allocations = allocation_stats.allocations - allocation_stats_.allocations;
+    phase.allocated_bytes = allocation_stats.bytes - allocation_stats_.bytes;
+    phase.nodes = nodes_;
+    instrumentation_->Record(phase);
+}
+
+Instrumentation::Instrumentation() : Instrumentation(Config{}) {}
+
+Instrumentation::Instrumentation(const Config& config)
+    : config_(config), epoch_(std::chrono::steady_clock::now()) {}
+
+Instrumentation::~Instrumentation() = default;
+
+Instrumentation::ThreadState& Instrumentation::CurrentThread() {
+    thread_local ThreadState state;
+    return state;
+}
+
+void Instrumentation::Record(const Phase& phase) {
+    if (config_.listener) {
+        config_.listener->OnPhaseEnd(phase);
+    }
+    if (config_.record_phases) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        phases_.push_back(phase);
+    }
+}
+
+std::vector<Instrumentation::Phase> Instrumentation::Phases() const {
+    std::vector<Phase> phases;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        phases = phases_;
+    }
+    // Phases are recorded as they end, so enclosing phases follow the phases they enclose.
+    std::stable_sort(phases.begin(), phases.end(), [](const Phase& a, const Phase& b) {
+        if (a.start != b.start) {
+            return a.start < b.start;
+        }
+        return a.depth < b.depth;
+    });
+    return phases;
+}
+
+void Instrumentation::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    phases_.clear();
+}
+
+std::string Instrumentation::ToJson() const {
+    StringStream out;
+    out << "{\n  \"phases\": [";
+    bool first = true;
+    for (auto& phase : Phases()) {
+        out << (first ? "\n" : ",\n") << "    {\"name\": ";
+        EmitString(out, phase.name);
+        out << ", \"thread\": " << phase.thread << ", \"depth\": " << phase.depth
+            << ", \"start_ns\": " << phase.start.count()
+            << ", \"duration_ns\": " << phase.duration.count()
+            << ", \"allocations\": " << phase.allocations
+            << ", \"allocated_bytes\": " << phase.allocated_bytes << ", \"nodes\": " << phase.nodes
+            << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+std::string Instrumentation::ToChromeTrace() const {
+    StringStream out;
+    out << "{\"traceEvents\": [";
+    bool first = true;
+    for (auto& phase : Phases()) {
+        out << (first ? "\n" : ",\n") << "  {\"name\": ";
+        EmitString(out, phase.name);
+        out << ", \"cat\": \"tint\", \"ph\": \"X\", \"ts\": ";
+        EmitMicroseconds(out, phase.start);
+        out << ", \"dur\": ";
+        EmitMicroseconds(out, phase.duration);
+        out << ", \"pid\": 0, \"tid\": " << phase.thread
+            << ", \"args\": {\"allocations\": " << phase.allocations
+            << ", \"allocated_bytes\": " << phase.allocated_bytes << ", \"nodes\": " << phase.nodes
+            << "}}";
+        first = false;
+    }
+    out << "\n], \"displayTimeUnit\": \"ns\"}\n";
+    return out.str();
+}
+
+}  // namespace tint
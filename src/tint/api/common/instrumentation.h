@@ -0,0 +1,201 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_API_COMMON_INSTRUMENTATION_H_
+#define SRC_TINT_API_COMMON_INSTRUMENTATION_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tint/utils/memory/allocation_stats.h"
+
+namespace tint {
+
+/// Instrumentation is an opt-in recorder of the phases that Tint runs when compiling a shader:
+/// parsing, resolving, uniformity analysis, each AST transform, conversion to IR, each IR pass and
+/// printing.
+///
+/// For each phase, Instrumentation records the wall time, the number and size of the heap blocks
+/// allocated by the BlockAllocator and BumpAllocator, and the number of nodes that the phase
+/// produced, if the phase reports one. Phases nest, and the figures of a phase include those of
+/// the phases that it encloses.
+///
+/// Phases are only recorded on threads that the Instrumentation has been attached to with a
+/// Scope. On other threads a PhaseScope costs a single thread-local load.
+///
+/// The recorded phases can be written as JSON or in the Chrome trace event format. A Listener
+/// can also be used to forward each phase to another tracing system as it begins and ends.
+class Instrumentation {
+    /// The per-thread attachment state
+    struct ThreadState {
+        /// The Instrumentation attached to the thread, or nullptr
+        Instrumentation* instrumentation = nullptr;
+        /// The index of the thread within #instrumentation
+        uint32_t thread = 0;
+        /// The number of phases currently open on the thread
+        uint32_t depth = 0;
+    };
+
+  public:
+    /// Phase holds the measurements of a completed phase
+    struct Phase {
+        /// The name of the phase. Phase names have static storage duration.
+        const char* name = nullptr;
+        /// The index of the thread that ran the phase, in the order the threads were attached
+        uint32_t thread = 0;
+        /// The number of phases that enclose this phase
+        uint32_t depth = 0;
+        /// The start time of the phase, relative to the construction of the Instrumentation
+        std::chrono::nanoseconds start{};
+        /// The wall time of the phase
+        std::chrono::nanoseconds duration{};
+        /// The number of heap blocks allocated during the phase
+        size_t allocations = 0;
+        /// The number of bytes allocated during the phase
+        size_t allocated_bytes = 0;
+        /// The number of nodes reported by the phase, such as the AST nodes of the program or the
+        /// instructions of the IR module that the phase produced. 0 if no count was reported.
+        size_t nodes = 0;
+    };
+
+    /// Listener is notified of phases as they begin and end, on the thread that runs the phase.
+    class Listener {
+      public:
+        /// Destructor
+        virtual ~Listener();
+
+        /// Called when a phase begins
+        /// @param name the name of the phase
+        virtual void OnPhaseBegin(const char* name) = 0;
+
+        /// Called when a phase ends
+        /// @param phase the completed phase
+        virtual void OnPhaseEnd(const Phase& phase) = 0;
+    };
+
+    /// Configuration for the Instrumentation
+    struct Config {
+        /// If true, completed phases are retained and returned by Phases().
+        /// Set this to false if phases only need to be forwarded to the #listener.
+        bool record_phases = true;
+        /// An optional listener notified of each phase. Must outlive the Instrumentation.
+        Listener* listener = nullptr;
+    };
+
+    /// Scope attaches an Instrumentation to the calling thread for the lifetime of the Scope.
+    /// Scopes can be nested, in which case the innermost Scope is active.
+    class Scope {
+      public:
+        /// Constructor
+        /// @param instrumentation the Instrumentation to attach to the calling thread
+        explicit Scope(Instrumentation& instrumentation);
+
+        /// Destructor
+        ~Scope();
+
+      private:
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ThreadState prev_;
+    };
+
+    /// PhaseScope records a phase that spans the lifetime of the PhaseScope, if an
+    /// Instrumentation is attached to the calling thread.
+    class PhaseScope {
+      public:
+        /// Constructor
+        /// @param name the name of the phase. Must have static storage duration.
+        explicit PhaseScope(const char* name);
+
+        /// Destructor
+        ~PhaseScope();
+
+        /// Sets the number of nodes reported for the phase
+        /// @param count the node count
+        void SetNodeCount(size_t count) { nodes_ = count; }
+
+      private:
+        PhaseScope(const PhaseScope&) = delete;
+        PhaseScope& operator=(const PhaseScope&) = delete;
+
+        Instrumentation* instrumentation_ = nullptr;
+        const char* name_ = nullptr;
+        std::chrono::steady_clock::time_point start_;
+        AllocationStats allocation_stats_;
+        size_t nodes_ = 0;
+    };
+
+    /// Constructor
+    Instrumentation();
+
+    /// Constructor
+    /// @param config the instrumentation configuration
+    explicit Instrumentation(const Config& config);
+
+    /// Destructor
+    ~Instrumentation();
+
+    /// @returns the completed phases, ordered by start time
+    std::vector<Phase> Phases() const;
+
+    /// Removes all the completed phases
+    void Clear();
+
+    /// @returns the completed phases as a JSON document
+    std::string ToJson() const;
+
+    /// @returns the completed phases as a JSON document in the Chrome trace event format, which
+    /// can be loaded into chrome://tracing or Perfetto.
+    std::string ToChromeTrace() const;
+
+  private:
+    Instrumentation(const Instrumentation&) = delete;
+    Instrumentation& operator=(const Instrumentation&) = delete;
+
+    /// Records a completed phase
+    /// @param phase the phase
+    void Record(const Phase& phase);
+
+    /// @returns the state of the calling thread
+    static ThreadState& CurrentThread();
+
+    const Config config_;
+    const std::chrono::steady_clock::time_point epoch_;
+    std::atomic<uint32_t> next_thread_{0};
+    mutable std::mutex mutex_;
+    std::vector<Phase> phases_;
+};
+
+}  // namespace tint
+
+#endif  // SRC_TINT_API_COMMON_INSTRUMENTATION_H_
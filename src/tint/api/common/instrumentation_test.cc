@@ -0,0 +1,173 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/api/common/instrumentation.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "tint/utils/memory/bump_allocator.h"
+
+namespace tint {
+namespace {
+
+using InstrumentationTest = testing::Test;
+
+class RecordingListener : public Instrumentation::Listener {
+  public:
+    void OnPhaseBegin(const char* name) override { events.push_back(std::string("+") + name); }
+    void OnPhaseEnd(const Instrumentation::Phase& phase) override {
+        events.push_back(std::string("-") + phase.name);
+    }
+    std::vector<std::string> events;
+};
+
+TEST_F(InstrumentationTest, NotAttached) {
+    Instrumentation instrumentation;
+    {
+        Instrumentation::PhaseScope phase("a");
+    }
+    EXPECT_TRUE(instrumentation.Phases().empty());
+}
+
+TEST_F(InstrumentationTest, NestedPhases) {
+    Instrumentation instrumentation;
+    {
+        Instrumentation::Scope scope(instrumentation);
+        Instrumentation::PhaseScope outer("outer");
+        {
+            Instrumentation::PhaseScope inner("inner");
+            inner.SetNodeCount(42);
+        }
+        {
+            Instrumentation::PhaseScope inner("inner2");
+        }
+    }
+    {
+        // Detached again
+        Instrumentation::PhaseScope phase("detached");
+    }
+
+    auto phases = instrumentation.Phases();
+    ASSERT_EQ(phases.size(), 3u);
+    EXPECT_STREQ(phases[0].name, "outer");
+    EXPECT_EQ(phases[0].depth, 0u);
+    EXPECT_EQ(phases[0].nodes, 0u);
+    EXPECT_STREQ(phases[1].name, "inner");
+    EXPECT_EQ(phases[1].depth, 1u);
+    EXPECT_EQ(phases[1].nodes, 42u);
+    EXPECT_STREQ(phases[2].name, "inner2");
+    EXPECT_EQ(phases[2].depth, 1u);
+    EXPECT_GE(phases[0].duration, phases[1].duration + phases[2].duration);
+    EXPECT_LE(phases[0].start, phases[1].start);
+    EXPECT_LE(phases[1].start, phases[2].start);
+
+    instrumentation.Clear();
+    EXPECT_TRUE(instrumentation.Phases().empty());
+}
+
+TEST_F(InstrumentationTest, Allocations) {
+    Instrumentation instrumentation;
+    {
+        Instrumentation::Scope scope(instrumentation);
+        Instrumentation::PhaseScope phase("alloc");
+        BumpAllocator allocator;
+        allocator.Allocate(16);
+        allocator.Allocate(BumpAllocator::kDefaultBlockDataSize + 1);
+    }
+    auto phases = instrumentation.Phases();
+    ASSERT_EQ(phases.size(), 1u);
+    EXPECT_EQ(phases[0].allocations, 2u);
+    EXPECT_GT(phases[0].allocated_bytes, BumpAllocator::kDefaultBlockDataSize * 2);
+}
+
+TEST_F(InstrumentationTest, Listener) {
+    RecordingListener listener;
+    Instrumentation::Config config;
+    config.record_phases = false;
+    config.listener = &listener;
+    Instrumentation instrumentation(config);
+    {
+        Instrumentation::Scope scope(instrumentation);
+        Instrumentation::PhaseScope outer("outer");
+        Instrumentation::PhaseScope inner("inner");
+    }
+    EXPECT_THAT(listener.events, testing::ElementsAre("+outer", "+inner", "-inner", "-outer"));
+    EXPECT_TRUE(instrumentation.Phases().empty());
+}
+
+TEST_F(InstrumentationTest, Threads) {
+    Instrumentation instrumentation;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&] {
+            Instrumentation::Scope scope(instrumentation);
+            Instrumentation::PhaseScope phase("thread");
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto phases = instrumentation.Phases();
+    ASSERT_EQ(phases.size(), 4u);
+    std::vector<uint32_t> ids;
+    for (auto& phase : phases) {
+        EXPECT_EQ(phase.depth, 0u);
+        ids.push_back(phase.thread);
+    }
+    EXPECT_THAT(ids, testing::UnorderedElementsAre(0u, 1u, 2u, 3u));
+}
+
+TEST_F(InstrumentationTest, ToJson) {
+    Instrumentation instrumentation;
+    {
+        Instrumentation::Scope scope(instrumentation);
+        Instrumentation::PhaseScope phase("a \"quoted\" phase");
+        phase.SetNodeCount(7);
+    }
+    auto json = instrumentation.ToJson();
+    EXPECT_THAT(json, testing::HasSubstr(R"("phases": [)"));
+    EXPECT_THAT(json, testing::HasSubstr(R"({"name": "a \"quoted\" phase", "thread": 0, "depth": 0)"));
+    EXPECT_THAT(json, testing::HasSubstr(R"("nodes": 7})"));
+}
+
+TEST_F(InstrumentationTest, ToChromeTrace) {
+    Instrumentation instrumentation;
+    {
+        Instrumentation::Scope scope(instrumentation);
+        Instrumentation::PhaseScope phase("wgsl.parse");
+    }
+    auto trace = instrumentation.ToChromeTrace();
+    EXPECT_THAT(trace, testing::HasSubstr(R"({"traceEvents": [)"));
+    EXPECT_THAT(trace, testing::HasSubstr(R"({"name": "wgsl.parse", "cat": "tint", "ph": "X", )"));
+    EXPECT_THAT(trace, testing::HasSubstr(R"("pid": 0, "tid": 0, "args": {"allocations": )"));
+}
+
+}  // namespace
+}  // namespace tint
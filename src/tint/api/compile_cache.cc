@@ -0,0 +1,375 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/api/compile_cache.h"
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "tint/utils/reflection/reflection.h"
+
+#if TINT_BUILD_WGSL_READER
+#include "tint/lang/wgsl/reader/reader.h"  // nogncheck
+#endif
+
+namespace tint {
+namespace {
+
+/// The estimated number of bytes used by each AST and semantic node of a cached program.
+constexpr size_t kEstimatedBytesPerNode = 128;
+
+/// Tags that prefix the keys of the cache entries, so that programs and the outputs of each
+/// backend cannot collide.
+enum class KeyTag : char {
+    kProgram = 'P',
+    kSpirv = 'S',
+    kMsl = 'M',
+    kHlsl = 'H',
+    kGlsl = 'G',
+    kWgsl = 'W',
+};
+
+// Key writers append an unambiguous binary encoding of a value to a key.
+// Declared up-front so that the templates can recurse into each other.
+
+template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+void WriteKey(std::string& key, T value);
+void WriteKey(std::string& key, std::string_view value);
+void WriteKey(std::string& key, const std::string& value);
+template <typename T, typename = std::enable_if_t<HasReflection<T>>, typename = void>
+void WriteKey(std::string& key, const T& object);
+template <typename T>
+void WriteKey(std::string& key, const std::optional<T>& value);
+template <typename A, typename B>
+void WriteKey(std::string& key, const std::pair<A, B>& value);
+template <typename T>
+void WriteKey(std::string& key, const std::vector<T>& value);
+template <size_t N>
+void WriteKey(std::string& key, const std::bitset<N>& value);
+template <typename K, typename V, typename H, typename E, typename A>
+void WriteKey(std::string& key, const std::unordered_map<K, V, H, E, A>& value);
+template <typename T, typename H, typename E, typename A>
+void WriteKey(std::string& key, const std::unordered_set<T, H, E, A>& value);
+
+template <typename T, typename>
+void WriteKey(std::string& key, T value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void WriteKey(std::string& key, std::string_view value) {
+    WriteKey(key, value.size());
+    key.append(value);
+}
+
+void WriteKey(std::string& key, const std::string& value) {
+    WriteKey(key, std::string_view(value));
+}
+
+template <typename T, typename, typename>
+void WriteKey(std::string& key, const T& object) {
+    ForeachField(object, [&](auto& field) { WriteKey(key, field); });
+}
+
+template <typename T>
+void WriteKey(std::string& key, const std::optional<T>& value) {
+    WriteKey(key, value.has_value());
+    if (value.has_value()) {
+        WriteKey(key, *value);
+    }
+}
+
+template <typename A, typename B>
+void WriteKey(std::string& key, const std::pair<A, B>& value) {
+    WriteKey(key, value.first);
+    WriteKey(key, value.second);
+}
+
+template <typename T>
+void WriteKey(std::string& key, const std::vector<T>& value) {
+    WriteKey(key, value.size());
+    for (auto& el : value) {
+        WriteKey(key, el);
+    }
+}
+
+template <size_t N>
+void WriteKey(std::string& key, const std::bitset<N>& value) {
+    for (size_t i = 0; i < N; i += 8) {
+        uint8_t bits = 0;
+        for (size_t j = i; j < std::min(i + 8, N); j++) {
+            bits |= static_cast<uint8_t>(value.test(j) ? 1u << (j - i) : 0u);
+        }
+        WriteKey(key, bits);
+    }
+}
+
+/// Writes the elements of an unordered container. The encoded elements are sorted, so that the
+/// key does not depend on the container's iteration order.
+template <typename CONTAINER>
+void WriteUnorderedKey(std::string& key, const CONTAINER& container) {
+    std::vector<std::string> elements;
+    elements.reserve(container.size());
+    for (auto& el : container) {
+        WriteKey(elements.emplace_back(), el);
+    }
+    std::sort(elements.begin(), elements.end());
+    WriteKey(key, elements);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void WriteKey(std::string& key, const std::unordered_map<K, V, H, E, A>& value) {
+    WriteUnorderedKey(key, value);
+}
+
+template <typename T, typename H, typename E, typename A>
+void WriteKey(std::string& key, const std::unordered_set<T, H, E, A>& value) {
+    WriteUnorderedKey(key, value);
+}
+
+/// @returns the key for the options of the backend with the given tag
+template <typename OPTIONS>
+[[maybe_unused]] std::string OptionsKey(KeyTag tag, const OPTIONS& options) {
+    std::string key;
+    WriteKey(key, tag);
+    WriteKey(key, options);
+    return key;
+}
+
+}  // namespace
+
+struct CompileCache::ProgramEntry {
+    /// A unique identifier for the program, used to key the program's outputs
+    uint64_t id = 0;
+    /// The source file. Must outlive `program`.
+    std::unique_ptr<Source::File> file;
+    /// The parsed program
+    Program program;
+};
+
+CompileCache::CompileCache() : CompileCache(Config{}) {}
+
+CompileCache::CompileCache(const Config& config) : config_(config) {}
+
+CompileCache::~CompileCache() = default;
+
+#if TINT_BUILD_WGSL_READER
+
+CompileCache::ProgramPtr CompileCache::Parse(std::string_view source) {
+    auto entry = GetProgram(source);
+    return ProgramPtr(entry, &entry->program);
+}
+
+std::shared_ptr<const CompileCache::ProgramEntry> CompileCache::GetProgram(
+    std::string_view source) {
+    std::string key;
+    key.reserve(source.size() + 1);
+    WriteKey(key, KeyTag::kProgram);
+    key.append(source);
+
+    uint64_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto value = Find(key)) {
+            stats_.program_hits++;
+            return std::static_pointer_cast<const ProgramEntry>(value);
+        }
+        stats_.program_misses++;
+        id = next_program_id_++;
+    }
+
+    // Parse without holding the lock, so that other sources can be parsed concurrently.
+    auto entry = std::make_shared<ProgramEntry>();
+    entry->id = id;
+    entry->file = std::make_unique<Source::File>("", source);
+    entry->program = wgsl::reader::Parse(entry->file.get());
+
+    size_t size = key.size() + source.size() +
+                  (entry->program.ASTNodes().Count() + entry->program.SemNodes().Count()) *
+                      kEstimatedBytesPerNode;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto value = Insert(Entry{std::move(key), std::move(entry), size});
+    return std::static_pointer_cast<const ProgramEntry>(value);
+}
+
+template <typename OUTPUT, typename GENERATE, typename SIZE_OF>
+Result<CompileCache::OutputPtr<OUTPUT>> CompileCache::GetOutput(std::string_view source,
+                                                                 std::string key,
+                                                                 GENERATE&& generate,
+                                                                 SIZE_OF&& size_of) {
+    auto program = GetProgram(source);
+    if (!program->program.IsValid()) {
+        return Failure{program->program.Diagnostics()};
+    }
+
+    // Outputs are keyed on the program's identifier rather than its source. If the program is
+    // evicted and parsed again it gets a new identifier, and its stale outputs age out of the
+    // cache.
+    WriteKey(key, program->id);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto value = Find(key)) {
+            stats_.output_hits++;
+            return std::static_pointer_cast<const OUTPUT>(value);
+        }
+        stats_.output_misses++;
+    }
+
+    auto result = generate(program->program);
+    if (!result) {
+        return result.Failure();
+    }
+    auto output = std::make_shared<const OUTPUT>(result.Move());
+    size_t size = key.size() + size_of(*output);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto value = Insert(Entry{std::move(key), std::move(output), size});
+    return std::static_pointer_cast<const OUTPUT>(value);
+}
+
+#endif  // TINT_BUILD_WGSL_READER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_SPV_WRITER
+Result<CompileCache::OutputPtr<spirv::writer::Output>> CompileCache::GenerateSpirv(
+    std::string_view source,
+    const spirv::writer::Options& options) {
+    return GetOutput<spirv::writer::Output>(
+        source, OptionsKey(KeyTag::kSpirv, options),
+        [&](const Program& program) { return spirv::writer::Generate(program, options); },
+        [](const spirv::writer::Output& output) {
+            return output.spirv.size() * sizeof(uint32_t);
+        });
+}
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_SPV_WRITER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_MSL_WRITER
+Result<CompileCache::OutputPtr<msl::writer::Output>> CompileCache::GenerateMsl(
+    std::string_view source,
+    const msl::writer::Options& options) {
+    return GetOutput<msl::writer::Output>(
+        source, OptionsKey(KeyTag::kMsl, options),
+        [&](const Program& program) { return msl::writer::Generate(program, options); },
+        [](const msl::writer::Output& output) { return output.msl.size(); });
+}
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_MSL_WRITER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_HLSL_WRITER
+Result<CompileCache::OutputPtr<hlsl::writer::Output>> CompileCache::GenerateHlsl(
+    std::string_view source,
+    const hlsl::writer::Options& options) {
+    return GetOutput<hlsl::writer::Output>(
+        source, OptionsKey(KeyTag::kHlsl, options),
+        [&](const Program& program) { return hlsl::writer::Generate(program, options); },
+        [](const hlsl::writer::Output& output) { return output.hlsl.size(); });
+}
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_HLSL_WRITER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_GLSL_WRITER
+Result<CompileCache::OutputPtr<glsl::writer::Output>> CompileCache::GenerateGlsl(
+    std::string_view source,
+    const glsl::writer::Options& options,
+    const std::string& entry_point) {
+    auto key = OptionsKey(KeyTag::kGlsl, options);
+    WriteKey(key, entry_point);
+    return GetOutput<glsl::writer::Output>(
+        source, std::move(key),
+        [&](const Program& program) {
+            return glsl::writer::Generate(program, options, entry_point);
+        },
+        [](const glsl::writer::Output& output) { return output.glsl.size(); });
+}
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_GLSL_WRITER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_WGSL_WRITER
+Result<CompileCache::OutputPtr<wgsl::writer::Output>> CompileCache::GenerateWgsl(
+    std::string_view source,
+    const wgsl::writer::Options& options) {
+    return GetOutput<wgsl::writer::Output>(
+        source, OptionsKey(KeyTag::kWgsl, options),
+        [&](const Program& program) { return wgsl::writer::Generate(program, options); },
+        [](const wgsl::writer::Output& output) { return output.wgsl.size(); });
+}
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_WGSL_WRITER
+
+CompileCache::Stats CompileCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void CompileCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    stats_.entries = 0;
+    stats_.memory_usage = 0;
+}
+
+std::shared_ptr<const void> CompileCache::Find(std::string_view key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->value;
+}
+
+std::shared_ptr<const void> CompileCache::Insert(Entry&& entry) {
+    // Another thread may have added the same entry while this one was parsing or generating.
+    if (auto existing = Find(entry.key)) {
+        return existing;
+    }
+
+    // Entries that are larger than the whole budget are not retained.
+    if (entry.size > config_.memory_budget) {
+        return std::move(entry.value);
+    }
+
+    // Evict least recently used entries until the new entry fits.
+    while (!lru_.empty() && stats_.memory_usage + entry.size > config_.memory_budget) {
+        auto& last = lru_.back();
+        stats_.memory_usage -= last.size;
+        stats_.entries--;
+        stats_.evictions++;
+        entries_.erase(last.key);
+        lru_.pop_back();
+    }
+
+    stats_.memory_usage += entry.size;
+    stats_.entries++;
+    lru_.push_front(std::move(entry));
+    entries_.emplace(lru_.front().key, lru_.begin());
+    return lru_.front().value;
+}
+
+}  // namespace tint
@@ -0,0 +1,241 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_API_COMPILE_CACHE_H_
+#define SRC_TINT_API_COMPILE_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "tint/lang/wgsl/program/program.h"
+#include "tint/utils/result/result.h"
+
+#if TINT_BUILD_GLSL_WRITER
+#include "tint/lang/glsl/writer/writer.h"  // nogncheck
+#endif
+
+#if TINT_BUILD_HLSL_WRITER
+#include "tint/lang/hlsl/writer/writer.h"  // nogncheck
+#endif
+
+#if TINT_BUILD_MSL_WRITER
+#include "tint/lang/msl/writer/writer.h"  // nogncheck
+#endif
+
+#if TINT_BUILD_SPV_WRITER
+#include "tint/lang/spirv/writer/writer.h"  // nogncheck
+#endif
+
+#if TINT_BUILD_WGSL_WRITER
+#include "tint/lang/wgsl/writer/writer.h"  // nogncheck
+#endif
+
+namespace tint {
+
+/// CompileCache is a thread-safe, in-memory cache of the programs parsed from WGSL source, and of
+/// the shaders generated from those programs.
+///
+/// The cache is content-addressed: programs are keyed on the WGSL source text, and generated
+/// shaders on the source text, the backend and the backend options. Identical sources are parsed
+/// and resolved once, and each shader is generated once per set of options, no matter how many
+/// callers ask for it.
+///
+/// Backend options are keyed on the fields reflected with TINT_REFLECT(), so every field of a
+/// writer's options, and of the reflected structures they hold, must be reflected. A field that is
+/// left out would let two different requests share a cached output.
+/// CompileCacheTest.OptionsAreFullyReflected checks this for each writer.
+///
+/// Cached programs and outputs are immutable and shared, and stay valid after they have been
+/// evicted. Once the estimated memory used by the cache exceeds the budget, the least recently
+/// used entries are evicted.
+class CompileCache {
+  public:
+    /// Configuration for the cache
+    struct Config {
+        /// The estimated number of bytes of programs and outputs that the cache may retain.
+        size_t memory_budget = 64 * 1024 * 1024;
+    };
+
+    /// Statistics about the use of the cache
+    struct Stats {
+        /// The number of program lookups that were served from the cache
+        size_t program_hits = 0;
+        /// The number of program lookups that had to parse the source
+        size_t program_misses = 0;
+        /// The number of output lookups that were served from the cache
+        size_t output_hits = 0;
+        /// The number of output lookups that had to generate the output
+        size_t output_misses = 0;
+        /// The number of entries evicted to stay within the memory budget
+        size_t evictions = 0;
+        /// The number of programs and outputs currently held by the cache
+        size_t entries = 0;
+        /// The estimated number of bytes currently held by the cache
+        size_t memory_usage = 0;
+    };
+
+    /// A shared, immutable program
+    using ProgramPtr = std::shared_ptr<const Program>;
+
+    /// A shared, immutable generator output
+    template <typename OUTPUT>
+    using OutputPtr = std::shared_ptr<const OUTPUT>;
+
+    /// Constructor
+    CompileCache();
+
+    /// Constructor
+    /// @param config the cache configuration
+    explicit CompileCache(const Config& config);
+
+    /// Destructor
+    ~CompileCache();
+
+#if TINT_BUILD_WGSL_READER
+    /// Parses the WGSL source, or returns the program previously parsed from the same source.
+    /// If the source fails to parse then the returned program is not valid, and its diagnostics
+    /// describe the error.
+    /// @param source the WGSL source
+    /// @returns the parsed program
+    ProgramPtr Parse(std::string_view source);
+#endif  // TINT_BUILD_WGSL_READER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_SPV_WRITER
+    /// Generates SPIR-V from the WGSL source, or returns the previously generated output.
+    /// @param source the WGSL source
+    /// @param options the generator options
+    /// @returns the generated output, or failure
+    Result<OutputPtr<spirv::writer::Output>> GenerateSpirv(std::string_view source,
+                                                           const spirv::writer::Options& options);
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_SPV_WRITER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_MSL_WRITER
+    /// Generates MSL from the WGSL source, or returns the previously generated output.
+    /// @param source the WGSL source
+    /// @param options the generator options
+    /// @returns the generated output, or failure
+    Result<OutputPtr<msl::writer::Output>> GenerateMsl(std::string_view source,
+                                                       const msl::writer::Options& options);
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_MSL_WRITER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_HLSL_WRITER
+    /// Generates HLSL from the WGSL source, or returns the previously generated output.
+    /// @param source the WGSL source
+    /// @param options the generator options
+    /// @returns the generated output, or failure
+    Result<OutputPtr<hlsl::writer::Output>> GenerateHlsl(std::string_view source,
+                                                         const hlsl::writer::Options& options);
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_HLSL_WRITER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_GLSL_WRITER
+    /// Generates GLSL from the WGSL source, or returns the previously generated output.
+    /// @param source the WGSL source
+    /// @param options the generator options
+    /// @param entry_point the entry point to generate GLSL for
+    /// @returns the generated output, or failure
+    Result<OutputPtr<glsl::writer::Output>> GenerateGlsl(std::string_view source,
+                                                         const glsl::writer::Options& options,
+                                                         const std::string& entry_point);
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_GLSL_WRITER
+
+#if TINT_BUILD_WGSL_READER && TINT_BUILD_WGSL_WRITER
+    /// Generates WGSL from the WGSL source, or returns the previously generated output.
+    /// @param source the WGSL source
+    /// @param options the generator options
+    /// @returns the generated output, or failure
+    Result<OutputPtr<wgsl::writer::Output>> GenerateWgsl(std::string_view source,
+                                                         const wgsl::writer::Options& options);
+#endif  // TINT_BUILD_WGSL_READER && TINT_BUILD_WGSL_WRITER
+
+    /// @returns a snapshot of the cache statistics
+    Stats GetStats() const;
+
+    /// Removes all the entries from the cache. Statistics are preserved.
+    void Clear();
+
+  private:
+    /// A cached program or generator output
+    struct Entry {
+        /// The content key of the entry
+        std::string key;
+        /// The cached value
+        std::shared_ptr<const void> value;
+        /// The estimated memory used by the entry, in bytes
+        size_t size = 0;
+    };
+
+    /// A parsed program and the source file that it references
+    struct ProgramEntry;
+
+    /// Looks up the program parsed from `source`, parsing and adding it to the cache on a miss.
+    /// @param source the WGSL source
+    /// @returns the cached program entry
+    std::shared_ptr<const ProgramEntry> GetProgram(std::string_view source);
+
+    /// Looks up a generator output, generating and adding it to the cache on a miss.
+    /// @param source the WGSL source
+    /// @param key the output key, without the program part
+    /// @param generate the function that generates the output from a program
+    /// @param size_of the function that estimates the memory used by an output
+    /// @returns the cached output, or failure
+    template <typename OUTPUT, typename GENERATE, typename SIZE_OF>
+    Result<OutputPtr<OUTPUT>> GetOutput(std::string_view source,
+                                        std::string key,
+                                        GENERATE&& generate,
+                                        SIZE_OF&& size_of);
+
+    /// @param key the content key
+    /// @returns the cached value for `key` and marks it as most recently used, or nullptr.
+    /// @note must be called with `mutex_` held.
+    std::shared_ptr<const void> Find(std::string_view key);
+
+    /// Adds an entry to the cache, evicting least recently used entries to stay within budget.
+    /// If an entry already exists for the key, the existing value is returned instead.
+    /// @param entry the new entry
+    /// @returns the value cached for the entry's key
+    /// @note must be called with `mutex_` held.
+    std::shared_ptr<const void> Insert(Entry&& entry);
+
+    const Config config_;
+    mutable std::mutex mutex_;
+    /// Entries in most recently used first order
+    std::list<Entry> lru_;
+    /// Map of entry key to entry. The keys reference the strings held by `lru_`.
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> entries_;
+    uint64_t next_program_id_ = 0;
+    Stats stats_;
+};
+
+}  // namespace tint
+
+#endif  // SRC_TINT_API_COMPILE_CACHE_H_
@@ -0,0 +1,373 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/api/compile_cache.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tint/lang/wgsl/ast/module.h"
+#include "tint/utils/math/math.h"
+#include "tint/utils/reflection/reflection.h"
+
+namespace tint {
+namespace {
+
+/// Checks that the fields reflected by @p object, and by the reflected structures it holds, cover
+/// all the bytes of the object other than alignment padding. An unreflected field would not be
+/// part of the cache key.
+/// @note a field that is small enough to fit in the padding before the next field goes unnoticed.
+template <typename T>
+void ExpectAllFieldsReflected(const T& object, const std::string& name) {
+    struct Field {
+        size_t offset;
+        size_t size;
+        size_t align;
+    };
+    std::vector<Field> fields;
+    auto* base = reinterpret_cast<const char*>(&object);
+    ForeachField(object, [&](auto& field) {
+        using F = std::decay_t<decltype(field)>;
+        auto offset = static_cast<size_t>(reinterpret_cast<const char*>(&field) - base);
+        fields.push_back(Field{offset, sizeof(F), alignof(F)});
+        if constexpr (HasReflection<F>) {
+            ExpectAllFieldsReflected(field, name + " field at offset " + std::to_string(offset));
+        }
+    });
+    std::sort(fields.begin(), fields.end(),
+              [](const Field& a, const Field& b) { return a.offset < b.offset; });
+
+    size_t end = 0;
+    for (auto& field : fields) {
+        EXPECT_EQ(field.offset, RoundUp(field.align, end))
+            << name << " has an unreflected field at offset " << end;
+        end = field.offset + field.size;
+    }
+    EXPECT_EQ(RoundUp(alignof(T), end), sizeof(T))
+        << name << " has an unreflected field at offset " << end;
+}
+
+TEST(CompileCacheTest, OptionsAreFullyReflected) {
+#if TINT_BUILD_SPV_WRITER
+    ExpectAllFieldsReflected(spirv::writer::Options{}, "spirv::writer::Options");
+#endif
+#if TINT_BUILD_MSL_WRITER
+    ExpectAllFieldsReflected(msl::writer::Options{}, "msl::writer::Options");
+#endif
+#if TINT_BUILD_HLSL_WRITER
+    ExpectAllFieldsReflected(hlsl::writer::Options{}, "hlsl::writer::Options");
+#endif
+#if TINT_BUILD_GLSL_WRITER
+    ExpectAllFieldsReflected(glsl::writer::Options{}, "glsl::writer::Options");
+#endif
+#if TINT_BUILD_WGSL_WRITER && defined(TINT_BUILD_SYNTAX_TREE_WRITER)
+    ExpectAllFieldsReflected(wgsl::writer::Options{}, "wgsl::writer::Options");
+#endif
+}
+
+#if TINT_BUILD_WGSL_READER
+
+constexpr const char* kShaderA = R"(
+@compute @workgroup_size(1)
+fn main() {
+  var x = 1;
+  x = x + 1;
+}
+)";
+
+constexpr const char* kShaderB = R"(
+@fragment
+fn main() -> @location(0) vec4f {
+  return vec4f(1, 0, 0, 1);
+}
+)";
+
+TEST(CompileCacheTest, ParseHit) {
+    CompileCache cache;
+    auto a = cache.Parse(kShaderA);
+    auto b = cache.Parse(std::string(kShaderA));
+    ASSERT_TRUE(a->IsValid()) << a->Diagnostics();
+    EXPECT_EQ(a, b);
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.program_misses, 1u);
+    EXPECT_EQ(stats.program_hits, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_GT(stats.memory_usage, 0u);
+}
+
+TEST(CompileCacheTest, ParseDifferentSources) {
+    CompileCache cache;
+    auto a = cache.Parse(kShaderA);
+    auto b = cache.Parse(kShaderB);
+    EXPECT_TRUE(a->IsValid());
+    EXPECT_TRUE(b->IsValid());
+    EXPECT_NE(a, b);
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.program_misses, 2u);
+    EXPECT_EQ(stats.program_hits, 0u);
+    EXPECT_EQ(stats.entries, 2u);
+}
+
+TEST(CompileCacheTest, ParseError) {
+    CompileCache cache;
+    auto a = cache.Parse("fn main( {}");
+    auto b = cache.Parse("fn main( {}");
+    EXPECT_FALSE(a->IsValid());
+    EXPECT_TRUE(a->Diagnostics().contains_errors());
+    EXPECT_EQ(a, b);
+}
+
+TEST(CompileCacheTest, EvictsLeastRecentlyUsed) {
+    // Measure the size of a single program, then size the budget to hold two of them.
+    size_t size = 0;
+    {
+        CompileCache cache;
+        cache.Parse(kShaderA);
+        size = cache.GetStats().memory_usage;
+    }
+
+    CompileCache::Config config;
+    config.memory_budget = size * 2 + size / 2;
+    CompileCache cache(config);
+    auto a = cache.Parse(kShaderA);
+    cache.Parse(std::string(kShaderA) + " ");
+    cache.Parse(kShaderA);                      // Makes A the most recently used.
+    cache.Parse(std::string(kShaderA) + "  ");  // Evicts the first variant.
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_LE(stats.memory_usage, config.memory_budget);
+
+    EXPECT_EQ(cache.Parse(kShaderA), a);
+    EXPECT_EQ(cache.GetStats().program_hits, 2u);
+    cache.Parse(std::string(kShaderA) + " ");
+    EXPECT_EQ(cache.GetStats().program_misses, 4u);
+}
+
+TEST(CompileCacheTest, EvictedProgramStaysValid) {
+    CompileCache::Config config;
+    config.memory_budget = 1;
+    CompileCache cache(config);
+    auto a = cache.Parse(kShaderA);
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.entries, 0u);
+    EXPECT_EQ(stats.memory_usage, 0u);
+    EXPECT_TRUE(a->IsValid());
+    EXPECT_EQ(a->AST().Functions().Length(), 1u);
+}
+
+TEST(CompileCacheTest, Clear) {
+    CompileCache cache;
+    auto a = cache.Parse(kShaderA);
+    cache.Clear();
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.entries, 0u);
+    EXPECT_EQ(stats.memory_usage, 0u);
+
+    auto b = cache.Parse(kShaderA);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(cache.GetStats().program_misses, 2u);
+}
+
+TEST(CompileCacheTest, ConcurrentParse) {
+    CompileCache cache;
+    constexpr size_t kNumThreads = 8;
+    constexpr size_t kNumIterations = 16;
+
+    std::vector<std::thread> threads;
+    std::vector<CompileCache::ProgramPtr> programs(kNumThreads * kNumIterations);
+    for (size_t t = 0; t < kNumThreads; t++) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < kNumIterations; i++) {
+                programs[t * kNumIterations + i] = cache.Parse(i % 2 ? kShaderA : kShaderB);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < programs.size(); i++) {
+        EXPECT_EQ(programs[i], programs[i % 2]);
+    }
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.program_hits + stats.program_misses, programs.size());
+    EXPECT_EQ(stats.entries, 2u);
+}
+
+#if TINT_BUILD_WGSL_WRITER
+TEST(CompileCacheTest, GenerateWgsl) {
+    CompileCache cache;
+    auto a = cache.GenerateWgsl(kShaderA, {});
+    auto b = cache.GenerateWgsl(kShaderA, {});
+    ASSERT_TRUE(a) << a.Failure();
+    ASSERT_TRUE(b) << b.Failure();
+    EXPECT_EQ(a.Get(), b.Get());
+    EXPECT_NE(a.Get()->wgsl.find("fn main()"), std::string::npos);
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.output_misses, 1u);
+    EXPECT_EQ(stats.output_hits, 1u);
+    EXPECT_EQ(stats.program_misses, 1u);
+    EXPECT_EQ(stats.program_hits, 1u);
+    EXPECT_EQ(stats.entries, 2u);
+}
+
+TEST(CompileCacheTest, GenerateWgslParseError) {
+    CompileCache cache;
+    auto a = cache.GenerateWgsl("fn main( {}", {});
+    ASSERT_FALSE(a);
+    EXPECT_TRUE(a.Failure().reason.contains_errors());
+    EXPECT_EQ(cache.GetStats().output_misses, 0u);
+}
+#endif  // TINT_BUILD_WGSL_WRITER
+
+#if TINT_BUILD_HLSL_WRITER
+TEST(CompileCacheTest, GenerateHlslKeyedOnOptions) {
+    CompileCache cache;
+    hlsl::writer::Options robust;
+    hlsl::writer::Options not_robust;
+    not_robust.disable_robustness = true;
+
+    auto a = cache.GenerateHlsl(kShaderA, robust);
+    auto b = cache.GenerateHlsl(kShaderA, not_robust);
+    auto c = cache.GenerateHlsl(kShaderA, robust);
+    ASSERT_TRUE(a) << a.Failure();
+    ASSERT_TRUE(b) << b.Failure();
+    ASSERT_TRUE(c) << c.Failure();
+    EXPECT_NE(a.Get(), b.Get());
+    EXPECT_EQ(a.Get(), c.Get());
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.output_misses, 2u);
+    EXPECT_EQ(stats.output_hits, 1u);
+    EXPECT_EQ(stats.program_misses, 1u);
+}
+
+TEST(CompileCacheTest, GenerateHlslUnorderedOptions) {
+    CompileCache cache;
+    hlsl::writer::Options a_options;
+    a_options.access_controls.emplace(BindingPoint{0, 1}, core::Access::kRead);
+    a_options.access_controls.emplace(BindingPoint{0, 2}, core::Access::kRead);
+    a_options.access_controls.emplace(BindingPoint{1, 0}, core::Access::kReadWrite);
+    hlsl::writer::Options b_options;
+    b_options.access_controls.emplace(BindingPoint{1, 0}, core::Access::kReadWrite);
+    b_options.access_controls.emplace(BindingPoint{0, 2}, core::Access::kRead);
+    b_options.access_controls.emplace(BindingPoint{0, 1}, core::Access::kRead);
+
+    auto a = cache.GenerateHlsl(kShaderA, a_options);
+    auto b = cache.GenerateHlsl(kShaderA, b_options);
+    ASSERT_TRUE(a) << a.Failure();
+    ASSERT_TRUE(b) << b.Failure();
+    EXPECT_EQ(a.Get(), b.Get());
+}
+#endif  // TINT_BUILD_HLSL_WRITER
+
+#if TINT_BUILD_SPV_WRITER
+TEST(CompileCacheTest, GenerateSpirv) {
+    CompileCache cache;
+    auto a = cache.GenerateSpirv(kShaderA, {});
+    auto b = cache.GenerateSpirv(kShaderA, {});
+    ASSERT_TRUE(a) << a.Failure();
+    EXPECT_EQ(a.Get(), b.Get());
+    EXPECT_FALSE(a.Get()->spirv.empty());
+}
+
+TEST(CompileCacheTest, GenerateSpirvKeyedOnPassMatrixByPointer) {
+    CompileCache cache;
+    spirv::writer::Options by_value;
+    spirv::writer::Options by_pointer;
+    by_pointer.pass_matrix_by_pointer = true;
+
+    auto a = cache.GenerateSpirv(kShaderA, by_value);
+    auto b = cache.GenerateSpirv(kShaderA, by_pointer);
+    ASSERT_TRUE(a) << a.Failure();
+    ASSERT_TRUE(b) << b.Failure();
+    EXPECT_NE(a.Get(), b.Get());
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.output_misses, 2u);
+    EXPECT_EQ(stats.output_hits, 0u);
+}
+#endif  // TINT_BUILD_SPV_WRITER
+
+#if TINT_BUILD_MSL_WRITER
+TEST(CompileCacheTest, GenerateMsl) {
+    CompileCache cache;
+    auto a = cache.GenerateMsl(kShaderA, {});
+    auto b = cache.GenerateMsl(kShaderA, {});
+    ASSERT_TRUE(a) << a.Failure();
+    EXPECT_EQ(a.Get(), b.Get());
+    EXPECT_FALSE(a.Get()->msl.empty());
+}
+#endif  // TINT_BUILD_MSL_WRITER
+
+#if TINT_BUILD_GLSL_WRITER
+TEST(CompileCacheTest, GenerateGlslKeyedOnEntryPoint) {
+    CompileCache cache;
+    auto a = cache.GenerateGlsl(kShaderA, {}, "main");
+    auto b = cache.GenerateGlsl(kShaderA, {}, "");
+    auto c = cache.GenerateGlsl(kShaderA, {}, "main");
+    ASSERT_TRUE(a) << a.Failure();
+    ASSERT_TRUE(b) << b.Failure();
+    EXPECT_NE(a.Get(), b.Get());
+    EXPECT_EQ(a.Get(), c.Get());
+}
+
+TEST(CompileCacheTest, GenerateGlslKeyedOnUseTintIR) {
+    CompileCache cache;
+    glsl::writer::Options ast;
+    glsl::writer::Options ir;
+    ir.use_tint_ir = true;
+
+    auto a = cache.GenerateGlsl(kShaderA, ast, "main");
+    ASSERT_TRUE(a) << a.Failure();
+    // The IR path may not support everything that the AST path does, so only check that the IR
+    // request was not served the AST path's output.
+    auto b = cache.GenerateGlsl(kShaderA, ir, "main");
+    if (b) {
+        EXPECT_NE(a.Get(), b.Get());
+    }
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.output_misses, 2u);
+    EXPECT_EQ(stats.output_hits, 0u);
+}
+#endif  // TINT_BUILD_GLSL_WRITER
+
+#endif  // TINT_BUILD_WGSL_READER
+
+}  // namespace
+}  // namespace tint
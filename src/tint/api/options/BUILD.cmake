@@ -42,6 +42,7 @@ tint_add_target(tint_api_options lib
   api/options/array_length_from_uniform.h
   api/options/binding_remapper.h
   api/options/external_texture.h
+  api/options/optimization.h
   api/options/options.cc
   api/options/pixel_local.h
   api/options/texture_builtins_from_uniform.h
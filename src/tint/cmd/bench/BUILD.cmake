@@ -65,6 +65,7 @@ tint_target_add_dependencies(tint_cmd_bench_bench_cmd bench_cmd
   tint_utils_rtti_bench
   tint_utils_symbol
   tint_utils_text
+  tint_utils_text_bench
   tint_utils_traits
 )
 
@@ -80,12 +81,14 @@ endif(TINT_BUILD_GLSL_WRITER)
 
 if(TINT_BUILD_HLSL_WRITER)
   tint_target_add_dependencies(tint_cmd_bench_bench_cmd bench_cmd
+    tint_lang_hlsl_writer_ast_printer_bench
     tint_lang_hlsl_writer_bench
   )
 endif(TINT_BUILD_HLSL_WRITER)
 
 if(TINT_BUILD_MSL_WRITER)
   tint_target_add_dependencies(tint_cmd_bench_bench_cmd bench_cmd
+    tint_lang_msl_writer_ast_printer_bench
     tint_lang_msl_writer_bench
   )
 endif(TINT_BUILD_MSL_WRITER)
@@ -98,7 +101,9 @@ endif(TINT_BUILD_SPV_WRITER)
 
 if(TINT_BUILD_WGSL_READER)
   tint_target_add_dependencies(tint_cmd_bench_bench_cmd bench_cmd
+    tint_lang_core_ir_binary_bench
     tint_lang_wgsl_reader_bench
+    tint_lang_wgsl_resolver_bench
   )
 endif(TINT_BUILD_WGSL_READER)
 
@@ -44,9 +44,12 @@ tint_add_target(tint_cmd_test_test_cmd test_cmd
 
 tint_target_add_dependencies(tint_cmd_test_test_cmd test_cmd
   tint_api
+  tint_api_common_test
+  tint_api_test
   tint_cmd_common_test
   tint_lang_core_constant_test
   tint_lang_core_intrinsic_test
+  tint_lang_core_ir_binary_test
   tint_lang_core_ir_transform_test
   tint_lang_core_ir_test
   tint_lang_core_type_test
@@ -78,6 +78,10 @@ tint_target_add_dependencies(tint_cmd_tint_cmd cmd
   tint_utils_traits
 )
 
+tint_target_add_external_dependencies(tint_cmd_tint_cmd cmd
+  "thread"
+)
+
 if(TINT_BUILD_GLSL_VALIDATOR)
   tint_target_add_dependencies(tint_cmd_tint_cmd cmd
     tint_lang_glsl_validate
@@ -25,22 +25,30 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
+#include <atomic>
 #include <charconv>
+#include <chrono>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #if TINT_BUILD_SPV_READER || TINT_BUILD_SPV_WRITER
 #include "spirv-tools/libspirv.hpp"
 #endif  // TINT_BUILD_SPV_READER || TINT_BUILD_SPV_WRITER
 
+#include "tint/api/common/instrumentation.h"
+#include "tint/api/options/optimization.h"
 #include "tint/api/options/pixel_local.h"
 #include "tint/api/tint.h"
 #include "tint/cmd/common/generate_external_texture_bindings.h"
@@ -58,7 +66,6 @@
 #include "tint/utils/command/command.h"
 #include "tint/utils/containers/transform.h"
 #include "tint/utils/diagnostic/formatter.h"
-#include "tint/utils/diagnostic/printer.h"
 #include "tint/utils/macros/defer.h"
 #include "tint/utils/text/string.h"
 #include "tint/utils/text/string_stream.h"
@@ -132,8 +139,8 @@
 namespace {
 
 /// Prints the given hash value in a format string that the end-to-end test runner can parse.
-[[maybe_unused]] void PrintHash(uint32_t hash) {
-    std::cout << "<<HASH: 0x" << std::hex << hash << ">>" << std::endl;
+[[maybe_unused]] void PrintHash(std::ostream& out, uint32_t hash) {
+    out << "<<HASH: 0x" << std::hex << hash << ">>" << std::endl;
 }
 
 enum class Format {
@@ -147,6 +154,11 @@ enum class Format {
     kGlsl,
 };
 
+enum class InstrumentationFormat {
+    kJson,
+    kChromeTrace,
+};
+
 struct Options {
     bool verbose = false;
 
@@ -184,10 +196,28 @@ struct Options {
 
     bool dump_ir = false;
     bool use_ir = false;
+    tint::OptimizationLevel optimization_level = tint::OptimizationLevel::kNone;
 
 #if TINT_BUILD_SYNTAX_TREE_WRITER
     bool dump_ast = false;
 #endif  // TINT_BUILD_SYNTAX_TREE_WRITER
+
+    // Batch mode compiles every file in `batch_inputs` in a single process.
+    bool batch = false;
+    tint::Vector<std::string, 4> batch_inputs;
+    std::string output_dir;
+    uint32_t jobs = 0;  // 0 uses std::thread::hardware_concurrency()
+
+    // If not empty, the compiler phases are recorded and written to this file.
+    std::string instrumentation_file;
+    InstrumentationFormat instrumentation_format = InstrumentationFormat::kJson;
+    tint::Instrumentation* instrumentation = nullptr;
+
+    // The streams that diagnostics and informational output are written to. In batch mode these
+    // point at per-file buffers so that the output of concurrently compiled files is not
+    // interleaved.
+    std::ostream* err = &std::cerr;
+    std::ostream* out = &std::cout;
 };
 
 /// @param filename the filename to inspect
@@ -297,6 +327,16 @@ When specified, automatically enables MSL validation)",
         "use-ir", "Use the IR for writers and transforms when possible", Default{false});
     TINT_DEFER(opts->use_ir = *use_ir.value);
 
+    tint::Vector<EnumName<tint::OptimizationLevel>, 3> opt_level_enum_names{
+        EnumName(tint::OptimizationLevel::kNone, "none"),
+        EnumName(tint::OptimizationLevel::kBasic, "basic"),
+        EnumName(tint::OptimizationLevel::kFull, "full"),
+    };
+    auto& opt_level = options.Add<EnumOption<tint::OptimizationLevel>>(
+        "opt-level", "The optimization level of the IR, when used by the writer",
+        opt_level_enum_names, Default{tint::OptimizationLevel::kNone});
+    TINT_DEFER(opts->optimization_level = *opt_level.value);
+
     auto& verbose =
         options.Add<BoolOption>("verbose", "Verbose output", ShortName{"v"}, Default{false});
     TINT_DEFER(opts->verbose = *verbose.value);
@@ -403,10 +443,51 @@ of the hash codes in the comma separated list of hashes)");
     auto& overrides = options.Add<StringOption>(
         "overrides", "Override values as IDENTIFIER=VALUE, comma-separated");
 
+    auto& batch =
+        options.Add<BoolOption>("batch", R"(Compile all of the input files in a single process.
+Each output is written next to its input, or to the
+directory given by --output-dir, and is named after the
+input with the output format's extension appended.
+Inputs that would be written to the same output are
+an error)",
+                                Default{false});
+
+    auto& manifest = options.Add<StringOption>("manifest", R"(File that lists the inputs to compile.
+Each line names one input file. Blank lines and lines
+starting with '#' are ignored. Implies --batch)",
+                                               Parameter{"path"});
+
+    auto& output_dir = options.Add<StringOption>(
+        "output-dir", "Directory that batch mode outputs are written to", Parameter{"path"});
+    TINT_DEFER(opts->output_dir = output_dir.value.value_or(""));
+
+    auto& jobs = options.Add<ValueOption<uint32_t>>("jobs", R"(Number of threads used by batch mode.
+Defaults to the number of hardware threads)",
+                                                    ShortName{"j"}, Parameter{"count"});
+    TINT_DEFER(opts->jobs = jobs.value.value_or(0));
+
+    auto& instrumentation = options.Add<StringOption>(
+        "instrumentation", R"(Records the time and memory used by each compiler phase,
+and writes them to the given file)",
+        Parameter{"path"});
+    TINT_DEFER(opts->instrumentation_file = instrumentation.value.value_or(""));
+
+    tint::Vector<EnumName<InstrumentationFormat>, 2> instrumentation_format_enum_names{
+        EnumName(InstrumentationFormat::kJson, "json"),
+        EnumName(InstrumentationFormat::kChromeTrace, "trace"),
+    };
+    auto& instrumentation_format = options.Add<EnumOption<InstrumentationFormat>>(
+        "instrumentation-format", R"(The format of the --instrumentation file.
+'trace' is the Chrome trace event format)",
+        instrumentation_format_enum_names, Default{InstrumentationFormat::kJson});
+    TINT_DEFER(opts->instrumentation_format = *instrumentation_format.value);
+
     auto& help = options.Add<BoolOption>("help", "Show usage", ShortName{"h"});
 
     auto show_usage = [&] {
         std::cout << R"(Usage: tint [options] <input-file>
+       tint [options] --batch <input-file>...
+       tint [options] --manifest <path>
 
 Options:
 )";
@@ -489,9 +570,42 @@ Options:
     }
 
     auto files = result.Get();
+    if (manifest.value.has_value() || batch.value.value_or(false)) {
+        opts->batch = true;
+        for (auto& file : files) {
+            opts->batch_inputs.Push(std::string(file));
+        }
+        if (manifest.value.has_value()) {
+            std::ifstream manifest_file(*manifest.value);
+            if (!manifest_file) {
+                std::cerr << "Failed to open manifest " << *manifest.value << std::endl;
+                return false;
+            }
+            std::string line;
+            while (std::getline(manifest_file, line)) {
+                auto input = tint::TrimSpace(line);
+                if (input.empty() || input[0] == '#') {
+                    continue;
+                }
+                opts->batch_inputs.Push(std::string(input));
+            }
+        }
+        if (opts->batch_inputs.IsEmpty()) {
+            std::cerr << "No input files specified for batch mode" << std::endl;
+            return false;
+        }
+        if (output.value.has_value()) {
+            std::cerr << "--output-name cannot be used in batch mode, use --output-dir instead"
+                      << std::endl;
+            return false;
+        }
+        return true;
+    }
+
     if (files.Length() > 1) {
         std::cerr << "More than one input file specified: "
-                  << tint::Join(Transform(files, tint::Quote), ", ") << std::endl;
+                  << tint::Join(Transform(files, tint::Quote), ", ")
+                  << ". Use --batch to compile multiple files." << std::endl;
         return false;
     }
     if (files.Length() == 1) {
@@ -504,13 +618,14 @@ Options:
 /// Writes the given `buffer` into the file named as `output_file` using the
 /// given `mode`.  If `output_file` is empty or "-", writes to standard
 /// output. If any error occurs, returns false and outputs error message to
-/// standard error. The ContainerT type must have data() and size() methods,
+/// `err`. The ContainerT type must have data() and size() methods,
 /// like `std::string` and `std::vector` do.
 /// @returns true on success
 template <typename ContainerT>
 [[maybe_unused]] bool WriteFile(const std::string& output_file,
                                 const std::string mode,
-                                const ContainerT& buffer) {
+                                const ContainerT& buffer,
+                                std::ostream& err) {
     const bool use_stdout = output_file.empty() || output_file == "-";
     FILE* file = stdout;
 
@@ -521,7 +636,7 @@ template <typename ContainerT>
         file = fopen(output_file.c_str(), mode.c_str());
 #endif
         if (!file) {
-            std::cerr << "Could not open file " << output_file << " for writing" << std::endl;
+            err << "Could not open file " << output_file << " for writing" << std::endl;
             return false;
         }
     }
@@ -530,9 +645,9 @@ template <typename ContainerT>
         fwrite(buffer.data(), sizeof(typename ContainerT::value_type), buffer.size(), file);
     if (buffer.size() != written) {
         if (use_stdout) {
-            std::cerr << "Could not write all output to standard output" << std::endl;
+            err << "Could not write all output to standard output" << std::endl;
         } else {
-            std::cerr << "Could not write to file " << output_file << std::endl;
+            err << "Could not write to file " << output_file << std::endl;
             fclose(file);
         }
         return false;
@@ -545,7 +660,7 @@ template <typename ContainerT>
 }
 
 #if TINT_BUILD_SPV_WRITER
-std::string Disassemble(const std::vector<uint32_t>& data) {
+std::string Disassemble(const std::vector<uint32_t>& data, std::ostream& err) {
     std::string spv_errors;
     spv_target_env target_env = SPV_ENV_VULKAN_1_1;
 
@@ -578,7 +693,7 @@ std::string Disassemble(const std::vector<uint32_t>& data) {
     if (!tools.Disassemble(
             data, &result,
             SPV_BINARY_TO_TEXT_OPTION_INDENT | SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES)) {
-        std::cerr << spv_errors << std::endl;
+        err << spv_errors << std::endl;
     }
     return result;
 }
@@ -596,36 +711,38 @@ bool GenerateSpirv(const tint::Program& program, const Options& options) {
     gen_options.disable_workgroup_init = options.disable_workgroup_init;
     gen_options.bindings = tint::spirv::writer::GenerateBindings(program);
     gen_options.use_tint_ir = options.use_ir;
+    gen_options.optimization_level = options.optimization_level;
 
     auto result = tint::spirv::writer::Generate(program, gen_options);
     if (!result) {
-        tint::cmd::PrintWGSL(std::cerr, program);
-        std::cerr << "Failed to generate: " << result.Failure() << std::endl;
+        tint::cmd::PrintWGSL(*options.err, program);
+        *options.err << "Failed to generate: " << result.Failure() << std::endl;
         return false;
     }
 
     if (options.format == Format::kSpvAsm) {
-        if (!WriteFile(options.output_file, "w", Disassemble(result.Get().spirv))) {
+        if (!WriteFile(options.output_file, "w", Disassemble(result.Get().spirv, *options.err),
+                       *options.err)) {
             return false;
         }
     } else {
-        if (!WriteFile(options.output_file, "wb", result.Get().spirv)) {
+        if (!WriteFile(options.output_file, "wb", result.Get().spirv, *options.err)) {
             return false;
         }
     }
 
     const auto hash = tint::CRC32(result.Get().spirv.data(), result.Get().spirv.size());
     if (options.print_hash) {
-        PrintHash(hash);
+        PrintHash(*options.out, hash);
     }
 
     if (options.validate && options.skip_hash.count(hash) == 0) {
         // Use Vulkan 1.1, since this is what Tint, internally, uses.
         spvtools::SpirvTools tools(SPV_ENV_VULKAN_1_1);
-        tools.SetMessageConsumer(
-            [](spv_message_level_t, const char*, const spv_position_t& pos, const char* msg) {
-                std::cerr << (pos.line + 1) << ":" << (pos.column + 1) << ": " << msg << std::endl;
-            });
+        tools.SetMessageConsumer([&](spv_message_level_t, const char*, const spv_position_t& pos,
+                                     const char* msg) {
+            *options.err << (pos.line + 1) << ":" << (pos.column + 1) << ": " << msg << std::endl;
+        });
         if (!tools.Validate(result.Get().spirv.data(), result.Get().spirv.size(),
                             spvtools::ValidatorOptions())) {
             return false;
@@ -636,7 +753,7 @@ bool GenerateSpirv(const tint::Program& program, const Options& options) {
 #else
     (void)program;
     (void)options;
-    std::cerr << "SPIR-V writer not enabled in tint build" << std::endl;
+    *options.err << "SPIR-V writer not enabled in tint build" << std::endl;
     return false;
 #endif  // TINT_BUILD_SPV_WRITER
 }
@@ -652,17 +769,17 @@ bool GenerateWgsl([[maybe_unused]] const tint::Program& program,
     tint::wgsl::writer::Options gen_options;
     auto result = tint::wgsl::writer::Generate(program, gen_options);
     if (!result) {
-        std::cerr << "Failed to generate: " << result.Failure() << std::endl;
+        *options.err << "Failed to generate: " << result.Failure() << std::endl;
         return false;
     }
 
-    if (!WriteFile(options.output_file, "w", result->wgsl)) {
+    if (!WriteFile(options.output_file, "w", result->wgsl, *options.err)) {
         return false;
     }
 
     const auto hash = tint::CRC32(result->wgsl.data(), result->wgsl.size());
     if (options.print_hash) {
-        PrintHash(hash);
+        PrintHash(*options.out, hash);
     }
 
 #if TINT_BUILD_WGSL_READER
@@ -671,9 +788,8 @@ bool GenerateWgsl([[maybe_unused]] const tint::Program& program,
         auto source = std::make_unique<tint::Source::File>(options.input_filename, result->wgsl);
         auto reparsed_program = tint::wgsl::reader::Parse(source.get());
         if (!reparsed_program.IsValid()) {
-            auto diag_printer = tint::diag::Printer::create(stderr, true);
             tint::diag::Formatter diag_formatter;
-            diag_formatter.format(reparsed_program.Diagnostics(), diag_printer.get());
+            *options.err << diag_formatter.format(reparsed_program.Diagnostics());
             return false;
         }
     }
@@ -681,7 +797,7 @@ bool GenerateWgsl([[maybe_unused]] const tint::Program& program,
 
     return true;
 #else
-    std::cerr << "WGSL writer not enabled in tint build" << std::endl;
+    *options.err << "WGSL writer not enabled in tint build" << std::endl;
     return false;
 #endif  // TINT_BUILD_WGSL_WRITER
 }
@@ -693,7 +809,7 @@ bool GenerateWgsl([[maybe_unused]] const tint::Program& program,
 bool GenerateMsl([[maybe_unused]] const tint::Program& program,
                  [[maybe_unused]] const Options& options) {
 #if !TINT_BUILD_MSL_WRITER
-    std::cerr << "MSL writer not enabled in tint build" << std::endl;
+    *options.err << "MSL writer not enabled in tint build" << std::endl;
     return false;
 #else
     // Remap resource numbers to a flat namespace.
@@ -707,6 +823,7 @@ bool GenerateMsl([[maybe_unused]] const tint::Program& program,
     // TODO(jrprice): Provide a way for the user to set non-default options.
     tint::msl::writer::Options gen_options;
     gen_options.use_tint_ir = options.use_ir;
+    gen_options.optimization_level = options.optimization_level;
     gen_options.disable_robustness = !options.enable_robustness;
     gen_options.disable_workgroup_init = options.disable_workgroup_init;
     gen_options.pixel_local_options = options.pixel_local_options;
@@ -719,18 +836,18 @@ bool GenerateMsl([[maybe_unused]] const tint::Program& program,
                                                                           1);
     auto result = tint::msl::writer::Generate(*input_program, gen_options);
     if (!result) {
-        tint::cmd::PrintWGSL(std::cerr, program);
-        std::cerr << "Failed to generate: " << result.Failure() << std::endl;
+        tint::cmd::PrintWGSL(*options.err, program);
+        *options.err << "Failed to generate: " << result.Failure() << std::endl;
         return false;
     }
 
-    if (!WriteFile(options.output_file, "w", result->msl)) {
+    if (!WriteFile(options.output_file, "w", result->msl, *options.err)) {
         return false;
     }
 
     const auto hash = tint::CRC32(result->msl.c_str());
     if (options.print_hash) {
-        PrintHash(hash);
+        PrintHash(*options.out, hash);
     }
 
     // Default to validating against MSL 1.2.
@@ -765,7 +882,7 @@ bool GenerateMsl([[maybe_unused]] const tint::Program& program,
         }
 #endif  // __APPLE__
         if (res.failed) {
-            std::cerr << res.output << std::endl;
+            *options.err << res.output << std::endl;
             return false;
         }
     }
@@ -789,18 +906,18 @@ bool GenerateHlsl(const tint::Program& program, const Options& options) {
     gen_options.root_constant_binding_point = options.hlsl_root_constant_binding_point;
     auto result = tint::hlsl::writer::Generate(program, gen_options);
     if (!result) {
-        tint::cmd::PrintWGSL(std::cerr, program);
-        std::cerr << "Failed to generate: " << result.Failure() << std::endl;
+        tint::cmd::PrintWGSL(*options.err, program);
+        *options.err << "Failed to generate: " << result.Failure() << std::endl;
         return false;
     }
 
-    if (!WriteFile(options.output_file, "w", result->hlsl)) {
+    if (!WriteFile(options.output_file, "w", result->hlsl, *options.err)) {
         return false;
     }
 
     const auto hash = tint::CRC32(result->hlsl.c_str());
     if (options.print_hash) {
-        PrintHash(hash);
+        PrintHash(*options.out, hash);
     }
 
     // If --fxc or --dxc was passed, then we must explicitly find and validate with that respective
@@ -862,28 +979,28 @@ bool GenerateHlsl(const tint::Program& program, const Options& options) {
         }
 
         if (fxc_res.failed) {
-            std::cerr << "FXC validation failure:" << std::endl << fxc_res.output << std::endl;
+            *options.err << "FXC validation failure:" << std::endl << fxc_res.output << std::endl;
         }
         if (dxc_res.failed) {
-            std::cerr << "DXC validation failure:" << std::endl << dxc_res.output << std::endl;
+            *options.err << "DXC validation failure:" << std::endl << dxc_res.output << std::endl;
         }
         if (fxc_res.failed || dxc_res.failed) {
             return false;
         }
         if (!fxc_found && !dxc_found) {
-            std::cerr << "Couldn't find FXC or DXC. Cannot validate" << std::endl;
+            *options.err << "Couldn't find FXC or DXC. Cannot validate" << std::endl;
             return false;
         }
         if (options.verbose) {
             if (fxc_found && !fxc_res.failed) {
-                std::cout << "Passed FXC validation" << std::endl;
-                std::cout << fxc_res.output;
-                std::cout << std::endl;
+                *options.out << "Passed FXC validation" << std::endl;
+                *options.out << fxc_res.output;
+                *options.out << std::endl;
             }
             if (dxc_found && !dxc_res.failed) {
-                std::cout << "Passed DXC validation" << std::endl;
-                std::cout << dxc_res.output;
-                std::cout << std::endl;
+                *options.out << "Passed DXC validation" << std::endl;
+                *options.out << dxc_res.output;
+                *options.out << std::endl;
             }
         }
     }
@@ -892,7 +1009,7 @@ bool GenerateHlsl(const tint::Program& program, const Options& options) {
 #else
     (void)program;
     (void)options;
-    std::cerr << "HLSL writer not enabled in tint build" << std::endl;
+    *options.err << "HLSL writer not enabled in tint build" << std::endl;
     return false;
 #endif  // TINT_BUILD_HLSL_WRITER
 }
@@ -904,12 +1021,13 @@ bool GenerateHlsl(const tint::Program& program, const Options& options) {
 bool GenerateGlsl([[maybe_unused]] const tint::Program& program,
                   [[maybe_unused]] const Options& options) {
 #if !TINT_BUILD_GLSL_WRITER
-    std::cerr << "GLSL writer not enabled in tint build" << std::endl;
+    *options.err << "GLSL writer not enabled in tint build" << std::endl;
     return false;
 #else
     auto generate = [&](const tint::Program& prg, const std::string entry_point_name) -> bool {
         tint::glsl::writer::Options gen_options;
         gen_options.disable_robustness = !options.enable_robustness;
+        gen_options.optimization_level = options.optimization_level;
         gen_options.external_texture_options.bindings_map =
             tint::cmd::GenerateExternalTextureBindings(prg);
         tint::TextureBuiltinsFromUniformOptions textureBuiltinsFromUniform;
@@ -918,28 +1036,28 @@ bool GenerateGlsl([[maybe_unused]] const tint::Program& program,
         gen_options.texture_builtins_from_uniform = std::move(textureBuiltinsFromUniform);
         auto result = tint::glsl::writer::Generate(prg, gen_options, entry_point_name);
         if (!result) {
-            tint::cmd::PrintWGSL(std::cerr, prg);
-            std::cerr << "Failed to generate: " << result.Failure() << std::endl;
+            tint::cmd::PrintWGSL(*options.err, prg);
+            *options.err << "Failed to generate: " << result.Failure() << std::endl;
             return false;
         }
 
-        if (!WriteFile(options.output_file, "w", result->glsl)) {
+        if (!WriteFile(options.output_file, "w", result->glsl, *options.err)) {
             return false;
         }
 
         const auto hash = tint::CRC32(result->glsl.c_str());
         if (options.print_hash) {
-            PrintHash(hash);
+            PrintHash(*options.out, hash);
         }
 
         if (options.validate && options.skip_hash.count(hash) == 0) {
 #if !TINT_BUILD_GLSL_VALIDATOR
-            std::cerr << "GLSL validator not enabled in tint build" << std::endl;
+            *options.err << "GLSL validator not enabled in tint build" << std::endl;
             return false;
 #else
             auto val = tint::glsl::validate::Validate(result->glsl, result->entry_points);
             if (!val) {
-                std::cerr << val.Failure();
+                *options.err << val.Failure();
                 return false;
             }
 #endif
@@ -963,153 +1081,69 @@ bool GenerateGlsl([[maybe_unused]] const tint::Program& program,
 #endif  // TINT_BUILD_GLSL_WRITER
 }
 
-}  // namespace
-
-int main(int argc, const char** argv) {
-    tint::Vector<std::string_view, 8> arguments;
-    for (int i = 1; i < argc; i++) {
-        std::string_view arg(argv[i]);
-        if (!arg.empty()) {
-            arguments.Push(argv[i]);
-        }
-    }
-
-    Options options;
-
-    tint::Initialize();
-    tint::SetInternalCompilerErrorReporter(&tint::cmd::TintInternalCompilerErrorReporter);
-
-    struct TransformFactory {
-        const char* name;
-        /// Build and adds the transform to the transform manager.
-        /// Parameters:
-        ///   inspector - an inspector created from the parsed program
-        ///   manager   - the transform manager. Add transforms to this.
-        ///   inputs    - the input data to the transform manager. Add inputs to this.
-        /// Returns true on success, false on error (program will immediately exit)
-        std::function<bool(tint::inspector::Inspector& inspector,
-                           tint::ast::transform::Manager& manager,
-                           tint::ast::transform::DataMap& inputs)>
-            make;
-    };
-    std::vector<TransformFactory> transforms = {
-        {"first_index_offset",
-         [](tint::inspector::Inspector&, tint::ast::transform::Manager& m,
-            tint::ast::transform::DataMap& i) {
-             i.Add<tint::ast::transform::FirstIndexOffset::BindingPoint>(0, 0);
-             m.Add<tint::ast::transform::FirstIndexOffset>();
-             return true;
-         }},
-        {"renamer",
-         [](tint::inspector::Inspector&, tint::ast::transform::Manager& m,
-            tint::ast::transform::DataMap&) {
-             m.Add<tint::ast::transform::Renamer>();
-             return true;
-         }},
-        {"robustness",
-         [&](tint::inspector::Inspector&, tint::ast::transform::Manager&,
-             tint::ast::transform::DataMap&) {  // enabled via writer option
-             options.enable_robustness = true;
-             return true;
-         }},
-        {"substitute_override",
-         [&](tint::inspector::Inspector& inspector, tint::ast::transform::Manager& m,
-             tint::ast::transform::DataMap& i) {
-             tint::ast::transform::SubstituteOverride::Config cfg;
-
-             std::unordered_map<tint::OverrideId, double> values;
-             values.reserve(options.overrides.Count());
-
-             for (auto override : options.overrides) {
-                 const auto& name = override.key;
-                 const auto& value = override.value;
-                 if (name.empty()) {
-                     std::cerr << "empty override name" << std::endl;
-                     return false;
-                 }
-                 if (auto num = tint::ParseNumber<decltype(tint::OverrideId::value)>(name)) {
-                     tint::OverrideId id{num.Get()};
-                     values.emplace(id, value);
-                 } else {
-                     auto override_names = inspector.GetNamedOverrideIds();
-                     auto it = override_names.find(name);
-                     if (it == override_names.end()) {
-                         std::cerr << "unknown override '" << name << "'" << std::endl;
-                         return false;
-                     }
-                     values.emplace(it->second, value);
-                 }
-             }
-
-             cfg.map = std::move(values);
-
-             i.Add<tint::ast::transform::SubstituteOverride::Config>(cfg);
-             m.Add<tint::ast::transform::SubstituteOverride>();
-             return true;
-         }},
-    };
-    auto transform_names = [&] {
-        tint::StringStream names;
-        for (auto& t : transforms) {
-            names << "   " << t.name << std::endl;
-        }
-        return names.str();
-    };
-
-    if (!ParseArgs(arguments, transform_names(), &options)) {
-        return 1;
-    }
-
-    // Implement output format defaults.
-    if (options.format == Format::kUnknown) {
-        // Try inferring from filename.
-        options.format = infer_format(options.output_file);
-    }
-    if (options.format == Format::kUnknown) {
-        // Ultimately, default to SPIR-V assembly. That's nice for interactive use.
-        options.format = Format::kSpvAsm;
-    }
-
-    tint::cmd::LoadProgramOptions opts;
-    opts.filename = options.input_filename;
-#if TINT_BUILD_SPV_READER
-    opts.spirv_reader_options = options.spirv_reader_options;
-#endif
-
-    auto info = tint::cmd::LoadProgramInfo(opts);
+/// A transform that can be enabled with --transform.
+struct TransformFactory {
+    const char* name;
+    /// Build and adds the transform to the transform manager.
+    /// Parameters:
+    ///   options   - the options for the program being compiled
+    ///   inspector - an inspector created from the parsed program
+    ///   manager   - the transform manager. Add transforms to this.
+    ///   inputs    - the input data to the transform manager. Add inputs to this.
+    /// Returns true on success, false on error (compilation of the program fails)
+    std::function<bool(Options& options,
+                       tint::inspector::Inspector& inspector,
+                       tint::ast::transform::Manager& manager,
+                       tint::ast::transform::DataMap& inputs)>
+        make;
+};
 
-    if (options.parse_only) {
-        return 1;
+/// @param transforms the list of transform factories
+/// @returns the names of the transforms, one per line
+std::string TransformNames(const std::vector<TransformFactory>& transforms) {
+    tint::StringStream names;
+    for (auto& t : transforms) {
+        names << "   " << t.name << std::endl;
     }
+    return names.str();
+}
 
+/// Runs the transforms and the writer selected by `options` on the parsed program.
+/// @param input the parsed program
+/// @param options the options for the program being compiled
+/// @param transforms the transforms that can be enabled with --transform
+/// @returns true on success
+bool Compile(const tint::Program& input,
+             Options& options,
+             const std::vector<TransformFactory>& transforms) {
 #if TINT_BUILD_SYNTAX_TREE_WRITER
     if (options.dump_ast) {
         tint::wgsl::writer::Options gen_options;
         gen_options.use_syntax_tree_writer = true;
-        auto result = tint::wgsl::writer::Generate(info.program, gen_options);
+        auto result = tint::wgsl::writer::Generate(input, gen_options);
         if (!result) {
-            std::cerr << "Failed to dump AST: " << result.Failure() << std::endl;
+            *options.err << "Failed to dump AST: " << result.Failure() << std::endl;
         } else {
-            std::cout << result->wgsl << std::endl;
+            *options.out << result->wgsl << std::endl;
         }
     }
 #endif  // TINT_BUILD_SYNTAX_TREE_WRITER
 
 #if TINT_BUILD_WGSL_READER
     if (options.dump_ir) {
-        auto result = tint::wgsl::reader::ProgramToIR(info.program);
+        auto result = tint::wgsl::reader::ProgramToIR(input);
         if (!result) {
-            std::cerr << "Failed to build IR from program: " << result.Failure() << std::endl;
+            *options.err << "Failed to build IR from program: " << result.Failure() << std::endl;
         } else {
             auto mod = result.Move();
             if (options.dump_ir) {
-                std::cout << tint::core::ir::Disassemble(mod) << std::endl;
+                *options.out << tint::core::ir::Disassemble(mod) << std::endl;
             }
         }
     }
 #endif  // TINT_BUILD_WGSL_READER
 
-    tint::inspector::Inspector inspector(info.program);
+    tint::inspector::Inspector inspector(input);
     if (options.dump_inspector_bindings) {
         tint::cmd::PrintInspectorBindings(inspector);
     }
@@ -1160,19 +1194,20 @@ int main(int argc, const char** argv) {
     auto enable_transform = [&](std::string_view name) {
         for (auto& t : transforms) {
             if (t.name == name) {
-                return t.make(inspector, transform_manager, transform_inputs);
+                return t.make(options, inspector, transform_manager, transform_inputs);
             }
         }
 
-        std::cerr << "Unknown transform: " << name << std::endl;
-        std::cerr << "Available transforms: " << std::endl << transform_names() << std::endl;
+        *options.err << "Unknown transform: " << name << std::endl;
+        *options.err << "Available transforms: " << std::endl
+                     << TransformNames(transforms) << std::endl;
         return false;
     };
 
     // If overrides are provided, add the SubstituteOverride transform.
     if (!options.overrides.IsEmpty()) {
         if (!enable_transform("substitute_override")) {
-            return 1;
+            return false;
         }
     }
 
@@ -1181,7 +1216,7 @@ int main(int argc, const char** argv) {
         // be run that needs user input. Should we find a way to support that here
         // maybe through a provided file?
         if (!enable_transform(name)) {
-            return 1;
+            return false;
         }
     }
 
@@ -1191,40 +1226,369 @@ int main(int argc, const char** argv) {
     }
 
     tint::ast::transform::DataMap outputs;
-    auto program = transform_manager.Run(info.program, std::move(transform_inputs), outputs);
+    auto program = transform_manager.Run(input, std::move(transform_inputs), outputs);
     if (!program.IsValid()) {
-        tint::cmd::PrintWGSL(std::cerr, program);
-        std::cerr << program.Diagnostics() << std::endl;
-        return 1;
+        tint::cmd::PrintWGSL(*options.err, program);
+        *options.err << program.Diagnostics() << std::endl;
+        return false;
     }
 
-    bool success = false;
     switch (options.format) {
         case Format::kSpirv:
         case Format::kSpvAsm:
-            success = GenerateSpirv(program, options);
-            break;
+            return GenerateSpirv(program, options);
         case Format::kWgsl:
-            success = GenerateWgsl(program, options);
-            break;
+            return GenerateWgsl(program, options);
         case Format::kMsl:
-            success = GenerateMsl(program, options);
-            break;
+            return GenerateMsl(program, options);
         case Format::kHlsl:
-            success = GenerateHlsl(program, options);
-            break;
+            return GenerateHlsl(program, options);
         case Format::kGlsl:
-            success = GenerateGlsl(program, options);
-            break;
+            return GenerateGlsl(program, options);
         case Format::kNone:
-            break;
+            return true;
+        default:
+            *options.err << "Unknown output format specified" << std::endl;
+            return false;
+    }
+}
+
+/// @param format the output format
+/// @returns the file extension used for outputs of the given format
+std::string_view FormatExtension(Format format) {
+    switch (format) {
+        case Format::kSpirv:
+            return ".spv";
+        case Format::kSpvAsm:
+            return ".spvasm";
+        case Format::kWgsl:
+            return ".wgsl";
+        case Format::kMsl:
+            return ".metal";
+        case Format::kHlsl:
+            return ".hlsl";
+        case Format::kGlsl:
+            return ".glsl";
         default:
-            std::cerr << "Unknown output format specified" << std::endl;
+            return "";
+    }
+}
+
+/// @param options the batch options
+/// @param input_filename the name of the input file
+/// @returns the name of the file that batch mode writes the output for `input_filename` to.
+/// The output format's extension is appended to the input name, so that an output is never
+/// written over its input.
+std::string BatchOutputFilename(const Options& options, const std::string& input_filename) {
+    std::string name = input_filename;
+    if (!options.output_dir.empty()) {
+        auto separator = name.find_last_of("/\\");
+        if (separator != std::string::npos) {
+            name = name.substr(separator + 1);
+        }
+        name = options.output_dir + "/" + name;
+    }
+    return name + std::string(FormatExtension(options.format));
+}
+
+#if TINT_BUILD_WGSL_READER
+/// Parses and compiles a single WGSL file of a batch.
+/// Unlike tint::cmd::LoadProgramInfo(), errors are reported to `options.err` and do not terminate
+/// the process.
+/// @param options the options for the file being compiled
+/// @param transforms the transforms that can be enabled with --transform
+/// @returns true on success
+bool CompileBatchFile(Options& options, const std::vector<TransformFactory>& transforms) {
+    if (!tint::HasSuffix(options.input_filename, ".wgsl")) {
+        *options.err << "Batch mode only supports WGSL input: " << options.input_filename
+                     << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    if (!tint::cmd::ReadFile<uint8_t>(options.input_filename, &data)) {
+        return false;
+    }
+    auto source = std::make_unique<tint::Source::File>(options.input_filename,
+                                                       std::string(data.begin(), data.end()));
+    auto program = tint::wgsl::reader::Parse(source.get());
+    if (program.Diagnostics().count() > 0) {
+        tint::diag::Formatter diag_formatter;
+        *options.err << diag_formatter.format(program.Diagnostics());
+    }
+    if (!program.IsValid()) {
+        return false;
+    }
+    if (options.parse_only) {
+        return true;
+    }
+    return Compile(program, options, transforms);
+}
+#endif  // TINT_BUILD_WGSL_READER
+
+/// Compiles each of the batch inputs across `options.jobs` threads, writing a separate output for
+/// each input, then prints a timing summary.
+/// @param options the batch options
+/// @param transforms the transforms that can be enabled with --transform
+/// @returns the process exit code
+int RunBatch([[maybe_unused]] Options options,
+             [[maybe_unused]] const std::vector<TransformFactory>& transforms) {
+#if !TINT_BUILD_WGSL_READER
+    std::cerr << "Tint not built with the WGSL reader enabled" << std::endl;
+    return 1;
+#else
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    // Take the inputs out of the options, so they are not copied for each file.
+    auto inputs = std::move(options.batch_inputs);
+    options.batch_inputs.Clear();
+
+    uint32_t num_threads = options.jobs;
+    if (num_threads == 0) {
+        num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    num_threads = std::min(num_threads, static_cast<uint32_t>(inputs.Length()));
+
+    // Each input must be written to its own output, otherwise the workers would write the same
+    // file concurrently. This happens when --output-dir is given inputs from different
+    // directories with the same file name, or when an input is listed more than once.
+    if (!options.parse_only && options.format != Format::kNone) {
+        std::unordered_map<std::string, std::string> output_inputs;
+        for (auto& input : inputs) {
+            auto res = output_inputs.emplace(BatchOutputFilename(options, input), input);
+            if (!res.second) {
+                std::cerr << "Batch inputs " << res.first->second << " and " << input
+                          << " would both be written to " << res.first->first << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    struct FileResult {
+        bool success = false;
+        double ms = 0;
+    };
+    std::vector<FileResult> results(inputs.Length());
+    std::atomic<size_t> next_file{0};
+    std::mutex output_mutex;
+
+    auto start = Clock::now();
+    auto worker = [&] {
+        for (size_t i = next_file++; i < inputs.Length(); i = next_file++) {
+            // Buffer the output of each file, so that it is printed in one piece.
+            std::ostringstream err;
+            std::ostringstream out;
+            Options file_options = options;
+            file_options.input_filename = inputs[i];
+            file_options.output_file = BatchOutputFilename(options, inputs[i]);
+            file_options.err = &err;
+            file_options.out = &out;
+
+            std::optional<tint::Instrumentation::Scope> instrumentation_scope;
+            if (options.instrumentation) {
+                instrumentation_scope.emplace(*options.instrumentation);
+            }
+
+            auto file_start = Clock::now();
+            bool success = CompileBatchFile(file_options, transforms);
+            double ms = Milliseconds(Clock::now() - file_start).count();
+            results[i] = {success, ms};
+
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cout << out.str();
+            std::cerr << err.str();
+            if (options.verbose) {
+                std::cout << inputs[i] << ": " << (success ? "" : "FAILED, ") << ms << " ms"
+                          << std::endl;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (uint32_t i = 0; i < num_threads; i++) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double wall_ms = Milliseconds(Clock::now() - start).count();
+
+    size_t num_failed = 0;
+    double total_ms = 0;
+    size_t slowest = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        num_failed += results[i].success ? 0 : 1;
+        total_ms += results[i].ms;
+        if (results[i].ms > results[slowest].ms) {
+            slowest = i;
+        }
+    }
+
+    std::cout << "Batch summary:" << std::endl;
+    std::cout << "  files:     " << inputs.Length() << " (" << num_failed << " failed)"
+              << std::endl;
+    std::cout << "  threads:   " << num_threads << std::endl;
+    std::cout << "  wall time: " << wall_ms << " ms ("
+              << (static_cast<double>(inputs.Length()) * 1000.0 / std::max(wall_ms, 1e-3))
+              << " files/s)" << std::endl;
+    std::cout << "  file time: " << total_ms << " ms total, "
+              << (total_ms / static_cast<double>(inputs.Length())) << " ms average, "
+              << results[slowest].ms << " ms slowest (" << inputs[slowest] << ")" << std::endl;
+    if (num_failed > 0) {
+        std::cout << "Failed files:" << std::endl;
+        for (size_t i = 0; i < results.size(); i++) {
+            if (!results[i].success) {
+                std::cout << "  " << inputs[i] << std::endl;
+            }
+        }
+        return 1;
+    }
+    return 0;
+#endif  // TINT_BUILD_WGSL_READER
+}
+
+/// Writes the phases recorded by `options.instrumentation` to `options.instrumentation_file`.
+/// @param options the options
+/// @returns true on success
+bool WriteInstrumentation(const Options& options) {
+    std::string data;
+    switch (options.instrumentation_format) {
+        case InstrumentationFormat::kJson:
+            data = options.instrumentation->ToJson();
+            break;
+        case InstrumentationFormat::kChromeTrace:
+            data = options.instrumentation->ToChromeTrace();
+            break;
+    }
+    return WriteFile(options.instrumentation_file, "w", data, std::cerr);
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+    tint::Vector<std::string_view, 8> arguments;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg(argv[i]);
+        if (!arg.empty()) {
+            arguments.Push(argv[i]);
+        }
+    }
+
+    Options options;
+
+    tint::Initialize();
+    tint::SetInternalCompilerErrorReporter(&tint::cmd::TintInternalCompilerErrorReporter);
+
+    std::vector<TransformFactory> transforms = {
+        {"first_index_offset",
+         [](Options&, tint::inspector::Inspector&, tint::ast::transform::Manager& m,
+            tint::ast::transform::DataMap& i) {
+             i.Add<tint::ast::transform::FirstIndexOffset::BindingPoint>(0, 0);
+             m.Add<tint::ast::transform::FirstIndexOffset>();
+             return true;
+         }},
+        {"renamer",
+         [](Options&, tint::inspector::Inspector&, tint::ast::transform::Manager& m,
+            tint::ast::transform::DataMap&) {
+             m.Add<tint::ast::transform::Renamer>();
+             return true;
+         }},
+        {"robustness",
+         [](Options& opts, tint::inspector::Inspector&, tint::ast::transform::Manager&,
+            tint::ast::transform::DataMap&) {  // enabled via writer option
+             opts.enable_robustness = true;
+             return true;
+         }},
+        {"substitute_override",
+         [](Options& opts, tint::inspector::Inspector& inspector,
+            tint::ast::transform::Manager& m, tint::ast::transform::DataMap& i) {
+             tint::ast::transform::SubstituteOverride::Config cfg;
+
+             std::unordered_map<tint::OverrideId, double> values;
+             values.reserve(opts.overrides.Count());
+
+             for (auto override : opts.overrides) {
+                 const auto& name = override.key;
+                 const auto& value = override.value;
+                 if (name.empty()) {
+                     *opts.err << "empty override name" << std::endl;
+                     return false;
+                 }
+                 if (auto num = tint::ParseNumber<decltype(tint::OverrideId::value)>(name)) {
+                     tint::OverrideId id{num.Get()};
+                     values.emplace(id, value);
+                 } else {
+                     auto override_names = inspector.GetNamedOverrideIds();
+                     auto it = override_names.find(name);
+                     if (it == override_names.end()) {
+                         *opts.err << "unknown override '" << name << "'" << std::endl;
+                         return false;
+                     }
+                     values.emplace(it->second, value);
+                 }
+             }
+
+             cfg.map = std::move(values);
+
+             i.Add<tint::ast::transform::SubstituteOverride::Config>(cfg);
+             m.Add<tint::ast::transform::SubstituteOverride>();
+             return true;
+         }},
+    };
+
+    if (!ParseArgs(arguments, TransformNames(transforms), &options)) {
+        return 1;
+    }
+
+    // Implement output format defaults.
+    if (options.format == Format::kUnknown) {
+        // Try inferring from filename.
+        options.format = infer_format(options.output_file);
+    }
+    if (options.format == Format::kUnknown) {
+        // Ultimately, default to SPIR-V assembly. That's nice for interactive use.
+        options.format = Format::kSpvAsm;
+    }
+
+    std::optional<tint::Instrumentation> instrumentation;
+    if (!options.instrumentation_file.empty()) {
+        instrumentation.emplace();
+        options.instrumentation = &instrumentation.value();
+    }
+
+    if (options.batch) {
+        if (options.dump_inspector_bindings) {
+            std::cerr << "--dump-inspector-bindings cannot be used in batch mode" << std::endl;
             return 1;
+        }
+        int exit_code = RunBatch(options, transforms);
+        if (instrumentation && !WriteInstrumentation(options)) {
+            return 1;
+        }
+        return exit_code;
     }
-    if (!success) {
+
+    std::optional<tint::Instrumentation::Scope> instrumentation_scope;
+    if (instrumentation) {
+        instrumentation_scope.emplace(*instrumentation);
+    }
+
+    tint::cmd::LoadProgramOptions opts;
+    opts.filename = options.input_filename;
+#if TINT_BUILD_SPV_READER
+    opts.spirv_reader_options = options.spirv_reader_options;
+#endif
+
+    auto info = tint::cmd::LoadProgramInfo(opts);
+
+    // Like a failed compile, --parse-only exits with 1.
+    bool success = !options.parse_only && Compile(info.program, options, transforms);
+
+    if (instrumentation && !WriteInstrumentation(options)) {
         return 1;
     }
 
-    return 0;
+    return success ? 0 : 1;
 }
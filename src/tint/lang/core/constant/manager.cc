@@ -54,6 +54,11 @@ Manager& Manager::operator=(Manager&& rhs) = default;
 
 Manager::~Manager() = default;
 
+void Manager::Clear() {
+    values_.Clear();
+    types.Clear();
+}
+
 const constant::Value* Manager::Composite(const core::type::Type* type,
                                           VectorRef<const constant::Value*> elements) {
     if (elements.IsEmpty()) {
@@ -80,6 +80,10 @@ class Manager final {
         return out;
     }
 
+    /// Destructs all the constants and types owned by the manager, but retains the memory used to
+    /// allocate them so that it can be reused for the constants of the next module.
+    void Clear();
+
     /// @param args the arguments used to construct the type, unique node or node.
     /// @return a pointer to an instance of `T` with the provided arguments.
     ///         If NODE derives from UniqueNode and an existing instance of `T` has been
@@ -103,20 +103,31 @@ static inline void SortCandidates(Candidates& candidates) {
 /// @param intrinsic the intrinsic being called
 /// @param intrinsic_name the name of the intrinsic
 /// @param args the argument types
-/// @param templates initial template state. This may contain explicitly specified template
-///                  arguments. For example `vec3<f32>()` would have the first template-type
-///                  defined as `f32`.
+/// @param template_arg the optional explicitly specified template argument. For example
+///                     `vec3<f32>()` would have the first template-type defined as `f32`.
 /// @param on_no_match an error callback when no intrinsic overloads matched the provided
 ///                    arguments.
 /// @returns the matched intrinsic
+/// @note if the context has an OverloadCache, then successful matches are added to the cache, and
+/// a match already in the cache is returned without evaluating any overloads.
 Result<Overload> MatchIntrinsic(Context& context,
                                 const IntrinsicInfo& intrinsic,
                                 std::string_view intrinsic_name,
                                 VectorRef<const core::type::Type*> args,
                                 EvaluationStage earliest_eval_stage,
-                                TemplateState templates,
+                                const core::type::Type* template_arg,
                                 const OnNoMatch& on_no_match);
 
+/// Evaluates all the overloads of the intrinsic to find the one that matches the provided argument
+/// types. Parameters are as for MatchIntrinsic().
+Result<Overload> ResolveIntrinsic(Context& context,
+                                  const IntrinsicInfo& intrinsic,
+                                  std::string_view intrinsic_name,
+                                  VectorRef<const core::type::Type*> args,
+                                  EvaluationStage earliest_eval_stage,
+                                  TemplateState templates,
+                                  const OnNoMatch& on_no_match);
+
 /// Evaluates the single overload for the provided argument types.
 /// @param context the intrinsic context
 /// @param overload the overload being considered
@@ -211,8 +222,39 @@ Result<Overload> MatchIntrinsic(Context& context,
                                 std::string_view intrinsic_name,
                                 VectorRef<const core::type::Type*> args,
                                 EvaluationStage earliest_eval_stage,
-                                TemplateState templates,
+                                const core::type::Type* template_arg,
                                 const OnNoMatch& on_no_match) {
+    // If a template type was provided, then close the 0'th type with this.
+    TemplateState templates;
+    if (template_arg) {
+        templates.Type(0, template_arg);
+    }
+
+    if (!context.cache) {
+        return ResolveIntrinsic(context, intrinsic, intrinsic_name, args, earliest_eval_stage,
+                                std::move(templates), on_no_match);
+    }
+
+    OverloadKey key{&intrinsic, template_arg, args, earliest_eval_stage};
+    if (auto cached = context.cache->Get(key)) {
+        return *cached;
+    }
+
+    auto overload = ResolveIntrinsic(context, intrinsic, intrinsic_name, args,
+                                     earliest_eval_stage, std::move(templates), on_no_match);
+    if (overload) {
+        context.cache->Add(std::move(key), overload.Get());
+    }
+    return overload;
+}
+
+Result<Overload> ResolveIntrinsic(Context& context,
+                                  const IntrinsicInfo& intrinsic,
+                                  std::string_view intrinsic_name,
+                                  VectorRef<const core::type::Type*> args,
+                                  EvaluationStage earliest_eval_stage,
+                                  TemplateState templates,
+                                  const OnNoMatch& on_no_match) {
     size_t num_matched = 0;
     size_t match_idx = 0;
     Vector<Candidate, kNumFixedCandidates> candidates;
@@ -617,7 +659,21 @@ Result<Overload> LookupFn(Context& context,
 
     // Resolve the intrinsic overload
     return MatchIntrinsic(context, context.data.builtins[function_id], intrinsic_name, args,
-                          earliest_eval_stage, TemplateState{}, on_no_match);
+                          earliest_eval_stage, nullptr, on_no_match);
+}
+
+bool IsConstEvaluable(const TableData& data, size_t function_id) {
+    auto& intrinsic = data.builtins[function_id];
+    if (intrinsic.num_overloads == 0) {
+        return false;
+    }
+    for (size_t overload_idx = 0; overload_idx < static_cast<size_t>(intrinsic.num_overloads);
+         overload_idx++) {
+        if (!data[intrinsic.overloads + overload_idx].const_eval_fn.IsValid()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 Result<Overload> LookupUnary(Context& context,
@@ -662,7 +718,7 @@ Result<Overload> LookupUnary(Context& context,
 
     // Resolve the intrinsic overload
     return MatchIntrinsic(context, *intrinsic_info, intrinsic_name, args, earliest_eval_stage,
-                          TemplateState{}, on_no_match);
+                          nullptr, on_no_match);
 }
 
 Result<Overload> LookupBinary(Context& context,
@@ -766,7 +822,7 @@ Result<Overload> LookupBinary(Context& context,
 
     // Resolve the intrinsic overload
     return MatchIntrinsic(context, *intrinsic_info, intrinsic_name, args, earliest_eval_stage,
-                          TemplateState{}, on_no_match);
+                          nullptr, on_no_match);
 }
 
 Result<Overload> LookupCtorConv(Context& context,
@@ -804,15 +860,9 @@ Result<Overload> LookupCtorConv(Context& context,
         context.diags.add_error(diag::System::Intrinsics, ss.str(), source);
     };
 
-    // If a template type was provided, then close the 0'th type with this.
-    TemplateState templates;
-    if (template_arg) {
-        templates.Type(0, template_arg);
-    }
-
     // Resolve the intrinsic overload
     return MatchIntrinsic(context, context.data.ctor_conv[type_id], type_name, args,
-                          earliest_eval_stage, templates, on_no_match);
+                          earliest_eval_stage, template_arg, on_no_match);
 }
 
 }  // namespace tint::core::intrinsic
@@ -34,10 +34,12 @@
 
 #include "tint/lang/core/binary_op.h"
 #include "tint/lang/core/builtin_fn.h"
+#include "tint/lang/core/evaluation_stage.h"
 #include "tint/lang/core/intrinsic/ctor_conv.h"
 #include "tint/lang/core/intrinsic/table_data.h"
 #include "tint/lang/core/parameter_usage.h"
 #include "tint/lang/core/unary_op.h"
+#include "tint/utils/containers/hashmap.h"
 #include "tint/utils/containers/vector.h"
 #include "tint/utils/text/string.h"
 
@@ -96,6 +98,36 @@ struct Overload {
     bool operator!=(const Overload& other) const { return !(*this == other); }
 };
 
+/// OverloadKey identifies a single intrinsic lookup.
+/// Two lookups with equal keys resolve to the same overload.
+struct OverloadKey {
+    /// The intrinsic being called
+    const IntrinsicInfo* intrinsic = nullptr;
+    /// The explicit template argument, or nullptr if there is none
+    const core::type::Type* template_arg = nullptr;
+    /// The argument types
+    Vector<const core::type::Type*, 4> args;
+    /// The earliest evaluation stage of the call
+    EvaluationStage earliest_eval_stage = EvaluationStage::kRuntime;
+
+    /// @returns the hash code of the key
+    size_t HashCode() const { return Hash(intrinsic, template_arg, args, earliest_eval_stage); }
+
+    /// Equality operator
+    /// @param other the key to compare against
+    /// @returns true if this key is equal to @p other
+    bool operator==(const OverloadKey& other) const {
+        return intrinsic == other.intrinsic && template_arg == other.template_arg &&
+               args == other.args && earliest_eval_stage == other.earliest_eval_stage;
+    }
+};
+
+/// OverloadCache holds the overloads resolved by successful lookups, keyed by the lookup.
+/// Failed lookups are not cached, so that they raise their diagnostics every time.
+/// @note the cache holds types owned by the context's type manager, so it must not be used once
+/// those types have been destroyed.
+using OverloadCache = Hashmap<OverloadKey, Overload, 8>;
+
 /// The context data used to lookup intrinsic information
 struct Context {
     /// The table table
@@ -106,6 +138,9 @@ struct Context {
     SymbolTable& symbols;
     /// The diagnostics
     diag::List& diags;
+    /// The optional cache of resolved overloads. Lookups with the same intrinsic, argument types
+    /// and evaluation stage as a previous successful lookup skip overload resolution.
+    OverloadCache* cache = nullptr;
 };
 
 /// Lookup looks for the builtin overload with the given signature, raising an error diagnostic
@@ -193,6 +228,13 @@ Result<Overload> LookupCtorConv(Context& context,
                                 EvaluationStage earliest_eval_stage,
                                 const Source& source);
 
+/// @param data the intrinsic table data
+/// @param function_id the builtin function identifier
+/// @returns true if every overload of the builtin function can be evaluated at shader-creation
+/// time. Calls to these builtins have no side effects, and do not depend on any state other than
+/// their arguments.
+bool IsConstEvaluable(const TableData& data, size_t function_id);
+
 /// Table is a wrapper around a dialect to provide type-safe interface to the intrinsic table.
 template <typename DIALECT>
 struct Table {
@@ -209,7 +251,10 @@ struct Table {
     /// @param symbols The symbol table
     /// @param diags The diagnostics
     Table(core::type::Manager& types, SymbolTable& symbols, diag::List& diags)
-        : context{DIALECT::kData, types, symbols, diags} {}
+        : context{DIALECT::kData, types, symbols, diags, &cache} {}
+
+    /// Copying would leave the context pointing at the cache of the source table
+    Table(const Table&) = delete;
 
     /// Lookup looks for the builtin overload with the given signature, raising an error diagnostic
     /// if the builtin was not found.
@@ -297,6 +342,9 @@ struct Table {
                               source);
     }
 
+    /// The resolved overloads, shared by all the lookups made with this table
+    OverloadCache cache;
+
     /// The intrinsic context
     Context context;
 };
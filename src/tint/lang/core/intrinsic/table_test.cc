@@ -1014,6 +1014,78 @@ TEST_F(IntrinsicTableTest, OverloadResolution) {
     EXPECT_EQ(result->parameters[0].type, ai);
 }
 
+TEST_F(IntrinsicTableTest, IsConstEvaluable) {
+    auto is_const = [](core::BuiltinFn fn) {
+        return IsConstEvaluable(Dialect::kData, static_cast<size_t>(fn));
+    };
+    EXPECT_TRUE(is_const(core::BuiltinFn::kCos));
+    EXPECT_TRUE(is_const(core::BuiltinFn::kSelect));
+    EXPECT_FALSE(is_const(core::BuiltinFn::kDpdx));
+    EXPECT_FALSE(is_const(core::BuiltinFn::kTextureSample));
+    EXPECT_FALSE(is_const(core::BuiltinFn::kAtomicAdd));
+    EXPECT_FALSE(is_const(core::BuiltinFn::kArrayLength));
+}
+
+TEST_F(IntrinsicTableTest, CachedLookup) {
+    auto* f32 = create<core::type::F32>();
+    auto first =
+        table.Lookup(core::BuiltinFn::kCos, Vector{f32}, EvaluationStage::kConstant, Source{});
+    ASSERT_TRUE(first) << Diagnostics();
+    EXPECT_EQ(table.cache.Count(), 1u);
+
+    auto second =
+        table.Lookup(core::BuiltinFn::kCos, Vector{f32}, EvaluationStage::kConstant, Source{});
+    ASSERT_TRUE(second) << Diagnostics();
+    EXPECT_EQ(table.cache.Count(), 1u);
+    EXPECT_EQ(first.Get(), second.Get());
+    EXPECT_EQ(first->const_eval_fn, second->const_eval_fn);
+}
+
+TEST_F(IntrinsicTableTest, CachedLookup_KeyedByEvalStage) {
+    auto* ai = create<core::type::AbstractInt>();
+    auto* vec3_ai = create<core::type::Vector>(ai, 3u);
+    auto* vec3_i32 = create<core::type::Vector>(create<core::type::I32>(), 3u);
+    for (int i = 0; i < 2; i++) {
+        auto constant = table.Lookup(CtorConv::kVec3, nullptr, Vector{ai, ai, ai},
+                                     EvaluationStage::kConstant, Source{});
+        ASSERT_TRUE(constant) << Diagnostics();
+        EXPECT_EQ(constant->return_type, vec3_ai);
+
+        auto runtime = table.Lookup(CtorConv::kVec3, nullptr, Vector{ai, ai, ai},
+                                    EvaluationStage::kRuntime, Source{});
+        ASSERT_TRUE(runtime) << Diagnostics();
+        EXPECT_EQ(runtime->return_type, vec3_i32);
+    }
+    EXPECT_EQ(table.cache.Count(), 2u);
+}
+
+TEST_F(IntrinsicTableTest, CachedLookup_KeyedByTemplateArg) {
+    auto* f32 = create<core::type::F32>();
+    auto* vec3_f32 = create<core::type::Vector>(f32, 3u);
+    auto* vec3_i32 = create<core::type::Vector>(create<core::type::I32>(), 3u);
+    auto* vec3_u32 = create<core::type::Vector>(create<core::type::U32>(), 3u);
+    auto to_i32 = table.Lookup(CtorConv::kVec3, create<core::type::I32>(), Vector{vec3_f32},
+                               EvaluationStage::kConstant, Source{});
+    auto to_u32 = table.Lookup(CtorConv::kVec3, create<core::type::U32>(), Vector{vec3_f32},
+                               EvaluationStage::kConstant, Source{});
+    ASSERT_TRUE(to_i32) << Diagnostics();
+    ASSERT_TRUE(to_u32) << Diagnostics();
+    EXPECT_EQ(to_i32->return_type, vec3_i32);
+    EXPECT_EQ(to_u32->return_type, vec3_u32);
+    EXPECT_EQ(table.cache.Count(), 2u);
+}
+
+TEST_F(IntrinsicTableTest, CachedLookup_FailuresNotCached) {
+    auto* bool_ = create<core::type::Bool>();
+    for (int i = 0; i < 2; i++) {
+        auto result = table.Lookup(core::BuiltinFn::kCos, Vector{bool_},
+                                   EvaluationStage::kConstant, Source{{12, 34}});
+        ASSERT_FALSE(result);
+    }
+    EXPECT_EQ(table.cache.Count(), 0u);
+    EXPECT_EQ(Diagnostics().error_count(), 2u);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // AbstractBinaryTests
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,177 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// GEN_BUILD:CONDITION(tint_build_wgsl_reader)
+
+#include <string>
+
+#include "tint/cmd/bench/bench.h"
+#include "tint/lang/core/ir/binary/decode.h"
+#include "tint/lang/core/ir/binary/encode.h"
+#include "tint/lang/wgsl/reader/reader.h"
+#include "tint/utils/memory/allocation_stats.h"
+
+namespace tint::core::ir::binary {
+namespace {
+
+/// Counts the arena blocks allocated from the heap by the benchmark loop, and reports them per
+/// iteration in the `allocations` and `allocated_bytes` counters.
+class AllocationCounter {
+  public:
+    /// Constructor
+    /// @param state the benchmark state
+    explicit AllocationCounter(benchmark::State& state)
+        : state_(state), start_(ThreadAllocationStats()) {}
+
+    /// Destructor
+    ~AllocationCounter() {
+        auto& end = ThreadAllocationStats();
+        state_.counters["allocations"] =
+            benchmark::Counter(static_cast<double>(end.allocations - start_.allocations),
+                               benchmark::Counter::kAvgIterations);
+        state_.counters["allocated_bytes"] = benchmark::Counter(
+            static_cast<double>(end.bytes - start_.bytes), benchmark::Counter::kAvgIterations);
+    }
+
+  private:
+    benchmark::State& state_;
+    AllocationStats start_;
+};
+
+// Builds the IR for the WGSL program, as a cache miss would need to.
+void WgslToIR(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadInputFile(input_name);
+    if (!res) {
+        state.SkipWithError(res.Failure().reason.str());
+        return;
+    }
+    AllocationCounter allocation_counter(state);
+    for (auto _ : state) {
+        auto ir = wgsl::reader::WgslToIR(&res.Get());
+        if (!ir) {
+            state.SkipWithError(ir.Failure().reason.str());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * res->content.data.size()));
+}
+
+TINT_BENCHMARK_PROGRAMS(WgslToIR);
+
+// Encodes the IR for the WGSL program.
+void EncodeIR(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadInputFile(input_name);
+    if (!res) {
+        state.SkipWithError(res.Failure().reason.str());
+        return;
+    }
+    auto ir = wgsl::reader::WgslToIR(&res.Get());
+    if (!ir) {
+        state.SkipWithError(ir.Failure().reason.str());
+        return;
+    }
+    size_t encoded_bytes = 0;
+    for (auto _ : state) {
+        auto encoded = Encode(ir.Get());
+        if (!encoded) {
+            state.SkipWithError(encoded.Failure().reason.str());
+            return;
+        }
+        encoded_bytes = encoded->size();
+    }
+    state.counters["encoded_bytes"] = static_cast<double>(encoded_bytes);
+}
+
+TINT_BENCHMARK_PROGRAMS(EncodeIR);
+
+// Decodes the encoded IR for the WGSL program, as a cache hit would need to.
+void DecodeIR(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadInputFile(input_name);
+    if (!res) {
+        state.SkipWithError(res.Failure().reason.str());
+        return;
+    }
+    auto ir = wgsl::reader::WgslToIR(&res.Get());
+    if (!ir) {
+        state.SkipWithError(ir.Failure().reason.str());
+        return;
+    }
+    auto encoded = Encode(ir.Get());
+    if (!encoded) {
+        state.SkipWithError(encoded.Failure().reason.str());
+        return;
+    }
+    {
+        AllocationCounter allocation_counter(state);
+        for (auto _ : state) {
+            auto decoded = Decode(Slice<const std::byte>{encoded->data(), encoded->size()});
+            if (!decoded) {
+                state.SkipWithError(decoded.Failure().reason.str());
+            }
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * encoded->size()));
+    state.counters["encoded_bytes"] = static_cast<double>(encoded->size());
+    state.counters["wgsl_bytes"] = static_cast<double>(res->content.data.size());
+}
+
+TINT_BENCHMARK_PROGRAMS(DecodeIR);
+
+// Decodes the encoded IR for the WGSL program into the same module on each iteration, as a worker
+// that reuses its module between compilations would.
+void DecodeIRReuseModule(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadInputFile(input_name);
+    if (!res) {
+        state.SkipWithError(res.Failure().reason.str());
+        return;
+    }
+    auto ir = wgsl::reader::WgslToIR(&res.Get());
+    if (!ir) {
+        state.SkipWithError(ir.Failure().reason.str());
+        return;
+    }
+    auto encoded = Encode(ir.Get());
+    if (!encoded) {
+        state.SkipWithError(encoded.Failure().reason.str());
+        return;
+    }
+    Module mod;
+    {
+        AllocationCounter allocation_counter(state);
+        for (auto _ : state) {
+            auto decoded = Decode(Slice<const std::byte>{encoded->data(), encoded->size()}, mod);
+            if (!decoded) {
+                state.SkipWithError(decoded.Failure().reason.str());
+            }
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * encoded->size()));
+}
+
+TINT_BENCHMARK_PROGRAMS(DecodeIRReuseModule);
+
+}  // namespace
+}  // namespace tint::core::ir::binary
@@ -0,0 +1,1037 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/binary/decode.h"
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "tint/lang/core/ir/binary/format.h"
+#include "tint/lang/core/ir/builder.h"
+#include "tint/lang/core/type/depth_multisampled_texture.h"
+#include "tint/lang/core/type/depth_texture.h"
+#include "tint/lang/core/type/external_texture.h"
+#include "tint/lang/core/type/multisampled_texture.h"
+#include "tint/lang/core/type/sampled_texture.h"
+#include "tint/lang/core/type/storage_texture.h"
+#include "tint/utils/containers/hashset.h"
+#include "tint/utils/memory/bitcast.h"
+
+namespace tint::core::ir::binary {
+namespace {
+
+/// The maximum depth of nested control instructions. Bounds the recursion of the decoder.
+static constexpr uint32_t kMaxNestingDepth = 256;
+
+/// PIMPL state for Decode().
+struct Decoder {
+    /// Constructor
+    /// @param in the encoded module
+    /// @param out the empty module to decode into
+    Decoder(Slice<const std::byte> in, Module& out) : data(in), mod(out) {}
+
+    /// The encoded module.
+    Slice<const std::byte> data;
+    /// The offset of the next byte to read from #data.
+    size_t offset = 0;
+
+    /// The decoded module.
+    Module& mod;
+    /// The IR builder.
+    Builder b{mod};
+
+    /// The string table.
+    Vector<Symbol, 32> strings;
+    /// The type table.
+    Vector<const core::type::Type*, 32> types;
+    /// The constant table.
+    Vector<ir::Constant*, 32> constants;
+    /// The values, in declaration order.
+    Vector<Value*, 64> values;
+    /// The control instructions, in declaration order.
+    Vector<ir::ControlInstruction*, 16> control_instructions;
+    /// The names of the structures decoded so far.
+    Hashset<Symbol, 8> struct_names;
+    /// The current depth of nested control instructions.
+    uint32_t depth = 0;
+
+    /// The first error raised while decoding, if any.
+    std::string error;
+
+    /// Decodes the module.
+    /// @returns success or failure
+    Result<SuccessType> Decode() {
+        for (auto c : kMagic) {
+            if (offset >= data.len || data[offset++] != static_cast<std::byte>(c)) {
+                return Failure{"invalid IR encoding: bad magic"};
+            }
+        }
+        if (auto version = Uint(); version != kVersion) {
+            return Failure{"unsupported IR encoding version: " + std::to_string(version)};
+        }
+
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            String();
+        }
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            Type();
+        }
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            Constant();
+        }
+
+        // Functions are numbered before their parameters, so reserve their slots up front.
+        auto num_functions = Count();
+        values.Resize(num_functions);
+        for (size_t i = 0; ok() && i < num_functions; i++) {
+            FunctionDecl(i);
+        }
+        Block(mod.root_block);
+        for (size_t i = 0; ok() && i < mod.functions.Length(); i++) {
+            Block(mod.functions[i]->Block());
+        }
+
+        if (ok() && offset != data.len) {
+            Error("unexpected data after the end of the module");
+        }
+        if (!ok()) {
+            return Failure{"invalid IR encoding: " + error};
+        }
+        return Success;
+    }
+
+    /// @returns true if no error has been raised
+    bool ok() const { return error.empty(); }
+
+    /// Records @p msg as the error, if no error has already been raised.
+    /// @param msg the error message
+    void Error(std::string msg) {
+        if (ok()) {
+            error = std::move(msg) + " at offset " + std::to_string(offset);
+        }
+    }
+
+    /// @returns the next unsigned LEB128 varint, or 0 on error
+    uint64_t Uint() {
+        uint64_t value = 0;
+        for (uint32_t shift = 0; ok(); shift += 7) {
+            if (offset >= data.len) {
+                Error("unexpected end of data");
+                break;
+            }
+            if (shift >= 64) {
+                Error("integer too large");
+                break;
+            }
+            auto byte = static_cast<uint8_t>(data[offset++]);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        return 0;
+    }
+
+    /// @returns the next varint as a uint32_t, or 0 on error
+    uint32_t Uint32() {
+        auto value = Uint();
+        if (value > 0xffffffffu) {
+            Error("integer too large");
+            return 0;
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    /// @returns the next varint as an element count, or 0 on error.
+    /// @note every element is encoded with at least one byte, so the count is bounded by the
+    /// number of remaining bytes. This prevents malformed data from triggering huge allocations.
+    size_t Count() {
+        auto value = Uint();
+        if (value > data.len - offset) {
+            Error("invalid count");
+            return 0;
+        }
+        return static_cast<size_t>(value);
+    }
+
+    /// @returns the next varint as a boolean, or false on error
+    bool Bool() {
+        auto value = Uint();
+        if (value > 1) {
+            Error("invalid boolean");
+            return false;
+        }
+        return value == 1;
+    }
+
+    /// @param last the last valid enumerator of the enum
+    /// @returns the next varint as an enumerator, or the zero enumerator on error
+    template <typename ENUM>
+    ENUM Enum(ENUM last) {
+        auto value = Uint();
+        if (value > static_cast<uint64_t>(last)) {
+            Error("invalid enumerator");
+            return static_cast<ENUM>(0);
+        }
+        return static_cast<ENUM>(value);
+    }
+
+    /// Reads a boolean, followed by a value read with @p read if the boolean was true.
+    /// @param read the function used to read the value
+    /// @returns the optional value
+    template <typename READ>
+    auto Optional(READ&& read) -> std::optional<decltype(read())> {
+        if (Bool()) {
+            return read();
+        }
+        return std::nullopt;
+    }
+
+    /// Reads the next entry of the string table.
+    void String() {
+        auto len = Count();
+        if (!ok()) {
+            return;
+        }
+        if (len == 0) {
+            Error("empty string");
+            return;
+        }
+        std::string str(reinterpret_cast<const char*>(&data[offset]), len);
+        offset += len;
+        strings.Push(mod.symbols.Register(str));
+    }
+
+    /// @returns the symbol referenced by the next varint, which is invalid for an unnamed value
+    Symbol StringRef() {
+        auto idx = Uint();
+        if (idx == 0) {
+            return Symbol{};
+        }
+        if (idx > strings.Length()) {
+            Error("invalid string index");
+            return Symbol{};
+        }
+        return strings[idx - 1];
+    }
+
+    /// Reads a name reference, and names @p value with it.
+    /// @param value the value to name
+    void Name(Value* value) {
+        if (auto name = StringRef(); name.IsValid()) {
+            mod.SetName(value, name);
+        }
+    }
+
+    /// @returns the type referenced by the next varint, or nullptr on error
+    const core::type::Type* TypeRef() {
+        auto idx = Uint();
+        if (idx >= types.Length()) {
+            Error("invalid type index");
+            return nullptr;
+        }
+        return types[idx];
+    }
+
+    /// @returns the value referenced by the next varint, or nullptr for a null operand or on error
+    Value* Operand() {
+        auto ref = Uint();
+        if (ref == 0) {
+            return nullptr;
+        }
+        auto idx = (ref - 1) / 2;
+        if (ref % 2 == 1) {
+            if (idx >= constants.Length()) {
+                Error("invalid constant index");
+                return nullptr;
+            }
+            return constants[idx];
+        }
+        if (idx >= values.Length()) {
+            Error("invalid value index");
+            return nullptr;
+        }
+        return values[idx];
+    }
+
+    /// @returns the control instruction referenced by the next varint, or nullptr on error
+    template <typename T>
+    T* ControlInstructionRef() {
+        auto idx = Uint();
+        if (idx >= control_instructions.Length()) {
+            Error("invalid control instruction index");
+            return nullptr;
+        }
+        auto* ctrl = control_instructions[idx]->As<T>();
+        if (!ctrl) {
+            Error("exit to the wrong kind of control instruction");
+        }
+        return ctrl;
+    }
+
+    /// @returns the next interpolation
+    std::optional<core::Interpolation> Interpolation() {
+        return Optional([&] {
+            core::Interpolation interp;
+            interp.type = Enum(core::InterpolationType::kPerspective);
+            interp.sampling = Enum(core::InterpolationSampling::kSample);
+            return interp;
+        });
+    }
+
+    /// @returns the next location
+    std::optional<struct Location> Location() {
+        return Optional([&] {
+            struct Location loc;
+            loc.value = Uint32();
+            loc.interpolation = Interpolation();
+            return loc;
+        });
+    }
+
+    /// @returns the next binding point
+    std::optional<struct BindingPoint> BindingPoint() {
+        return Optional([&] {
+            struct BindingPoint bp;
+            bp.group = Uint32();
+            bp.binding = Uint32();
+            return bp;
+        });
+    }
+
+    /// Reads the next entry of the type table.
+    void Type() {
+        auto& ty = mod.Types();
+        const core::type::Type* type = nullptr;
+        switch (Enum(TypeKind::kStorageTexture)) {
+            case TypeKind::kVoid:
+                type = ty.void_();
+                break;
+            case TypeKind::kBool:
+                type = ty.bool_();
+                break;
+            case TypeKind::kI32:
+                type = ty.i32();
+                break;
+            case TypeKind::kU32:
+                type = ty.u32();
+                break;
+            case TypeKind::kF32:
+                type = ty.f32();
+                break;
+            case TypeKind::kF16:
+                type = ty.f16();
+                break;
+            case TypeKind::kVector: {
+                auto* el = TypeRef();
+                auto width = Uint32();
+                auto packed = Bool();
+                if (ok() && (!el->Is<core::type::Scalar>() || width < 2 || width > 4)) {
+                    Error("invalid vector type");
+                }
+                if (ok()) {
+                    type = packed ? ty.packed_vec(el, width) : ty.vec(el, width);
+                }
+                break;
+            }
+            case TypeKind::kMatrix: {
+                auto* col = TypeRef();
+                auto columns = Uint32();
+                if (ok() && (!col->Is<core::type::Vector>() || columns < 2 || columns > 4)) {
+                    Error("invalid matrix type");
+                }
+                if (ok()) {
+                    type = ty.mat(col->As<core::type::Vector>(), columns);
+                }
+                break;
+            }
+            case TypeKind::kArray:
+                type = Array(/* runtime_sized */ false);
+                break;
+            case TypeKind::kRuntimeArray:
+                type = Array(/* runtime_sized */ true);
+                break;
+            case TypeKind::kAtomic: {
+                auto* el = TypeRef();
+                if (ok()) {
+                    type = ty.atomic(el);
+                }
+                break;
+            }
+            case TypeKind::kPointer: {
+                auto space = Enum(core::AddressSpace::kWorkgroup);
+                auto* store = TypeRef();
+                auto access = Enum(core::Access::kWrite);
+                if (ok() && access == core::Access::kUndefined) {
+                    Error("invalid pointer access");
+                }
+                if (ok()) {
+                    type = ty.ptr(space, store, access);
+                }
+                break;
+            }
+            case TypeKind::kStruct:
+                type = Struct();
+                break;
+            case TypeKind::kSampler: {
+                auto kind = Enum(core::type::SamplerKind::kComparisonSampler);
+                if (ok()) {
+                    type = ty.Get<core::type::Sampler>(kind);
+                }
+                break;
+            }
+            case TypeKind::kDepthTexture: {
+                auto dim = DepthDimension();
+                if (ok()) {
+                    type = ty.Get<core::type::DepthTexture>(dim);
+                }
+                break;
+            }
+            case TypeKind::kDepthMultisampledTexture: {
+                auto dim = DepthDimension();
+                if (ok()) {
+                    type = ty.Get<core::type::DepthMultisampledTexture>(dim);
+                }
+                break;
+            }
+            case TypeKind::kExternalTexture:
+                type = ty.Get<core::type::ExternalTexture>();
+                break;
+            case TypeKind::kMultisampledTexture: {
+                auto dim = Enum(core::type::TextureDimension::kCubeArray);
+                auto* el = TypeRef();
+                if (ok()) {
+                    type = ty.Get<core::type::MultisampledTexture>(dim, el);
+                }
+                break;
+            }
+            case TypeKind::kSampledTexture: {
+                auto dim = Enum(core::type::TextureDimension::kCubeArray);
+                auto* el = TypeRef();
+                if (ok()) {
+                    type = ty.Get<core::type::SampledTexture>(dim, el);
+                }
+                break;
+            }
+            case TypeKind::kStorageTexture: {
+                auto dim = Enum(core::type::TextureDimension::kCubeArray);
+                auto format = Enum(core::TexelFormat::kRgba8Unorm);
+                auto access = Enum(core::Access::kWrite);
+                auto* el = TypeRef();
+                if (ok()) {
+                    type = ty.Get<core::type::StorageTexture>(dim, format, access, el);
+                }
+                break;
+            }
+        }
+        if (ok()) {
+            types.Push(type);
+        }
+    }
+    /// @returns the next texture dimension, which must be valid for a depth texture
+    core::type::TextureDimension DepthDimension() {
+        auto dim = Enum(core::type::TextureDimension::kCubeArray);
+        switch (dim) {
+            case core::type::TextureDimension::k2d:
+            case core::type::TextureDimension::k2dArray:
+            case core::type::TextureDimension::kCube:
+            case core::type::TextureDimension::kCubeArray:
+                break;
+            default:
+                Error("invalid depth texture dimension");
+                break;
+        }
+        return dim;
+    }
+
+    /// @param runtime_sized true if the array is runtime-sized
+    /// @returns the array type with the fields that follow the array type kind, or nullptr on
+    /// error
+    const core::type::Type* Array(bool runtime_sized) {
+        auto& ty = mod.Types();
+        auto* el = TypeRef();
+        auto count = runtime_sized ? 0 : Uint32();
+        auto align = Uint32();
+        auto size = Uint32();
+        auto stride = Uint32();
+        auto implicit_stride = Uint32();
+        if (ok() && stride < implicit_stride) {
+            Error("invalid array stride");
+        }
+        if (!ok()) {
+            return nullptr;
+        }
+        const core::type::ArrayCount* array_count = nullptr;
+        if (runtime_sized) {
+            array_count = ty.Get<core::type::RuntimeArrayCount>();
+        } else {
+            array_count = ty.Get<core::type::ConstantArrayCount>(count);
+        }
+        return ty.Get<core::type::Array>(el, array_count, align, size, stride, implicit_stride);
+    }
+
+    /// @returns the structure with the fields that follow the structure type kind, or nullptr on
+    /// error
+    const core::type::Type* Struct() {
+        auto& ty = mod.Types();
+        auto name = StringRef();
+        if (ok() && !name.IsValid()) {
+            Error("unnamed structure");
+        }
+        if (ok() && !struct_names.Add(name)) {
+            Error("duplicate structure name");
+        }
+
+        Vector<core::type::StructMember*, 8> members;
+        for (uint32_t i = 0, n = static_cast<uint32_t>(Count()); ok() && i < n; i++) {
+            auto member_name = StringRef();
+            auto* member_type = TypeRef();
+            auto offset = Uint32();
+            auto align = Uint32();
+            auto size = Uint32();
+            core::type::StructMemberAttributes attrs;
+            attrs.location = Optional([&] { return Uint32(); });
+            attrs.index = Optional([&] { return Uint32(); });
+            attrs.builtin = Optional([&] { return Enum(core::BuiltinValue::kWorkgroupId); });
+            attrs.interpolation = Interpolation();
+            attrs.invariant = Bool();
+            if (ok() && !member_name.IsValid()) {
+                Error("unnamed structure member");
+            }
+            if (ok()) {
+                members.Push(ty.Get<core::type::StructMember>(member_name, member_type, i, offset,
+                                                              align, size, attrs));
+            }
+        }
+        auto align = Uint32();
+        auto size = Uint32();
+        auto size_no_padding = Uint32();
+        auto flags = Uint();
+        if (ok() && (flags & ~core::type::StructFlags{core::type::kBlock}.Value()) != 0) {
+            Error("invalid structure flags");
+        }
+        Vector<core::AddressSpace, 4> address_spaces;
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            address_spaces.Push(Enum(core::AddressSpace::kWorkgroup));
+        }
+        Vector<core::type::PipelineStageUsage, 4> stages;
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            stages.Push(Enum(core::type::PipelineStageUsage::kComputeOutput));
+        }
+        if (!ok()) {
+            return nullptr;
+        }
+
+        Vector<const core::type::StructMember*, 8> const_members;
+        for (auto* member : members) {
+            const_members.Push(member);
+        }
+        auto* s = ty.Get<core::type::Struct>(name, const_members, align, size, size_no_padding);
+        for (auto* member : members) {
+            member->SetStruct(s);
+        }
+        if (flags != 0) {
+            s->SetStructFlag(core::type::kBlock);
+        }
+        for (auto usage : address_spaces) {
+            s->AddUsage(usage);
+        }
+        for (auto usage : stages) {
+            s->AddUsage(usage);
+        }
+        return s;
+    }
+
+    /// Reads the next entry of the constant table.
+    void Constant() {
+        auto& cv = mod.constant_values;
+        const core::constant::Value* value = nullptr;
+        switch (Enum(ConstantKind::kComposite)) {
+            case ConstantKind::kBool:
+                value = cv.Get(Bool());
+                break;
+            case ConstantKind::kI32:
+                value = cv.Get(core::i32(tint::Bitcast<int32_t>(Uint32())));
+                break;
+            case ConstantKind::kU32:
+                value = cv.Get(core::u32(Uint32()));
+                break;
+            case ConstantKind::kF32:
+                value = cv.Get(core::f32(tint::Bitcast<float>(Uint32())));
+                break;
+            case ConstantKind::kF16:
+                value = cv.Get(core::f16(tint::Bitcast<float>(Uint32())));
+                break;
+            case ConstantKind::kSplat: {
+                auto* type = TypeRef();
+                auto* el = ConstantRef();
+                auto count = Uint32();
+                if (ok() && count == 0) {
+                    Error("empty splat");
+                }
+                if (ok()) {
+                    value = cv.Splat(type, el, count);
+                }
+                break;
+            }
+            case ConstantKind::kComposite: {
+                auto* type = TypeRef();
+                Vector<const core::constant::Value*, 8> elements;
+                for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+                    elements.Push(ConstantRef());
+                }
+                if (ok() && elements.IsEmpty()) {
+                    Error("empty composite");
+                }
+                if (ok()) {
+                    value = cv.Composite(type, std::move(elements));
+                }
+                break;
+            }
+        }
+        if (ok()) {
+            constants.Push(b.Constant(value));
+        }
+    }
+
+    /// @returns the constant value referenced by the next varint, or nullptr on error
+    const core::constant::Value* ConstantRef() {
+        auto idx = Uint();
+        if (idx >= constants.Length()) {
+            Error("invalid constant index");
+            return nullptr;
+        }
+        return constants[idx]->Value();
+    }
+
+    /// Reads the declaration of the function at index @p idx, and declares its parameters.
+    /// @param idx the index of the function
+    void FunctionDecl(size_t idx) {
+        auto name = StringRef();
+        auto* return_type = TypeRef();
+        auto stage = Enum(Function::PipelineStage::kVertex);
+        auto wg_size = Optional([&] {
+            std::array<uint32_t, 3> wg{};
+            wg[0] = Uint32();
+            wg[1] = Uint32();
+            wg[2] = Uint32();
+            return wg;
+        });
+        auto return_builtin = Optional([&] { return Enum(Function::ReturnBuiltin::kSampleMask); });
+        auto return_location = Location();
+        auto return_invariant = Bool();
+        if (!ok()) {
+            return;
+        }
+
+        auto* func = mod.values.Create<Function>(return_type, stage, wg_size);
+        func->SetBlock(b.Block());
+        if (name.IsValid()) {
+            mod.SetName(func, name);
+        }
+        if (return_builtin) {
+            func->SetReturnBuiltin(*return_builtin);
+        }
+        if (return_location) {
+            func->SetReturnLocation(return_location->value, return_location->interpolation);
+        }
+        func->SetReturnInvariant(return_invariant);
+        mod.functions.Push(func);
+        values[idx] = func;
+
+        Vector<FunctionParam*, 4> params;
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            auto* type = TypeRef();
+            if (!ok()) {
+                return;
+            }
+            auto* param = mod.values.Create<FunctionParam>(type);
+            Name(param);
+            if (auto builtin =
+                    Optional([&] { return Enum(FunctionParam::Builtin::kSubgroupSize); })) {
+                param->SetBuiltin(*builtin);
+            }
+            if (auto loc = Location()) {
+                param->SetLocation(loc->value, loc->interpolation);
+            }
+            param->SetInvariant(Bool());
+            if (auto bp = BindingPoint()) {
+                param->SetBindingPoint(bp->group, bp->binding);
+            }
+            values.Push(param);
+            params.Push(param);
+        }
+        func->SetParams(std::move(params));
+    }
+
+    /// Reads the instructions of a block, appending them to @p block.
+    /// @param block the block
+    void Block(ir::Block* block) {
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            if (auto* inst = Instruction()) {
+                block->Append(inst);
+            }
+        }
+    }
+
+    /// Reads the parameters and instructions of a block into @p block.
+    /// @param block the block
+    void MultiInBlock(ir::MultiInBlock* block) {
+        Vector<BlockParam*, 4> params;
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            auto* type = TypeRef();
+            if (!ok()) {
+                return;
+            }
+            auto* param = mod.values.Create<BlockParam>(type);
+            Name(param);
+            values.Push(param);
+            params.Push(param);
+        }
+        block->SetParams(std::move(params));
+        Block(block);
+    }
+
+    /// @returns the next instruction, or nullptr on error
+    ir::Instruction* Instruction() {
+        auto kind = Enum(InstructionKind::kVar);
+
+        Vector<Value*, 8> operands;
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            operands.Push(Operand());
+        }
+        Vector<InstructionResult*, 1> results;
+        for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+            auto* type = TypeRef();
+            if (!ok()) {
+                break;
+            }
+            auto* result = mod.values.Create<InstructionResult>(type);
+            Name(result);
+            values.Push(result);
+            results.Push(result);
+        }
+        if (!ok()) {
+            return nullptr;
+        }
+
+        // Checks that the instruction has the expected number of operands and results.
+        auto expect = [&](size_t min_operands, size_t max_operands, size_t num_results) {
+            if (operands.Length() < min_operands || operands.Length() > max_operands) {
+                Error("unexpected number of operands");
+            } else if (results.Length() != num_results) {
+                Error("unexpected number of results");
+            }
+            return ok();
+        };
+        // @returns the operands from index @p start onwards
+        auto operands_from = [&](size_t start) {
+            Vector<Value*, 8> out;
+            for (size_t i = start; i < operands.Length(); i++) {
+                out.Push(operands[i]);
+            }
+            return out;
+        };
+        // @returns the operand at @p idx as a function, or nullptr if it is not a function
+        auto function_operand = [&](size_t idx) -> Function* {
+            auto* func = operands[idx] ? operands[idx]->As<Function>() : nullptr;
+            if (!func) {
+                Error("operand is not a function");
+            }
+            return func;
+        };
+
+        static constexpr size_t kAny = ~size_t(0);
+        auto& insts = mod.instructions;
+        switch (kind) {
+            case InstructionKind::kAccess:
+                if (expect(1, kAny, 1)) {
+                    return insts.Create<ir::Access>(results[0], operands[0], operands_from(1));
+                }
+                break;
+            case InstructionKind::kBinary: {
+                auto op = Enum(BinaryOp::kShiftRight);
+                if (expect(2, 2, 1)) {
+                    return insts.Create<ir::Binary>(results[0], op, operands[0], operands[1]);
+                }
+                break;
+            }
+            case InstructionKind::kBitcast:
+                if (expect(1, 1, 1)) {
+                    return insts.Create<ir::Bitcast>(results[0], operands[0]);
+                }
+                break;
+            case InstructionKind::kBreakIf: {
+                auto* loop = ControlInstructionRef<ir::Loop>();
+                if (expect(1, kAny, 0)) {
+                    return insts.Create<ir::BreakIf>(operands[0], loop, operands_from(1));
+                }
+                break;
+            }
+            case InstructionKind::kConstruct:
+                if (expect(0, kAny, 1)) {
+                    return insts.Create<ir::Construct>(results[0], std::move(operands));
+                }
+                break;
+            case InstructionKind::kContinue: {
+                auto* loop = ControlInstructionRef<ir::Loop>();
+                if (expect(0, kAny, 0)) {
+                    return insts.Create<ir::Continue>(loop, std::move(operands));
+                }
+                break;
+            }
+            case InstructionKind::kConvert:
+                if (expect(1, 1, 1)) {
+                    return insts.Create<ir::Convert>(results[0], operands[0]);
+                }
+                break;
+            case InstructionKind::kCoreBuiltinCall: {
+                auto func = Enum(core::BuiltinFn::kNone);
+                if (ok() && (func == core::BuiltinFn::kNone ||
+                             func == core::BuiltinFn::kTintMaterialize)) {
+                    Error("invalid builtin function");
+                }
+                if (expect(0, kAny, 1)) {
+                    return insts.Create<ir::CoreBuiltinCall>(results[0], func, std::move(operands));
+                }
+                break;
+            }
+            case InstructionKind::kDiscard:
+                if (expect(0, 0, 0)) {
+                    return insts.Create<ir::Discard>();
+                }
+                break;
+            case InstructionKind::kExitIf: {
+                auto* target = ControlInstructionRef<ir::If>();
+                if (expect(0, kAny, 0)) {
+                    return insts.Create<ir::ExitIf>(target, std::move(operands));
+                }
+                break;
+            }
+            case InstructionKind::kExitLoop: {
+                auto* target = ControlInstructionRef<ir::Loop>();
+                if (expect(0, kAny, 0)) {
+                    return insts.Create<ir::ExitLoop>(target, std::move(operands));
+                }
+                break;
+            }
+            case InstructionKind::kExitSwitch: {
+                auto* target = ControlInstructionRef<ir::Switch>();
+                if (expect(0, kAny, 0)) {
+                    return insts.Create<ir::ExitSwitch>(target, std::move(operands));
+                }
+                break;
+            }
+            case InstructionKind::kIf:
+                if (expect(1, 1, results.Length()) && Enter()) {
+                    auto* if_ = insts.Create<ir::If>(operands[0], b.Block(), b.Block());
+                    if_->SetResults(std::move(results));
+                    control_instructions.Push(if_);
+                    Block(if_->True());
+                    Block(if_->False());
+                    depth--;
+                    return if_;
+                }
+                break;
+            case InstructionKind::kLet:
+                if (expect(1, 1, 1)) {
+                    return insts.Create<ir::Let>(results[0], operands[0]);
+                }
+                break;
+            case InstructionKind::kLoad:
+                if (expect(1, 1, 1)) {
+                    return insts.Create<ir::Load>(results[0], operands[0]);
+                }
+                break;
+            case InstructionKind::kLoadVectorElement:
+                if (expect(2, 2, 1)) {
+                    return insts.Create<ir::LoadVectorElement>(results[0], operands[0],
+                                                               operands[1]);
+                }
+                break;
+            case InstructionKind::kLoop:
+                if (expect(0, 0, results.Length()) && Enter()) {
+                    auto* loop =
+                        insts.Create<ir::Loop>(b.Block(), b.MultiInBlock(), b.MultiInBlock());
+                    loop->SetResults(std::move(results));
+                    control_instructions.Push(loop);
+                    Block(loop->Initializer());
+                    MultiInBlock(loop->Body());
+                    MultiInBlock(loop->Continuing());
+                    depth--;
+                    return loop;
+                }
+                break;
+            case InstructionKind::kNextIteration: {
+                auto* loop = ControlInstructionRef<ir::Loop>();
+                if (expect(0, kAny, 0)) {
+                    return insts.Create<ir::NextIteration>(loop, std::move(operands));
+                }
+                break;
+            }
+            case InstructionKind::kReturn:
+                if (expect(1, 2, 0)) {
+                    auto* func = function_operand(0);
+                    if (!func) {
+                        break;
+                    }
+                    if (operands.Length() == 2) {
+                        return insts.Create<ir::Return>(func, operands[1]);
+                    }
+                    return insts.Create<ir::Return>(func);
+                }
+                break;
+            case InstructionKind::kStore:
+                if (expect(2, 2, 0)) {
+                    return insts.Create<ir::Store>(operands[0], operands[1]);
+                }
+                break;
+            case InstructionKind::kStoreVectorElement:
+                if (expect(3, 3, 0)) {
+                    return insts.Create<ir::StoreVectorElement>(operands[0], operands[1],
+                                                                operands[2]);
+                }
+                break;
+            case InstructionKind::kSwitch:
+                if (expect(1, 1, results.Length()) && Enter()) {
+                    if (!operands[0]) {
+                        Error("switch without a condition");
+                        break;
+                    }
+                    auto* switch_ = insts.Create<ir::Switch>(operands[0]);
+                    switch_->SetResults(std::move(results));
+                    control_instructions.Push(switch_);
+                    for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+                        Vector<Switch::CaseSelector, 4> selectors;
+                        for (size_t j = 0, m = Count(); ok() && j < m; j++) {
+                            auto* val = Operand();
+                            auto* constant = val ? val->As<ir::Constant>() : nullptr;
+                            if (val && !constant) {
+                                Error("case selector is not a constant");
+                            }
+                            selectors.Push(Switch::CaseSelector{constant});
+                        }
+                        Block(b.Case(switch_, std::move(selectors)));
+                    }
+                    depth--;
+                    return switch_;
+                }
+                break;
+            case InstructionKind::kSwizzle: {
+                Vector<uint32_t, 4> indices;
+                for (size_t i = 0, n = Count(); ok() && i < n; i++) {
+                    indices.Push(Uint32());
+                }
+                if (ok() && (indices.IsEmpty() || indices.Length() > 4 ||
+                             indices.Any([](uint32_t idx) { return idx >= 4; }))) {
+                    Error("invalid swizzle indices");
+                }
+                if (expect(1, 1, 1)) {
+                    return insts.Create<ir::Swizzle>(results[0], operands[0], std::move(indices));
+                }
+                break;
+            }
+            case InstructionKind::kTerminateInvocation:
+                if (expect(0, 0, 0)) {
+                    return insts.Create<ir::TerminateInvocation>();
+                }
+                break;
+            case InstructionKind::kUnary: {
+                auto op = Enum(UnaryOp::kNegation);
+                if (expect(1, 1, 1)) {
+                    return insts.Create<ir::Unary>(results[0], op, operands[0]);
+                }
+                break;
+            }
+            case InstructionKind::kUnreachable:
+                if (expect(0, 0, 0)) {
+                    return insts.Create<ir::Unreachable>();
+                }
+                break;
+            case InstructionKind::kUserCall:
+                if (expect(1, kAny, 1)) {
+                    if (auto* func = function_operand(0)) {
+                        return insts.Create<ir::UserCall>(results[0], func, operands_from(1));
+                    }
+                }
+                break;
+            case InstructionKind::kVar: {
+                auto bp = BindingPoint();
+                IOAttributes attrs;
+                attrs.location = Optional([&] { return Uint32(); });
+                attrs.index = Optional([&] { return Uint32(); });
+                attrs.builtin = Optional([&] { return Enum(core::BuiltinValue::kWorkgroupId); });
+                attrs.interpolation = Interpolation();
+                attrs.invariant = Bool();
+                if (expect(1, 1, 1) && !results[0]->Type()->Is<core::type::Pointer>()) {
+                    Error("var with a non-pointer type");
+                }
+                if (ok()) {
+                    auto* var = insts.Create<ir::Var>(results[0]);
+                    var->SetInitializer(operands[0]);
+                    if (bp) {
+                        var->SetBindingPoint(bp->group, bp->binding);
+                    }
+                    var->SetAttributes(attrs);
+                    return var;
+                }
+                break;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Enters a nested control instruction, raising an error if this exceeds kMaxNestingDepth.
+    /// @returns true if the nesting depth is within limits
+    bool Enter() {
+        if (depth >= kMaxNestingDepth) {
+            Error("control instructions nested too deeply");
+            return false;
+        }
+        depth++;
+        return true;
+    }
+};
+
+}  // namespace
+
+Result<Module> Decode(Slice<const std::byte> encoded) {
+    Module mod;
+    auto res = Decode(encoded, mod);
+    if (!res) {
+        return res.Failure();
+    }
+    return mod;
+}
+
+Result<SuccessType> Decode(Slice<const std::byte> encoded, Module& module) {
+    module.Clear();
+    return Decoder{encoded, module}.Decode();
+}
+
+}  // namespace tint::core::ir::binary
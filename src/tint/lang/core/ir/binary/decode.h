@@ -0,0 +1,58 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_LANG_CORE_IR_BINARY_DECODE_H_
+#define SRC_TINT_LANG_CORE_IR_BINARY_DECODE_H_
+
+#include <cstddef>
+
+#include "tint/lang/core/ir/module.h"
+#include "tint/utils/containers/slice.h"
+#include "tint/utils/result/result.h"
+
+namespace tint::core::ir::binary {
+
+/// Decodes an IR module from the binary form produced by Encode().
+/// @param encoded the encoded module
+/// @returns the decoded module, or failure if @p encoded is malformed or was produced by an
+/// incompatible version of the encoder
+/// @note the decoded module is not validated. Use ir::Validate() if @p encoded is untrusted.
+Result<Module> Decode(Slice<const std::byte> encoded);
+
+/// Decodes an IR module from the binary form produced by Encode() into an existing module.
+/// @p module is cleared with Module::Clear() first, so that a module can be reused to decode many
+/// encoded modules, without returning its memory to the heap in between.
+/// @param encoded the encoded module
+/// @param module the module to decode into
+/// @returns success, or failure if @p encoded is malformed or was produced by an incompatible
+/// version of the encoder. On failure, @p module is left in an unspecified but valid state.
+/// @note the decoded module is not validated. Use ir::Validate() if @p encoded is untrusted.
+Result<SuccessType> Decode(Slice<const std::byte> encoded, Module& module);
+
+}  // namespace tint::core::ir::binary
+
+#endif  // SRC_TINT_LANG_CORE_IR_BINARY_DECODE_H_
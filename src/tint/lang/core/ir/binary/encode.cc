@@ -0,0 +1,708 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/binary/encode.h"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "tint/lang/core/constant/composite.h"
+#include "tint/lang/core/constant/scalar.h"
+#include "tint/lang/core/constant/splat.h"
+#include "tint/lang/core/ir/access.h"
+#include "tint/lang/core/ir/binary.h"
+#include "tint/lang/core/ir/binary/format.h"
+#include "tint/lang/core/ir/bitcast.h"
+#include "tint/lang/core/ir/block_param.h"
+#include "tint/lang/core/ir/break_if.h"
+#include "tint/lang/core/ir/construct.h"
+#include "tint/lang/core/ir/continue.h"
+#include "tint/lang/core/ir/convert.h"
+#include "tint/lang/core/ir/core_builtin_call.h"
+#include "tint/lang/core/ir/discard.h"
+#include "tint/lang/core/ir/exit_if.h"
+#include "tint/lang/core/ir/exit_loop.h"
+#include "tint/lang/core/ir/exit_switch.h"
+#include "tint/lang/core/ir/if.h"
+#include "tint/lang/core/ir/let.h"
+#include "tint/lang/core/ir/load.h"
+#include "tint/lang/core/ir/load_vector_element.h"
+#include "tint/lang/core/ir/loop.h"
+#include "tint/lang/core/ir/module.h"
+#include "tint/lang/core/ir/multi_in_block.h"
+#include "tint/lang/core/ir/next_iteration.h"
+#include "tint/lang/core/ir/return.h"
+#include "tint/lang/core/ir/store.h"
+#include "tint/lang/core/ir/store_vector_element.h"
+#include "tint/lang/core/ir/switch.h"
+#include "tint/lang/core/ir/swizzle.h"
+#include "tint/lang/core/ir/terminate_invocation.h"
+#include "tint/lang/core/ir/unary.h"
+#include "tint/lang/core/ir/unreachable.h"
+#include "tint/lang/core/ir/user_call.h"
+#include "tint/lang/core/ir/var.h"
+#include "tint/lang/core/type/array.h"
+#include "tint/lang/core/type/atomic.h"
+#include "tint/lang/core/type/bool.h"
+#include "tint/lang/core/type/depth_multisampled_texture.h"
+#include "tint/lang/core/type/depth_texture.h"
+#include "tint/lang/core/type/external_texture.h"
+#include "tint/lang/core/type/f16.h"
+#include "tint/lang/core/type/f32.h"
+#include "tint/lang/core/type/i32.h"
+#include "tint/lang/core/type/matrix.h"
+#include "tint/lang/core/type/multisampled_texture.h"
+#include "tint/lang/core/type/pointer.h"
+#include "tint/lang/core/type/sampled_texture.h"
+#include "tint/lang/core/type/sampler.h"
+#include "tint/lang/core/type/storage_texture.h"
+#include "tint/lang/core/type/struct.h"
+#include "tint/lang/core/type/u32.h"
+#include "tint/lang/core/type/vector.h"
+#include "tint/lang/core/type/void.h"
+#include "tint/utils/containers/hashmap.h"
+#include "tint/utils/memory/bitcast.h"
+#include "tint/utils/rtti/switch.h"
+
+namespace tint::core::ir::binary {
+namespace {
+
+/// A byte stream for one section of the encoding.
+struct Stream {
+    /// The encoded bytes
+    std::vector<std::byte> bytes;
+
+    /// Appends @p value as an unsigned LEB128 varint.
+    /// @param value the value to append
+    void Uint(uint64_t value) {
+        do {
+            uint8_t byte = value & 0x7f;
+            value >>= 7;
+            if (value != 0) {
+                byte |= 0x80;
+            }
+            bytes.push_back(static_cast<std::byte>(byte));
+        } while (value != 0);
+    }
+
+    /// Appends @p value as a varint.
+    /// @param value the boolean to append
+    void Bool(bool value) { Uint(value ? 1 : 0); }
+
+    /// Appends @p value as a varint of its underlying value.
+    /// @param value the enum to append
+    template <typename ENUM>
+    void Enum(ENUM value) {
+        Uint(static_cast<uint64_t>(value));
+    }
+
+    /// Appends @p value as 0 if it has no value, otherwise 1 followed by the value written with
+    /// @p write.
+    /// @param value the optional value to append
+    /// @param write the function used to write the value
+    template <typename T, typename WRITE>
+    void Optional(const std::optional<T>& value, WRITE&& write) {
+        Bool(value.has_value());
+        if (value) {
+            write(*value);
+        }
+    }
+
+    /// Appends the bytes of @p other.
+    /// @param other the stream to append
+    void Append(const Stream& other) {
+        bytes.insert(bytes.end(), other.bytes.begin(), other.bytes.end());
+    }
+};
+
+/// PIMPL state for Encode().
+struct Encoder {
+    /// Constructor
+    /// @param m the module to encode
+    explicit Encoder(Module& m) : mod(m) {}
+
+    /// The module being encoded.
+    Module& mod;
+
+    /// The interned strings.
+    Stream strings_out;
+    /// The interned types.
+    Stream types_out;
+    /// The interned constants.
+    Stream constants_out;
+    /// The function declarations and blocks.
+    Stream body_out;
+
+    /// Map of string to string index.
+    Hashmap<std::string_view, uint32_t, 32> strings;
+    /// Map of type to type index.
+    Hashmap<const core::type::Type*, uint32_t, 32> types;
+    /// Map of constant value to constant index.
+    Hashmap<const core::constant::Value*, uint32_t, 32> constants;
+    /// Map of value to value index.
+    Hashmap<Value*, uint32_t, 64> values;
+    /// Map of control instruction to control instruction index.
+    Hashmap<ControlInstruction*, uint32_t, 16> control_instructions;
+
+    /// The first error raised while encoding, if any.
+    std::string error;
+
+    /// Encodes the module.
+    /// @returns the encoded module
+    Result<std::vector<std::byte>> Encode() {
+        // Structures are emitted in the order they were declared, as this order is observable,
+        // and the module may contain structures that are not referenced by any value.
+        for (auto* type : mod.Types()) {
+            if (type->Is<core::type::Struct>()) {
+                TypeId(type);
+            }
+        }
+
+        // All functions are declared up front, so that calls can reference functions that are
+        // declared later in the module.
+        for (auto* func : mod.functions) {
+            DeclareValue(func);
+        }
+        body_out.Uint(mod.functions.Length());
+        for (auto* func : mod.functions) {
+            FunctionDecl(func);
+        }
+        WriteBlock(body_out, mod.root_block);
+        for (auto* func : mod.functions) {
+            WriteBlock(body_out, func->Block());
+        }
+
+        if (!error.empty()) {
+            return Failure{error};
+        }
+
+        Stream out;
+        for (auto c : kMagic) {
+            out.bytes.push_back(static_cast<std::byte>(c));
+        }
+        out.Uint(kVersion);
+        out.Uint(strings.Count());
+        out.Append(strings_out);
+        out.Uint(types.Count());
+        out.Append(types_out);
+        out.Uint(constants.Count());
+        out.Append(constants_out);
+        out.Append(body_out);
+        return std::move(out.bytes);
+    }
+
+    /// Records @p msg as the error, if no error has already been raised.
+    /// @param msg the error message
+    void Error(std::string msg) {
+        if (error.empty()) {
+            error = std::move(msg);
+        }
+    }
+
+    /// Assigns the next value index to @p value.
+    /// @param value the value
+    void DeclareValue(Value* value) { values.Add(value, static_cast<uint32_t>(values.Count())); }
+
+    /// Writes a reference to the name of @p value.
+    /// @param out the stream to write to
+    /// @param value the value
+    void WriteName(Stream& out, Value* value) { WriteString(out, mod.NameOf(value)); }
+
+    /// Writes a reference to the string table entry for @p sym.
+    /// @param out the stream to write to
+    /// @param sym the symbol, which may be invalid
+    void WriteString(Stream& out, Symbol sym) {
+        if (!sym.IsValid()) {
+            out.Uint(0);
+            return;
+        }
+        auto name = sym.NameView();
+        if (auto idx = strings.Get(name)) {
+            out.Uint(*idx + 1);
+            return;
+        }
+        auto idx = static_cast<uint32_t>(strings.Count());
+        strings.Add(name, idx);
+        strings_out.Uint(name.size());
+        for (auto c : name) {
+            strings_out.bytes.push_back(static_cast<std::byte>(c));
+        }
+        out.Uint(idx + 1);
+    }
+
+    /// Writes @p interp.
+    /// @param out the stream to write to
+    /// @param interp the interpolation
+    void WriteInterpolation(Stream& out, const std::optional<core::Interpolation>& interp) {
+        out.Optional(interp, [&](const core::Interpolation& i) {
+            out.Enum(i.type);
+            out.Enum(i.sampling);
+        });
+    }
+
+    /// Writes @p loc.
+    /// @param out the stream to write to
+    /// @param loc the location
+    void WriteLocation(Stream& out, const std::optional<struct Location>& loc) {
+        out.Optional(loc, [&](const struct Location& l) {
+            out.Uint(l.value);
+            WriteInterpolation(out, l.interpolation);
+        });
+    }
+
+    /// Writes @p bp.
+    /// @param out the stream to write to
+    /// @param bp the binding point
+    void WriteBindingPoint(Stream& out, const std::optional<struct BindingPoint>& bp) {
+        out.Optional(bp, [&](const struct BindingPoint& b) {
+            out.Uint(b.group);
+            out.Uint(b.binding);
+        });
+    }
+
+    /// Writes the declaration of @p func and declares its parameters.
+    /// @param func the function
+    void FunctionDecl(Function* func) {
+        auto& out = body_out;
+        WriteName(out, func);
+        out.Uint(TypeId(func->ReturnType()));
+        out.Enum(func->Stage());
+        out.Optional(func->WorkgroupSize(), [&](const std::array<uint32_t, 3>& wg) {
+            out.Uint(wg[0]);
+            out.Uint(wg[1]);
+            out.Uint(wg[2]);
+        });
+        out.Optional(func->ReturnBuiltin(), [&](auto b) { out.Enum(b); });
+        WriteLocation(out, func->ReturnLocation());
+        out.Bool(func->ReturnInvariant());
+        out.Uint(func->Params().Length());
+        for (auto* param : func->Params()) {
+            DeclareValue(param);
+            out.Uint(TypeId(param->Type()));
+            WriteName(out, param);
+            out.Optional(param->Builtin(), [&](auto b) { out.Enum(b); });
+            WriteLocation(out, param->Location());
+            out.Bool(param->Invariant());
+            WriteBindingPoint(out, param->BindingPoint());
+        }
+    }
+
+    /// Writes the instructions of @p block.
+    /// @param out the stream to write to
+    /// @param block the block
+    void WriteBlock(Stream& out, ir::Block* block) {
+        out.Uint(block->Length());
+        for (auto* inst : *block) {
+            WriteInstruction(out, inst);
+        }
+    }
+
+    /// Writes the parameters and instructions of @p block.
+    /// @param out the stream to write to
+    /// @param block the block
+    void WriteMultiInBlock(Stream& out, ir::MultiInBlock* block) {
+        out.Uint(block->Params().Length());
+        for (auto* param : block->Params()) {
+            DeclareValue(param);
+            out.Uint(TypeId(param->Type()));
+            WriteName(out, param);
+        }
+        WriteBlock(out, block);
+    }
+
+    /// Writes a reference to @p value.
+    /// @param out the stream to write to
+    /// @param value the value
+    void WriteOperand(Stream& out, Value* value) {
+        if (!value) {
+            out.Uint(0);
+            return;
+        }
+        if (auto* constant = value->As<ir::Constant>()) {
+            if (&constant->TypeInfo() != &tint::TypeInfo::Of<ir::Constant>()) {
+                Error("unsupported operand: " + std::string(constant->TypeInfo().name));
+            }
+            out.Uint(uint64_t(ConstantId(constant->Value())) * 2 + 1);
+            return;
+        }
+        if (auto idx = values.Get(value)) {
+            out.Uint(uint64_t(*idx) * 2 + 2);
+            return;
+        }
+        Error("operand used before its declaration");
+        out.Uint(0);
+    }
+
+    /// Writes a reference to @p ctrl.
+    /// @param out the stream to write to
+    /// @param ctrl the control instruction
+    void ControlInstructionRef(Stream& out, ir::ControlInstruction* ctrl) {
+        if (auto idx = ctrl ? control_instructions.Get(ctrl) : std::nullopt) {
+            out.Uint(*idx);
+            return;
+        }
+        Error("exit from a control instruction that does not enclose it");
+        out.Uint(0);
+    }
+
+    /// @returns the instruction kind of @p inst, or an empty optional if the instruction is not
+    /// part of the core dialect.
+    /// @param inst the instruction
+    std::optional<InstructionKind> KindOf(ir::Instruction* inst) {
+        std::optional<InstructionKind> kind;
+        tint::Switch(
+            inst,  //
+            [&](ir::Access*) { kind = InstructionKind::kAccess; },
+            [&](ir::Binary*) { kind = InstructionKind::kBinary; },
+            [&](ir::Bitcast*) { kind = InstructionKind::kBitcast; },
+            [&](ir::BreakIf*) { kind = InstructionKind::kBreakIf; },
+            [&](ir::Construct*) { kind = InstructionKind::kConstruct; },
+            [&](ir::Continue*) { kind = InstructionKind::kContinue; },
+            [&](ir::Convert*) { kind = InstructionKind::kConvert; },
+            [&](ir::CoreBuiltinCall*) { kind = InstructionKind::kCoreBuiltinCall; },
+            [&](ir::Discard*) { kind = InstructionKind::kDiscard; },
+            [&](ir::ExitIf*) { kind = InstructionKind::kExitIf; },
+            [&](ir::ExitLoop*) { kind = InstructionKind::kExitLoop; },
+            [&](ir::ExitSwitch*) { kind = InstructionKind::kExitSwitch; },
+            [&](ir::If*) { kind = InstructionKind::kIf; },
+            [&](ir::Let*) { kind = InstructionKind::kLet; },
+            [&](ir::Load*) { kind = InstructionKind::kLoad; },
+            [&](ir::LoadVectorElement*) { kind = InstructionKind::kLoadVectorElement; },
+            [&](ir::Loop*) { kind = InstructionKind::kLoop; },
+            [&](ir::NextIteration*) { kind = InstructionKind::kNextIteration; },
+            [&](ir::Return*) { kind = InstructionKind::kReturn; },
+            [&](ir::Store*) { kind = InstructionKind::kStore; },
+            [&](ir::StoreVectorElement*) { kind = InstructionKind::kStoreVectorElement; },
+            [&](ir::Switch*) { kind = InstructionKind::kSwitch; },
+            [&](ir::Swizzle*) { kind = InstructionKind::kSwizzle; },
+            [&](ir::TerminateInvocation*) { kind = InstructionKind::kTerminateInvocation; },
+            [&](ir::Unary*) { kind = InstructionKind::kUnary; },
+            [&](ir::Unreachable*) { kind = InstructionKind::kUnreachable; },
+            [&](ir::UserCall*) { kind = InstructionKind::kUserCall; },
+            [&](ir::Var*) { kind = InstructionKind::kVar; });
+        return kind;
+    }
+
+    /// Writes @p inst.
+    /// @param out the stream to write to
+    /// @param inst the instruction
+    void WriteInstruction(Stream& out, ir::Instruction* inst) {
+        auto kind = KindOf(inst);
+        if (!kind) {
+            Error("unsupported instruction: " + inst->FriendlyName());
+            return;
+        }
+        out.Enum(*kind);
+
+        auto operands = inst->Operands();
+        out.Uint(operands.Length());
+        for (auto* operand : operands) {
+            WriteOperand(out, operand);
+        }
+
+        auto results = inst->Results();
+        out.Uint(results.Length());
+        for (auto* result : results) {
+            DeclareValue(result);
+            out.Uint(TypeId(result->Type()));
+            WriteName(out, result);
+        }
+
+        if (auto* ctrl = inst->As<ir::ControlInstruction>()) {
+            control_instructions.Add(ctrl, static_cast<uint32_t>(control_instructions.Count()));
+        }
+
+        tint::Switch(
+            inst,  //
+            [&](ir::Binary* b) { out.Enum(b->Op()); },
+            [&](ir::Unary* u) { out.Enum(u->Op()); },
+            [&](ir::CoreBuiltinCall* c) { out.Enum(c->Func()); },
+            [&](ir::Swizzle* s) {
+                out.Uint(s->Indices().Length());
+                for (auto idx : s->Indices()) {
+                    out.Uint(idx);
+                }
+            },
+            [&](ir::Var* v) {
+                WriteBindingPoint(out, v->BindingPoint());
+                auto& attrs = v->Attributes();
+                out.Optional(attrs.location, [&](uint32_t l) { out.Uint(l); });
+                out.Optional(attrs.index, [&](uint32_t i) { out.Uint(i); });
+                out.Optional(attrs.builtin, [&](core::BuiltinValue b) { out.Enum(b); });
+                WriteInterpolation(out, attrs.interpolation);
+                out.Bool(attrs.invariant);
+            },
+            [&](ir::Exit* e) { ControlInstructionRef(out, e->ControlInstruction()); },
+            [&](ir::BreakIf* b) { ControlInstructionRef(out, b->Loop()); },
+            [&](ir::Continue* c) { ControlInstructionRef(out, c->Loop()); },
+            [&](ir::NextIteration* n) { ControlInstructionRef(out, n->Loop()); },
+            [&](ir::If* i) {
+                WriteBlock(out, i->True());
+                WriteBlock(out, i->False());
+            },
+            [&](ir::Loop* l) {
+                WriteBlock(out, l->Initializer());
+                WriteMultiInBlock(out, l->Body());
+                WriteMultiInBlock(out, l->Continuing());
+            },
+            [&](ir::Switch* s) {
+                out.Uint(s->Cases().Length());
+                for (auto& c : s->Cases()) {
+                    out.Uint(c.selectors.Length());
+                    for (auto& sel : c.selectors) {
+                        WriteOperand(out, sel.val);
+                    }
+                    WriteBlock(out, c.Block());
+                }
+            });
+    }
+
+    /// @returns the index of @p type in the type table, adding it if necessary
+    /// @param type the type
+    uint32_t TypeId(const core::type::Type* type) {
+        if (auto idx = types.Get(type)) {
+            return *idx;
+        }
+
+        // Dependencies are added to the table before the type that references them, so encode the
+        // type into a temporary stream.
+        Stream out;
+        tint::Switch(
+            type,  //
+            [&](const core::type::Void*) { out.Enum(TypeKind::kVoid); },
+            [&](const core::type::Bool*) { out.Enum(TypeKind::kBool); },
+            [&](const core::type::I32*) { out.Enum(TypeKind::kI32); },
+            [&](const core::type::U32*) { out.Enum(TypeKind::kU32); },
+            [&](const core::type::F32*) { out.Enum(TypeKind::kF32); },
+            [&](const core::type::F16*) { out.Enum(TypeKind::kF16); },
+            [&](const core::type::Vector* v) {
+                auto el = TypeId(v->type());
+                out.Enum(TypeKind::kVector);
+                out.Uint(el);
+                out.Uint(v->Width());
+                out.Bool(v->Packed());
+            },
+            [&](const core::type::Matrix* m) {
+                auto col = TypeId(m->ColumnType());
+                out.Enum(TypeKind::kMatrix);
+                out.Uint(col);
+                out.Uint(m->columns());
+            },
+            [&](const core::type::Array* a) {
+                auto el = TypeId(a->ElemType());
+                if (auto* count = a->Count()->As<core::type::ConstantArrayCount>()) {
+                    out.Enum(TypeKind::kArray);
+                    out.Uint(el);
+                    out.Uint(count->value);
+                } else if (a->Count()->Is<core::type::RuntimeArrayCount>()) {
+                    out.Enum(TypeKind::kRuntimeArray);
+                    out.Uint(el);
+                } else {
+                    Error("unsupported array count: " + a->FriendlyName());
+                }
+                out.Uint(a->Align());
+                out.Uint(a->Size());
+                out.Uint(a->Stride());
+                out.Uint(a->ImplicitStride());
+            },
+            [&](const core::type::Atomic* a) {
+                auto el = TypeId(a->Type());
+                out.Enum(TypeKind::kAtomic);
+                out.Uint(el);
+            },
+            [&](const core::type::Pointer* p) {
+                auto store = TypeId(p->StoreType());
+                out.Enum(TypeKind::kPointer);
+                out.Enum(p->AddressSpace());
+                out.Uint(store);
+                out.Enum(p->Access());
+            },
+            [&](const core::type::Struct* s) { WriteStruct(out, s); },
+            [&](const core::type::Sampler* s) {
+                out.Enum(TypeKind::kSampler);
+                out.Enum(s->kind());
+            },
+            [&](const core::type::DepthTexture* t) {
+                out.Enum(TypeKind::kDepthTexture);
+                out.Enum(t->dim());
+            },
+            [&](const core::type::DepthMultisampledTexture* t) {
+                out.Enum(TypeKind::kDepthMultisampledTexture);
+                out.Enum(t->dim());
+            },
+            [&](const core::type::ExternalTexture*) { out.Enum(TypeKind::kExternalTexture); },
+            [&](const core::type::MultisampledTexture* t) {
+                auto el = TypeId(t->type());
+                out.Enum(TypeKind::kMultisampledTexture);
+                out.Enum(t->dim());
+                out.Uint(el);
+            },
+            [&](const core::type::SampledTexture* t) {
+                auto el = TypeId(t->type());
+                out.Enum(TypeKind::kSampledTexture);
+                out.Enum(t->dim());
+                out.Uint(el);
+            },
+            [&](const core::type::StorageTexture* t) {
+                auto el = TypeId(t->type());
+                out.Enum(TypeKind::kStorageTexture);
+                out.Enum(t->dim());
+                out.Enum(t->texel_format());
+                out.Enum(t->access());
+                out.Uint(el);
+            },
+            [&](Default) { Error("unsupported type: " + type->FriendlyName()); });
+
+        auto idx = static_cast<uint32_t>(types.Count());
+        types.Add(type, idx);
+        types_out.Append(out);
+        return idx;
+    }
+
+    /// Writes the structure @p s.
+    /// @param out the stream to write to
+    /// @param s the structure
+    void WriteStruct(Stream& out, const core::type::Struct* s) {
+        // Encode the member types first, as these will be added to the type table.
+        Vector<uint32_t, 8> member_types;
+        for (auto* member : s->Members()) {
+            member_types.Push(TypeId(member->Type()));
+        }
+
+        out.Enum(TypeKind::kStruct);
+        WriteString(out, s->Name());
+        out.Uint(s->Members().Length());
+        for (auto* member : s->Members()) {
+            WriteString(out, member->Name());
+            out.Uint(member_types[member->Index()]);
+            out.Uint(member->Offset());
+            out.Uint(member->Align());
+            out.Uint(member->Size());
+            auto& attrs = member->Attributes();
+            out.Optional(attrs.location, [&](uint32_t l) { out.Uint(l); });
+            out.Optional(attrs.index, [&](uint32_t i) { out.Uint(i); });
+            out.Optional(attrs.builtin, [&](core::BuiltinValue b) { out.Enum(b); });
+            WriteInterpolation(out, attrs.interpolation);
+            out.Bool(attrs.invariant);
+        }
+        out.Uint(s->Align());
+        out.Uint(s->Size());
+        out.Uint(s->SizeNoPadding());
+        out.Uint(s->StructFlags().Value());
+
+        // The usages are held in unordered sets, so sort them to keep the encoding deterministic.
+        Vector<core::AddressSpace, 4> address_spaces;
+        for (auto usage : s->AddressSpaceUsage()) {
+            address_spaces.Push(usage);
+        }
+        std::sort(address_spaces.begin(), address_spaces.end());
+        out.Uint(address_spaces.Length());
+        for (auto usage : address_spaces) {
+            out.Enum(usage);
+        }
+        Vector<core::type::PipelineStageUsage, 4> stages;
+        for (auto usage : s->PipelineStageUses()) {
+            stages.Push(usage);
+        }
+        std::sort(stages.begin(), stages.end());
+        out.Uint(stages.Length());
+        for (auto usage : stages) {
+            out.Enum(usage);
+        }
+    }
+
+    /// @returns the index of @p value in the constant table, adding it if necessary
+    /// @param value the constant value
+    uint32_t ConstantId(const core::constant::Value* value) {
+        if (auto idx = constants.Get(value)) {
+            return *idx;
+        }
+
+        Stream out;
+        tint::Switch(
+            value,  //
+            [&](const core::constant::Scalar<bool>* s) {
+                out.Enum(ConstantKind::kBool);
+                out.Bool(s->value);
+            },
+            [&](const core::constant::Scalar<core::i32>* s) {
+                out.Enum(ConstantKind::kI32);
+                out.Uint(tint::Bitcast<uint32_t>(s->value.value));
+            },
+            [&](const core::constant::Scalar<core::u32>* s) {
+                out.Enum(ConstantKind::kU32);
+                out.Uint(s->value.value);
+            },
+            [&](const core::constant::Scalar<core::f32>* s) {
+                out.Enum(ConstantKind::kF32);
+                out.Uint(tint::Bitcast<uint32_t>(s->value.value));
+            },
+            [&](const core::constant::Scalar<core::f16>* s) {
+                out.Enum(ConstantKind::kF16);
+                out.Uint(tint::Bitcast<uint32_t>(s->value.value));
+            },
+            [&](const core::constant::Splat* s) {
+                auto ty = TypeId(s->Type());
+                auto el = ConstantId(s->el);
+                out.Enum(ConstantKind::kSplat);
+                out.Uint(ty);
+                out.Uint(el);
+                out.Uint(s->count);
+            },
+            [&](const core::constant::Composite* c) {
+                auto ty = TypeId(c->Type());
+                Vector<uint32_t, 8> elements;
+                for (auto* el : c->elements) {
+                    elements.Push(ConstantId(el));
+                }
+                out.Enum(ConstantKind::kComposite);
+                out.Uint(ty);
+                out.Uint(elements.Length());
+                for (auto el : elements) {
+                    out.Uint(el);
+                }
+            },
+            [&](Default) {
+                Error("unsupported constant of type: " + value->Type()->FriendlyName());
+            });
+
+        auto idx = static_cast<uint32_t>(constants.Count());
+        constants.Add(value, idx);
+        constants_out.Append(out);
+        return idx;
+    }
+};
+
+}  // namespace
+
+Result<std::vector<std::byte>> Encode(Module& module) {
+    return Encoder{module}.Encode();
+}
+
+}  // namespace tint::core::ir::binary
@@ -0,0 +1,132 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_LANG_CORE_IR_BINARY_FORMAT_H_
+#define SRC_TINT_LANG_CORE_IR_BINARY_FORMAT_H_
+
+#include <cstdint>
+
+// The binary encoding of a core IR module is laid out as follows:
+//
+//   magic    : the four bytes 'T', 'I', 'R', 'B'
+//   version  : uint
+//   strings  : uint count, then for each string: uint length, bytes
+//   types    : uint count, then for each type: TypeKind, kind-specific fields
+//   constants: uint count, then for each constant: ConstantKind, kind-specific fields
+//   functions: uint count, then for each function: its signature and parameters
+//   root     : the module-scope block
+//   bodies   : the block of each function, in declaration order
+//
+// All integers are unsigned LEB128 varints. Signed integers are encoded as their two's complement
+// bit pattern, and floating point values as the bit pattern of their f32 representation. Types and
+// constants are interned, and are emitted before any entry that references them. Names are
+// references into the string table, where 0 is an unnamed value and N+1 is the N'th string.
+//
+// Values are numbered in the order they are declared: functions, then function parameters, then
+// block parameters and instruction results in the order they appear in the blocks. An operand is
+// encoded as 0 for a null operand, 2N+1 for the N'th constant and 2N+2 for the N'th value.
+// Control instructions are numbered in the order they appear, and exits refer to their target by
+// this number.
+
+namespace tint::core::ir::binary {
+
+/// The magic bytes at the start of the encoding.
+static constexpr uint8_t kMagic[] = {'T', 'I', 'R', 'B'};
+
+/// The version of the encoding. Must be incremented for any change to the encoding.
+static constexpr uint32_t kVersion = 1;
+
+/// The kind of an encoded type.
+enum class TypeKind : uint8_t {
+    kVoid,
+    kBool,
+    kI32,
+    kU32,
+    kF32,
+    kF16,
+    kVector,
+    kMatrix,
+    kArray,
+    kRuntimeArray,
+    kAtomic,
+    kPointer,
+    kStruct,
+    kSampler,
+    kDepthTexture,
+    kDepthMultisampledTexture,
+    kExternalTexture,
+    kMultisampledTexture,
+    kSampledTexture,
+    kStorageTexture,
+};
+
+/// The kind of an encoded constant value.
+enum class ConstantKind : uint8_t {
+    kBool,
+    kI32,
+    kU32,
+    kF32,
+    kF16,
+    kSplat,
+    kComposite,
+};
+
+/// The kind of an encoded instruction.
+enum class InstructionKind : uint8_t {
+    kAccess,
+    kBinary,
+    kBitcast,
+    kBreakIf,
+    kConstruct,
+    kContinue,
+    kConvert,
+    kCoreBuiltinCall,
+    kDiscard,
+    kExitIf,
+    kExitLoop,
+    kExitSwitch,
+    kIf,
+    kLet,
+    kLoad,
+    kLoadVectorElement,
+    kLoop,
+    kNextIteration,
+    kReturn,
+    kStore,
+    kStoreVectorElement,
+    kSwitch,
+    kSwizzle,
+    kTerminateInvocation,
+    kUnary,
+    kUnreachable,
+    kUserCall,
+    kVar,
+};
+
+}  // namespace tint::core::ir::binary
+
+#endif  // SRC_TINT_LANG_CORE_IR_BINARY_FORMAT_H_
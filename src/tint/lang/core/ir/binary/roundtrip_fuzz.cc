@@ -0,0 +1,90 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// GEN_BUILD:CONDITION(tint_build_wgsl_reader)
+
+#include <iostream>
+
+#include "tint/cmd/fuzz/wgsl/wgsl_fuzz.h"
+#include "tint/lang/core/ir/binary/decode.h"
+#include "tint/lang/core/ir/binary/encode.h"
+#include "tint/lang/core/ir/disassembler.h"
+#include "tint/lang/wgsl/helpers/apply_substitute_overrides.h"
+#include "tint/lang/wgsl/reader/lower/lower.h"
+#include "tint/lang/wgsl/reader/program_to_ir/program_to_ir.h"
+
+namespace tint::core::ir::binary {
+namespace {
+
+void IRBinaryRoundtripFuzzer(const tint::Program& program) {
+    auto transformed = tint::wgsl::ApplySubstituteOverrides(program);
+    auto& src = transformed ? transformed.value() : program;
+    if (!src.IsValid()) {
+        return;
+    }
+
+    auto ir = tint::wgsl::reader::ProgramToIR(src);
+    if (!ir) {
+        return;
+    }
+    if (auto res = tint::wgsl::reader::Lower(ir.Get()); !res) {
+        return;
+    }
+
+    auto encoded = Encode(ir.Get());
+    if (!encoded) {
+        TINT_ICE() << encoded.Failure();
+        return;
+    }
+    auto decoded = Decode(Slice<const std::byte>{encoded->data(), encoded->size()});
+    if (!decoded) {
+        TINT_ICE() << decoded.Failure();
+        return;
+    }
+
+    auto pre = Disassemble(ir.Get());
+    auto post = Disassemble(decoded.Get());
+    if (pre != post) {
+        std::cerr << "Original IR:\n" << pre << std::endl;
+        std::cerr << "Decoded IR:\n" << post << std::endl;
+        TINT_ICE() << "IR changed by encoding and decoding";
+        return;
+    }
+
+    // Corrupt a byte of the encoding. The decoder must fail gracefully, or produce a module.
+    if (!encoded->empty()) {
+        auto& byte = encoded.Get()[pre.size() % encoded->size()];
+        byte = static_cast<std::byte>(static_cast<uint8_t>(byte) ^ 0x5a);
+        auto corrupted = Decode(Slice<const std::byte>{encoded->data(), encoded->size()});
+        (void)corrupted;
+    }
+}
+
+}  // namespace
+}  // namespace tint::core::ir::binary
+
+TINT_WGSL_PROGRAM_FUZZER(tint::core::ir::binary::IRBinaryRoundtripFuzzer);
@@ -0,0 +1,462 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "tint/lang/core/ir/binary/decode.h"
+#include "tint/lang/core/ir/binary/encode.h"
+#include "tint/lang/core/ir/disassembler.h"
+#include "tint/lang/core/ir/ir_helper_test.h"
+#include "tint/lang/core/type/depth_multisampled_texture.h"
+#include "tint/lang/core/type/depth_texture.h"
+#include "tint/lang/core/type/external_texture.h"
+#include "tint/lang/core/type/multisampled_texture.h"
+#include "tint/lang/core/type/sampled_texture.h"
+#include "tint/lang/core/type/storage_texture.h"
+#include "tint/utils/memory/allocation_stats.h"
+
+namespace tint::core::ir::binary {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+class IRBinaryRoundtripTest : public IRTestHelper {
+  public:
+    /// @returns the module encoded, or an empty vector on failure
+    std::vector<std::byte> EncodeModule() {
+        auto encoded = Encode(mod);
+        EXPECT_TRUE(encoded) << encoded.Failure();
+        return encoded ? encoded.Get() : std::vector<std::byte>{};
+    }
+
+    /// @returns the disassembly of the module before and after encoding and decoding it
+    std::pair<std::string, std::string> Roundtrip() {
+        auto pre = Disassemble(mod);
+        auto encoded = EncodeModule();
+        auto decoded = Decode(Slice<const std::byte>{encoded.data(), encoded.size()});
+        if (!decoded) {
+            return {pre, decoded.Failure().reason.str()};
+        }
+        return {pre, Disassemble(decoded.Get())};
+    }
+};
+
+#define RUN_TEST()                    \
+    {                                 \
+        auto [pre, post] = Roundtrip(); \
+        EXPECT_EQ(pre, post);         \
+    }
+
+TEST_F(IRBinaryRoundtripTest, EmptyModule) {
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, Types) {
+    auto* s = ty.Struct(mod.symbols.New("S"), {
+                                                  {mod.symbols.New("a"), ty.i32()},
+                                                  {mod.symbols.New("b"), ty.vec3<f32>()},
+                                              });
+    Vector<const core::type::Type*, 16> types{
+        ty.bool_(),
+        ty.i32(),
+        ty.u32(),
+        ty.f32(),
+        ty.f16(),
+        ty.vec2<i32>(),
+        ty.vec4<bool>(),
+        ty.packed_vec(ty.f32(), 3),
+        ty.mat2x3<f32>(),
+        ty.mat4x4<f16>(),
+        ty.array<u32, 4>(),
+        ty.array(ty.vec3<f32>(), 3, 32),
+        ty.array(ty.array<i32, 2>(), 2),
+        ty.atomic<i32>(),
+        s,
+    };
+    b.Append(mod.root_block, [&] {
+        for (auto* type : types) {
+            b.Var(ty.ptr(core::AddressSpace::kPrivate, type));
+        }
+        b.Var(ty.ptr(core::AddressSpace::kStorage, ty.runtime_array(ty.u32()), read_write));
+        b.Var(ty.ptr<workgroup, atomic<u32>>());
+    });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, HandleTypes) {
+    using Dim = core::type::TextureDimension;
+    Vector<const core::type::Type*, 16> types{
+        ty.sampler(),
+        ty.comparison_sampler(),
+        ty.Get<core::type::DepthTexture>(Dim::k2d),
+        ty.Get<core::type::DepthTexture>(Dim::kCubeArray),
+        ty.Get<core::type::DepthMultisampledTexture>(Dim::k2d),
+        ty.Get<core::type::ExternalTexture>(),
+        ty.Get<core::type::MultisampledTexture>(Dim::k2d, ty.i32()),
+        ty.Get<core::type::SampledTexture>(Dim::k3d, ty.f32()),
+        ty.Get<core::type::SampledTexture>(Dim::k2dArray, ty.u32()),
+        ty.Get<core::type::StorageTexture>(Dim::k2d, core::TexelFormat::kRgba8Unorm,
+                                           core::Access::kWrite, ty.f32()),
+        ty.Get<core::type::StorageTexture>(Dim::k1d, core::TexelFormat::kR32Uint,
+                                           core::Access::kReadWrite, ty.u32()),
+    };
+    b.Append(mod.root_block, [&] {
+        uint32_t binding = 0;
+        for (auto* type : types) {
+            auto* v = b.Var(ty.ptr(core::AddressSpace::kHandle, type, core::Access::kRead));
+            v->SetBindingPoint(1, binding++);
+        }
+    });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, StructAttributes) {
+    core::type::StructMemberAttributes pos_attrs;
+    pos_attrs.builtin = core::BuiltinValue::kPosition;
+    pos_attrs.invariant = true;
+    core::type::StructMemberAttributes color_attrs;
+    color_attrs.location = 1;
+    color_attrs.index = 0;
+    color_attrs.interpolation = core::Interpolation{core::InterpolationType::kLinear,
+                                                    core::InterpolationSampling::kCentroid};
+    auto* s = ty.Struct(mod.symbols.New("Outputs"),
+                        {
+                            {mod.symbols.New("pos"), ty.vec4<f32>(), pos_attrs},
+                            {mod.symbols.New("color"), ty.vec4<f32>(), color_attrs},
+                        });
+    s->SetStructFlag(core::type::kBlock);
+    s->AddUsage(core::AddressSpace::kUniform);
+    s->AddUsage(core::AddressSpace::kStorage);
+    s->AddUsage(core::type::PipelineStageUsage::kVertexOutput);
+    b.Append(mod.root_block, [&] { b.Var(ty.ptr(core::AddressSpace::kPrivate, s)); });
+    RUN_TEST();
+
+    auto encoded = EncodeModule();
+    auto decoded = Decode(Slice<const std::byte>{encoded.data(), encoded.size()});
+    ASSERT_TRUE(decoded) << decoded.Failure();
+    auto* var = decoded->root_block->Front()->As<ir::Var>();
+    ASSERT_NE(var, nullptr);
+    auto* got = var->Result()->Type()->UnwrapPtr()->As<core::type::Struct>();
+    ASSERT_NE(got, nullptr);
+    EXPECT_TRUE(got->StructFlags().Contains(core::type::kBlock));
+    EXPECT_EQ(got->AddressSpaceUsage(), s->AddressSpaceUsage());
+    EXPECT_EQ(got->PipelineStageUses(), s->PipelineStageUses());
+    ASSERT_EQ(got->Members().Length(), 2u);
+    EXPECT_EQ(got->Members()[0]->Struct(), got);
+    EXPECT_EQ(got->Members()[1]->Attributes().index, 0u);
+    EXPECT_EQ(got->Size(), s->Size());
+    EXPECT_EQ(got->Align(), s->Align());
+}
+
+TEST_F(IRBinaryRoundtripTest, Constants) {
+    b.Append(mod.root_block, [&] {
+        b.Var("b", ty.ptr<private_, bool>())->SetInitializer(b.Constant(true));
+        b.Var("i", ty.ptr<private_, i32>())->SetInitializer(b.Constant(-42_i));
+        b.Var("u", ty.ptr<private_, u32>())->SetInitializer(b.Constant(0xffffffff_u));
+        b.Var("f", ty.ptr<private_, f32>())->SetInitializer(b.Constant(-1.5_f));
+        b.Var("h", ty.ptr<private_, f16>())->SetInitializer(b.Constant(0.25_h));
+        b.Var("splat", ty.ptr<private_, vec4<f32>>())
+            ->SetInitializer(b.Splat(ty.vec4<f32>(), 2_f, 4));
+        b.Var("composite", ty.ptr<private_, vec3<i32>>())
+            ->SetInitializer(b.Composite(ty.vec3<i32>(), 1_i, 2_i, 3_i));
+        b.Var("mat", ty.ptr<private_, mat2x2<f32>>())
+            ->SetInitializer(b.Composite(ty.mat2x2<f32>(), b.Composite(ty.vec2<f32>(), 1_f, 2_f),
+                                         b.Splat(ty.vec2<f32>(), 3_f, 2)));
+        b.Var("zero", ty.ptr<private_, array<u32, 3>>())
+            ->SetInitializer(b.Constant(mod.constant_values.Zero(ty.array<u32, 3>())));
+    });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, EntryPointAttributes) {
+    auto* frag = b.Function("frag", ty.vec4<f32>(), Function::PipelineStage::kFragment);
+    frag->SetReturnLocation(0, core::Interpolation{core::InterpolationType::kFlat});
+    auto* color = b.FunctionParam("color", ty.vec4<f32>());
+    color->SetLocation(2, core::Interpolation{core::InterpolationType::kPerspective,
+                                              core::InterpolationSampling::kSample});
+    auto* front_facing = b.FunctionParam("front_facing", ty.bool_());
+    front_facing->SetBuiltin(FunctionParam::Builtin::kFrontFacing);
+    frag->SetParams({color, front_facing});
+    b.Append(frag->Block(), [&] { b.Return(frag, color); });
+
+    auto* vert = b.Function("vert", ty.vec4<f32>(), Function::PipelineStage::kVertex);
+    vert->SetReturnBuiltin(Function::ReturnBuiltin::kPosition);
+    vert->SetReturnInvariant(true);
+    auto* index = b.FunctionParam("index", ty.u32());
+    index->SetBuiltin(FunctionParam::Builtin::kVertexIndex);
+    auto* pos = b.FunctionParam("pos", ty.vec4<f32>());
+    pos->SetLocation(0, {});
+    pos->SetInvariant(true);
+    vert->SetParams({index, pos});
+    b.Append(vert->Block(), [&] { b.Return(vert, pos); });
+
+    auto* comp = b.Function("comp", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{8, 4, 1});
+    auto* lid = b.FunctionParam("lid", ty.vec3<u32>());
+    lid->SetBuiltin(FunctionParam::Builtin::kLocalInvocationId);
+    comp->SetParams({lid});
+    b.Append(comp->Block(), [&] { b.Return(comp); });
+
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, RootVarAttributes) {
+    b.Append(mod.root_block, [&] {
+        auto* buffer = b.Var("buffer", ty.ptr<storage, array<u32>, read_write>());
+        buffer->SetBindingPoint(2, 3);
+        auto* in = b.Var("in", ty.ptr(core::AddressSpace::kIn, ty.vec4<f32>()));
+        IOAttributes attrs;
+        attrs.location = 1;
+        attrs.interpolation = core::Interpolation{core::InterpolationType::kLinear,
+                                                  core::InterpolationSampling::kCenter};
+        in->SetAttributes(attrs);
+        auto* out = b.Var("out", ty.ptr(core::AddressSpace::kOut, ty.vec4<f32>()));
+        IOAttributes out_attrs;
+        out_attrs.builtin = core::BuiltinValue::kPosition;
+        out_attrs.invariant = true;
+        out->SetAttributes(out_attrs);
+        auto* blend = b.Var("blend", ty.ptr(core::AddressSpace::kOut, ty.vec4<f32>()));
+        IOAttributes blend_attrs;
+        blend_attrs.location = 0;
+        blend_attrs.index = 1;
+        blend->SetAttributes(blend_attrs);
+    });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, Instructions) {
+    auto* helper = b.Function("helper", ty.f32());
+    auto* x = b.FunctionParam("x", ty.f32());
+    helper->SetParams({x});
+    b.Append(helper->Block(), [&] { b.Return(helper, b.Multiply(ty.f32(), x, 2_f)); });
+
+    auto* func = b.Function("func", ty.void_());
+    auto* p = b.FunctionParam("p", ty.ptr<function, vec4<f32>>());
+    auto* i = b.FunctionParam(ty.i32());
+    func->SetParams({p, i});
+    b.Append(func->Block(), [&] {
+        auto* v = b.Var("v", ty.ptr<function, array<vec4<f32>, 4>>());
+        auto* access = b.Access(ty.ptr<function, vec4<f32>>(), v, i);
+        auto* load = b.Load(access);
+        b.Store(p, load);
+        auto* el = b.LoadVectorElement(p, 1_u);
+        b.StoreVectorElement(p, 2_u, el);
+        auto* add = b.Add(ty.f32(), el, 1_f);
+        auto* neg = b.Negation(ty.f32(), add);
+        auto* cmp = b.LessThan(ty.bool_(), neg, 0_f);
+        auto* not_ = b.Not(ty.bool_(), cmp);
+        auto* let = b.Let("l", not_);
+        auto* conv = b.Convert(ty.u32(), i);
+        auto* cast = b.Bitcast(ty.f32(), conv);
+        auto* call = b.Call(ty.f32(), helper, cast);
+        auto* builtin = b.Call(ty.f32(), core::BuiltinFn::kMax, call, 3_f);
+        auto* vec = b.Construct(ty.vec2<f32>(), builtin, let);
+        b.Swizzle(ty.vec4<f32>(), vec, {1, 0, 1, 1});
+        b.Var("init", ty.ptr<function, f32>())->SetInitializer(builtin->Result());
+        b.Return(func);
+    });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, If) {
+    auto* func = b.Function("func", ty.i32(), Function::PipelineStage::kFragment);
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    cond->SetBuiltin(FunctionParam::Builtin::kFrontFacing);
+    func->SetParams({cond});
+    b.Append(func->Block(), [&] {
+        auto* if_ = b.If(cond);
+        auto* result = b.InstructionResult(ty.i32());
+        if_->SetResults(result);
+        b.Append(if_->True(), [&] {
+            auto* inner = b.If(false);
+            b.Append(inner->True(), [&] { b.Discard(); b.ExitIf(inner); });
+            b.ExitIf(if_, 1_i);
+        });
+        b.Append(if_->False(), [&] { b.ExitIf(if_, 2_i); });
+        b.Return(func, result);
+    });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, Loop) {
+    auto* func = b.Function("func", ty.u32());
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        auto* result = b.InstructionResult(ty.u32());
+        loop->SetResults(result);
+        b.Append(loop->Initializer(), [&] { b.NextIteration(loop, 0_u); });
+        auto* idx = b.BlockParam("idx", ty.u32());
+        loop->Body()->SetParams({idx});
+        b.Append(loop->Body(), [&] {
+            auto* if_ = b.If(b.Equal(ty.bool_(), idx, 10_u));
+            b.Append(if_->True(), [&] { b.ExitLoop(loop, idx); });
+            b.Continue(loop, b.Add(ty.u32(), idx, 1_u));
+        });
+        auto* next = b.BlockParam(ty.u32());
+        loop->Continuing()->SetParams({next});
+        b.Append(loop->Continuing(), [&] {
+            b.BreakIf(loop, b.GreaterThan(ty.bool_(), next, 100_u), next);
+        });
+        b.Return(func, result);
+    });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, Switch) {
+    auto* func = b.Function("func", ty.void_());
+    auto* sel = b.FunctionParam("sel", ty.i32());
+    func->SetParams({sel});
+    b.Append(func->Block(), [&] {
+        auto* switch_ = b.Switch(sel);
+        auto* result = b.InstructionResult(ty.f32());
+        switch_->SetResults(result);
+        b.Append(b.Case(switch_, {Switch::CaseSelector{b.Constant(1_i)},
+                                  Switch::CaseSelector{b.Constant(2_i)}}),
+                 [&] { b.ExitSwitch(switch_, 1_f); });
+        b.Append(b.Case(switch_, {Switch::CaseSelector{b.Constant(3_i)}}),
+                 [&] { b.TerminateInvocation(); });
+        b.Append(b.Case(switch_, {Switch::CaseSelector{b.Constant(4_i)}, Switch::CaseSelector{}}),
+                 [&] { b.ExitSwitch(switch_, 2_f); });
+        b.Let("r", result);
+        b.Unreachable();
+    });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, CallBeforeDeclaration) {
+    auto* caller = b.Function("caller", ty.i32());
+    auto* callee = b.Function("callee", ty.i32());
+    b.Append(caller->Block(), [&] { b.Return(caller, b.Call(ty.i32(), callee)); });
+    b.Append(callee->Block(), [&] { b.Return(callee, 1_i); });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, Names) {
+    auto* func = b.Function("a", ty.void_());
+    b.Append(func->Block(), [&] {
+        // Unnamed values, and values that share a name with other values.
+        b.Var(ty.ptr<function, i32>());
+        b.Var("a", ty.ptr<function, i32>());
+        b.Var("a", ty.ptr<function, i32>());
+        b.Return(func);
+    });
+    RUN_TEST();
+}
+
+TEST_F(IRBinaryRoundtripTest, Deterministic) {
+    auto* s = ty.Struct(mod.symbols.New("S"), {{mod.symbols.New("a"), ty.i32()}});
+    s->AddUsage(core::AddressSpace::kWorkgroup);
+    s->AddUsage(core::AddressSpace::kPrivate);
+    s->AddUsage(core::AddressSpace::kStorage);
+    b.Append(mod.root_block, [&] { b.Var(ty.ptr(core::AddressSpace::kPrivate, s)); });
+    EXPECT_EQ(EncodeModule(), EncodeModule());
+}
+
+TEST_F(IRBinaryRoundtripTest, DecodeIntoReusedModule) {
+    auto* func = b.Function("func", ty.vec2<f32>());
+    b.Append(func->Block(), [&] {
+        auto* v = b.Var("v", ty.ptr<function, vec2<f32>>());
+        v->SetInitializer(b.Composite(ty.vec2<f32>(), 1_f, 2_f));
+        b.Return(func, b.Load(v));
+    });
+    auto expected = Disassemble(mod);
+    auto encoded = EncodeModule();
+    Slice<const std::byte> slice{encoded.data(), encoded.size()};
+
+    Module decoded;
+    ASSERT_TRUE(Decode(slice, decoded));
+    EXPECT_EQ(Disassemble(decoded), expected);
+
+    // Decoding again replaces the previous content, and reuses the module's memory.
+    auto before = ThreadAllocationStats();
+    auto res = Decode(slice, decoded);
+    ASSERT_TRUE(res) << res.Failure();
+    EXPECT_EQ(ThreadAllocationStats().allocations, before.allocations);
+    EXPECT_EQ(Disassemble(decoded), expected);
+}
+
+TEST_F(IRBinaryRoundtripTest, Truncated) {
+    auto* func = b.Function("func", ty.vec2<f32>());
+    b.Append(func->Block(), [&] {
+        auto* v = b.Var("v", ty.ptr<function, vec2<f32>>());
+        v->SetInitializer(b.Composite(ty.vec2<f32>(), 1_f, 2_f));
+        b.Return(func, b.Load(v));
+    });
+    auto encoded = EncodeModule();
+    ASSERT_FALSE(encoded.empty());
+    for (size_t len = 0; len < encoded.size(); len++) {
+        auto decoded = Decode(Slice<const std::byte>{encoded.data(), len});
+        EXPECT_FALSE(decoded) << "length: " << len;
+    }
+}
+
+TEST_F(IRBinaryRoundtripTest, TrailingData) {
+    auto encoded = EncodeModule();
+    encoded.push_back(std::byte{0});
+    auto decoded = Decode(Slice<const std::byte>{encoded.data(), encoded.size()});
+    ASSERT_FALSE(decoded);
+    EXPECT_EQ(decoded.Failure().reason.str(),
+              "error: invalid IR encoding: unexpected data after the end of the module at offset " +
+                  std::to_string(encoded.size() - 1));
+}
+
+TEST_F(IRBinaryRoundtripTest, BadMagic) {
+    auto encoded = EncodeModule();
+    encoded[0] = std::byte{'X'};
+    auto decoded = Decode(Slice<const std::byte>{encoded.data(), encoded.size()});
+    ASSERT_FALSE(decoded);
+    EXPECT_EQ(decoded.Failure().reason.str(), "error: invalid IR encoding: bad magic");
+}
+
+TEST_F(IRBinaryRoundtripTest, BadVersion) {
+    auto encoded = EncodeModule();
+    encoded[4] = std::byte{0x7f};
+    auto decoded = Decode(Slice<const std::byte>{encoded.data(), encoded.size()});
+    ASSERT_FALSE(decoded);
+    EXPECT_EQ(decoded.Failure().reason.str(), "error: unsupported IR encoding version: 127");
+}
+
+TEST_F(IRBinaryRoundtripTest, InvalidValueIndex) {
+    auto* func = b.Function("func", ty.void_());
+    b.Append(func->Block(), [&] { b.Return(func); });
+    auto encoded = EncodeModule();
+    // The encoding ends with the return instruction's reference to the function, followed by its
+    // result count.
+    auto& ref = encoded[encoded.size() - 2];
+    ASSERT_EQ(ref, std::byte{2});
+    ref = std::byte{4};
+    auto decoded = Decode(Slice<const std::byte>{encoded.data(), encoded.size()});
+    ASSERT_FALSE(decoded);
+    EXPECT_THAT(decoded.Failure().reason.str(), testing::HasSubstr("invalid value index"));
+}
+
+}  // namespace
+}  // namespace tint::core::ir::binary
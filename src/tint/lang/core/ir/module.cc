@@ -41,6 +41,19 @@ Module::~Module() = default;
 
 Module& Module::operator=(Module&&) = default;
 
+void Module::Clear() {
+    value_to_name_.Clear();
+    constants.Clear();
+    functions.Clear();
+    disassembly_file.reset();
+    instructions.Clear();
+    values.Clear();
+    blocks.Clear();
+    constant_values.Clear();
+    symbols.Clear();
+    root_block = blocks.Create<ir::Block>();
+}
+
 Symbol Module::NameOf(Instruction* inst) {
     TINT_ASSERT(inst->HasResults() && !inst->HasMultiResults());
     return NameOf(inst->Result());
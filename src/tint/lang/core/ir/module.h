@@ -69,6 +69,12 @@ class Module {
     /// @returns a reference to this module
     Module& operator=(Module&& o);
 
+    /// Destroys all the functions, blocks, instructions, values, constants, types and symbols of
+    /// the module, leaving it empty as if it was default-constructed. The memory used to allocate
+    /// them is retained, so that building the next module into this one makes few heap allocations.
+    /// Pointers and symbols obtained from the module before the call must not be used after it.
+    void Clear();
+
     /// @param inst the instruction
     /// @return the name of the given instruction, or an invalid symbol if the instruction is not
     /// named. Requires that the instruction only has a single return value.
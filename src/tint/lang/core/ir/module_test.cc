@@ -55,5 +55,30 @@ TEST_F(IR_ModuleTest, SetNameRename) {
     EXPECT_EQ(mod.NameOf(v).Name(), "b");
 }
 
+TEST_F(IR_ModuleTest, Clear) {
+    auto* func = b.Function("f", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* v = b.Var("v", ty.ptr<function, i32>());
+        b.Return(func, b.Load(v));
+    });
+    b.Append(mod.root_block, [&] { b.Var("g", ty.ptr<private_, f32>()); });
+
+    mod.Clear();
+    EXPECT_TRUE(mod.functions.IsEmpty());
+    ASSERT_NE(mod.root_block, nullptr);
+    EXPECT_TRUE(mod.root_block->IsEmpty());
+    EXPECT_EQ(mod.instructions.Count(), 0u);
+    EXPECT_EQ(mod.values.Count(), 0u);
+    EXPECT_EQ(mod.blocks.Count(), 1u);
+    EXPECT_FALSE(mod.symbols.Get("f").IsValid());
+    EXPECT_EQ(mod.Types().begin(), mod.Types().end());
+
+    // The module can be used to build a new module.
+    auto* func2 = b.Function("f", ty.u32());
+    b.Append(func2->Block(), [&] { b.Return(func2, 1_u); });
+    EXPECT_EQ(mod.functions.Length(), 1u);
+    EXPECT_EQ(mod.NameOf(func2).Name(), "f");
+}
+
 }  // namespace
 }  // namespace tint::core::ir
@@ -53,14 +53,22 @@ tint_add_target(tint_lang_core_ir_transform lib
   lang/core/ir/transform/builtin_polyfill.h
   lang/core/ir/transform/combine_access_instructions.cc
   lang/core/ir/transform/combine_access_instructions.h
+  lang/core/ir/transform/constant_propagation.cc
+  lang/core/ir/transform/constant_propagation.h
   lang/core/ir/transform/conversion_polyfill.cc
   lang/core/ir/transform/conversion_polyfill.h
+  lang/core/ir/transform/dead_code_elimination.cc
+  lang/core/ir/transform/dead_code_elimination.h
   lang/core/ir/transform/demote_to_helper.cc
   lang/core/ir/transform/demote_to_helper.h
   lang/core/ir/transform/direct_variable_access.cc
   lang/core/ir/transform/direct_variable_access.h
+  lang/core/ir/transform/inline_functions.cc
+  lang/core/ir/transform/inline_functions.h
   lang/core/ir/transform/multiplanar_external_texture.cc
   lang/core/ir/transform/multiplanar_external_texture.h
+  lang/core/ir/transform/optimize.cc
+  lang/core/ir/transform/optimize.h
   lang/core/ir/transform/preserve_padding.cc
   lang/core/ir/transform/preserve_padding.h
   lang/core/ir/transform/robustness.cc
@@ -69,6 +77,8 @@ tint_add_target(tint_lang_core_ir_transform lib
   lang/core/ir/transform/shader_io.h
   lang/core/ir/transform/std140.cc
   lang/core/ir/transform/std140.h
+  lang/core/ir/transform/value_numbering.cc
+  lang/core/ir/transform/value_numbering.h
   lang/core/ir/transform/vectorize_scalar_matrix_constructors.cc
   lang/core/ir/transform/vectorize_scalar_matrix_constructors.h
   lang/core/ir/transform/zero_init_workgroup_memory.cc
@@ -110,14 +120,18 @@ tint_add_target(tint_lang_core_ir_transform_test test
   lang/core/ir/transform/block_decorated_structs_test.cc
   lang/core/ir/transform/builtin_polyfill_test.cc
   lang/core/ir/transform/combine_access_instructions_test.cc
+  lang/core/ir/transform/constant_propagation_test.cc
   lang/core/ir/transform/conversion_polyfill_test.cc
+  lang/core/ir/transform/dead_code_elimination_test.cc
   lang/core/ir/transform/demote_to_helper_test.cc
   lang/core/ir/transform/direct_variable_access_test.cc
   lang/core/ir/transform/helper_test.h
+  lang/core/ir/transform/inline_functions_test.cc
   lang/core/ir/transform/multiplanar_external_texture_test.cc
   lang/core/ir/transform/preserve_padding_test.cc
   lang/core/ir/transform/robustness_test.cc
   lang/core/ir/transform/std140_test.cc
+  lang/core/ir/transform/value_numbering_test.cc
   lang/core/ir/transform/vectorize_scalar_matrix_constructors_test.cc
   lang/core/ir/transform/zero_init_workgroup_memory_test.cc
 )
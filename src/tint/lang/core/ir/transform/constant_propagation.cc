@@ -0,0 +1,280 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/transform/constant_propagation.h"
+
+#include <utility>
+
+#include "tint/lang/core/constant/eval.h"
+#include "tint/lang/core/intrinsic/table.h"
+#include "tint/lang/core/ir/builder.h"
+#include "tint/lang/core/ir/module.h"
+#include "tint/lang/core/ir/traverse.h"
+#include "tint/lang/core/ir/validator.h"
+#include "tint/lang/core/type/matrix.h"
+#include "tint/lang/core/type/vector.h"
+#include "tint/utils/containers/transform.h"
+#include "tint/utils/ice/ice.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The IR builder.
+    Builder b{ir};
+
+    /// The type manager.
+    core::type::Manager& ty{ir.Types()};
+
+    /// The diagnostics produced by constant evaluation and intrinsic lookups.
+    /// These are cleared after each instruction, as failures just leave the instruction untouched.
+    diag::List diags{};
+
+    /// The constant evaluator.
+    core::constant::Eval eval{ir.constant_values, diags};
+
+    /// The overloads resolved by intrinsic lookups, as the same operators and builtins are
+    /// typically folded many times over.
+    core::intrinsic::OverloadCache overloads{};
+
+    /// The intrinsic lookup context.
+    core::intrinsic::Context context{core::intrinsic::Dialect::kData, ty, ir.symbols, diags,
+                                     &overloads};
+
+    /// Process the module.
+    void Process() {
+        // Gather the instructions up-front, as folding destroys instructions while we iterate.
+        // The instructions are visited in program order, so that the folded results of one
+        // instruction are visible to the instructions that use them.
+        Vector<Instruction*, 64> worklist;
+        auto gather = [&](Block* block) {
+            Traverse(block, [&](Instruction* inst) { worklist.Push(inst); });
+        };
+        gather(ir.root_block);
+        for (auto* func : ir.functions) {
+            gather(func->Block());
+        }
+
+        for (auto* inst : worklist) {
+            if (!inst->Alive()) {
+                continue;
+            }
+            auto* value = Fold(inst);
+            diags = diag::List{};
+            if (value) {
+                inst->Result()->ReplaceAllUsesWith(b.Constant(value));
+                inst->Destroy();
+            }
+        }
+    }
+
+    /// @param value the IR value
+    /// @returns the constant value of @p value, or nullptr if @p value is not a constant
+    const core::constant::Value* ConstantOf(Value* value) {
+        if (auto* c = As<ir::Constant>(value)) {
+            return c->Value();
+        }
+        return nullptr;
+    }
+
+    /// @param values the IR values
+    /// @param out the constant values of @p values
+    /// @returns true if all the values in @p values are constants
+    bool ConstantsOf(VectorRef<Value*> values, Vector<const core::constant::Value*, 4>& out) {
+        for (auto* value : values) {
+            auto* c = ConstantOf(value);
+            if (!c) {
+                return false;
+            }
+            out.Push(c);
+        }
+        return true;
+    }
+
+    /// Calls the constant evaluation function @p fn.
+    /// @param fn the constant evaluation function
+    /// @param type the result type
+    /// @param args the constant arguments
+    /// @returns the result of the evaluation, or nullptr if it failed
+    const core::constant::Value* Call(core::constant::Eval::Function fn,
+                                      const core::type::Type* type,
+                                      VectorRef<const core::constant::Value*> args) {
+        if (!fn) {
+            return nullptr;
+        }
+        auto result = (eval.*fn)(type, std::move(args), Source{});
+        return result ? result.Get() : nullptr;
+    }
+
+    /// Attempts to fold an instruction.
+    /// @param inst the instruction
+    /// @returns the constant value of the instruction's result, or nullptr if it cannot be folded
+    const core::constant::Value* Fold(Instruction* inst) {
+        Vector<const core::constant::Value*, 4> args;
+        if (!inst->Result() || !ConstantsOf(inst->Operands(), args)) {
+            return nullptr;
+        }
+        auto* res_ty = inst->Result()->Type();
+        return tint::Switch(
+            inst,  //
+            [&](Let*) -> const core::constant::Value* { return args[0]; },
+            [&](Binary* binary) -> const core::constant::Value* {
+                auto overload = core::intrinsic::LookupBinary(
+                    context, CoreOp(binary->Op()), args[0]->Type(), args[1]->Type(),
+                    core::EvaluationStage::kRuntime, Source{}, /* is_compound */ false);
+                return overload ? Call(overload->const_eval_fn, res_ty, args) : nullptr;
+            },
+            [&](Unary* unary) -> const core::constant::Value* {
+                auto op = unary->Op() == UnaryOp::kComplement ? core::UnaryOp::kComplement
+                                                              : core::UnaryOp::kNegation;
+                auto overload = core::intrinsic::LookupUnary(
+                    context, op, args[0]->Type(), core::EvaluationStage::kRuntime, Source{});
+                return overload ? Call(overload->const_eval_fn, res_ty, args) : nullptr;
+            },
+            [&](CoreBuiltinCall* call) -> const core::constant::Value* {
+                auto arg_tys = tint::Transform<4>(
+                    args.Slice(), [](const core::constant::Value* arg) { return arg->Type(); });
+                auto overload = core::intrinsic::LookupFn(
+                    context, call->FriendlyName(), call->FuncId(), std::move(arg_tys),
+                    core::EvaluationStage::kRuntime, Source{});
+                return overload ? Call(overload->const_eval_fn, res_ty, args) : nullptr;
+            },
+            [&](ir::Construct*) -> const core::constant::Value* {
+                return Construct(res_ty, args);
+            },
+            [&](Convert*) -> const core::constant::Value* {
+                auto result = eval.Convert(res_ty, args[0], Source{});
+                return result ? result.Get() : nullptr;
+            },
+            [&](Bitcast*) -> const core::constant::Value* {
+                auto result = eval.Bitcast(res_ty, args[0], Source{});
+                return result ? result.Get() : nullptr;
+            },
+            [&](Swizzle* swizzle) -> const core::constant::Value* {
+                auto result = eval.Swizzle(res_ty, args[0], swizzle->Indices());
+                return result ? result.Get() : nullptr;
+            },
+            [&](Access*) -> const core::constant::Value* {
+                const core::constant::Value* obj = args[0];
+                for (size_t i = 1; i < args.Length() && obj; i++) {
+                    auto result = eval.Index(obj, obj->Type(), args[i], Source{});
+                    obj = result ? result.Get() : nullptr;
+                }
+                return obj;
+            },
+            [&](Default) -> const core::constant::Value* { return nullptr; });
+    }
+
+    /// @param op the IR binary operator
+    /// @returns the core binary operator for @p op
+    core::BinaryOp CoreOp(BinaryOp op) {
+        switch (op) {
+            case BinaryOp::kAdd:
+                return core::BinaryOp::kAdd;
+            case BinaryOp::kSubtract:
+                return core::BinaryOp::kSubtract;
+            case BinaryOp::kMultiply:
+                return core::BinaryOp::kMultiply;
+            case BinaryOp::kDivide:
+                return core::BinaryOp::kDivide;
+            case BinaryOp::kModulo:
+                return core::BinaryOp::kModulo;
+            case BinaryOp::kAnd:
+                return core::BinaryOp::kAnd;
+            case BinaryOp::kOr:
+                return core::BinaryOp::kOr;
+            case BinaryOp::kXor:
+                return core::BinaryOp::kXor;
+            case BinaryOp::kEqual:
+                return core::BinaryOp::kEqual;
+            case BinaryOp::kNotEqual:
+                return core::BinaryOp::kNotEqual;
+            case BinaryOp::kLessThan:
+                return core::BinaryOp::kLessThan;
+            case BinaryOp::kGreaterThan:
+                return core::BinaryOp::kGreaterThan;
+            case BinaryOp::kLessThanEqual:
+                return core::BinaryOp::kLessThanEqual;
+            case BinaryOp::kGreaterThanEqual:
+                return core::BinaryOp::kGreaterThanEqual;
+            case BinaryOp::kShiftLeft:
+                return core::BinaryOp::kShiftLeft;
+            case BinaryOp::kShiftRight:
+                return core::BinaryOp::kShiftRight;
+        }
+        TINT_UNREACHABLE();
+        return core::BinaryOp::kAdd;
+    }
+
+    /// Evaluates a value construction.
+    /// @param type the constructed type
+    /// @param args the constant arguments
+    /// @returns the constructed value
+    const core::constant::Value* Construct(const core::type::Type* type,
+                                           VectorRef<const core::constant::Value*> args) {
+        if (args.IsEmpty()) {
+            return ir.constant_values.Zero(type);
+        }
+        auto result = [&] {
+            auto* arg_ty = args[0]->Type();
+            if (type->Is<core::type::Vector>()) {
+                if (args.Length() == 1 && arg_ty->Is<core::type::Scalar>()) {
+                    return eval.VecSplat(type, std::move(args), Source{});
+                }
+                return eval.VecInitM(type, std::move(args), Source{});
+            }
+            if (type->Is<core::type::Matrix>()) {
+                if (arg_ty->Is<core::type::Scalar>()) {
+                    return eval.MatInitS(type, std::move(args), Source{});
+                }
+                return eval.MatInitV(type, std::move(args), Source{});
+            }
+            return eval.ArrayOrStructCtor(type, std::move(args));
+        }();
+        return result ? result.Get() : nullptr;
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> ConstantPropagation(Module& ir) {
+    auto result = ValidateAndDumpIfNeeded(ir, "ConstantPropagation transform");
+    if (!result) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,312 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/transform/constant_propagation.h"
+
+#include <utility>
+
+#include "tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_ConstantPropagationTest = TransformTest;
+
+TEST_F(IR_ConstantPropagationTest, NoModify_NonConstantOperand) {
+    auto* param = b.FunctionParam("p", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({param});
+    b.Append(func->Block(), [&] {
+        auto* add = b.Add(ty.i32(), param, 1_i);
+        b.Return(func, add);
+    });
+
+    auto* src = R"(
+%foo = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, Binary) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* add = b.Add(ty.i32(), 1_i, 2_i);
+        b.Return(func, add);
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = add 1i, 2i
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    ret 3i
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, Chain) {
+    auto* func = b.Function("foo", ty.f32());
+    b.Append(func->Block(), [&] {
+        auto* x = b.Let("x", 2_i);
+        auto* neg = b.Negation(ty.i32(), x);
+        auto* mul = b.Multiply(ty.i32(), neg, 3_i);
+        auto* conv = b.Convert(ty.f32(), mul);
+        b.Return(func, conv);
+    });
+
+    auto* src = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    %x:i32 = let 2i
+    %3:i32 = negation %x
+    %4:i32 = mul %3, 3i
+    %5:f32 = convert %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    ret -6.0f
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, IntegerOverflowWraps) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* add = b.Add(ty.i32(), i32::Highest(), 1_i);
+        b.Return(func, add);
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = add 2147483647i, 1i
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    ret -2147483648i
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, NoModify_FloatOverflow) {
+    auto* func = b.Function("foo", ty.f32());
+    b.Append(func->Block(), [&] {
+        auto* mul = b.Multiply(ty.f32(), f32::Highest(), 2_f);
+        b.Return(func, mul);
+    });
+
+    auto* src = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    %2:f32 = mul 340282346638528859811704183484516925440.0f, 2.0f
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, NoModify_DivideByZero) {
+    auto* func = b.Function("foo", ty.u32());
+    b.Append(func->Block(), [&] {
+        auto* div = b.Divide(ty.u32(), 4_u, 0_u);
+        b.Return(func, div);
+    });
+
+    auto* src = R"(
+%foo = func():u32 -> %b1 {
+  %b1 = block {
+    %2:u32 = div 4u, 0u
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, Builtin) {
+    auto* param = b.FunctionParam("p", ty.f32());
+    auto* func = b.Function("foo", ty.f32());
+    func->SetParams({param});
+    b.Append(func->Block(), [&] {
+        auto* max = b.Call(ty.f32(), core::BuiltinFn::kMax, 1_f, 2_f);
+        auto* min = b.Call(ty.f32(), core::BuiltinFn::kMin, max, param);
+        b.Return(func, min);
+    });
+
+    auto* src = R"(
+%foo = func(%p:f32):f32 -> %b1 {
+  %b1 = block {
+    %3:f32 = max 1.0f, 2.0f
+    %4:f32 = min %3, %p
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%p:f32):f32 -> %b1 {
+  %b1 = block {
+    %3:f32 = min 2.0f, %p
+    ret %3
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, ConstructSwizzleAccess) {
+    auto* func = b.Function("foo", ty.f32());
+    b.Append(func->Block(), [&] {
+        auto* vec = b.Construct(ty.vec3<f32>(), 1_f, 2_f, 3_f);
+        auto* swizzle = b.Swizzle(ty.vec2<f32>(), vec, {2u, 1u});
+        auto* access = b.Access(ty.f32(), swizzle, 1_u);
+        b.Return(func, access);
+    });
+
+    auto* src = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    %2:vec3<f32> = construct 1.0f, 2.0f, 3.0f
+    %3:vec2<f32> = swizzle %2, zy
+    %4:f32 = access %3, 1u
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    ret 2.0f
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, ConstructMatrixFromScalars) {
+    auto* func = b.Function("foo", ty.mat2x2<f32>());
+    b.Append(func->Block(), [&] {
+        auto* mat = b.Construct(ty.mat2x2<f32>(), 1_f, 2_f, 3_f, 4_f);
+        b.Return(func, mat);
+    });
+
+    auto* src = R"(
+%foo = func():mat2x2<f32> -> %b1 {
+  %b1 = block {
+    %2:mat2x2<f32> = construct 1.0f, 2.0f, 3.0f, 4.0f
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():mat2x2<f32> -> %b1 {
+  %b1 = block {
+    ret mat2x2<f32>(vec2<f32>(1.0f, 2.0f), vec2<f32>(3.0f, 4.0f))
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,154 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/transform/dead_code_elimination.h"
+
+#include "tint/lang/core/intrinsic/table.h"
+#include "tint/lang/core/ir/builder.h"
+#include "tint/lang/core/ir/module.h"
+#include "tint/lang/core/ir/traverse.h"
+#include "tint/lang/core/ir/validator.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The instructions that may have become dead.
+    Vector<Instruction*, 64> worklist{};
+
+    /// Process the module.
+    void Process() {
+        RemoveUnusedFunctions();
+
+        for (auto* func : ir.functions) {
+            Traverse(func->Block(), [&](Instruction* inst) { worklist.Push(inst); });
+        }
+        while (!worklist.IsEmpty()) {
+            auto* inst = worklist.Pop();
+            if (inst->Alive() && IsDead(inst)) {
+                Remove(inst);
+            }
+        }
+    }
+
+    /// Removes the functions that are not entry points and are never called, including functions
+    /// that are only called by other unused functions.
+    void RemoveUnusedFunctions() {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (auto* func : ir.functions) {
+                if (func->Stage() == Function::PipelineStage::kUndefined && !IsCalled(func)) {
+                    // Destroying the function releases the uses of the functions that it calls.
+                    func->Destroy();
+                    changed = true;
+                }
+            }
+            ir.functions.EraseIf([](Function* func) { return !func->Alive(); });
+        }
+    }
+
+    /// @param func the function
+    /// @returns true if @p func is the target of a call instruction
+    bool IsCalled(Function* func) {
+        // The return instructions of a function also use the function as an operand.
+        return !func->Usages().All([](const Usage& u) { return u.instruction->Is<Return>(); });
+    }
+
+    /// Removes an instruction, and queues the instructions that produce its operands, as they may
+    /// now be unused.
+    /// @param inst the instruction to remove
+    void Remove(Instruction* inst) {
+        for (auto* operand : inst->Operands()) {
+            if (auto* res = As<InstructionResult>(operand)) {
+                worklist.Push(res->Source());
+            }
+        }
+        if (auto* var = inst->As<Var>()) {
+            // The variable is only ever stored to, so remove the stores too.
+            while (!var->Result()->Usages().IsEmpty()) {
+                Remove((*var->Result()->Usages().begin()).instruction);
+            }
+        }
+        inst->Destroy();
+    }
+
+    /// @param inst the instruction
+    /// @returns true if @p inst can be removed without changing the behavior of the program
+    bool IsDead(Instruction* inst) {
+        auto* result = inst->Result();
+        if (!result) {
+            return false;
+        }
+        if (auto* var = inst->As<Var>()) {
+            // A function-scope variable is dead if its pointer is only used as the target of
+            // stores.
+            return var->Block() != ir.root_block && result->Usages().All([](const Usage& u) {
+                return u.instruction->Is<Store>() && u.operand_index == Store::kToOperandOffset;
+            });
+        }
+        if (!result->Usages().IsEmpty()) {
+            return false;
+        }
+        return tint::Switch(
+            inst,  //
+            [&](Access*) { return true; },
+            [&](Binary*) { return true; },
+            [&](Bitcast*) { return true; },
+            [&](Construct*) { return true; },
+            [&](Convert*) { return true; },
+            [&](Let*) { return true; },
+            [&](Load*) { return true; },
+            [&](LoadVectorElement*) { return true; },
+            [&](Swizzle*) { return true; },
+            [&](Unary*) { return true; },
+            [&](BuiltinCall* call) {
+                return core::intrinsic::IsConstEvaluable(call->TableData(), call->FuncId());
+            },
+            [&](Default) { return false; });
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> DeadCodeElimination(Module& ir) {
+    auto result = ValidateAndDumpIfNeeded(ir, "DeadCodeElimination transform");
+    if (!result) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
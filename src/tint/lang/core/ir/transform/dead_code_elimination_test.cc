@@ -0,0 +1,402 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/transform/dead_code_elimination.h"
+
+#include <utility>
+
+#include "tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_DeadCodeEliminationTest = TransformTest;
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_EntryPoint) {
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {  //
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnusedChain) {
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {
+        auto* x = b.Let("x", 1_i);
+        auto* mul = b.Multiply(ty.i32(), x, 2_i);
+        auto* construct = b.Construct(ty.vec2<i32>(), mul, x);
+        b.Swizzle(ty.i32(), construct, {1u});
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    %x:i32 = let 1i
+    %3:i32 = mul %x, 2i
+    %4:vec2<i32> = construct %3, %x
+    %5:i32 = swizzle %4, y
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    ret
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnusedPureBuiltin) {
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {
+        b.Call(ty.f32(), core::BuiltinFn::kMax, 1_f, 2_f);
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    %2:f32 = max 1.0f, 2.0f
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    ret
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_UnusedImpureBuiltin) {
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {
+        b.Call(ty.f32(), core::BuiltinFn::kDpdx, 1_f);
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    %2:f32 = dpdx 1.0f
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_UnusedUserCall) {
+    auto* foo = b.Function("foo", ty.i32());
+    b.Append(foo->Block(), [&] {  //
+        b.Return(foo, 1_i);
+    });
+
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {
+        b.Call(foo);
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    ret 1i
+  }
+}
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = call %foo
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnusedFunctions) {
+    auto* foo = b.Function("foo", ty.i32());
+    b.Append(foo->Block(), [&] {  //
+        b.Return(foo, 1_i);
+    });
+
+    auto* bar = b.Function("bar", ty.i32());
+    b.Append(bar->Block(), [&] {  //
+        b.Return(bar, b.Call(foo));
+    });
+
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {  //
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    ret 1i
+  }
+}
+%bar = func():i32 -> %b2 {
+  %b2 = block {
+    %3:i32 = call %foo
+    ret %3
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    ret
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, VarOnlyStored) {
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        auto* x = b.Let("x", 1_i);
+        b.Store(v, b.Add(ty.i32(), x, 2_i));
+        b.Store(v, 3_i);
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var
+    %x:i32 = let 1i
+    %4:i32 = add %x, 2i
+    store %v, %4
+    store %v, 3i
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    ret
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnusedLoad) {
+    auto* g = b.Var<private_, i32>("g");
+    mod.root_block->Append(g);
+
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        b.Load(g);
+        b.Store(g, b.Load(v));
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %v:ptr<function, i32, read_write> = var
+    %4:i32 = load %g
+    %5:i32 = load %v
+    store %g, %5
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %v:ptr<function, i32, read_write> = var
+    %4:i32 = load %v
+    store %g, %4
+    ret
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_ModuleScopeVarOnlyStored) {
+    auto* g = b.Var<private_, i32>("g");
+    mod.root_block->Append(g);
+
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {
+        b.Store(g, 1_i);
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    store %g, 1i
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnusedInNestedBlock) {
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {
+        auto* x = b.Let("x", true);
+        auto* ifelse = b.If(x);
+        b.Append(ifelse->True(), [&] {
+            b.Not(ty.bool_(), x);
+            b.ExitIf(ifelse);
+        });
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    %x:bool = let true
+    if %x [t: %b2] {  # if_1
+      %b2 = block {  # true
+        %3:bool = eq %x, false
+        exit_if  # if_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    %x:bool = let true
+    if %x [t: %b2] {  # if_1
+      %b2 = block {  # true
+        exit_if  # if_1
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,341 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/transform/inline_functions.h"
+
+#include <utility>
+
+#include "tint/lang/core/ir/builder.h"
+#include "tint/lang/core/ir/clone_context.h"
+#include "tint/lang/core/ir/module.h"
+#include "tint/lang/core/ir/traverse.h"
+#include "tint/lang/core/ir/validator.h"
+#include "tint/utils/containers/hashmap.h"
+#include "tint/utils/containers/hashset.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// VariantKey identifies a specialized variant of a function.
+struct VariantKey {
+    /// The function that was specialized
+    Function* fn = nullptr;
+    /// The argument value of each specialized parameter, or nullptr for parameters that are not
+    /// specialized.
+    Vector<Value*, 4> args;
+
+    /// @returns the hash code of the key
+    size_t HashCode() const { return Hash(fn, args); }
+
+    /// Equality operator
+    /// @param other the key to compare against
+    /// @returns true if this key is equal to @p other
+    bool operator==(const VariantKey& other) const { return fn == other.fn && args == other.args; }
+};
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The transform options.
+    const InlineFunctionsOptions& options;
+
+    /// The IR builder.
+    Builder b{ir};
+
+    /// The specialized variants, keyed by function and argument values.
+    Hashmap<VariantKey, Function*, 8> variants{};
+
+    /// The specialized variants of each function, in creation order.
+    Hashmap<Function*, Vector<Function*, 4>, 8> variants_of{};
+
+    /// The functions that had calls redirected or inlined, and may no longer be called.
+    Hashset<Function*, 8> maybe_unused{};
+
+    /// Process the module.
+    void Process() {
+        if (options.max_specializations > 0) {
+            // Make a copy of all the functions in the IR module.
+            auto input_fns = ir.functions;
+
+            // Specialize the calls of every function, including the variants that are created as
+            // the functions are processed.
+            Vector<Function*, 8> queue;
+            for (auto* fn : Reverse(input_fns)) {
+                queue.Push(fn);
+            }
+            while (!queue.IsEmpty()) {
+                auto* fn = queue.Pop();
+                Traverse(fn->Block(), [&](UserCall* call) {
+                    if (auto* variant = Specialize(call)) {
+                        queue.Push(variant);
+                    }
+                });
+            }
+
+            // Rebuild ir.functions, with each variant following the function it was created from.
+            ir.functions.Clear();
+            for (auto* fn : input_fns) {
+                EmitFunction(fn);
+            }
+        }
+
+        // Inline calls. The functions are generally ordered so that callees come before their
+        // callers, so the body of a callee has already had its own calls inlined.
+        for (auto* fn : ir.functions) {
+            Vector<UserCall*, 8> calls;
+            Traverse(fn->Block(), [&](UserCall* call) { calls.Push(call); });
+            for (auto* call : calls) {
+                if (ShouldInline(call->Target())) {
+                    Inline(call);
+                }
+            }
+        }
+
+        // Remove the functions that are no longer called.
+        for (auto* fn : ir.functions) {
+            if (maybe_unused.Contains(fn) && CountCalls(fn) == 0) {
+                fn->Destroy();
+            }
+        }
+        ir.functions.EraseIf([](Function* fn) { return !fn->Alive(); });
+    }
+
+    /// Appends @p fn and its variants to ir.functions.
+    /// @param fn the function
+    void EmitFunction(Function* fn) {
+        ir.functions.Push(fn);
+        if (auto fn_variants = variants_of.Get(fn)) {
+            for (auto* variant : *fn_variants) {
+                EmitFunction(variant);
+            }
+        }
+    }
+
+    /// @param value the argument value
+    /// @returns true if a parameter can be replaced with @p value in the body of the callee
+    bool IsSpecializable(Value* value) {
+        if (value->Is<Constant>()) {
+            return true;
+        }
+        if (auto* res = value->As<InstructionResult>()) {
+            auto* var = res->Source()->As<Var>();
+            return var && var->Block() == ir.root_block;
+        }
+        return false;
+    }
+
+    /// Redirects @p call to a variant of the callee that is specialized for the call's constant
+    /// and module-scope variable pointer arguments.
+    /// @param call the call
+    /// @returns the variant if it was created by this call, otherwise nullptr
+    Function* Specialize(UserCall* call) {
+        auto* target = call->Target();
+
+        VariantKey key{target, {}};
+        bool any_specialized = false;
+        for (auto* arg : call->Args()) {
+            if (IsSpecializable(arg)) {
+                key.args.Push(arg);
+                any_specialized = true;
+            } else {
+                key.args.Push(nullptr);
+            }
+        }
+        if (!any_specialized) {
+            return nullptr;
+        }
+
+        Function* created = nullptr;
+        auto* variant = variants.GetOrCreate(key, [&]() -> Function* {
+            auto fn_variants = variants_of.GetOrZero(target);
+            if (fn_variants->Length() >= options.max_specializations) {
+                return nullptr;
+            }
+            created = CreateVariant(key);
+            fn_variants->Push(created);
+            return created;
+        });
+        if (!variant) {
+            return nullptr;
+        }
+
+        // Drop the arguments that have been substituted into the variant.
+        Vector<Value*, 4> args;
+        for (size_t i = 0; i < key.args.Length(); i++) {
+            if (!key.args[i]) {
+                args.Push(call->Args()[i]);
+            }
+        }
+        call->SetTarget(variant);
+        call->SetArgs(std::move(args));
+        maybe_unused.Add(target);
+        return created;
+    }
+
+    /// @param key the variant key
+    /// @returns a clone of the function of @p key, with the specialized parameters replaced with
+    /// the argument values
+    Function* CreateVariant(const VariantKey& key) {
+        auto* variant = CloneContext{ir}.Clone(key.fn);
+        if (auto name = ir.NameOf(key.fn); name.IsValid()) {
+            ir.SetName(variant, ir.symbols.New(name.Name()));
+        }
+
+        Vector<FunctionParam*, 4> params;
+        for (size_t i = 0; i < key.args.Length(); i++) {
+            auto* param = variant->Params()[i];
+            if (key.args[i]) {
+                param->ReplaceAllUsesWith(key.args[i]);
+                param->Destroy();
+            } else {
+                params.Push(param);
+            }
+        }
+        variant->SetParams(std::move(params));
+        return variant;
+    }
+
+    /// @param fn the function
+    /// @returns the number of calls to @p fn
+    size_t CountCalls(Function* fn) {
+        size_t count = 0;
+        for (auto& usage : fn->Usages()) {
+            if (usage.instruction->Is<UserCall>()) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /// @param fn the function
+    /// @returns true if calls to @p fn should be replaced with the body of @p fn
+    bool ShouldInline(Function* fn) {
+        // The body is spliced into the caller in place of the call, so the function must only
+        // return at the end of its top-level block.
+        if (!tint::Is<Return>(fn->Block()->Terminator())) {
+            return false;
+        }
+        uint32_t num_instructions = 0;
+        uint32_t num_returns = 0;
+        Traverse(fn->Block(), [&](Instruction* inst) {
+            num_instructions++;
+            if (inst->Is<Return>()) {
+                num_returns++;
+            }
+        });
+        if (num_returns != 1) {
+            return false;
+        }
+        return num_instructions <= options.max_inline_instructions ||
+               (options.inline_single_call_sites && CountCalls(fn) == 1);
+    }
+
+    /// Replaces @p call with the body of the callee.
+    /// @param call the call
+    void Inline(UserCall* call) {
+        auto* fn = call->Target();
+
+        CloneContext ctx{ir};
+        for (size_t i = 0; i < fn->Params().Length(); i++) {
+            ctx.Replace(static_cast<Value*>(fn->Params()[i]), call->Args()[i]);
+        }
+
+        bool in_loop = IsInLoop(call);
+        for (auto* inst = fn->Block()->Front(); inst != fn->Block()->Terminator();
+             inst = inst->next) {
+            auto* clone = ctx.Clone(inst);
+            clone->InsertBefore(call);
+            Rename(clone);
+
+            // A function-scope variable without an initializer is zero-initialized each time its
+            // declaration is executed. The backends only do that once per function invocation, so
+            // make the initializer explicit when the declaration is moved into a loop.
+            if (auto* var = clone->As<Var>(); var && in_loop && !var->Initializer()) {
+                auto* ptr = var->Result()->Type()->As<core::type::Pointer>();
+                var->SetInitializer(b.Constant(ir.constant_values.Zero(ptr->StoreType())));
+            }
+        }
+
+        if (auto* value = fn->Block()->Terminator()->As<Return>()->Value()) {
+            call->Result()->ReplaceAllUsesWith(ctx.Remap(value));
+        }
+        call->Destroy();
+        maybe_unused.Add(fn);
+    }
+
+    /// Gives the named results of @p inst and its nested instructions unique names, as the names
+    /// used by the callee may already be used by the caller.
+    /// @param inst the cloned instruction
+    void Rename(Instruction* inst) {
+        for (auto* result : inst->Results()) {
+            if (auto name = ir.NameOf(result); name.IsValid()) {
+                ir.SetName(result, ir.symbols.New(name.Name()));
+            }
+        }
+        if (auto* ctrl = inst->As<ControlInstruction>()) {
+            ctrl->ForeachBlock([&](Block* block) {
+                for (auto* child : *block) {
+                    Rename(child);
+                }
+            });
+        }
+    }
+
+    /// @param inst the instruction
+    /// @returns true if @p inst is nested inside a loop
+    bool IsInLoop(Instruction* inst) {
+        for (auto* block = inst->Block(); block;) {
+            auto* parent = block->Parent();
+            if (!parent) {
+                return false;
+            }
+            if (parent->Is<Loop>()) {
+                return true;
+            }
+            block = parent->Block();
+        }
+        return false;
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> InlineFunctions(Module& ir, const InlineFunctionsOptions& options) {
+    auto result = ValidateAndDumpIfNeeded(ir, "InlineFunctions transform");
+    if (!result) {
+        return result;
+    }
+
+    State{ir, options}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
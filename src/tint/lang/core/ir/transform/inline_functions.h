@@ -0,0 +1,71 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_INLINE_FUNCTIONS_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_INLINE_FUNCTIONS_H_
+
+#include <cstdint>
+
+#include "tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::core::ir {
+class Module;
+}
+
+namespace tint::core::ir::transform {
+
+/// InlineFunctionsOptions adjusts the behaviour of the transform.
+struct InlineFunctionsOptions {
+    /// Functions with no more than this many instructions are inlined into every caller.
+    uint32_t max_inline_instructions = 16;
+    /// If true, functions that are only called once are inlined regardless of their size.
+    bool inline_single_call_sites = true;
+    /// The maximum number of specialized variants created for each function. Zero disables
+    /// specialization.
+    uint32_t max_specializations = 4;
+};
+
+/// InlineFunctions is a transform that specializes and inlines calls to user functions.
+///
+/// Calls that pass constants or pointers to module-scope variables as arguments are redirected to
+/// a variant of the callee that has those parameters replaced with the argument values. Unlike
+/// DirectVariableAccess, which rewrites pointer parameters so that the program remains valid for
+/// the backends, this is an optimization that exposes the argument values to the other passes.
+///
+/// Calls to functions that are small, or that are only called once, are then replaced with the
+/// body of the callee. Functions that return from within nested control flow are not inlined.
+/// Functions that are no longer called after being specialized or inlined are removed.
+///
+/// @param module the module to transform
+/// @param options the transform options
+/// @returns success or failure
+Result<SuccessType> InlineFunctions(Module& module, const InlineFunctionsOptions& options = {});
+
+}  // namespace tint::core::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_INLINE_FUNCTIONS_H_
@@ -0,0 +1,949 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/transform/inline_functions.h"
+
+#include <utility>
+
+#include "tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+class IR_InlineFunctionsTest : public TransformTest {
+  protected:
+    /// @returns a module-scope private variable named @p name
+    Var* MakeVar(const char* name) {
+        auto* var = b.Var<private_, i32>(name);
+        mod.root_block->Append(var);
+        return var;
+    }
+
+    /// @returns a function named @p name that returns the sum of its two parameters
+    Function* MakeAdd(const char* name) {
+        auto* x = b.FunctionParam("x", ty.i32());
+        auto* y = b.FunctionParam("y", ty.i32());
+        auto* fn = b.Function(name, ty.i32());
+        fn->SetParams({x, y});
+        b.Append(fn->Block(), [&] {  //
+            b.Return(fn, b.Add(ty.i32(), x, y));
+        });
+        return fn;
+    }
+
+    /// Options that disable specialization.
+    InlineFunctionsOptions NoSpecialization() {
+        InlineFunctionsOptions options;
+        options.max_specializations = 0;
+        return options;
+    }
+};
+
+TEST_F(IR_InlineFunctionsTest, NoModify_NoCalls) {
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {  //
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%main = @fragment func():void -> %b1 {
+  %b1 = block {
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(InlineFunctions, InlineFunctionsOptions{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, Inline) {
+    auto* g = MakeVar("g");
+    auto* add = MakeAdd("add");
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        auto* a = b.Load(g);
+        auto* c = b.Load(g);
+        b.Store(g, b.Call(add, a, c));
+        b.Store(g, b.Call(add, c, a));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add = func(%x:i32, %y:i32):i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = add %x, %y
+    ret %5
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %7:i32 = load %g
+    %8:i32 = load %g
+    %9:i32 = call %add, %7, %8
+    store %g, %9
+    %10:i32 = call %add, %8, %7
+    store %g, %10
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = load %g
+    %4:i32 = load %g
+    %5:i32 = add %3, %4
+    store %g, %5
+    %6:i32 = add %4, %3
+    store %g, %6
+    ret
+  }
+}
+)";
+
+    Run(InlineFunctions, NoSpecialization());
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, NoModify_TooLarge) {
+    auto* g = MakeVar("g");
+    auto* add = MakeAdd("add");
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        auto* a = b.Load(g);
+        b.Store(g, b.Call(add, a, a));
+        b.Store(g, b.Call(add, a, a));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add = func(%x:i32, %y:i32):i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = add %x, %y
+    ret %5
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %7:i32 = load %g
+    %8:i32 = call %add, %7, %7
+    store %g, %8
+    %9:i32 = call %add, %7, %7
+    store %g, %9
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    auto options = NoSpecialization();
+    options.max_inline_instructions = 1;
+    Run(InlineFunctions, options);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, SingleCallSite) {
+    auto* g = MakeVar("g");
+    auto* add = MakeAdd("add");
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        auto* a = b.Load(g);
+        b.Store(g, b.Call(add, a, a));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add = func(%x:i32, %y:i32):i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = add %x, %y
+    ret %5
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %7:i32 = load %g
+    %8:i32 = call %add, %7, %7
+    store %g, %8
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = load %g
+    %4:i32 = add %3, %3
+    store %g, %4
+    ret
+  }
+}
+)";
+
+    auto options = NoSpecialization();
+    options.max_inline_instructions = 1;
+    Run(InlineFunctions, options);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, NoModify_SingleCallSiteDisabled) {
+    auto* g = MakeVar("g");
+    auto* add = MakeAdd("add");
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        auto* a = b.Load(g);
+        b.Store(g, b.Call(add, a, a));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add = func(%x:i32, %y:i32):i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = add %x, %y
+    ret %5
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %7:i32 = load %g
+    %8:i32 = call %add, %7, %7
+    store %g, %8
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    auto options = NoSpecialization();
+    options.max_inline_instructions = 1;
+    options.inline_single_call_sites = false;
+    Run(InlineFunctions, options);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, NoModify_ReturnInNestedBlock) {
+    auto* g = MakeVar("g");
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* select = b.Function("select", ty.i32());
+    select->SetParams({cond});
+    b.Append(select->Block(), [&] {
+        auto* ifelse = b.If(cond);
+        b.Append(ifelse->True(), [&] {  //
+            b.Return(select, 1_i);
+        });
+        b.Return(select, 2_i);
+    });
+
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        auto* a = b.Equal(ty.bool_(), b.Load(g), 0_i);
+        b.Store(g, b.Call(select, a));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%select = func(%cond:bool):i32 -> %b2 {
+  %b2 = block {
+    if %cond [t: %b3] {  # if_1
+      %b3 = block {  # true
+        ret 1i
+      }
+    }
+    ret 2i
+  }
+}
+%main = @fragment func():void -> %b4 {
+  %b4 = block {
+    %5:i32 = load %g
+    %6:bool = eq %5, 0i
+    %7:i32 = call %select, %6
+    store %g, %7
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(InlineFunctions, NoSpecialization());
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, ControlFlow) {
+    auto* g = MakeVar("g");
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* select = b.Function("select", ty.i32());
+    select->SetParams({cond});
+    b.Append(select->Block(), [&] {
+        auto* ifelse = b.If(cond);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, 1_i);
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, 2_i);
+        });
+        b.Return(select, ifelse->Result(0));
+    });
+
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        auto* a = b.Equal(ty.bool_(), b.Load(g), 0_i);
+        b.Store(g, b.Call(select, a));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%select = func(%cond:bool):i32 -> %b2 {
+  %b2 = block {
+    %4:i32 = if %cond [t: %b3, f: %b4] {  # if_1
+      %b3 = block {  # true
+        exit_if 1i  # if_1
+      }
+      %b4 = block {  # false
+        exit_if 2i  # if_1
+      }
+    }
+    ret %4
+  }
+}
+%main = @fragment func():void -> %b5 {
+  %b5 = block {
+    %6:i32 = load %g
+    %7:bool = eq %6, 0i
+    %8:i32 = call %select, %7
+    store %g, %8
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = load %g
+    %4:bool = eq %3, 0i
+    %5:i32 = if %4 [t: %b3, f: %b4] {  # if_1
+      %b3 = block {  # true
+        exit_if 1i  # if_1
+      }
+      %b4 = block {  # false
+        exit_if 2i  # if_1
+      }
+    }
+    store %g, %5
+    ret
+  }
+}
+)";
+
+    Run(InlineFunctions, NoSpecialization());
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, NestedCalls) {
+    auto* g = MakeVar("g");
+    auto* add = MakeAdd("add");
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* twice = b.Function("twice", ty.i32());
+    twice->SetParams({x});
+    b.Append(twice->Block(), [&] {  //
+        b.Return(twice, b.Call(add, x, x));
+    });
+
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        b.Store(g, b.Call(twice, b.Load(g)));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add = func(%x:i32, %y:i32):i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = add %x, %y
+    ret %5
+  }
+}
+%twice = func(%x_1:i32):i32 -> %b3 {  # %x_1: 'x'
+  %b3 = block {
+    %8:i32 = call %add, %x_1, %x_1
+    ret %8
+  }
+}
+%main = @fragment func():void -> %b4 {
+  %b4 = block {
+    %10:i32 = load %g
+    %11:i32 = call %twice, %10
+    store %g, %11
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = load %g
+    %4:i32 = add %3, %3
+    store %g, %4
+    ret
+  }
+}
+)";
+
+    Run(InlineFunctions, NoSpecialization());
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, RenameValues) {
+    auto* g = MakeVar("g");
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* square = b.Function("square", ty.i32());
+    square->SetParams({x});
+    b.Append(square->Block(), [&] {
+        auto* sq = b.Let("sq", b.Multiply(ty.i32(), x, x));
+        b.Return(square, sq);
+    });
+
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        auto* a = b.Load(g);
+        b.Store(g, b.Call(square, a));
+        b.Store(g, b.Call(square, a));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%square = func(%x:i32):i32 -> %b2 {
+  %b2 = block {
+    %4:i32 = mul %x, %x
+    %sq:i32 = let %4
+    ret %sq
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %7:i32 = load %g
+    %8:i32 = call %square, %7
+    store %g, %8
+    %9:i32 = call %square, %7
+    store %g, %9
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = load %g
+    %4:i32 = mul %3, %3
+    %sq_1:i32 = let %4
+    store %g, %sq_1
+    %6:i32 = mul %3, %3
+    %sq_2:i32 = let %6
+    store %g, %sq_2
+    ret
+  }
+}
+)";
+
+    Run(InlineFunctions, NoSpecialization());
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, VarInLoop) {
+    auto* g = MakeVar("g");
+    auto* accumulate = b.Function("accumulate", ty.void_());
+    b.Append(accumulate->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        b.Store(v, b.Add(ty.i32(), b.Load(v), 1_i));
+        b.Store(g, b.Load(v));
+        b.Return(accumulate);
+    });
+
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        b.Call(accumulate);
+        b.LoopRange(ty, 0_u, 4_u, 1_u, [&](Value*) { b.Call(accumulate); });
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%accumulate = func():void -> %b2 {
+  %b2 = block {
+    %v:ptr<function, i32, read_write> = var
+    %4:i32 = load %v
+    %5:i32 = add %4, 1i
+    store %v, %5
+    %6:i32 = load %v
+    store %g, %6
+    ret
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %8:void = call %accumulate
+    loop [i: %b4, b: %b5, c: %b6] {  # loop_1
+      %b4 = block {  # initializer
+        next_iteration %b5 0u
+      }
+      %b5 = block (%idx:u32) {  # body
+        %10:bool = gte %idx:u32, 4u
+        if %10 [t: %b7] {  # if_1
+          %b7 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        %11:void = call %accumulate
+        continue %b6
+      }
+      %b6 = block {  # continuing
+        %12:u32 = add %idx:u32, 1u
+        next_iteration %b5 %12
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %v_1:ptr<function, i32, read_write> = var
+    %4:i32 = load %v_1
+    %5:i32 = add %4, 1i
+    store %v_1, %5
+    %6:i32 = load %v_1
+    store %g, %6
+    loop [i: %b3, b: %b4, c: %b5] {  # loop_1
+      %b3 = block {  # initializer
+        next_iteration %b4 0u
+      }
+      %b4 = block (%idx:u32) {  # body
+        %8:bool = gte %idx:u32, 4u
+        if %8 [t: %b6] {  # if_1
+          %b6 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        %v_2:ptr<function, i32, read_write> = var, 0i
+        %10:i32 = load %v_2
+        %11:i32 = add %10, 1i
+        store %v_2, %11
+        %12:i32 = load %v_2
+        store %g, %12
+        continue %b5
+      }
+      %b5 = block {  # continuing
+        %13:u32 = add %idx:u32, 1u
+        next_iteration %b4 %13
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(InlineFunctions, NoSpecialization());
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, Specialize_Constant) {
+    auto* g = MakeVar("g");
+    auto* add = MakeAdd("add");
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        auto* a = b.Load(g);
+        b.Store(g, b.Call(add, a, 1_i));
+        b.Store(g, b.Call(add, 2_i, a));
+        b.Store(g, b.Call(add, a, 1_i));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add = func(%x:i32, %y:i32):i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = add %x, %y
+    ret %5
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %7:i32 = load %g
+    %8:i32 = call %add, %7, 1i
+    store %g, %8
+    %9:i32 = call %add, 2i, %7
+    store %g, %9
+    %10:i32 = call %add, %7, 1i
+    store %g, %10
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add_1 = func(%x:i32):i32 -> %b2 {
+  %b2 = block {
+    %4:i32 = add %x, 1i
+    ret %4
+  }
+}
+%add_2 = func(%y:i32):i32 -> %b3 {
+  %b3 = block {
+    %7:i32 = add 2i, %y
+    ret %7
+  }
+}
+%main = @fragment func():void -> %b4 {
+  %b4 = block {
+    %9:i32 = load %g
+    %10:i32 = call %add_1, %9
+    store %g, %10
+    %11:i32 = call %add_2, %9
+    store %g, %11
+    %12:i32 = call %add_1, %9
+    store %g, %12
+    ret
+  }
+}
+)";
+
+    InlineFunctionsOptions options;
+    options.max_inline_instructions = 0;
+    options.inline_single_call_sites = false;
+    Run(InlineFunctions, options);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, Specialize_ModuleScopePointer) {
+    auto* g = MakeVar("g");
+    auto* h = MakeVar("h");
+    auto* p = b.FunctionParam("p", ty.ptr<private_, i32>());
+    auto* inc = b.Function("inc", ty.void_());
+    inc->SetParams({p});
+    b.Append(inc->Block(), [&] {
+        b.Store(p, b.Add(ty.i32(), b.Load(p), 1_i));
+        b.Return(inc);
+    });
+
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        b.Call(inc, g);
+        b.Call(inc, h);
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+  %h:ptr<private, i32, read_write> = var
+}
+
+%inc = func(%p:ptr<private, i32, read_write>):void -> %b2 {
+  %b2 = block {
+    %5:i32 = load %p
+    %6:i32 = add %5, 1i
+    store %p, %6
+    ret
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %8:void = call %inc, %g
+    %9:void = call %inc, %h
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+  %h:ptr<private, i32, read_write> = var
+}
+
+%inc_1 = func():void -> %b2 {
+  %b2 = block {
+    %4:i32 = load %g
+    %5:i32 = add %4, 1i
+    store %g, %5
+    ret
+  }
+}
+%inc_2 = func():void -> %b3 {
+  %b3 = block {
+    %7:i32 = load %h
+    %8:i32 = add %7, 1i
+    store %h, %8
+    ret
+  }
+}
+%main = @fragment func():void -> %b4 {
+  %b4 = block {
+    %10:void = call %inc_1
+    %11:void = call %inc_2
+    ret
+  }
+}
+)";
+
+    InlineFunctionsOptions options;
+    options.max_inline_instructions = 0;
+    options.inline_single_call_sites = false;
+    Run(InlineFunctions, options);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, Specialize_Limit) {
+    auto* g = MakeVar("g");
+    auto* add = MakeAdd("add");
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        auto* a = b.Load(g);
+        b.Store(g, b.Call(add, a, 1_i));
+        b.Store(g, b.Call(add, a, 2_i));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add = func(%x:i32, %y:i32):i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = add %x, %y
+    ret %5
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %7:i32 = load %g
+    %8:i32 = call %add, %7, 1i
+    store %g, %8
+    %9:i32 = call %add, %7, 2i
+    store %g, %9
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add = func(%x:i32, %y:i32):i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = add %x, %y
+    ret %5
+  }
+}
+%add_1 = func(%x_1:i32):i32 -> %b3 {  # %x_1: 'x'
+  %b3 = block {
+    %8:i32 = add %x_1, 1i
+    ret %8
+  }
+}
+%main = @fragment func():void -> %b4 {
+  %b4 = block {
+    %10:i32 = load %g
+    %11:i32 = call %add_1, %10
+    store %g, %11
+    %12:i32 = call %add, %10, 2i
+    store %g, %12
+    ret
+  }
+}
+)";
+
+    InlineFunctionsOptions options;
+    options.max_inline_instructions = 0;
+    options.inline_single_call_sites = false;
+    options.max_specializations = 1;
+    Run(InlineFunctions, options);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, SpecializeAndInline) {
+    auto* g = MakeVar("g");
+    auto* add = MakeAdd("add");
+    auto* fn = b.Function("main", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(fn->Block(), [&] {
+        b.Store(g, b.Call(add, b.Load(g), 1_i));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%add = func(%x:i32, %y:i32):i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = add %x, %y
+    ret %5
+  }
+}
+%main = @fragment func():void -> %b3 {
+  %b3 = block {
+    %7:i32 = load %g
+    %8:i32 = call %add, %7, 1i
+    store %g, %8
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %g:ptr<private, i32, read_write> = var
+}
+
+%main = @fragment func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = load %g
+    %4:i32 = add %3, 1i
+    store %g, %4
+    ret
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsOptions{});
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
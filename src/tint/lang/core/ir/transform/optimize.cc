@@ -0,0 +1,70 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/transform/optimize.h"
+
+#include "tint/api/common/instrumentation.h"
+#include "tint/lang/core/ir/module.h"
+#include "tint/lang/core/ir/transform/constant_propagation.h"
+#include "tint/lang/core/ir/transform/dead_code_elimination.h"
+#include "tint/lang/core/ir/transform/inline_functions.h"
+#include "tint/lang/core/ir/transform/value_numbering.h"
+
+namespace tint::core::ir::transform {
+
+Result<SuccessType> Optimize(Module& module, OptimizationLevel level) {
+#define RUN_TRANSFORM(name, ...)                       \
+    do {                                               \
+        Instrumentation::PhaseScope name_phase(#name); \
+        auto result = name(__VA_ARGS__);               \
+        if (!result) {                                 \
+            return result;                             \
+        }                                              \
+    } while (false)
+
+    Instrumentation::PhaseScope phase("core.optimize");
+
+    if (level == OptimizationLevel::kNone) {
+        return Success;
+    }
+
+    if (level == OptimizationLevel::kFull) {
+        // Inlining and specialization substitute constant arguments into function bodies, which
+        // the passes below then fold.
+        RUN_TRANSFORM(InlineFunctions, module, InlineFunctionsOptions{});
+    }
+
+    // Folding constants exposes more identical instructions to value numbering, and both leave
+    // behind instructions that dead code elimination can remove.
+    RUN_TRANSFORM(ConstantPropagation, module);
+    RUN_TRANSFORM(ValueNumbering, module);
+    RUN_TRANSFORM(DeadCodeElimination, module);
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
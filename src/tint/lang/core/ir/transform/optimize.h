@@ -1,4 +1,4 @@
-// Copyright 2023 The Dawn & Tint Authors
+// Copyright 2024 The Dawn & Tint Authors
 //
 // Redistribution and use in source and binary forms, with or without
 // modification, are permitted provided that the following conditions are met:
@@ -25,9 +25,25 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-#if defined(__clang__)
-#pragma clang diagnostic ignored "-Wmissing-variable-declarations"
-#endif
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_OPTIMIZE_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_OPTIMIZE_H_
 
-// A placeholder symbol used to emit a symbol for this lib target.
-int tint_utils_memory_symbol = 1;
+#include "tint/api/options/optimization.h"
+#include "tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::core::ir {
+class Module;
+}
+
+namespace tint::core::ir::transform {
+
+/// Optimize runs the IR optimization passes selected by the optimization level.
+/// @param module the module to transform
+/// @param level the optimization level
+/// @returns success or failure
+Result<SuccessType> Optimize(Module& module, OptimizationLevel level);
+
+}  // namespace tint::core::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_OPTIMIZE_H_
@@ -0,0 +1,197 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/transform/value_numbering.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "tint/lang/core/intrinsic/table.h"
+#include "tint/lang/core/ir/builder.h"
+#include "tint/lang/core/ir/module.h"
+#include "tint/lang/core/ir/validator.h"
+#include "tint/lang/core/type/matrix.h"
+#include "tint/utils/containers/hashmap.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// Key identifies the value computed by an instruction that has no side effects.
+/// Two instructions with equal keys produce the same result.
+struct Key {
+    /// The instruction kind
+    const tint::TypeInfo* kind = nullptr;
+    /// The result type
+    const core::type::Type* type = nullptr;
+    /// The intrinsic table of a builtin call
+    const void* table = nullptr;
+    /// The operator, or builtin function identifier
+    size_t op = 0;
+    /// The operands
+    Vector<Value*, 4> operands;
+    /// The swizzle indices
+    Vector<uint32_t, 4> indices;
+
+    /// @returns the hash code of the key
+    size_t HashCode() const { return Hash(kind, type, table, op, operands, indices); }
+
+    /// Equality operator
+    /// @param other the key to compare against
+    /// @returns true if this key is equal to @p other
+    bool operator==(const Key& other) const {
+        return kind == other.kind && type == other.type && table == other.table &&
+               op == other.op && operands == other.operands && indices == other.indices;
+    }
+};
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The instructions that are in scope, keyed by the value that they compute.
+    Hashmap<Key, Instruction*, 64> values{};
+
+    /// Process the module.
+    void Process() {
+        for (auto* func : ir.functions) {
+            Visit(func->Block());
+        }
+    }
+
+    /// Replaces the redundant instructions of a block and all of its nested blocks.
+    /// An instruction dominates the rest of its block and all of the blocks nested within it, so
+    /// the instructions of a block are only in scope while visiting that block.
+    /// @param block the block
+    void Visit(Block* block) {
+        Vector<Key, 16> scope;
+        for (auto* inst = block->Front(); inst;) {
+            auto* next = inst->next;
+            if (auto key = KeyOf(inst)) {
+                if (auto existing = values.Get(*key)) {
+                    inst->Result()->ReplaceAllUsesWith((*existing)->Result());
+                    inst->Destroy();
+                } else {
+                    values.Add(*key, inst);
+                    scope.Push(std::move(*key));
+                }
+            } else if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* child) { Visit(child); });
+            }
+            inst = next;
+        }
+        for (auto& key : scope) {
+            values.Remove(key);
+        }
+    }
+
+    /// @param inst the instruction
+    /// @returns the key for the value computed by @p inst, or std::nullopt if the instruction
+    /// has side effects or cannot be replaced
+    std::optional<Key> KeyOf(Instruction* inst) {
+        auto* result = inst->Result();
+        if (!result) {
+            return std::nullopt;
+        }
+        Key key;
+        key.kind = &inst->TypeInfo();
+        key.type = result->Type();
+        bool ok = tint::Switch(
+            inst,  //
+            [&](Access*) { return true; },
+            [&](Bitcast*) { return true; },
+            [&](Construct*) { return true; },
+            [&](Convert*) { return true; },
+            [&](Binary* binary) {
+                key.op = static_cast<size_t>(binary->Op());
+                return true;
+            },
+            [&](Unary* unary) {
+                key.op = static_cast<size_t>(unary->Op());
+                return true;
+            },
+            [&](Swizzle* swizzle) {
+                key.indices = swizzle->Indices();
+                return true;
+            },
+            [&](BuiltinCall* call) {
+                key.table = &call->TableData();
+                key.op = call->FuncId();
+                return core::intrinsic::IsConstEvaluable(call->TableData(), call->FuncId());
+            },
+            [&](Default) { return false; });
+        if (!ok) {
+            return std::nullopt;
+        }
+
+        key.operands = inst->Operands();
+        if (auto* binary = inst->As<Binary>(); binary && IsCommutative(binary)) {
+            // Order the operands so that `a + b` and `b + a` have the same key.
+            if (std::less<Value*>{}(key.operands[1], key.operands[0])) {
+                std::swap(key.operands[0], key.operands[1]);
+            }
+        }
+        return key;
+    }
+
+    /// @param binary the binary instruction
+    /// @returns true if swapping the operands of @p binary does not change its result
+    bool IsCommutative(Binary* binary) {
+        switch (binary->Op()) {
+            case BinaryOp::kAdd:
+            case BinaryOp::kMultiply:
+            case BinaryOp::kAnd:
+            case BinaryOp::kOr:
+            case BinaryOp::kXor:
+            case BinaryOp::kEqual:
+            case BinaryOp::kNotEqual:
+                // Only operands of the same type are reordered. Matrix multiplication is not
+                // commutative.
+                return binary->LHS()->Type() == binary->RHS()->Type() &&
+                       !binary->LHS()->Type()->Is<core::type::Matrix>();
+            default:
+                return false;
+        }
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> ValueNumbering(Module& ir) {
+    auto result = ValidateAndDumpIfNeeded(ir, "ValueNumbering transform");
+    if (!result) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,383 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tint/lang/core/ir/transform/value_numbering.h"
+
+#include <utility>
+
+#include "tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_ValueNumberingTest = TransformTest;
+
+TEST_F(IR_ValueNumberingTest, SameBlock) {
+    auto* a = b.FunctionParam("a", ty.i32());
+    auto* c = b.FunctionParam("c", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({a, c});
+    b.Append(func->Block(), [&] {
+        auto* x = b.Multiply(ty.i32(), a, c);
+        auto* y = b.Multiply(ty.i32(), a, c);
+        b.Return(func, b.Add(ty.i32(), x, y));
+    });
+
+    auto* src = R"(
+%foo = func(%a:i32, %c:i32):i32 -> %b1 {
+  %b1 = block {
+    %4:i32 = mul %a, %c
+    %5:i32 = mul %a, %c
+    %6:i32 = add %4, %5
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%a:i32, %c:i32):i32 -> %b1 {
+  %b1 = block {
+    %4:i32 = mul %a, %c
+    %5:i32 = add %4, %4
+    ret %5
+  }
+}
+)";
+
+    Run(ValueNumbering);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ValueNumberingTest, Chain) {
+    auto* a = b.FunctionParam("a", ty.vec4<f32>());
+    auto* func = b.Function("foo", ty.f32());
+    func->SetParams({a});
+    b.Append(func->Block(), [&] {
+        auto* x = b.Swizzle(ty.vec2<f32>(), a, {0u, 1u});
+        auto* y = b.Swizzle(ty.vec2<f32>(), a, {0u, 1u});
+        auto* lx = b.Call(ty.f32(), core::BuiltinFn::kLength, x);
+        auto* ly = b.Call(ty.f32(), core::BuiltinFn::kLength, y);
+        b.Return(func, b.Subtract(ty.f32(), lx, ly));
+    });
+
+    auto* src = R"(
+%foo = func(%a:vec4<f32>):f32 -> %b1 {
+  %b1 = block {
+    %3:vec2<f32> = swizzle %a, xy
+    %4:vec2<f32> = swizzle %a, xy
+    %5:f32 = length %3
+    %6:f32 = length %4
+    %7:f32 = sub %5, %6
+    ret %7
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%a:vec4<f32>):f32 -> %b1 {
+  %b1 = block {
+    %3:vec2<f32> = swizzle %a, xy
+    %4:f32 = length %3
+    %5:f32 = sub %4, %4
+    ret %5
+  }
+}
+)";
+
+    Run(ValueNumbering);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ValueNumberingTest, Commutative) {
+    auto* a = b.FunctionParam("a", ty.i32());
+    auto* c = b.FunctionParam("c", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({a, c});
+    b.Append(func->Block(), [&] {
+        auto* x = b.Add(ty.i32(), a, c);
+        auto* y = b.Add(ty.i32(), c, a);
+        b.Return(func, b.Multiply(ty.i32(), x, y));
+    });
+
+    auto* src = R"(
+%foo = func(%a:i32, %c:i32):i32 -> %b1 {
+  %b1 = block {
+    %4:i32 = add %a, %c
+    %5:i32 = add %c, %a
+    %6:i32 = mul %4, %5
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%a:i32, %c:i32):i32 -> %b1 {
+  %b1 = block {
+    %4:i32 = add %a, %c
+    %5:i32 = mul %4, %4
+    ret %5
+  }
+}
+)";
+
+    Run(ValueNumbering);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ValueNumberingTest, NoModify_NonCommutative) {
+    auto* a = b.FunctionParam("a", ty.i32());
+    auto* c = b.FunctionParam("c", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({a, c});
+    b.Append(func->Block(), [&] {
+        auto* x = b.Subtract(ty.i32(), a, c);
+        auto* y = b.Subtract(ty.i32(), c, a);
+        b.Return(func, b.Multiply(ty.i32(), x, y));
+    });
+
+    auto* src = R"(
+%foo = func(%a:i32, %c:i32):i32 -> %b1 {
+  %b1 = block {
+    %4:i32 = sub %a, %c
+    %5:i32 = sub %c, %a
+    %6:i32 = mul %4, %5
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ValueNumbering);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ValueNumberingTest, NoModify_MatrixMultiply) {
+    auto* m = b.FunctionParam("m", ty.mat2x2<f32>());
+    auto* n = b.FunctionParam("n", ty.mat2x2<f32>());
+    auto* func = b.Function("foo", ty.mat2x2<f32>());
+    func->SetParams({m, n});
+    b.Append(func->Block(), [&] {
+        auto* x = b.Multiply(ty.mat2x2<f32>(), m, n);
+        auto* y = b.Multiply(ty.mat2x2<f32>(), n, m);
+        b.Return(func, b.Add(ty.mat2x2<f32>(), x, y));
+    });
+
+    auto* src = R"(
+%foo = func(%m:mat2x2<f32>, %n:mat2x2<f32>):mat2x2<f32> -> %b1 {
+  %b1 = block {
+    %4:mat2x2<f32> = mul %m, %n
+    %5:mat2x2<f32> = mul %n, %m
+    %6:mat2x2<f32> = add %4, %5
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ValueNumbering);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ValueNumberingTest, DominatingBlock) {
+    auto* a = b.FunctionParam("a", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({a});
+    b.Append(func->Block(), [&] {
+        auto* x = b.Negation(ty.i32(), a);
+        auto* ifelse = b.If(true);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, b.Negation(ty.i32(), a));
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, x);
+        });
+        b.Return(func, ifelse->Result(0));
+    });
+
+    auto* src = R"(
+%foo = func(%a:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = negation %a
+    %4:i32 = if true [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        %5:i32 = negation %a
+        exit_if %5  # if_1
+      }
+      %b3 = block {  # false
+        exit_if %3  # if_1
+      }
+    }
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%a:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = negation %a
+    %4:i32 = if true [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        exit_if %3  # if_1
+      }
+      %b3 = block {  # false
+        exit_if %3  # if_1
+      }
+    }
+    ret %4
+  }
+}
+)";
+
+    Run(ValueNumbering);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ValueNumberingTest, NoModify_SiblingBlocks) {
+    auto* a = b.FunctionParam("a", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({a});
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(true);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, b.Negation(ty.i32(), a));
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, b.Negation(ty.i32(), a));
+        });
+        b.Return(func, b.Negation(ty.i32(), a));
+    });
+
+    auto* src = R"(
+%foo = func(%a:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = if true [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        %4:i32 = negation %a
+        exit_if %4  # if_1
+      }
+      %b3 = block {  # false
+        %5:i32 = negation %a
+        exit_if %5  # if_1
+      }
+    }
+    %6:i32 = negation %a
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ValueNumbering);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ValueNumberingTest, NoModify_Load) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        auto* x = b.Load(v);
+        b.Store(v, 1_i);
+        auto* y = b.Load(v);
+        b.Return(func, b.Add(ty.i32(), x, y));
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var
+    %3:i32 = load %v
+    store %v, 1i
+    %4:i32 = load %v
+    %5:i32 = add %3, %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ValueNumbering);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ValueNumberingTest, NoModify_ImpureBuiltin) {
+    auto* a = b.FunctionParam("a", ty.f32());
+    auto* func = b.Function("foo", ty.f32(), Function::PipelineStage::kFragment);
+    func->SetParams({a});
+    func->SetReturnLocation(0, {});
+    b.Append(func->Block(), [&] {
+        auto* x = b.Call(ty.f32(), core::BuiltinFn::kDpdx, a);
+        auto* y = b.Call(ty.f32(), core::BuiltinFn::kDpdx, a);
+        b.Return(func, b.Add(ty.f32(), x, y));
+    });
+
+    auto* src = R"(
+%foo = @fragment func(%a:f32):f32 [@location(0)] -> %b1 {
+  %b1 = block {
+    %3:f32 = dpdx %a
+    %4:f32 = dpdx %a
+    %5:f32 = add %3, %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ValueNumbering);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
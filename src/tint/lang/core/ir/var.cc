@@ -52,6 +52,9 @@ Var::~Var() = default;
 Var* Var::Clone(CloneContext& ctx) {
     auto* new_result = ctx.Clone(Result());
     auto* new_var = ctx.ir.instructions.Create<Var>(new_result);
+    if (auto* init = Initializer()) {
+        new_var->SetInitializer(ctx.Remap(init));
+    }
 
     new_var->binding_point_ = binding_point_;
     new_var->attributes_ = attributes_;
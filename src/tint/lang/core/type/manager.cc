@@ -53,6 +53,12 @@ Manager& Manager::operator=(Manager&& rhs) = default;
 
 Manager::~Manager() = default;
 
+void Manager::Clear() {
+    types_.Clear();
+    unique_nodes_.Clear();
+    nodes_.Clear();
+}
+
 const core::type::Void* Manager::void_() {
     return Get<core::type::Void>();
 }
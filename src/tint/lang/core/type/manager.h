@@ -97,6 +97,10 @@ class Manager final {
         return out;
     }
 
+    /// Destructs all the types and nodes owned by the manager, but retains the memory used to
+    /// allocate them so that it can be reused for the types of the next module.
+    void Clear();
+
     /// Constructs or returns an existing type, unique node or node
     /// @param args the arguments used to construct the type, unique node or node.
     /// @tparam T a class deriving from core::type::Node, or a C-like type that's automatically
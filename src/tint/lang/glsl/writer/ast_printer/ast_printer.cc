@@ -35,6 +35,7 @@
 #include <utility>
 #include <vector>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/core/constant/splat.h"
 #include "tint/lang/core/constant/value.h"
 #include "tint/lang/core/fluent_types.h"
@@ -139,6 +140,8 @@ SanitizedResult::SanitizedResult(SanitizedResult&&) = default;
 SanitizedResult Sanitize(const Program& in,
                          const Options& options,
                          const std::string& entry_point) {
+    Instrumentation::PhaseScope phase("glsl.sanitize");
+
     ast::transform::Manager manager;
     ast::transform::DataMap data;
 
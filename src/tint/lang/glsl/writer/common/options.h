@@ -34,6 +34,7 @@
 
 #include "tint/api/options/binding_remapper.h"
 #include "tint/api/options/external_texture.h"
+#include "tint/api/options/optimization.h"
 #include "tint/api/options/texture_builtins_from_uniform.h"
 #include "tint/lang/core/access.h"
 #include "tint/lang/glsl/writer/common/version.h"
@@ -64,6 +65,10 @@ struct Options {
     /// Set to `true` to generate GLSL via the Tint IR instead of from the AST.
     bool use_tint_ir = false;
 
+    /// The optimization level to apply to the Tint IR before generating GLSL.
+    /// Only used when `use_tint_ir` is `true`.
+    OptimizationLevel optimization_level = OptimizationLevel::kNone;
+
     /// The GLSL version to emit
     Version version;
 
@@ -88,6 +93,8 @@ struct Options {
     /// Reflect the fields of this class so that it can be used by tint::ForeachField()
     TINT_REFLECT(disable_robustness,
                  disable_workgroup_init,
+                 use_tint_ir,
+                 optimization_level,
                  version,
                  binding_map,
                  placeholder_binding_point,
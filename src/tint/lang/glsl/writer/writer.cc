@@ -30,6 +30,8 @@
 #include <memory>
 #include <utility>
 
+#include "tint/api/common/instrumentation.h"
+#include "tint/lang/core/ir/transform/optimize.h"
 #include "tint/lang/glsl/writer/ast_printer/ast_printer.h"
 #include "tint/lang/glsl/writer/printer/printer.h"
 #include "tint/lang/glsl/writer/raise/raise.h"
@@ -48,6 +50,8 @@ Result<Output> Generate(const Program& program,
         return Failure{program.Diagnostics()};
     }
 
+    Instrumentation::PhaseScope phase("glsl.generate");
+
     Output output;
 
     if (options.use_tint_ir) {
@@ -65,12 +69,18 @@ Result<Output> Generate(const Program& program,
             return res.Failure();
         }
 
+        // Optimize the core-dialect IR.
+        if (auto res = core::ir::transform::Optimize(ir, options.optimization_level); !res) {
+            return res.Failure();
+        }
+
         // Raise from core-dialect to GLSL-dialect.
         if (auto res = raise::Raise(ir); !res) {
             return res.Failure();
         }
 
         // Generate the GLSL code.
+        Instrumentation::PhaseScope print_phase("glsl.print");
         auto result = Print(ir, options.version);
         if (!result) {
             return result.Failure();
@@ -87,6 +97,7 @@ Result<Output> Generate(const Program& program,
         }
 
         // Generate the GLSL code.
+        Instrumentation::PhaseScope print_phase("glsl.print");
         auto impl = std::make_unique<ASTPrinter>(sanitized_result.program, options.version);
         if (!impl->Generate()) {
             return Failure{impl->Diagnostics()};
@@ -35,6 +35,7 @@
 #include <utility>
 #include <vector>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/core/constant/splat.h"
 #include "tint/lang/core/constant/value.h"
 #include "tint/lang/core/fluent_types.h"
@@ -182,6 +183,8 @@ SanitizedResult::~SanitizedResult() = default;
 SanitizedResult::SanitizedResult(SanitizedResult&&) = default;
 
 SanitizedResult Sanitize(const Program& in, const Options& options) {
+    Instrumentation::PhaseScope phase("hlsl.sanitize");
+
     ast::transform::Manager manager;
     ast::transform::DataMap data;
 
@@ -30,6 +30,7 @@
 #include <memory>
 #include <utility>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/hlsl/writer/ast_printer/ast_printer.h"
 
 namespace tint::hlsl::writer {
@@ -39,6 +40,8 @@ Result<Output> Generate(const Program& program, const Options& options) {
         return Failure{program.Diagnostics()};
     }
 
+    Instrumentation::PhaseScope phase("hlsl.generate");
+
     // Sanitize the program.
     auto sanitized_result = Sanitize(program, options);
     if (!sanitized_result.program.IsValid()) {
@@ -46,6 +49,7 @@ Result<Output> Generate(const Program& program, const Options& options) {
     }
 
     // Generate the HLSL code.
+    Instrumentation::PhaseScope print_phase("hlsl.print");
     auto impl = std::make_unique<ASTPrinter>(sanitized_result.program);
     if (!impl->Generate()) {
         return Failure{impl->Diagnostics()};
@@ -0,0 +1,76 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string>
+
+#include "tint/cmd/bench/bench.h"
+#include "tint/lang/msl/writer/ast_printer/ast_printer.h"
+#include "tint/lang/wgsl/ast/module.h"
+#include "tint/lang/wgsl/sem/variable.h"
+
+namespace tint::msl::writer {
+namespace {
+
+// Runs the full chain of AST transforms used to sanitize a program for the MSL backend.
+void SanitizeMSL(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadProgram(input_name);
+    if (!res) {
+        state.SkipWithError(res.Failure().reason.str());
+        return;
+    }
+    auto& program = res->program;
+
+    // Use the same options as the GenerateMSL benchmark.
+    Options options = {};
+    options.array_length_from_uniform.ubo_binding = BindingPoint{0, 30};
+    for (uint32_t i = 0; i < 8; i++) {
+        options.array_length_from_uniform.bindpoint_to_size_index.emplace(BindingPoint{0, i}, i);
+    }
+    uint32_t next_binding_point = 0;
+    for (auto* var : program.AST().GlobalVariables()) {
+        if (auto* var_sem = program.Sem().Get(var)->As<sem::GlobalVariable>()) {
+            if (auto bp = var_sem->BindingPoint()) {
+                options.binding_remapper_options.binding_points[*bp] = BindingPoint{
+                    0,                     // group
+                    next_binding_point++,  // binding
+                };
+            }
+        }
+    }
+
+    for (auto _ : state) {
+        auto sanitized = Sanitize(program, options);
+        if (!sanitized.program.IsValid()) {
+            state.SkipWithError(sanitized.program.Diagnostics().str());
+        }
+    }
+}
+
+TINT_BENCHMARK_PROGRAMS(SanitizeMSL);
+
+}  // namespace
+}  // namespace tint::msl::writer
@@ -31,6 +31,7 @@
 #include "tint/api/options/array_length_from_uniform.h"
 #include "tint/api/options/binding_remapper.h"
 #include "tint/api/options/external_texture.h"
+#include "tint/api/options/optimization.h"
 #include "tint/api/options/pixel_local.h"
 #include "tint/utils/reflection/reflection.h"
 
@@ -61,6 +62,10 @@ struct Options {
     /// Set to `true` to generate MSL via the Tint IR instead of from the AST.
     bool use_tint_ir = false;
 
+    /// The optimization level to apply to the Tint IR before generating MSL.
+    /// Only used when `use_tint_ir` is `true`.
+    OptimizationLevel optimization_level = OptimizationLevel::kNone;
+
     /// The index to use when generating a UBO to receive storage buffer sizes.
     /// Defaults to 30, which is the last valid buffer slot.
     uint32_t buffer_size_ubo_index = 30;
@@ -87,6 +92,7 @@ struct Options {
                  disable_workgroup_init,
                  emit_vertex_point_size,
                  use_tint_ir,
+                 optimization_level,
                  buffer_size_ubo_index,
                  fixed_sample_mask,
                  pixel_local_options,
@@ -30,6 +30,8 @@
 #include <memory>
 #include <utility>
 
+#include "tint/api/common/instrumentation.h"
+#include "tint/lang/core/ir/transform/optimize.h"
 #include "tint/lang/msl/writer/ast_printer/ast_printer.h"
 #include "tint/lang/msl/writer/printer/printer.h"
 #include "tint/lang/msl/writer/raise/raise.h"
@@ -46,6 +48,8 @@ Result<Output> Generate(const Program& program, const Options& options) {
         return Failure{program.Diagnostics()};
     }
 
+    Instrumentation::PhaseScope phase("msl.generate");
+
     Output output;
 
     if (options.use_tint_ir) {
@@ -63,12 +67,18 @@ Result<Output> Generate(const Program& program, const Options& options) {
             return res.Failure();
         }
 
+        // Optimize the core-dialect IR.
+        if (auto res = core::ir::transform::Optimize(ir, options.optimization_level); !res) {
+            return res.Failure();
+        }
+
         // Raise from core-dialect to MSL-dialect.
         if (auto res = raise::Raise(ir); !res) {
             return res.Failure();
         }
 
         // Generate the MSL code.
+        Instrumentation::PhaseScope print_phase("msl.print");
         auto result = Print(ir);
         if (!result) {
             return result.Failure();
@@ -88,6 +98,7 @@ Result<Output> Generate(const Program& program, const Options& options) {
             std::move(sanitized_result.used_array_length_from_uniform_indices);
 
         // Generate the MSL code.
+        Instrumentation::PhaseScope print_phase("msl.print");
         auto impl = std::make_unique<ASTPrinter>(sanitized_result.program);
         if (!impl->Generate()) {
             return Failure{impl->Diagnostics()};
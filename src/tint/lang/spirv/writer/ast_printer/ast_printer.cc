@@ -31,6 +31,7 @@
 #include <utility>
 #include <vector>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/spirv/writer/ast_raise/clamp_frag_depth.h"
 #include "tint/lang/spirv/writer/ast_raise/for_loop_to_loop.h"
 #include "tint/lang/spirv/writer/ast_raise/merge_return.h"
@@ -63,6 +64,8 @@
 namespace tint::spirv::writer {
 
 SanitizedResult Sanitize(const Program& in, const Options& options) {
+    Instrumentation::PhaseScope phase("spirv.sanitize");
+
     ast::transform::Manager manager;
     ast::transform::DataMap data;
 
@@ -31,6 +31,7 @@
 #include <unordered_map>
 
 #include "tint/api/common/binding_point.h"
+#include "tint/api/options/optimization.h"
 #include "tint/utils/reflection/reflection.h"
 
 namespace tint::spirv::writer {
@@ -103,7 +104,7 @@ struct Bindings {
     ExternalTextureBindings external_texture{};
 
     /// Reflect the fields of this class so that it can be used by tint::ForeachField()
-    TINT_REFLECT(uniform, storage, texture, sampler, external_texture);
+    TINT_REFLECT(uniform, storage, texture, storage_texture, sampler, external_texture);
 };
 
 /// Configuration options used for generating SPIR-V.
@@ -137,6 +138,10 @@ struct Options {
     /// Set to `true` to generate SPIR-V via the Tint IR instead of from the AST.
     bool use_tint_ir = false;
 
+    /// The optimization level to apply to the Tint IR before generating SPIR-V.
+    /// Only used when `use_tint_ir` is `true`.
+    OptimizationLevel optimization_level = OptimizationLevel::kNone;
+
     /// Set to `true` to require `SPV_KHR_subgroup_uniform_control_flow` extension and
     /// `SubgroupUniformControlFlowKHR` execution mode for compute stage entry points in generated
     /// SPIRV module. Issue: dawn:464
@@ -153,7 +158,9 @@ struct Options {
                  use_zero_initialize_workgroup_memory_extension,
                  emit_vertex_point_size,
                  clamp_frag_depth,
+                 pass_matrix_by_pointer,
                  use_tint_ir,
+                 optimization_level,
                  experimental_require_subgroup_uniform_control_flow,
                  bindings);
 };
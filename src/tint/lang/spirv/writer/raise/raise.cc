@@ -29,6 +29,7 @@
 
 #include <utility>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/core/ir/transform/add_empty_entry_point.h"
 #include "tint/lang/core/ir/transform/bgra8unorm_polyfill.h"
 #include "tint/lang/core/ir/transform/binary_polyfill.h"
@@ -57,14 +58,17 @@
 namespace tint::spirv::writer::raise {
 
 Result<SuccessType> Raise(core::ir::Module& module, const Options& options) {
-#define RUN_TRANSFORM(name, ...)         \
-    do {                                 \
-        auto result = name(__VA_ARGS__); \
-        if (!result) {                   \
-            return result;               \
-        }                                \
+#define RUN_TRANSFORM(name, ...)                       \
+    do {                                               \
+        Instrumentation::PhaseScope name_phase(#name); \
+        auto result = name(__VA_ARGS__);               \
+        if (!result) {                                 \
+            return result;                             \
+        }                                              \
     } while (false)
 
+    Instrumentation::PhaseScope phase("spirv.raise");
+
     ExternalTextureOptions external_texture_options{};
     RemapperData remapper_data{};
     PopulateRemapperAndMultiplanarOptions(options, remapper_data, external_texture_options);
@@ -30,6 +30,8 @@
 #include <memory>
 #include <utility>
 
+#include "tint/api/common/instrumentation.h"
+#include "tint/lang/core/ir/transform/optimize.h"
 #include "tint/lang/spirv/writer/ast_printer/ast_printer.h"
 #include "tint/lang/spirv/writer/common/option_builder.h"
 #include "tint/lang/spirv/writer/printer/printer.h"
@@ -54,6 +56,8 @@ Result<Output> Generate(const Program& program, const Options& options) {
         return Failure{program.Diagnostics()};
     }
 
+    Instrumentation::PhaseScope phase("spirv.generate");
+
     bool zero_initialize_workgroup_memory =
         !options.disable_workgroup_init && options.use_zero_initialize_workgroup_memory_extension;
 
@@ -81,12 +85,18 @@ Result<Output> Generate(const Program& program, const Options& options) {
             return res.Failure();
         }
 
+        // Optimize the core-dialect IR.
+        if (auto res = core::ir::transform::Optimize(ir, options.optimization_level); !res) {
+            return res.Failure();
+        }
+
         // Raise from core-dialect to SPIR-V-dialect.
         if (auto res = raise::Raise(ir, options); !res) {
             return std::move(res.Failure());
         }
 
         // Generate the SPIR-V code.
+        Instrumentation::PhaseScope print_phase("spirv.print");
         auto spirv = Print(ir, zero_initialize_workgroup_memory);
         if (!spirv) {
             return std::move(spirv.Failure());
@@ -103,6 +113,7 @@ Result<Output> Generate(const Program& program, const Options& options) {
         }
 
         // Generate the SPIR-V code.
+        Instrumentation::PhaseScope print_phase("spirv.print");
         auto impl = std::make_unique<ASTPrinter>(
             sanitized_result.program, zero_initialize_workgroup_memory,
             options.experimental_require_subgroup_uniform_control_flow);
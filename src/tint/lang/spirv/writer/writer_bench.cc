@@ -26,6 +26,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <string>
+#include <utility>
 
 #include "tint/cmd/bench/bench.h"
 #include "tint/lang/spirv/writer/writer.h"
@@ -39,12 +40,16 @@ void RunBenchmark(benchmark::State& state, std::string input_name, Options optio
         state.SkipWithError(res.Failure().reason.str());
         return;
     }
+    size_t output_words = 0;
     for (auto _ : state) {
         auto gen_res = Generate(res->program, options);
         if (!gen_res) {
             state.SkipWithError(gen_res.Failure().reason.str());
+            return;
         }
+        output_words = gen_res->spirv.size();
     }
+    state.counters["SPIR-V words"] = static_cast<double>(output_words);
 }
 
 void GenerateSPIRV(benchmark::State& state, std::string input_name) {
@@ -57,8 +62,16 @@ void GenerateSPIRV_UseIR(benchmark::State& state, std::string input_name) {
     RunBenchmark(state, input_name, std::move(options));
 }
 
+void GenerateSPIRV_UseIR_Optimize(benchmark::State& state, std::string input_name) {
+    Options options;
+    options.use_tint_ir = true;
+    options.optimization_level = OptimizationLevel::kBasic;
+    RunBenchmark(state, input_name, std::move(options));
+}
+
 TINT_BENCHMARK_PROGRAMS(GenerateSPIRV);
 TINT_BENCHMARK_PROGRAMS(GenerateSPIRV_UseIR);
+TINT_BENCHMARK_PROGRAMS(GenerateSPIRV_UseIR_Optimize);
 
 }  // namespace
 }  // namespace tint::spirv::writer
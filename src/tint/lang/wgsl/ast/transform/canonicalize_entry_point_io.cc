@@ -692,22 +692,31 @@ struct CanonicalizeEntryPointIO::State {
         return b.Call(inner_function->name->symbol, inner_call_parameters);
     }
 
+    /// @returns true if a fixed sample mask needs to be added to the entry point outputs
+    bool NeedsFixedSampleMask() const {
+        return func_ast->PipelineStage() == PipelineStage::kFragment &&
+               cfg.fixed_sample_mask != 0xFFFFFFFF;
+    }
+
+    /// @returns true if the point size builtin needs to be added to the entry point outputs
+    bool NeedsVertexPointSize() const {
+        return func_ast->PipelineStage() == PipelineStage::kVertex && cfg.emit_vertex_point_size;
+    }
+
+    /// @returns true if the entry point has any shader IO for Process() to handle
+    bool HasShaderIO() const {
+        return func_sem->Parameters().Length() != 0 ||
+               !func_sem->ReturnType()->Is<core::type::Void>() || NeedsFixedSampleMask() ||
+               NeedsVertexPointSize() || cfg.shader_style == ShaderStyle::kGlsl;
+    }
+
     /// Process the entry point function.
     void Process() {
-        bool needs_fixed_sample_mask = false;
-        bool needs_vertex_point_size = false;
-        if (func_ast->PipelineStage() == PipelineStage::kFragment &&
-            cfg.fixed_sample_mask != 0xFFFFFFFF) {
-            needs_fixed_sample_mask = true;
-        }
-        if (func_ast->PipelineStage() == PipelineStage::kVertex && cfg.emit_vertex_point_size) {
-            needs_vertex_point_size = true;
-        }
+        bool needs_fixed_sample_mask = NeedsFixedSampleMask();
+        bool needs_vertex_point_size = NeedsVertexPointSize();
 
         // Exit early if there is no shader IO to handle.
-        if (func_sem->Parameters().Length() == 0 &&
-            func_sem->ReturnType()->Is<core::type::Void>() && !needs_fixed_sample_mask &&
-            !needs_vertex_point_size && cfg.shader_style != ShaderStyle::kGlsl) {
+        if (!HasShaderIO()) {
             return;
         }
 
@@ -910,6 +919,8 @@ Transform::ApplyResult CanonicalizeEntryPointIO::Apply(const Program& src,
         return resolver::Resolve(b);
     }
 
+    bool made_changes = false;
+
     // Remove entry point IO attributes from struct declarations.
     // New structures will be created for each entry point, as necessary.
     for (auto* ty : src.AST().TypeDecls()) {
@@ -918,6 +929,7 @@ Transform::ApplyResult CanonicalizeEntryPointIO::Apply(const Program& src,
                 for (auto* attr : member->attributes) {
                     if (IsShaderIOAttribute(attr)) {
                         ctx.Remove(member->attributes, attr);
+                        made_changes = true;
                     }
                 }
             }
@@ -930,7 +942,14 @@ Transform::ApplyResult CanonicalizeEntryPointIO::Apply(const Program& src,
         }
 
         State state(ctx, b, *cfg, func_ast);
-        state.Process();
+        if (state.HasShaderIO()) {
+            state.Process();
+            made_changes = true;
+        }
+    }
+
+    if (!made_changes) {
+        return SkipTransform;
     }
 
     ctx.Clone();
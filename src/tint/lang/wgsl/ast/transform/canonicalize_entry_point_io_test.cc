@@ -63,6 +63,8 @@ fn comp_main() {
 
     DataMap data;
     data.Add<CanonicalizeEntryPointIO::Config>(CanonicalizeEntryPointIO::ShaderStyle::kMsl);
+    EXPECT_FALSE(ShouldRun<CanonicalizeEntryPointIO>(src, data));
+
     auto got = Run<Unshadow, CanonicalizeEntryPointIO>(src, data);
 
     EXPECT_EQ(expect, str(got));
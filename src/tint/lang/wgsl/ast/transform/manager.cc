@@ -26,6 +26,8 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "tint/lang/wgsl/ast/transform/manager.h"
+
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/wgsl/ast/transform/transform.h"
 #include "tint/lang/wgsl/program/clone_context.h"
 #include "tint/lang/wgsl/program/program_builder.h"
@@ -42,12 +44,40 @@
 #define TINT_IF_PRINT_PROGRAM(x)
 #endif  // TINT_PRINT_PROGRAM_FOR_EACH_TRANSFORM
 
+/// If set to 1 then the transform::Manager will print the time taken by each transform once all
+/// the transforms have been run.
+#define TINT_PRINT_TRANSFORM_TIMINGS 0
+
+#if TINT_PRINT_TRANSFORM_TIMINGS
+#include <iomanip>
+#include <iostream>
+#endif  // TINT_PRINT_TRANSFORM_TIMINGS
+
+TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::Manager::Timings);
+
 namespace tint::ast::transform {
 
+Manager::Timings::Timings() = default;
+Manager::Timings::Timings(const Timings&) = default;
+Manager::Timings::~Timings() = default;
+
 Manager::Manager() = default;
 Manager::~Manager() = default;
 
-Program Manager::Run(const Program& program_in, const DataMap& inputs, DataMap& outputs) const {
+Program Manager::Run(const Program& program, const DataMap& inputs, DataMap& outputs) const {
+    if (auto output = Apply(program, inputs, outputs)) {
+        return std::move(output.value());
+    }
+
+    ProgramBuilder b;
+    program::CloneContext ctx{&b, &program, /* auto_clone_symbols */ true};
+    ctx.Clone();
+    return resolver::Resolve(b);
+}
+
+Transform::ApplyResult Manager::Apply(const Program& program_in,
+                                      const DataMap& inputs,
+                                      DataMap& outputs) const {
     const Program* program = &program_in;
 
 #if TINT_PRINT_PROGRAM_FOR_EACH_TRANSFORM
@@ -70,10 +100,32 @@ Program Manager::Run(const Program& program_in, const DataMap& inputs, DataMap&
 
     std::optional<Program> output;
 
+#if TINT_PRINT_TRANSFORM_TIMINGS
+    if (!outputs.Get<Timings>()) {
+        outputs.Add<Timings>();
+    }
+#endif
+    auto* timings = outputs.Get<Timings>();
+
     TINT_IF_PRINT_PROGRAM(print_program("Input of", nullptr));
 
     for (const auto& transform : transforms_) {
-        if (auto result = transform->Apply(*program, inputs, outputs)) {
+        using Clock = std::chrono::steady_clock;
+        auto start = timings ? Clock::now() : Clock::time_point{};
+        Transform::ApplyResult result;
+        {
+            Instrumentation::PhaseScope phase(transform->TypeInfo().name);
+            result = transform->Apply(*program, inputs, outputs);
+            if (result) {
+                phase.SetNodeCount(result->ASTNodes().Count());
+            }
+        }
+        if (timings) {
+            timings->entries.push_back(Timings::Entry{transform->TypeInfo().name,
+                                                      Clock::now() - start, result.has_value()});
+        }
+
+        if (result) {
             output.emplace(std::move(result.value()));
             program = &output.value();
 
@@ -91,13 +143,16 @@ Program Manager::Run(const Program& program_in, const DataMap& inputs, DataMap&
 
     TINT_IF_PRINT_PROGRAM(print_program("Final output of", nullptr));
 
-    if (!output) {
-        ProgramBuilder b;
-        program::CloneContext ctx{&b, program, /* auto_clone_symbols */ true};
-        ctx.Clone();
-        output = resolver::Resolve(b);
+#if TINT_PRINT_TRANSFORM_TIMINGS
+    for (auto& entry : timings->entries) {
+        std::cout << std::setw(12)
+                  << std::chrono::duration_cast<std::chrono::microseconds>(entry.duration).count()
+                  << "us " << (entry.applied ? "applied " : "skipped ") << entry.name
+                  << std::endl;
     }
-    return std::move(output.value());
+#endif
+
+    return output;
 }
 
 }  // namespace tint::ast::transform
@@ -28,6 +28,7 @@
 #ifndef SRC_TINT_LANG_WGSL_AST_TRANSFORM_MANAGER_H_
 #define SRC_TINT_LANG_WGSL_AST_TRANSFORM_MANAGER_H_
 
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -44,6 +45,31 @@ namespace tint::ast::transform {
 /// the error can be retrieved with the Output's diagnostics.
 class Manager {
   public:
+    /// Per-transform timing information, collected by Run() if the caller adds a Timings to the
+    /// outputs DataMap before calling Run(). Transforms that are implemented with a nested Manager
+    /// also record their inner transforms, ahead of their own entry.
+    struct Timings final : public Castable<Timings, Data> {
+        /// Constructor
+        Timings();
+        /// Copy constructor
+        Timings(const Timings&);
+        /// Destructor
+        ~Timings() override;
+
+        /// Timing information for a single transform
+        struct Entry {
+            /// The name of the transform
+            const char* name = nullptr;
+            /// The time taken by the transform, including the resolve of its output program
+            std::chrono::nanoseconds duration{};
+            /// True if the transform produced a new program, false if it was skipped
+            bool applied = false;
+        };
+
+        /// The transforms run, in the order they were run
+        std::vector<Entry> entries;
+    };
+
     /// Constructor
     Manager();
     ~Manager();
@@ -63,12 +89,25 @@ class Manager {
     }
 
     /// Runs the transforms on @p program, returning the transformed clone of @p program.
+    /// Transforms that have nothing to do return Transform::SkipTransform from Apply(), and so do
+    /// not clone or resolve the program. If @p outputs holds a Timings, then the time taken by each
+    /// transform is appended to it.
     /// @param program the source program to transform
     /// @param inputs optional extra transform-specific input data
     /// @param outputs optional extra transform-specific output data
     /// @returns the transformed program
     Program Run(const Program& program, const DataMap& inputs, DataMap& outputs) const;
 
+    /// Runs the transforms on @p program, like Run(), but without cloning @p program if none of
+    /// the transforms needed to run. Used by transforms that are implemented with a Manager.
+    /// @param program the source program to transform
+    /// @param inputs optional extra transform-specific input data
+    /// @param outputs optional extra transform-specific output data
+    /// @returns the transformed program, or Transform::SkipTransform if every transform was skipped
+    Transform::ApplyResult Apply(const Program& program,
+                                 const DataMap& inputs,
+                                 DataMap& outputs) const;
+
   private:
     std::vector<std::unique_ptr<Transform>> transforms_;
 };
@@ -77,5 +77,70 @@ TEST_F(TransformManagerTest, AST_AlwaysClone) {
     EXPECT_EQ(result.AST().Functions()[0]->name->symbol.Name(), "main");
 }
 
+// Test that Apply() does not clone the program if all transforms are skipped.
+TEST_F(TransformManagerTest, AST_ApplySkipped) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_NoOp>();
+    manager.Add<AST_NoOp>();
+
+    auto result = manager.Apply(ast, {}, outputs);
+    EXPECT_FALSE(result.has_value());
+}
+
+// Test that Apply() returns the output of the transforms that ran.
+TEST_F(TransformManagerTest, AST_Apply) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_NoOp>();
+    manager.Add<AST_AddFunction>();
+    manager.Add<AST_NoOp>();
+
+    auto result = manager.Apply(ast, {}, outputs);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->IsValid()) << result->Diagnostics();
+    ASSERT_EQ(result->AST().Functions().Length(), 2u);
+    EXPECT_EQ(result->AST().Functions()[0]->name->symbol.Name(), "ast_func");
+    EXPECT_EQ(result->AST().Functions()[1]->name->symbol.Name(), "main");
+}
+
+// Test that a Timings in the outputs is populated with an entry per transform.
+TEST_F(TransformManagerTest, AST_Timings) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    outputs.Add<Manager::Timings>();
+    manager.Add<AST_NoOp>();
+    manager.Add<AST_AddFunction>();
+
+    auto result = manager.Run(ast, {}, outputs);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+
+    auto* timings = outputs.Get<Manager::Timings>();
+    ASSERT_NE(timings, nullptr);
+    ASSERT_EQ(timings->entries.size(), 2u);
+    EXPECT_NE(timings->entries[0].name, nullptr);
+    EXPECT_FALSE(timings->entries[0].applied);
+    EXPECT_TRUE(timings->entries[1].applied);
+}
+
+// Test that no Timings are added to the outputs unless requested.
+TEST_F(TransformManagerTest, AST_NoTimingsByDefault) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_AddFunction>();
+
+    auto result = manager.Run(ast, {}, outputs);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+    EXPECT_EQ(outputs.Get<Manager::Timings>(), nullptr);
+}
+
 }  // namespace
 }  // namespace tint::ast::transform
@@ -54,6 +54,32 @@ TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::PromoteSideEffectsToDecl);
 namespace tint::ast::transform {
 namespace {
 
+// Returns true if the program contains any expressions with side-effects. If it doesn't, then
+// neither SimplifySideEffectStatements nor DecomposeSideEffects have anything to do.
+bool ShouldRun(const Program& program) {
+    for (auto* node : program.ASTNodes().Objects()) {
+        if (auto* sem_expr = program.Sem().GetVal(node)) {
+            if (sem_expr->HasSideEffects()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Returns true if the program contains any logical binary expressions with side-effecting operands.
+bool HasLogicalWithSideEffects(const Program& program) {
+    for (auto* node : program.ASTNodes().Objects()) {
+        auto* binary_expr = node->As<BinaryExpression>();
+        if (binary_expr && binary_expr->IsLogical() &&
+            (program.Sem().GetVal(binary_expr->lhs)->HasSideEffects() ||
+             program.Sem().GetVal(binary_expr->rhs)->HasSideEffects())) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Base state class for common members
 class StateBase {
   protected:
@@ -80,10 +106,24 @@ Transform::ApplyResult SimplifySideEffectStatements::Apply(const Program& src,
 
     bool made_changes = false;
 
+    // Declarations can already be hoisted above statements that sit directly in a block. Only
+    // 'else if' conditions, loop conditions and for-loop initializers and continuing statements
+    // need simplifying first.
+    auto needs_simplifying = [](const sem::Statement* stmt) {
+        if (!stmt) {
+            return false;
+        }
+        if (auto* if_stmt = stmt->As<sem::IfStatement>()) {
+            return if_stmt->Parent()->Is<sem::IfStatement>();
+        }
+        return stmt->IsAnyOf<sem::ForLoopStatement, sem::WhileStatement>() ||
+               !stmt->Parent()->Is<sem::BlockStatement>();
+    };
+
     HoistToDeclBefore hoist_to_decl_before(ctx);
     for (auto* node : ctx.src->ASTNodes().Objects()) {
         if (auto* sem_expr = src.Sem().GetVal(node)) {
-            if (!sem_expr->HasSideEffects()) {
+            if (!sem_expr->HasSideEffects() || !needs_simplifying(sem_expr->Stmt())) {
                 continue;
             }
 
@@ -662,6 +702,12 @@ Transform::ApplyResult DecomposeSideEffects::Apply(const Program& src,
     CollectHoistsState collect_hoists_state{ctx};
     auto to_hoist = collect_hoists_state.Run();
 
+    // Without anything to hoist, only short-circuiting expressions with side-effects need to be
+    // decomposed. If there are none of those either, then the program would be cloned unchanged.
+    if (to_hoist.empty() && !HasLogicalWithSideEffects(src)) {
+        return SkipTransform;
+    }
+
     // Now decompose these expressions
     DecomposeState decompose_state{ctx, std::move(to_hoist)};
     decompose_state.Run();
@@ -678,10 +724,14 @@ PromoteSideEffectsToDecl::~PromoteSideEffectsToDecl() = default;
 Transform::ApplyResult PromoteSideEffectsToDecl::Apply(const Program& src,
                                                        const DataMap& inputs,
                                                        DataMap& outputs) const {
+    if (!ShouldRun(src)) {
+        return SkipTransform;
+    }
+
     Manager manager;
     manager.Add<SimplifySideEffectStatements>();
     manager.Add<DecomposeSideEffects>();
-    return manager.Run(src, inputs, outputs);
+    return manager.Apply(src, inputs, outputs);
 }
 
 }  // namespace tint::ast::transform
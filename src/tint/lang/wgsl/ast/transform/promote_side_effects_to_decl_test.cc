@@ -38,6 +38,8 @@ TEST_F(PromoteSideEffectsToDeclTest, EmptyModule) {
     auto* src = "";
     auto* expect = "";
 
+    EXPECT_FALSE(ShouldRun<PromoteSideEffectsToDecl>(src));
+
     auto got = Run<PromoteSideEffectsToDecl>(src);
 
     EXPECT_EQ(expect, str(got));
@@ -56,6 +58,8 @@ fn f() {
 
     auto* expect = src;
 
+    EXPECT_FALSE(ShouldRun<PromoteSideEffectsToDecl>(src));
+
     auto got = Run<PromoteSideEffectsToDecl>(src);
 
     EXPECT_EQ(expect, str(got));
@@ -65,6 +65,10 @@ struct Robustness::State {
     /// Runs the transform
     /// @returns the new program or SkipTransform if the transform is not required
     ApplyResult Run() {
+        // Every change made by this transform builds new AST nodes, so if none have been built by
+        // the end of the walk then the program is already robust and doesn't need to be cloned.
+        const size_t num_ast_nodes = b.ASTNodes().Count();
+
         if (HasAction(Action::kPredicate)) {
             AddPredicateParameters();
         }
@@ -211,6 +215,10 @@ struct Robustness::State {
             }
         }
 
+        if (b.ASTNodes().Count() == num_ast_nodes && !b.Diagnostics().contains_errors()) {
+            return SkipTransform;
+        }
+
         ctx.Clone();
         return resolver::Resolve(b);
     }
@@ -91,6 +91,8 @@ fn f() {
 
     auto* expect = src;
 
+    EXPECT_FALSE(ShouldRun<Robustness>(src, Config(GetParam())));
+
     auto got = Run<Robustness>(src, Config(GetParam()));
 
     EXPECT_EQ(expect, str(got));
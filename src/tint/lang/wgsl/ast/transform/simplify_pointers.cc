@@ -146,14 +146,15 @@ struct SimplifyPointers::State {
         // A map of saved expressions to their saved variable name
         Hashmap<const Expression*, Symbol, 8> saved_vars;
 
+        // The transform only changes the program if it has pointer-typed `let` declarations to
+        // inline, or address-of / indirection chains to fold. Other uses of pointers are cloned
+        // unchanged.
         bool needs_transform = false;
-        for (auto* ty : ctx.src->Types()) {
-            if (ty->Is<core::type::Pointer>()) {
-                // Program contains pointers which need removing.
-                needs_transform = true;
-                break;
-            }
-        }
+        auto is_pointer_op = [](const Expression* expr) {
+            auto* unary = expr->As<UnaryOpExpression>();
+            return unary && (unary->op == core::UnaryOp::kAddressOf ||
+                             unary->op == core::UnaryOp::kIndirection);
+        };
 
         // Find all the pointer-typed `let` declarations.
         // Note that these must be function-scoped, as module-scoped `let`s are not
@@ -172,6 +173,7 @@ struct SimplifyPointers::State {
                     }
 
                     // We're dealing with a pointer-typed `let` declaration.
+                    needs_transform = true;
 
                     // Scan the initializer expression for array index expressions that need
                     // to be hoist to temporary "saved" variables.
@@ -221,9 +223,8 @@ struct SimplifyPointers::State {
                     RemoveStatement(ctx, let);
                 },
                 [&](const UnaryOpExpression* op) {
-                    if (op->op == core::UnaryOp::kAddressOf) {
-                        // Transform can be skipped if no address-of operator is used, as there
-                        // will be no pointers that can be inlined.
+                    if (is_pointer_op(op) && is_pointer_op(op->expr)) {
+                        // `&*p` or `*&v`, which can be folded.
                         needs_transform = true;
                     }
                 });
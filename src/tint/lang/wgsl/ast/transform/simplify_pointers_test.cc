@@ -70,6 +70,29 @@ fn f(p : ptr<function, i32>) {
 
     auto* expect = src;
 
+    EXPECT_FALSE(ShouldRun<SimplifyPointers>(src));
+
+    auto got = Run<Unshadow, SimplifyPointers>(src);
+
+    EXPECT_EQ(expect, str(got));
+}
+
+TEST_F(SimplifyPointersTest, NothingToFold) {
+    auto* src = R"(
+fn g(p : ptr<function, i32>) -> i32 {
+  return *(p);
+}
+
+fn f() {
+  var v : i32;
+  let x = g(&(v));
+}
+)";
+
+    auto* expect = src;
+
+    EXPECT_FALSE(ShouldRun<SimplifyPointers>(src));
+
     auto got = Run<Unshadow, SimplifyPointers>(src);
 
     EXPECT_EQ(expect, str(got));
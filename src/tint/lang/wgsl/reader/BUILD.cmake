@@ -127,6 +127,7 @@ tint_target_add_external_dependencies(tint_lang_wgsl_reader_bench bench
 if(TINT_BUILD_WGSL_READER)
   tint_target_add_dependencies(tint_lang_wgsl_reader_bench bench
     tint_lang_wgsl_reader
+    tint_lang_wgsl_reader_parser
   )
 endif(TINT_BUILD_WGSL_READER)
 
@@ -29,6 +29,7 @@
 
 #include <utility>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/core/builtin_fn.h"
 #include "tint/lang/core/ir/builder.h"
 #include "tint/lang/core/ir/core_builtin_call.h"
@@ -169,6 +170,8 @@ core::BuiltinFn Convert(wgsl::BuiltinFn fn) {
 }  // namespace
 
 Result<SuccessType> Lower(core::ir::Module& mod) {
+    Instrumentation::PhaseScope phase("wgsl.lower");
+
     if (auto res = core::ir::ValidateAndDumpIfNeeded(mod, "lowering from WGSL"); !res) {
         return res.Failure();
     }
@@ -50,6 +50,8 @@ tint_add_target(tint_lang_wgsl_reader_parser lib
   lang/wgsl/reader/parser/parser.h
   lang/wgsl/reader/parser/token.cc
   lang/wgsl/reader/parser/token.h
+  lang/wgsl/reader/parser/token_stream.cc
+  lang/wgsl/reader/parser/token_stream.h
 )
 
 tint_target_add_dependencies(tint_lang_wgsl_reader_parser lib
@@ -142,6 +144,7 @@ tint_add_target(tint_lang_wgsl_reader_parser_test test
   lang/wgsl/reader/parser/struct_member_test.cc
   lang/wgsl/reader/parser/switch_body_test.cc
   lang/wgsl/reader/parser/switch_stmt_test.cc
+  lang/wgsl/reader/parser/token_stream_test.cc
   lang/wgsl/reader/parser/token_test.cc
   lang/wgsl/reader/parser/type_alias_test.cc
   lang/wgsl/reader/parser/type_decl_test.cc
@@ -28,12 +28,61 @@
 #ifndef SRC_TINT_LANG_WGSL_READER_PARSER_CLASSIFY_TEMPLATE_ARGS_H_
 #define SRC_TINT_LANG_WGSL_READER_PARSER_CLASSIFY_TEMPLATE_ARGS_H_
 
+#include <cstdint>
 #include <vector>
 
 #include "tint/lang/wgsl/reader/parser/token.h"
+#include "tint/utils/containers/vector.h"
 
 namespace tint::wgsl::reader {
 
+/// TemplateArgumentClassifier converts the '<' and '>' tokens that delimit template argument lists
+/// into kTemplateArgsLeft and kTemplateArgsRight tokens, one token at a time.
+/// Tokens must be passed to Classify() in order, and must not move in memory while they are
+/// pending.
+class TemplateArgumentClassifier {
+  public:
+    /// Constructor
+    TemplateArgumentClassifier();
+    /// Destructor
+    ~TemplateArgumentClassifier();
+
+    /// Classifies the token at index @p idx.
+    /// @param idx the index of @p token in the token stream
+    /// @param token the token to classify
+    /// @param next the token at `idx + 1`. This is the placeholder that follows @p token, if
+    /// @p token has any.
+    /// @returns the number of tokens consumed: 2 if @p next was consumed with @p token,
+    /// otherwise 1.
+    size_t Classify(size_t idx, Token& token, Token& next);
+
+    /// @returns true if there is a '<' token that may still be classified as kTemplateArgsLeft
+    bool HasPending() const { return !stack_.IsEmpty(); }
+
+    /// @returns the index of the first '<' token that may still be classified as
+    /// kTemplateArgsLeft. Must only be called if HasPending() returns true.
+    size_t FirstPending() const { return stack_.Front().idx; }
+
+  private:
+    /// An opening '<' token
+    struct StackEntry {
+        Token* token;         // A pointer to the opening '<' token
+        size_t idx;           // The index of the opening '<' token
+        uint64_t expr_depth;  // The value of 'expr_depth' for the opening '<'
+    };
+
+    /// The current expression nesting depth.
+    /// Each '(', '[' increments the depth.
+    /// Each ')', ']' decrements the depth.
+    uint64_t expr_depth_ = 0;
+
+    /// A stack of '<' tokens.
+    /// Used to pair '<' and '>' tokens at the same expression depth.
+    Vector<StackEntry, 16> stack_;
+};
+
+/// Classifies the template argument list tokens of a complete token list.
+/// @param tokens the token list, as returned by Lexer::Lex()
 void ClassifyTemplateArguments(std::vector<Token>& tokens);
 
 }  // namespace tint::wgsl::reader
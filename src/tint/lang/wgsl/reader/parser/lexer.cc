@@ -55,7 +55,7 @@ static_assert(sizeof(decltype(tint::Source::FileContent::data[0])) == sizeof(uin
               "tint::wgsl::reader requires the size of a std::string element "
               "to be a single byte");
 
-// A token is ~80bytes. The 4k here comes from looking at the number of tokens in the benchmark
+// A token is 40 bytes. The 4k here comes from looking at the number of tokens in the benchmark
 // programs and being a bit bigger then those need (atan2-const-eval is the outlier here).
 static constexpr size_t kDefaultListSize = 4092;
 
@@ -84,6 +84,39 @@ bool read_blankspace(std::string_view str, size_t i, bool* is_blankspace, size_t
     return true;
 }
 
+// The byte classes below are used to skip over runs of characters without decoding them as UTF-8.
+// Bytes >= 0x80 are not part of the ASCII classes, so that non-ASCII characters are left to the
+// Unicode aware code paths.
+
+/// ' ' and '\t'
+struct AsciiBlankspace {
+    static bool Match(uint8_t c) { return c == ' ' || c == '\t'; }
+};
+
+/// The ASCII XID_Continue characters: [0-9A-Za-z_]
+struct AsciiIdentContinue {
+    static bool Match(uint8_t c) {
+        uint8_t lower = c | 0x20;
+        return (lower >= 'a' && lower <= 'z') || (c >= '0' && c <= '9') || c == '_';
+    }
+};
+
+/// The bytes of a block comment that cannot start or end a nested comment, and are not the null
+/// character. Comments are not decoded, so this includes the bytes of non-ASCII characters.
+struct BlockCommentBody {
+    static bool Match(uint8_t c) { return c != '/' && c != '*' && c != 0; }
+};
+
+/// @returns the number of leading bytes of @p str that belong to the byte class `CLASS`
+template <typename CLASS>
+size_t CountLeading(std::string_view str) {
+    size_t i = 0;
+    while (i < str.size() && CLASS::Match(static_cast<uint8_t>(str[i]))) {
+        i++;
+    }
+    return i;
+}
+
 uint32_t dec_value(char c) {
     if (c >= '0' && c <= '9') {
         return static_cast<uint32_t>(c - '0');
@@ -264,6 +297,12 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
                 continue;
             }
 
+            // Fast path for ASCII blankspace.
+            if (size_t n = CountLeading<AsciiBlankspace>(line().substr(pos())); n > 0) {
+                advance(n);
+                continue;
+            }
+
             bool is_blankspace;
             size_t blankspace_size;
             if (!read_blankspace(line(), pos(), &is_blankspace, &blankspace_size)) {
@@ -297,12 +336,12 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
 std::optional<Token> Lexer::skip_comment() {
     if (matches(pos(), "//")) {
         // Line comment: ignore everything until the end of line.
-        while (!is_eol()) {
-            if (is_null()) {
-                return Token{Token::Type::kError, begin_source(), "null character found"};
-            }
-            advance();
+        auto rest = line().substr(pos());
+        if (auto* null = std::memchr(rest.data(), 0, rest.size())) {
+            advance(static_cast<size_t>(static_cast<const char*>(null) - rest.data()));
+            return Token{Token::Type::kError, begin_source(), "null character found"};
         }
+        set_pos(length());
         return {};
     }
 
@@ -317,6 +356,12 @@ std::optional<Token> Lexer::skip_comment() {
 
         int depth = 1;
         while (!is_eof() && depth > 0) {
+            // Skip the characters that can't change the nesting depth or be a null character.
+            if (size_t n = CountLeading<BlockCommentBody>(line().substr(pos())); n > 0) {
+                advance(n);
+                continue;
+            }
+
             if (matches(pos(), "/*")) {
                 // Start of block comment: increase nesting depth.
                 advance(2);
@@ -981,8 +1026,21 @@ std::optional<Token> Lexer::try_ident() {
     auto source = begin_source();
     auto start = pos();
 
-    // Must begin with an XID_Source unicode character, or underscore
-    {
+    // Fast path for identifiers that start with ASCII characters. Falls back to the Unicode path
+    // below at the first non-ASCII character, if any.
+    if (auto first = static_cast<uint8_t>(at(start)); first < 0x80) {
+        // Must begin with an ASCII letter, or underscore
+        if (uint8_t lower = first | 0x20; first != '_' && (lower < 'a' || lower > 'z')) {
+            return {};
+        }
+        size_t end = start + 1 + CountLeading<AsciiIdentContinue>(line().substr(start + 1));
+        if (end - start >= 2 && first == '_' && at(start + 1) == '_') {
+            // Identifiers prefixed with two or more underscores are not allowed.
+            return {};
+        }
+        set_pos(end);
+    } else {
+        // Must begin with an XID_Source unicode character, or underscore
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = tint::utf8::Decode(utf8, length() - pos());
         if (n == 0) {
@@ -47,11 +47,13 @@ class Lexer {
     /// @return the token list.
     std::vector<Token> Lex();
 
-  private:
     /// Returns the next token in the input stream.
+    /// Unlike Lex(), no placeholder tokens are added for tokens that can be split. Once an EOF or
+    /// error token has been returned, the stream has ended.
     /// @return Token
     Token next();
 
+  private:
     /// Advances past blankspace and comments, if present at the current position.
     /// @returns error token, EOF, or uninitialized
     std::optional<Token> skip_blankspace_and_comments();
@@ -323,6 +323,59 @@ abcd)");
     EXPECT_EQ(t.source().range.end.column, 4u);
 }
 
+TEST_F(LexerTest, Skips_Comments_Block_Long) {
+    // Comment bodies long enough to be skipped in blocks, containing nested comments, stray '*'
+    // and '/' characters, and non-ASCII characters.
+    Source::File file("", R"(/* a block comment that spans more than sixteen bytes
+  /* with a nested comment ** // * / and some stray characters */ Ω𝕚 ∑ more text
+ */ident /*                                */)");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(2u, list.size());
+
+    {
+        auto& t = list[0];
+        EXPECT_TRUE(t.IsIdentifier());
+        EXPECT_EQ(t.source().range.begin.line, 3u);
+        EXPECT_EQ(t.source().range.begin.column, 4u);
+        EXPECT_EQ(t.source().range.end.line, 3u);
+        EXPECT_EQ(t.source().range.end.column, 9u);
+        EXPECT_EQ(t.to_str(), "ident");
+    }
+
+    {
+        auto& t = list[1];
+        EXPECT_TRUE(t.IsEof());
+    }
+}
+
+TEST_F(LexerTest, Skips_Blankspace_Long) {
+    Source::File file("",                                     //
+                      "  \t \t                 \t\t         "  //
+                      "ident"                                 //
+                      " \t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(2u, list.size());
+
+    {
+        auto& t = list[0];
+        EXPECT_TRUE(t.IsIdentifier());
+        EXPECT_EQ(t.source().range.begin.line, 1u);
+        EXPECT_EQ(t.source().range.begin.column, 34u);
+        EXPECT_EQ(t.source().range.end.line, 1u);
+        EXPECT_EQ(t.source().range.end.column, 39u);
+        EXPECT_EQ(t.to_str(), "ident");
+    }
+
+    {
+        auto& t = list[1];
+        EXPECT_TRUE(t.IsEof());
+    }
+}
+
 TEST_F(LexerTest, Null_InBlankspace_IsError) {
     Source::File file("", std::string{' ', 0, ' '});
     Lexer l(&file);
@@ -398,6 +451,43 @@ TEST_F(LexerTest, Null_InIdentifier_IsError) {
     }
 }
 
+TEST_F(LexerTest, Null_InLongLineComment_IsError) {
+    std::string src = "// a line comment longer than sixteen bytes ";
+    src += '\0';
+    Source::File file("", src);
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(1u, list.size());
+
+    auto& t = list[0];
+    EXPECT_TRUE(t.IsError());
+    EXPECT_EQ(t.source().range.begin.line, 1u);
+    EXPECT_EQ(t.source().range.begin.column, 45u);
+    EXPECT_EQ(t.source().range.end.line, 1u);
+    EXPECT_EQ(t.source().range.end.column, 45u);
+    EXPECT_EQ(t.to_str(), "null character found");
+}
+
+TEST_F(LexerTest, Null_InLongBlockComment_IsError) {
+    std::string src = "/* a block comment longer than sixteen bytes ";
+    src += '\0';
+    src += " */";
+    Source::File file("", src);
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(1u, list.size());
+
+    auto& t = list[0];
+    EXPECT_TRUE(t.IsError());
+    EXPECT_EQ(t.source().range.begin.line, 1u);
+    EXPECT_EQ(t.source().range.begin.column, 46u);
+    EXPECT_EQ(t.source().range.end.line, 1u);
+    EXPECT_EQ(t.source().range.end.column, 46u);
+    EXPECT_EQ(t.to_str(), "null character found");
+}
+
 struct FloatData {
     const char* input;
     double result;
@@ -636,7 +726,8 @@ INSTANTIATE_TEST_SUITE_P(LexerTest,
                                          "MiXeD_CaSe",
                                          "abcdefghijklmnopqrstuvwxyz",
                                          "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
-                                         "alldigits_0123456789"));
+                                         "alldigits_0123456789",
+                                         "a_long_identifier_that_spans_more_than_32_bytes"));
 
 struct UnicodeCase {
     const char* utf8;
@@ -695,6 +786,9 @@ INSTANTIATE_TEST_SUITE_P(
                     "\xf0\x9d\x96\x99\xf0\x9d\x96\x8e\xf0\x9d\x96\x8b\xf0\x9d\x96\x8e"
                     "\xf0\x9d\x96\x8a\xf0\x9d\x96\x97\x31\x32\x33",
                     43},
+        UnicodeCase{// "an_ascii_prefix_of_32_characters𝕚𝕕"
+                    "an_ascii_prefix_of_32_characters\xf0\x9d\x95\x9a\xf0\x9d\x95\x95",
+                    40},
     }));
 
 using InvalidUnicodeIdentifierTest = testing::TestWithParam<const char*>;
@@ -771,6 +865,17 @@ TEST_F(LexerTest, IdentifierTest_DoesNotStartWithDoubleUnderscore) {
     EXPECT_FALSE(t.IsIdentifier());
 }
 
+TEST_F(LexerTest, IdentifierTest_DoesNotStartWithLongDoubleUnderscore) {
+    Source::File file("", "__a_long_identifier_that_spans_more_than_32_bytes");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_FALSE(list.empty());
+
+    auto& t = list[0];
+    EXPECT_FALSE(t.IsIdentifier());
+}
+
 TEST_F(LexerTest, IdentifierTest_DoesNotStartWithNumber) {
     Source::File file("", "01test");
     Lexer l(&file);
@@ -53,8 +53,7 @@
 #include "tint/lang/wgsl/ast/unary_op_expression.h"
 #include "tint/lang/wgsl/ast/variable_decl_statement.h"
 #include "tint/lang/wgsl/ast/workgroup_attribute.h"
-#include "tint/lang/wgsl/reader/parser/classify_template_args.h"
-#include "tint/lang/wgsl/reader/parser/lexer.h"
+#include "tint/lang/wgsl/reader/parser/token_stream.h"
 #include "tint/utils/containers/reverse.h"
 #include "tint/utils/macros/defer.h"
 #include "tint/utils/text/string.h"
@@ -264,37 +263,35 @@ void Parser::deprecated(const Source& source, std::string_view msg) {
 
 const Token& Parser::next() {
     // If the next token is already an error or the end of file, stay there.
-    if (tokens_[next_token_idx_].IsEof() || tokens_[next_token_idx_].IsError()) {
-        return tokens_[next_token_idx_];
+    Token* token = &tokens_->Get(next_token_idx_);
+    if (token->IsEof() || token->IsError()) {
+        return *token;
     }
 
     // Skip over any placeholder elements
-    while (true) {
-        if (!tokens_[next_token_idx_].IsPlaceholder()) {
-            break;
-        }
-        next_token_idx_++;
+    while (token->IsPlaceholder()) {
+        token = &tokens_->Get(++next_token_idx_);
     }
-    last_source_idx_ = next_token_idx_;
+    last_source_ = token->source();
 
-    if (!tokens_[next_token_idx_].IsEof() && !tokens_[next_token_idx_].IsError()) {
+    if (!token->IsEof() && !token->IsError()) {
         next_token_idx_++;
     }
-    return tokens_[last_source_idx_];
+    return *token;
 }
 
 const Token& Parser::peek(size_t count) {
-    for (size_t idx = next_token_idx_; idx < tokens_.size(); idx++) {
-        if (tokens_[idx].IsPlaceholder()) {
+    for (size_t idx = next_token_idx_;; idx++) {
+        auto& token = tokens_->Get(idx);
+        if (token.IsPlaceholder()) {
             continue;
         }
-        if (count == 0) {
-            return tokens_[idx];
+        // The stream ends with an EOF or error token, which is returned for any token past the end.
+        if (count == 0 || token.IsEof() || token.IsError()) {
+            return token;
         }
         count--;
     }
-    // Walked off the end of the token list, return last token.
-    return tokens_[tokens_.size() - 1];
 }
 
 bool Parser::peek_is(Token::Type tok, size_t idx) {
@@ -305,24 +302,27 @@ void Parser::split_token(Token::Type lhs, Token::Type rhs) {
     if (TINT_UNLIKELY(next_token_idx_ == 0)) {
         TINT_ICE() << "attempt to update placeholder at beginning of tokens";
     }
-    if (TINT_UNLIKELY(next_token_idx_ >= tokens_.size())) {
+    if (TINT_UNLIKELY(tokens_->IsPastEnd(next_token_idx_))) {
         TINT_ICE() << "attempt to update placeholder past end of tokens";
     }
-    if (TINT_UNLIKELY(!tokens_[next_token_idx_].IsPlaceholder())) {
+    if (TINT_UNLIKELY(!tokens_->Get(next_token_idx_).IsPlaceholder())) {
         TINT_ICE() << "attempt to update non-placeholder token";
     }
-    tokens_[next_token_idx_ - 1].SetType(lhs);
-    tokens_[next_token_idx_].SetType(rhs);
+    tokens_->Get(next_token_idx_ - 1).SetType(lhs);
+    tokens_->Get(next_token_idx_).SetType(rhs);
 }
 
 Source Parser::last_source() const {
-    return tokens_[last_source_idx_].source();
+    return last_source_;
+}
+
+size_t Parser::max_buffered_tokens() const {
+    return tokens_ ? tokens_->MaxBuffered() : 0;
 }
 
 void Parser::InitializeLex() {
-    Lexer l{file_};
-    tokens_ = l.Lex();
-    ClassifyTemplateArguments(tokens_);
+    tokens_ = std::make_unique<TokenStream>(file_);
+    last_source_ = tokens_->Get(0).source();
 }
 
 bool Parser::Parse() {
@@ -336,6 +336,9 @@ bool Parser::Parse() {
 void Parser::translation_unit() {
     bool after_global_decl = false;
     while (continue_parsing()) {
+        // No references to the tokens of the previous declarations are held, so they can be freed.
+        tokens_->Release(next_token_idx_);
+
         auto& p = peek();
         if (p.IsEof()) {
             break;
@@ -56,6 +56,7 @@ class VariableDeclStatement;
 namespace tint::wgsl::reader {
 
 class Lexer;
+class TokenStream;
 
 /// Struct holding information for a for loop
 struct ForHeader {
@@ -305,7 +306,7 @@ class Parser {
     explicit Parser(Source::File const* file);
     ~Parser();
 
-    /// Reads tokens from the source file. This will be called automatically
+    /// Prepares to read tokens from the source file. This will be called automatically
     /// by |parse|.
     void InitializeLex();
 
@@ -338,6 +339,9 @@ class Parser {
     /// @returns the program builder.
     ProgramBuilder& builder() { return builder_; }
 
+    /// @returns the largest number of tokens that were held in memory at once
+    size_t max_buffered_tokens() const;
+
     /// @returns the next token
     const Token& next();
     /// Peeks ahead and returns the token at `idx` ahead of the current position
@@ -894,9 +898,9 @@ class Parser {
     }
 
     Source::File const* const file_;
-    std::vector<Token> tokens_;
+    std::unique_ptr<TokenStream> tokens_;
     size_t next_token_idx_ = 0;
-    size_t last_source_idx_ = 0;
+    Source last_source_;
     bool synchronized_ = true;
     uint32_t parse_depth_ = 0;
     std::vector<Token::Type> sync_tokens_;
@@ -214,56 +214,87 @@ std::string_view Token::TypeToName(Type type) {
 Token::Token() : type_(Type::kUninitialized) {}
 
 Token::Token(Type type, const Source& source, const std::string_view& view)
-    : type_(type), source_(source), value_(view) {}
+    : str_length_(static_cast<uint32_t>(view.length())), type_(type) {
+    SetSource(source);
+    value_.str = view.data();
+}
 
 Token::Token(Type type, const Source& source, const std::string& str)
-    : type_(type), source_(source), value_(str) {}
+    : str_length_(static_cast<uint32_t>(str.length())), type_(type), owns_str_(true) {
+    SetSource(source);
+    char* copy = new char[str.length()];
+    str.copy(copy, str.length());
+    value_.str = copy;
+}
 
 Token::Token(Type type, const Source& source, const char* str)
-    : type_(type), source_(source), value_(std::string_view(str)) {}
+    : Token(type, source, std::string_view(str)) {}
 
-Token::Token(Type type, const Source& source, int64_t val)
-    : type_(type), source_(source), value_(val) {}
+Token::Token(Type type, const Source& source, int64_t val) : type_(type) {
+    SetSource(source);
+    value_.i64 = val;
+}
 
-Token::Token(Type type, const Source& source, double val)
-    : type_(type), source_(source), value_(val) {}
+Token::Token(Type type, const Source& source, double val) : type_(type) {
+    SetSource(source);
+    value_.f64 = val;
+}
 
-Token::Token(Type type, const Source& source) : type_(type), source_(source) {}
+Token::Token(Type type, const Source& source) : type_(type) {
+    SetSource(source);
+}
 
-Token::Token(Token&&) = default;
+Token::Token(Token&& other) noexcept
+    : file_(other.file_),
+      begin_line_(other.begin_line_),
+      begin_column_(other.begin_column_),
+      end_line_(other.end_line_),
+      end_column_(other.end_column_),
+      value_(other.value_),
+      str_length_(other.str_length_),
+      type_(other.type_),
+      owns_str_(other.owns_str_) {
+    other.owns_str_ = false;
+}
 
-Token::~Token() = default;
+Token::~Token() {
+    if (owns_str_) {
+        delete[] value_.str;
+    }
+}
 
 bool Token::operator==(std::string_view ident) const {
     if (type_ != Type::kIdentifier) {
         return false;
     }
-    if (auto* view = std::get_if<std::string_view>(&value_)) {
-        return *view == ident;
-    }
-    return std::get<std::string>(value_) == ident;
+    return str() == ident;
+}
+
+void Token::SetSource(const Source& source) {
+    file_ = source.file;
+    begin_line_ = static_cast<uint32_t>(source.range.begin.line);
+    begin_column_ = static_cast<uint32_t>(source.range.begin.column);
+    end_line_ = static_cast<uint32_t>(source.range.end.line);
+    end_column_ = static_cast<uint32_t>(source.range.end.column);
 }
 
 std::string Token::to_str() const {
     switch (type_) {
         case Type::kFloatLiteral:
-            return std::to_string(std::get<double>(value_));
+            return std::to_string(value_.f64);
         case Type::kFloatLiteral_F:
-            return std::to_string(std::get<double>(value_)) + "f";
+            return std::to_string(value_.f64) + "f";
         case Type::kFloatLiteral_H:
-            return std::to_string(std::get<double>(value_)) + "h";
+            return std::to_string(value_.f64) + "h";
         case Type::kIntLiteral:
-            return std::to_string(std::get<int64_t>(value_));
+            return std::to_string(value_.i64);
         case Type::kIntLiteral_I:
-            return std::to_string(std::get<int64_t>(value_)) + "i";
+            return std::to_string(value_.i64) + "i";
         case Type::kIntLiteral_U:
-            return std::to_string(std::get<int64_t>(value_)) + "u";
+            return std::to_string(value_.i64) + "u";
         case Type::kIdentifier:
         case Type::kError:
-            if (auto* view = std::get_if<std::string_view>(&value_)) {
-                return std::string(*view);
-            }
-            return std::get<std::string>(value_);
+            return std::string(str());
         default:
             return "";
     }
@@ -273,20 +304,7 @@ std::string_view Token::to_str_view() const {
     if (type_ != Type::kIdentifier) {
         return {};
     }
-
-    if (auto* view = std::get_if<std::string_view>(&value_)) {
-        return *view;
-    }
-    auto& s = std::get<std::string>(value_);
-    return {s.data(), s.length()};
-}
-
-double Token::to_f64() const {
-    return std::get<double>(value_);
-}
-
-int64_t Token::to_i64() const {
-    return std::get<int64_t>(value_);
+    return str();
 }
 
 }  // namespace tint::wgsl::reader
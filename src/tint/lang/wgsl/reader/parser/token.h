@@ -28,19 +28,22 @@
 #ifndef SRC_TINT_LANG_WGSL_READER_PARSER_TOKEN_H_
 #define SRC_TINT_LANG_WGSL_READER_PARSER_TOKEN_H_
 
+#include <cstdint>
 #include <string>
 #include <string_view>
-#include <variant>
 
 #include "tint/utils/diagnostic/source.h"
 
 namespace tint::wgsl::reader {
 
 /// Stores tokens generated by the Lexer
+/// Tokens are kept small, as the parser holds a window of them in memory at once. The source range
+/// is stored with 32-bit lines and columns, and identifier tokens reference the source file
+/// content, which must outlive the token.
 class Token {
   public:
     /// The type of the parsed token
-    enum class Type {
+    enum class Type : int16_t {
         /// Error result
         kError = -2,
         /// Uninitialized token
@@ -239,7 +242,7 @@ class Token {
     /// @param source the source of the token
     /// @param view the source string view for the token
     Token(Type type, const Source& source, const std::string_view& view);
-    /// Create a string Token
+    /// Create a string Token that holds a copy of `str`
     /// @param type the Token::Type of the token
     /// @param source the source of the token
     /// @param str the source string for the token
@@ -247,7 +250,7 @@ class Token {
     /// Create a string Token
     /// @param type the Token::Type of the token
     /// @param source the source of the token
-    /// @param str the source string for the token
+    /// @param str the source string for the token. Must outlive the token.
     Token(Type type, const Source& source, const char* str);
     /// Create a integer Token of the given type
     /// @param type the Token::Type of the token
@@ -260,7 +263,7 @@ class Token {
     /// @param val the source double for the token
     Token(Type type, const Source& source, double val);
     /// Move constructor
-    Token(Token&&);
+    Token(Token&&) noexcept;
     ~Token();
 
     /// Equality operator with an identifier
@@ -339,7 +342,9 @@ class Token {
     }
 
     /// @returns the source information for this token
-    Source source() const { return source_; }
+    Source source() const {
+        return Source{Source::Range{{begin_line_, begin_column_}, {end_line_, end_column_}}, file_};
+    }
 
     /// @returns the type of the token
     Type type() const { return type_; }
@@ -354,22 +359,52 @@ class Token {
     /// Returns the float value of the token. 0 is returned if the token does not
     /// contain a float value.
     /// @return double
-    double to_f64() const;
+    double to_f64() const { return IsFloatLiteral() ? value_.f64 : 0; }
     /// Returns the int64_t value of the token. 0 is returned if the token does
     /// not contain an integer value.
     /// @return int64_t
-    int64_t to_i64() const;
+    int64_t to_i64() const { return IsIntLiteral() ? value_.i64 : 0; }
 
     /// @returns the token type as string
     std::string_view to_name() const { return Token::TypeToName(type_); }
 
   private:
+    /// @returns true if the token holds an integer value
+    bool IsIntLiteral() const {
+        return type_ == Type::kIntLiteral || type_ == Type::kIntLiteral_I ||
+               type_ == Type::kIntLiteral_U;
+    }
+    /// @returns true if the token holds a float value
+    bool IsFloatLiteral() const {
+        return type_ == Type::kFloatLiteral || type_ == Type::kFloatLiteral_F ||
+               type_ == Type::kFloatLiteral_H;
+    }
+    /// @returns the string held by the token
+    std::string_view str() const { return {value_.str, str_length_}; }
+
+    /// Sets the source where the token appeared
+    /// @param source the source
+    void SetSource(const Source& source);
+
+    /// The file where the token appeared
+    const Source::File* file_ = nullptr;
+    /// The source range where the token appeared
+    uint32_t begin_line_ = 0;
+    uint32_t begin_column_ = 0;
+    uint32_t end_line_ = 0;
+    uint32_t end_column_ = 0;
+    /// The value represented by the token. The active member is determined by #type_.
+    union {
+        int64_t i64;
+        double f64;
+        const char* str;
+    } value_{};
+    /// The length of the string, if the token holds a string
+    uint32_t str_length_ = 0;
     /// The Token::Type of the token
     Type type_ = Type::kError;
-    /// The source where the token appeared
-    Source source_;
-    /// The value represented by the token
-    std::variant<int64_t, double, std::string, std::string_view> value_;
+    /// True if #value_ holds a string allocated by the token
+    bool owns_str_ = false;
 };
 
 template <typename STREAM, typename = traits::EnableIfIsOStream<STREAM>>
@@ -0,0 +1,94 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "tint/lang/wgsl/reader/parser/token_stream.h"
+
+#include <algorithm>
+
+namespace tint::wgsl::reader {
+
+TokenStream::TokenStream(const Source::File* file) : lexer_(file) {}
+
+TokenStream::~TokenStream() = default;
+
+bool TokenStream::IsPastEnd(size_t idx) {
+    while (idx >= num_final_ && !ended_) {
+        LexNext();
+    }
+    return idx >= num_final_;
+}
+
+void TokenStream::Release(size_t idx) {
+    idx = std::min(idx, num_final_);
+    while (first_ < idx) {
+        tokens_.pop_front();
+        first_++;
+    }
+}
+
+Token& TokenStream::GetSlow(size_t idx) {
+    if (IsPastEnd(idx)) {
+        return tokens_.back();
+    }
+    return tokens_[idx - first_];
+}
+
+void TokenStream::LexNext() {
+    tokens_.emplace_back(lexer_.next());
+    if (tokens_.back().IsEof() || tokens_.back().IsError()) {
+        ended_ = true;
+    } else {
+        // If the token can be split, we insert a placeholder element(s) into the stream to hold the
+        // split character.
+        size_t num_placeholders = tokens_.back().NumPlaceholders();
+        for (size_t i = 0; i < num_placeholders; i++) {
+            auto src = tokens_.back().source();
+            src.range.begin.column++;
+            tokens_.emplace_back(Token::Type::kPlaceholder, src);
+        }
+    }
+    max_buffered_ = std::max(max_buffered_, tokens_.size());
+
+    // Classify the tokens that are followed by another token.
+    const size_t end = NumLexed();
+    while (num_classified_ + 1 < end) {
+        num_classified_ += classifier_.Classify(num_classified_, tokens_[num_classified_ - first_],
+                                                tokens_[num_classified_ + 1 - first_]);
+    }
+
+    if (ended_) {
+        // The last token is never classified, and any '<' still pending is a less-than.
+        num_final_ = end;
+    } else if (classifier_.HasPending()) {
+        num_final_ = std::min(num_classified_, classifier_.FirstPending());
+    } else {
+        num_final_ = num_classified_;
+    }
+}
+
+}  // namespace tint::wgsl::reader
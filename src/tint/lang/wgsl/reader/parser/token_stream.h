@@ -0,0 +1,116 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_LANG_WGSL_READER_PARSER_TOKEN_STREAM_H_
+#define SRC_TINT_LANG_WGSL_READER_PARSER_TOKEN_STREAM_H_
+
+#include <deque>
+
+#include "tint/lang/wgsl/reader/parser/classify_template_args.h"
+#include "tint/lang/wgsl/reader/parser/lexer.h"
+#include "tint/lang/wgsl/reader/parser/token.h"
+#include "tint/utils/macros/compiler.h"
+
+namespace tint::wgsl::reader {
+
+/// TokenStream lexes a source file on demand, instead of holding the tokens of the whole file in
+/// memory.
+///
+/// Tokens are addressed by their index in the stream, as if they were held in the list returned by
+/// Lexer::Lex(), and have had their template arguments classified by ClassifyTemplateArguments().
+/// The stream buffers the tokens from the last Release() up to the furthest token requested. The
+/// template argument classification may need to look ahead further than the parser, up to the end
+/// of the current expression.
+///
+/// Tokens do not move in memory until they are released, so references to tokens stay valid until
+/// then.
+class TokenStream {
+  public:
+    /// Constructor
+    /// @param file the source file
+    explicit TokenStream(const Source::File* file);
+    /// Destructor
+    ~TokenStream();
+
+    /// @param idx the index of the token in the stream. The token must not have been released.
+    /// @returns the token at index @p idx. If the stream ends before @p idx, then the last token
+    /// of the stream, which is either an EOF or an error token, is returned.
+    Token& Get(size_t idx) {
+        if (TINT_LIKELY(idx < num_final_)) {
+            return tokens_[idx - first_];
+        }
+        return GetSlow(idx);
+    }
+
+    /// @param idx the index of the token in the stream
+    /// @returns true if the stream ends before @p idx
+    bool IsPastEnd(size_t idx);
+
+    /// Releases the tokens before @p idx, invalidating references to them.
+    /// Tokens that are still needed to classify template arguments are kept.
+    /// @param idx the index of the first token to keep
+    void Release(size_t idx);
+
+    /// @returns the number of tokens lexed so far
+    size_t NumLexed() const { return first_ + tokens_.size(); }
+
+    /// @returns the largest number of tokens that have been buffered at once
+    size_t MaxBuffered() const { return max_buffered_; }
+
+  private:
+    /// Lexes until the token at @p idx can be returned.
+    /// @param idx the index of the token
+    /// @returns the token at index @p idx, or the last token of the stream.
+    Token& GetSlow(size_t idx);
+
+    /// Lexes the next token, and classifies the tokens that have a following token.
+    void LexNext();
+
+    /// The lexer
+    Lexer lexer_;
+    /// The template argument classifier
+    TemplateArgumentClassifier classifier_;
+    /// The buffered tokens. A deque keeps the tokens at a stable address, and frees the memory of
+    /// released tokens.
+    std::deque<Token> tokens_;
+    /// The index of the first token in #tokens_
+    size_t first_ = 0;
+    /// The index of the next token to be classified
+    size_t num_classified_ = 0;
+    /// The index of the first token that may still be modified by the template argument
+    /// classification. Tokens before this index can be handed out.
+    size_t num_final_ = 0;
+    /// True once the EOF or error token has been lexed
+    bool ended_ = false;
+    /// The largest size of #tokens_
+    size_t max_buffered_ = 0;
+};
+
+}  // namespace tint::wgsl::reader
+
+#endif  // SRC_TINT_LANG_WGSL_READER_PARSER_TOKEN_STREAM_H_
@@ -0,0 +1,113 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "tint/lang/wgsl/reader/parser/token_stream.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+namespace tint::wgsl::reader {
+namespace {
+
+using T = Token::Type;
+
+using WGSLParserTokenStreamTest = testing::TestWithParam<const char*>;
+
+// The stream returns the same tokens as lexing and classifying the whole file up front, even when
+// each token is released as soon as it has been read.
+TEST_P(WGSLParserTokenStreamTest, MatchesLex) {
+    Source::File file("", GetParam());
+    Lexer l(&file);
+    auto expected = l.Lex();
+    ClassifyTemplateArguments(expected);
+
+    TokenStream stream(&file);
+    for (size_t i = 0; i < expected.size(); i++) {
+        auto& token = stream.Get(i);
+        EXPECT_EQ(token.type(), expected[i].type()) << "token " << i;
+        EXPECT_EQ(token.source().range, expected[i].source().range) << "token " << i;
+        EXPECT_EQ(token.to_str(), expected[i].to_str()) << "token " << i;
+        stream.Release(i + 1);
+    }
+    EXPECT_EQ(stream.NumLexed(), expected.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(WGSLParserTokenStreamTest,
+                         WGSLParserTokenStreamTest,
+                         testing::Values("",
+                                         "fn f() -> i32 { return 1i + 2 * 3.5f; }",
+                                         "var<private> v : array<vec4<f32>, 4>;",
+                                         "a<b || c>d",
+                                         "a<(b || c)>d",
+                                         "a<b<c>>=d",
+                                         "a<b>>=c",
+                                         "x >>= 2; y >= 3; z >> 4",
+                                         "a<b, c<d>()>(e<f>g)",
+                                         "a<b; c>d",
+                                         "a<b",
+                                         "/* unterminated"));
+
+TEST_F(WGSLParserTokenStreamTest, GetPastEnd) {
+    Source::File file("", "a b");
+    TokenStream stream(&file);
+    EXPECT_TRUE(stream.Get(0).IsIdentifier());
+    EXPECT_FALSE(stream.IsPastEnd(2));
+    EXPECT_TRUE(stream.Get(2).IsEof());
+    EXPECT_TRUE(stream.IsPastEnd(3));
+    EXPECT_TRUE(stream.Get(10).IsEof());
+}
+
+TEST_F(WGSLParserTokenStreamTest, ReleaseBoundsBufferedTokens) {
+    std::string wgsl;
+    for (int i = 0; i < 1000; i++) {
+        wgsl += "const c" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+    }
+    Source::File file("", wgsl);
+    TokenStream stream(&file);
+    size_t idx = 0;
+    while (!stream.Get(idx).IsEof()) {
+        stream.Release(++idx);
+    }
+    EXPECT_EQ(stream.NumLexed(), 5001u);
+    EXPECT_LE(stream.MaxBuffered(), 2u);
+}
+
+TEST_F(WGSLParserTokenStreamTest, ReleaseKeepsPendingTemplateArgs) {
+    Source::File file("", "a<b>(c)");
+    TokenStream stream(&file);
+    EXPECT_TRUE(stream.Get(0).IsIdentifier());
+    // Only releases the 'a', as the '<' can only be classified once the '>' has been lexed.
+    stream.Release(5);
+    EXPECT_EQ(stream.Get(1).type(), T::kTemplateArgsLeft);
+    EXPECT_EQ(stream.Get(3).type(), T::kTemplateArgsRight);
+}
+
+}  // namespace
+}  // namespace tint::wgsl::reader
@@ -33,6 +33,7 @@
 #include <variant>
 #include <vector>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/core/fluent_types.h"
 #include "tint/lang/core/ir/block_param.h"
 #include "tint/lang/core/ir/builder.h"
@@ -125,17 +126,18 @@ using namespace tint::core::fluent_types;     // NOLINT
 namespace tint::wgsl::reader {
 namespace {
 
-using ResultType = tint::Result<core::ir::Module>;
+using ResultType = tint::Result<SuccessType>;
 
 /// Impl is the private-implementation of FromProgram().
 class Impl {
   public:
     /// Constructor
     /// @param program the program to convert to IR
-    explicit Impl(const Program& program) : program_(program) {}
+    /// @param module the empty IR module to build
+    Impl(const Program& program, core::ir::Module& module) : program_(program), mod(module) {}
 
-    /// Builds an IR module from the program passed to the constructor.
-    /// @return the IR module or an error.
+    /// Builds the IR module from the program passed to the constructor.
+    /// @return success or an error.
     ResultType Build() { return EmitModule(); }
 
   private:
@@ -145,7 +147,7 @@ class Impl {
     const Program& program_;
 
     /// The IR module being built
-    core::ir::Module mod;
+    core::ir::Module& mod;
 
     /// The IR builder being used by the impl.
     core::ir::Builder builder_{mod};
@@ -266,7 +268,7 @@ class Impl {
             return Failure{std::move(diagnostics_)};
         }
 
-        return std::move(mod);
+        return Success;
     }
 
     core::Interpolation ExtractInterpolation(const ast::InterpolateAttribute* interp) {
@@ -1421,11 +1423,23 @@ class Impl {
 }  // namespace
 
 tint::Result<core::ir::Module> ProgramToIR(const Program& program) {
+    core::ir::Module mod;
+    auto r = ProgramToIR(program, mod);
+    if (!r) {
+        return r.Failure();
+    }
+    return mod;
+}
+
+tint::Result<SuccessType> ProgramToIR(const Program& program, core::ir::Module& module) {
     if (!program.IsValid()) {
         return Failure{program.Diagnostics()};
     }
 
-    Impl b(program);
+    Instrumentation::PhaseScope phase("wgsl.program_to_ir");
+
+    module.Clear();
+    Impl b(program, module);
     auto r = b.Build();
     if (!r) {
         diag::List err = std::move(r.Failure().reason);
@@ -1433,7 +1447,8 @@ tint::Result<core::ir::Module> ProgramToIR(const Program& program) {
         return Failure{err};
     }
 
-    return r.Move();
+    phase.SetNodeCount(module.instructions.Count());
+    return Success;
 }
 
 }  // namespace tint::wgsl::reader
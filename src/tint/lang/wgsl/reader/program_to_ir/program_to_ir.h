@@ -50,6 +50,15 @@ namespace tint::wgsl::reader {
 /// concrete types.
 tint::Result<core::ir::Module> ProgramToIR(const Program& program);
 
+/// Builds a WGSL-dialect core::ir::Module from the given Program into an existing module.
+/// @p module is cleared with core::ir::Module::Clear() first, so that a module can be reused to
+/// build the IR of many programs, without returning its memory to the heap in between.
+/// @param program the Program to use.
+/// @param module the module to build the IR into.
+/// @returns success, or failure if the IR could not be built. On failure, @p module is left in an
+/// unspecified but valid state.
+tint::Result<SuccessType> ProgramToIR(const Program& program, core::ir::Module& module);
+
 }  // namespace tint::wgsl::reader
 
 #endif  // SRC_TINT_LANG_WGSL_READER_PROGRAM_TO_IR_PROGRAM_TO_IR_H_
@@ -1142,5 +1142,34 @@ TEST_F(IR_FromProgramTest, Func_WithParam_WithAttribute_Location_WithInterpolati
 )");
 }
 
+TEST_F(IR_FromProgramTest, ReuseModule) {
+    Func("f", Vector{Param("a", ty.u32())}, ty.u32(), Vector{Return("a")});
+    Program first{resolver::Resolve(*this)};
+    ASSERT_TRUE(first.IsValid()) << first.Diagnostics();
+
+    ProgramBuilder b;
+    b.Func("g", tint::Empty, b.ty.i32(), Vector{b.Return(1_i)});
+    Program second{resolver::Resolve(b)};
+    ASSERT_TRUE(second.IsValid()) << second.Diagnostics();
+
+    core::ir::Module mod;
+    ASSERT_TRUE(ProgramToIR(first, mod));
+    EXPECT_EQ(Disassemble(mod), R"(%f = func(%a:u32):u32 -> %b1 {
+  %b1 = block {
+    ret %a
+  }
+}
+)");
+
+    // Building the second program into the same module replaces the first.
+    ASSERT_TRUE(ProgramToIR(second, mod));
+    EXPECT_EQ(Disassemble(mod), R"(%g = func():i32 -> %b1 {
+  %b1 = block {
+    ret 1i
+  }
+}
+)");
+}
+
 }  // namespace
 }  // namespace tint::wgsl::reader
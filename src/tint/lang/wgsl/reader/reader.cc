@@ -29,6 +29,7 @@
 
 #include <utility>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/wgsl/reader/lower/lower.h"
 #include "tint/lang/wgsl/reader/parser/parser.h"
 #include "tint/lang/wgsl/reader/program_to_ir/program_to_ir.h"
@@ -36,10 +37,14 @@
 
 namespace tint::wgsl::reader {
 
-Program Parse(const Source::File* file) {
+Program Parse(const Source::File* file, const resolver::Options& options) {
     Parser parser(file);
-    parser.Parse();
-    return resolver::Resolve(parser.builder());
+    {
+        Instrumentation::PhaseScope phase("wgsl.parse");
+        parser.Parse();
+        phase.SetNodeCount(parser.builder().ASTNodes().Count());
+    }
+    return resolver::Resolve(parser.builder(), options);
 }
 
 Result<core::ir::Module> WgslToIR(const Source::File* file) {
@@ -30,6 +30,7 @@
 
 #include "tint/lang/core/ir/module.h"
 #include "tint/lang/wgsl/program/program.h"
+#include "tint/lang/wgsl/resolver/resolve.h"
 
 namespace tint::wgsl::reader {
 
@@ -38,8 +39,9 @@ namespace tint::wgsl::reader {
 /// `program.Diagnostics.contains_errors()` will be true, and the
 /// `program.Diagnostics()` will describe the error.
 /// @param file the source file
+/// @param options the resolver options
 /// @returns the parsed program
-Program Parse(const Source::File* file);
+Program Parse(const Source::File* file, const resolver::Options& options = {});
 
 /// Parse a WGSL program from source, and return an IR module.
 /// @param file the input WGSL file
@@ -28,6 +28,8 @@
 #include <string>
 
 #include "tint/cmd/bench/bench.h"
+#include "tint/lang/wgsl/reader/parser/lexer.h"
+#include "tint/lang/wgsl/reader/parser/parser.h"
 #include "tint/lang/wgsl/reader/reader.h"
 
 namespace tint::wgsl::reader {
@@ -45,9 +47,59 @@ void ParseWGSL(benchmark::State& state, std::string input_name) {
             state.SkipWithError(program.Diagnostics().str());
         }
     }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * res->content.data.size()));
 }
 
 TINT_BENCHMARK_PROGRAMS(ParseWGSL);
 
+// Tokenizes the WGSL, without parsing it.
+void LexWGSL(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadInputFile(input_name);
+    if (!res) {
+        state.SkipWithError(res.Failure().reason.str());
+        return;
+    }
+    for (auto _ : state) {
+        Lexer lexer(&res.Get());
+        for (;;) {
+            auto token = lexer.next();
+            if (token.IsError()) {
+                state.SkipWithError(token.to_str());
+            }
+            if (token.IsEof() || token.IsError()) {
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * res->content.data.size()));
+}
+
+TINT_BENCHMARK_PROGRAMS(LexWGSL);
+
+// Parses the WGSL without resolving it, and reports how many bytes of tokens the parser held in
+// memory at once, compared to holding the tokens of the whole file.
+void ParseWGSLSyntax(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadInputFile(input_name);
+    if (!res) {
+        state.SkipWithError(res.Failure().reason.str());
+        return;
+    }
+    size_t max_buffered_tokens = 0;
+    for (auto _ : state) {
+        Parser parser(&res.Get());
+        if (!parser.Parse()) {
+            state.SkipWithError(parser.error());
+        }
+        max_buffered_tokens = parser.max_buffered_tokens();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * res->content.data.size()));
+
+    size_t num_tokens = Lexer(&res.Get()).Lex().size();
+    state.counters["token_bytes"] = static_cast<double>(max_buffered_tokens * sizeof(Token));
+    state.counters["all_token_bytes"] = static_cast<double>(num_tokens * sizeof(Token));
+}
+
+TINT_BENCHMARK_PROGRAMS(ParseWGSLSyntax);
+
 }  // namespace
 }  // namespace tint::wgsl::reader
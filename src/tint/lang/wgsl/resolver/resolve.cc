@@ -33,8 +33,8 @@
 
 namespace tint::resolver {
 
-Program Resolve(ProgramBuilder& builder) {
-    Resolver resolver(&builder);
+Program Resolve(ProgramBuilder& builder, const Options& options) {
+    Resolver resolver(&builder, options);
     resolver.Resolve();
     return Program(std::move(builder));
 }
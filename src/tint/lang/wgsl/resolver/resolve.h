@@ -28,6 +28,8 @@
 #ifndef SRC_TINT_LANG_WGSL_RESOLVER_RESOLVE_H_
 #define SRC_TINT_LANG_WGSL_RESOLVER_RESOLVE_H_
 
+#include <cstddef>
+
 namespace tint {
 class Program;
 class ProgramBuilder;
@@ -35,9 +37,18 @@ class ProgramBuilder;
 
 namespace tint::resolver {
 
+/// Options for the resolver
+struct Options {
+    /// The maximum number of threads that the resolver may use. When greater than one, the
+    /// uniformity analysis of functions that do not call each other runs concurrently.
+    /// The resulting program and diagnostics do not depend on the number of threads.
+    size_t max_threads = 1;
+};
+
 /// Performs semantic analysis and validation on the program builder @p builder
+/// @param options the resolver options
 /// @returns the resolved Program. Program.Diagnostics() may contain validation errors.
-Program Resolve(ProgramBuilder& builder);
+Program Resolve(ProgramBuilder& builder, const Options& options = {});
 
 }  // namespace tint::resolver
 
@@ -33,6 +33,7 @@
 #include <limits>
 #include <utility>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/core/builtin_type.h"
 #include "tint/lang/core/constant/scalar.h"
 #include "tint/lang/core/fluent_types.h"
@@ -123,8 +124,9 @@ constexpr size_t kMaxNestDepthOfCompositeType = 255;
 
 }  // namespace
 
-Resolver::Resolver(ProgramBuilder* builder)
+Resolver::Resolver(ProgramBuilder* builder, const Options& options)
     : b(*builder),
+      options_(options),
       diagnostics_(builder->Diagnostics()),
       const_eval_(builder->constants, diagnostics_),
       intrinsic_table_{builder->Types(), builder->Symbols(), builder->Diagnostics()},
@@ -142,6 +144,9 @@ bool Resolver::Resolve() {
         return false;
     }
 
+    Instrumentation::PhaseScope phase("wgsl.resolve");
+    phase.SetNodeCount(b.ASTNodes().Count());
+
     b.Sem().Reserve(b.LastAllocatedNodeID());
 
     // Pre-allocate the marked bitset with the total number of AST nodes.
@@ -167,7 +172,7 @@ bool Resolver::Resolve() {
         enabled_extensions_.Contains(wgsl::Extension::kChromiumDisableUniformityAnalysis);
     if (result && !disable_uniformity_analysis) {
         // Run the uniformity analysis, which requires a complete semantic module.
-        if (!AnalyzeUniformity(b, dependencies_)) {
+        if (!AnalyzeUniformity(b, dependencies_, options_.max_threads)) {
             return false;
         }
     }
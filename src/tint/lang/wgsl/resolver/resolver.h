@@ -43,6 +43,7 @@
 #include "tint/lang/wgsl/intrinsic/dialect.h"
 #include "tint/lang/wgsl/program/program_builder.h"
 #include "tint/lang/wgsl/resolver/dependency_graph.h"
+#include "tint/lang/wgsl/resolver/resolve.h"
 #include "tint/lang/wgsl/resolver/sem_helper.h"
 #include "tint/lang/wgsl/resolver/validator.h"
 #include "tint/lang/wgsl/sem/block_statement.h"
@@ -96,7 +97,8 @@ class Resolver {
   public:
     /// Constructor
     /// @param builder the program builder
-    explicit Resolver(ProgramBuilder* builder);
+    /// @param options the resolver options
+    explicit Resolver(ProgramBuilder* builder, const Options& options = {});
 
     /// Destructor
     ~Resolver();
@@ -679,6 +681,7 @@ class Resolver {
     };
 
     ProgramBuilder& b;
+    const Options options_;
     diag::List& diagnostics_;
     core::constant::Eval const_eval_;
     core::intrinsic::Table<wgsl::intrinsic::Dialect> intrinsic_table_;
@@ -0,0 +1,213 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// GEN_BUILD:CONDITION(tint_build_wgsl_reader)
+
+#include <string>
+
+#include "tint/api/common/instrumentation.h"
+#include "tint/cmd/bench/bench.h"
+#include "tint/lang/wgsl/reader/parser/parser.h"
+#include "tint/lang/wgsl/resolver/resolve.h"
+#include "tint/utils/text/string_stream.h"
+
+namespace tint::resolver {
+namespace {
+
+/// @returns a shader with `count` helper functions that form a binary tree of calls, so that many
+/// of the functions are independent of each other. The entry point calls every helper.
+std::string GenerateHelpers(size_t count) {
+    StringStream ss;
+    ss << "@group(0) @binding(0) var<storage, read_write> buffer : array<vec4f>;\n";
+    for (size_t i = 0; i < count; i++) {
+        ss << "fn helper_" << i << "(p : vec4f, n : u32) -> vec4f {\n";
+        ss << "  var acc = p;\n";
+        ss << "  for (var j = 0u; j < n; j++) {\n";
+        ss << "    acc = acc * 1.5 + vec4f(f32(j)) - buffer[j];\n";
+        ss << "    if (acc.x > 2.0) {\n";
+        ss << "      acc = normalize(acc) + dot(acc, p) * vec4f(1, 2, 3, 4);\n";
+        ss << "    }\n";
+        ss << "    let m = mat4x4f(acc, p, acc.yzwx, p.wzyx);\n";
+        ss << "    acc = m * acc;\n";
+        ss << "  }\n";
+        if (i > 0) {
+            ss << "  acc += helper_" << (i - 1) / 2 << "(acc, n / 2u);\n";
+        }
+        ss << "  return acc;\n";
+        ss << "}\n";
+    }
+    ss << "@compute @workgroup_size(64)\n";
+    ss << "fn main(@builtin(global_invocation_id) id : vec3u) {\n";
+    ss << "  var v = buffer[id.x];\n";
+    for (size_t i = 0; i < count; i++) {
+        ss << "  v += helper_" << i << "(v, id.x);\n";
+    }
+    ss << "  buffer[id.x] = v;\n";
+    ss << "}\n";
+    return ss.str();
+}
+
+/// Benchmarks the resolver with `state.range(0)` threads, to show how the resolver scales with
+/// the number of cores.
+void ResolveHelpers(benchmark::State& state) {
+    Source::File file("helpers.wgsl", GenerateHelpers(512));
+    Options options;
+    options.max_threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        wgsl::reader::Parser parser(&file);
+        parser.Parse();
+        state.ResumeTiming();
+
+        auto program = Resolve(parser.builder(), options);
+        if (!program.IsValid()) {
+            state.SkipWithError(program.Diagnostics().str());
+        }
+    }
+}
+
+BENCHMARK(ResolveHelpers)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+/// @returns a shader with `count` helper functions that are all called by a `main` entry point
+/// that does not require uniformity. A second `sync` entry point calls every `barrier_interval`th
+/// helper and then `workgroupBarrier()`, so only those helpers need to be analyzed. If
+/// `barrier_interval` is 0, there is no `sync` entry point.
+std::string GenerateBarrierHelpers(size_t count, size_t barrier_interval) {
+    StringStream ss;
+    ss << "@group(0) @binding(0) var<storage, read_write> buffer : array<vec4f>;\n";
+    for (size_t i = 0; i < count; i++) {
+        ss << "fn helper_" << i << "(p : vec4f, n : u32) -> vec4f {\n";
+        ss << "  var acc = p;\n";
+        ss << "  for (var j = 0u; j < n; j++) {\n";
+        ss << "    acc = acc * 1.5 + buffer[j];\n";
+        ss << "    if (acc.x > 2.0) {\n";
+        ss << "      acc = normalize(acc);\n";
+        ss << "    }\n";
+        ss << "  }\n";
+        ss << "  return acc;\n";
+        ss << "}\n";
+    }
+    ss << "@compute @workgroup_size(64)\n";
+    ss << "fn main(@builtin(global_invocation_id) id : vec3u) {\n";
+    ss << "  var v = buffer[id.x];\n";
+    for (size_t i = 0; i < count; i++) {
+        ss << "  v += helper_" << i << "(v, id.x);\n";
+    }
+    ss << "  buffer[id.x] = v;\n";
+    ss << "}\n";
+    if (barrier_interval != 0) {
+        ss << "@compute @workgroup_size(64)\n";
+        ss << "fn sync(@builtin(local_invocation_index) index : u32) {\n";
+        ss << "  var v = vec4f();\n";
+        for (size_t i = 0; i < count; i += barrier_interval) {
+            ss << "  v += helper_" << i << "(v, 4u);\n";
+        }
+        ss << "  if (v.x > 0.0) {\n";
+        ss << "    buffer[index] = v;\n";
+        ss << "  }\n";
+        ss << "  workgroupBarrier();\n";
+        ss << "}\n";
+    }
+    return ss.str();
+}
+
+/// Benchmarks the uniformity analysis of a shader in which every `state.range(0)`th helper is
+/// called before a barrier, or none of them if `state.range(0)` is 0. The `nodes` and
+/// `uniformity_ns` counters are the number of nodes built and the time taken by the analysis in
+/// the last iteration, which drop as fewer functions need to be analyzed.
+void ResolveUniformity(benchmark::State& state) {
+    Source::File file("barriers.wgsl",
+                      GenerateBarrierHelpers(512, static_cast<size_t>(state.range(0))));
+    Instrumentation instrumentation;
+    Instrumentation::Scope scope(instrumentation);
+    for (auto _ : state) {
+        state.PauseTiming();
+        wgsl::reader::Parser parser(&file);
+        parser.Parse();
+        instrumentation.Clear();
+        state.ResumeTiming();
+
+        auto program = Resolve(parser.builder());
+        if (!program.IsValid()) {
+            state.SkipWithError(program.Diagnostics().str());
+        }
+    }
+
+    for (auto& phase : instrumentation.Phases()) {
+        if (std::string(phase.name) == "wgsl.uniformity") {
+            state.counters["nodes"] = static_cast<double>(phase.nodes);
+            state.counters["uniformity_ns"] = static_cast<double>(phase.duration.count());
+        }
+    }
+}
+
+BENCHMARK(ResolveUniformity)->Arg(0)->Arg(64)->Arg(8)->Arg(1);
+
+/// @returns a shader with `count` functions that each make many builtin, operator, constructor and
+/// conversion calls with the same few argument types, as is typical of math-heavy shaders.
+std::string GenerateBuiltinCalls(size_t count) {
+    StringStream ss;
+    for (size_t i = 0; i < count; i++) {
+        ss << "fn shade_" << i << "(n : vec3f, l : vec3f, v : vec3f, r : f32) -> vec4f {\n";
+        ss << "  let h = normalize(l + v);\n";
+        ss << "  let n_dot_l = clamp(dot(n, l), 0.0, 1.0);\n";
+        ss << "  let n_dot_h = clamp(dot(n, h), 0.0, 1.0);\n";
+        ss << "  let a = r * r;\n";
+        ss << "  let d = n_dot_h * n_dot_h * (a * a - 1.0) + 1.0;\n";
+        ss << "  let spec = (a * a) / max(3.14159 * d * d, 0.0001);\n";
+        ss << "  let fresnel = mix(vec3f(0.04), vec3f(1.0), pow(1.0 - n_dot_l, 5.0));\n";
+        ss << "  let refl = reflect(-l, n);\n";
+        ss << "  let fog = exp(-length(v) * 0.1) + abs(sin(r)) * cos(r);\n";
+        ss << "  let q = vec3i(floor(refl * 16.0));\n";
+        ss << "  let s = f32(q.x ^ q.y) + f32(u32(q.z) >> 2u);\n";
+        ss << "  return vec4f(fresnel * spec * n_dot_l + vec3f(fog, s, 1.0), min(a, 1.0));\n";
+        ss << "}\n";
+    }
+    return ss.str();
+}
+
+/// Benchmarks the resolver on a shader dominated by calls to builtins and operators.
+void ResolveBuiltins(benchmark::State& state) {
+    Source::File file("builtins.wgsl", GenerateBuiltinCalls(static_cast<size_t>(state.range(0))));
+    for (auto _ : state) {
+        state.PauseTiming();
+        wgsl::reader::Parser parser(&file);
+        parser.Parse();
+        state.ResumeTiming();
+
+        auto program = Resolve(parser.builder());
+        if (!program.IsValid()) {
+            state.SkipWithError(program.Diagnostics().str());
+        }
+    }
+}
+
+BENCHMARK(ResolveBuiltins)->Arg(64)->Arg(512);
+
+}  // namespace
+}  // namespace tint::resolver
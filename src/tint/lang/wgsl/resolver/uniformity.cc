@@ -27,11 +27,18 @@
 
 #include "tint/lang/wgsl/resolver/uniformity.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <queue>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/core/builtin_value.h"
 #include "tint/lang/wgsl/program/program_builder.h"
 #include "tint/lang/wgsl/resolver/dependency_graph.h"
@@ -49,6 +56,8 @@
 #include "tint/lang/wgsl/sem/value_conversion.h"
 #include "tint/lang/wgsl/sem/variable.h"
 #include "tint/lang/wgsl/sem/while_statement.h"
+#include "tint/utils/containers/hashmap.h"
+#include "tint/utils/containers/hashset.h"
 #include "tint/utils/containers/map.h"
 #include "tint/utils/containers/scope_stack.h"
 #include "tint/utils/containers/unique_vector.h"
@@ -346,53 +355,46 @@ struct FunctionInfo {
     BlockAllocator<LoopSwitchInfo> loop_switch_info_allocator;
 };
 
+/// Map of function declaration to its uniformity information.
+using FunctionInfoMap = Hashmap<const ast::Function*, FunctionInfo, 8>;
+
 /// UniformityGraph is used to analyze the uniformity requirements and effects of functions in a
 /// module.
 class UniformityGraph {
   public:
     /// Constructor.
     /// @param builder the program to analyze
-    explicit UniformityGraph(ProgramBuilder& builder)
-        : b(builder), sem_(b.Sem()), diagnostics_(builder.Diagnostics()) {}
+    /// @param functions the uniformity information of each function in the module
+    /// @param diagnostics the list that diagnostics are added to
+    /// @param report_mutex the mutex held while reporting a uniformity issue, as reporting an issue
+    /// traverses the graphs of called functions, which may be shared with other threads
+    UniformityGraph(const ProgramBuilder& builder,
+                    FunctionInfoMap& functions,
+                    diag::List& diagnostics,
+                    std::mutex& report_mutex)
+        : b(builder),
+          sem_(b.Sem()),
+          diagnostics_(diagnostics),
+          report_mutex_(report_mutex),
+          functions_(functions) {}
 
     /// Destructor.
     ~UniformityGraph() {}
 
-    /// Build and analyze the graph to determine whether the program satisfies the uniformity
-    /// constraints of WGSL.
-    /// @param dependency_graph the dependency-ordered module-scope declarations
-    /// @returns true if all uniformity constraints are satisfied, otherise false
-    bool Build(const DependencyGraph& dependency_graph) {
-#if TINT_DUMP_UNIFORMITY_GRAPH
-        std::cout << "digraph G {\n";
-        std::cout << "rankdir=BT\n";
-#endif
-
-        // Process all functions in the module.
-        bool success = true;
-        for (auto* decl : dependency_graph.ordered_globals) {
-            if (auto* func = decl->As<ast::Function>()) {
-                if (!ProcessFunction(func)) {
-                    success = false;
-                    break;
-                }
-            }
-        }
-
-#if TINT_DUMP_UNIFORMITY_GRAPH
-        std::cout << "\n}\n";
-#endif
-
-        return success;
-    }
+    /// Build and analyze the graph of a function to determine whether it satisfies the uniformity
+    /// constraints of WGSL. The functions called by `func` must have already been analyzed.
+    /// @param func the function to analyze
+    /// @returns true if all uniformity constraints are satisfied, otherwise false
+    bool Analyze(const ast::Function* func) { return ProcessFunction(func); }
 
   private:
     const ProgramBuilder& b;
     const sem::Info& sem_;
     diag::List& diagnostics_;
+    std::mutex& report_mutex_;
 
-    /// Map of analyzed function results.
-    Hashmap<const ast::Function*, FunctionInfo, 8> functions_;
+    /// Map of function results.
+    FunctionInfoMap& functions_;
 
     /// The function currently being analyzed.
     FunctionInfo* current_function_;
@@ -431,7 +433,8 @@ class UniformityGraph {
     /// @param func the function to process
     /// @returns true if there are no uniformity issues, false otherwise
     bool ProcessFunction(const ast::Function* func) {
-        current_function_ = functions_.Add(func, FunctionInfo(func, b)).value;
+        current_function_ = functions_.Find(func);
+        TINT_ASSERT(current_function_ != nullptr);
 
         // Process function body.
         if (func->body) {
@@ -476,6 +479,7 @@ class UniformityGraph {
             auto traverse = [&](wgsl::DiagnosticSeverity severity) {
                 Traverse(current_function_->RequiredToBeUniform(severity), &reachable);
                 if (reachable.Contains(current_function_->may_be_non_uniform)) {
+                    std::lock_guard<std::mutex> lock(report_mutex_);
                     MakeError(*current_function_, current_function_->may_be_non_uniform, severity);
                     return false;
                 }
@@ -1975,11 +1979,246 @@ class UniformityGraph {
     }
 };
 
+/// @returns true if a call to @p builtin may be required to be uniform.
+bool MayRequireUniformity(const sem::BuiltinFn* builtin) {
+    switch (builtin->Fn()) {
+        case wgsl::BuiltinFn::kWorkgroupUniformLoad:
+        case wgsl::BuiltinFn::kTextureSample:
+        case wgsl::BuiltinFn::kTextureSampleBias:
+        case wgsl::BuiltinFn::kTextureSampleCompare:
+            return true;
+        default:
+            return builtin->IsBarrier() || builtin->IsDerivative();
+    }
+}
+
+/// Collects the functions whose uniformity needs to be analyzed.
+/// Only a function that may (transitively) call a builtin that is required to be uniform can raise
+/// a uniformity issue. The uniformity effects of the functions that it calls are needed to analyze
+/// it, but the effects of all the other functions are never used, so their graphs are not built.
+/// @param builder the program to analyze
+/// @param dependency_graph the dependency-ordered module-scope declarations
+/// @returns the functions to analyze, in dependency order
+Vector<const ast::Function*, 64> FunctionsToAnalyze(const ProgramBuilder& builder,
+                                                    const DependencyGraph& dependency_graph) {
+    Vector<const sem::Function*, 64> functions;
+    Hashset<const sem::Function*, 64> requires_uniformity;
+    for (auto* decl : dependency_graph.ordered_globals) {
+        auto* decl_func = decl->As<ast::Function>();
+        if (!decl_func) {
+            continue;
+        }
+        auto* func = builder.Sem().Get(decl_func);
+        functions.Push(func);
+
+        // Callees precede their callers, so the callees have already been visited.
+        bool may_require = false;
+        for (auto* builtin : func->DirectlyCalledBuiltins()) {
+            if (MayRequireUniformity(builtin)) {
+                may_require = true;
+                break;
+            }
+        }
+        if (!may_require) {
+            for (auto* call : func->DirectCalls()) {
+                auto* target = call->Target()->As<sem::Function>();
+                if (target && requires_uniformity.Contains(target)) {
+                    may_require = true;
+                    break;
+                }
+            }
+        }
+        if (may_require) {
+            requires_uniformity.Add(func);
+        }
+    }
+
+    // Walk the functions in reverse dependency order, so that callers are visited before their
+    // callees, and mark the functions called by a function that needs to be analyzed.
+    Hashset<const sem::Function*, 64> needed;
+    for (size_t i = functions.Length(); i > 0; i--) {
+        auto* func = functions[i - 1];
+        if (!requires_uniformity.Contains(func) && !needed.Contains(func)) {
+            continue;
+        }
+        needed.Add(func);
+        for (auto* call : func->DirectCalls()) {
+            if (auto* target = call->Target()->As<sem::Function>()) {
+                needed.Add(target);
+            }
+        }
+    }
+
+    Vector<const ast::Function*, 64> result;
+    for (auto* func : functions) {
+        if (needed.Contains(func)) {
+            result.Push(func->Declaration());
+        }
+    }
+    return result;
+}
+
+/// The minimum number of functions per thread for the analysis to run concurrently. Below this
+/// the cost of starting the threads outweighs the gains.
+constexpr size_t kMinFunctionsPerThread = 16;
+
+/// Analyzes the functions in order, stopping at the first function with a uniformity error.
+/// @returns the index of the first function with a uniformity error, or `functions.Length()`.
+size_t AnalyzeSequentially(ProgramBuilder& builder,
+                           VectorRef<const ast::Function*> functions,
+                           FunctionInfoMap& infos) {
+    std::mutex report_mutex;
+    UniformityGraph graph(builder, infos, builder.Diagnostics(), report_mutex);
+    for (size_t i = 0; i < functions.Length(); i++) {
+        if (!graph.Analyze(functions[i])) {
+            return i;
+        }
+    }
+    return functions.Length();
+}
+
+/// Analyzes the functions using `num_threads` threads. A function is analyzed once all of the
+/// functions that it calls have been analyzed, so functions that do not depend on each other are
+/// analyzed concurrently.
+/// The diagnostics of each function are collected separately and then added in order, up to and
+/// including the first function with a uniformity error, so that the result is identical to
+/// AnalyzeSequentially().
+/// @returns the index of the first function with a uniformity error, or `functions.Length()`.
+size_t AnalyzeConcurrently(ProgramBuilder& builder,
+                           VectorRef<const ast::Function*> functions,
+                           FunctionInfoMap& infos,
+                           size_t num_threads) {
+    struct Task {
+        /// The indices of the functions that call this function
+        Vector<size_t, 4> callers;
+        /// The number of functions called by this function that have not been analyzed yet
+        size_t num_pending_callees = 0;
+        /// The diagnostics raised by the analysis of the function
+        diag::List diagnostics;
+    };
+
+    const size_t num_functions = functions.Length();
+    Hashmap<const ast::Function*, size_t, 64> indices;
+    for (size_t i = 0; i < num_functions; i++) {
+        indices.Add(functions[i], i);
+    }
+
+    std::vector<Task> tasks(num_functions);
+    for (size_t i = 0; i < num_functions; i++) {
+        Hashset<size_t, 8> callees;
+        for (auto* call : builder.Sem().Get(functions[i])->DirectCalls()) {
+            if (auto* target = call->Target()->As<sem::Function>()) {
+                auto callee = indices.Get(target->Declaration());
+                TINT_ASSERT(callee && *callee < i);
+                if (callees.Add(*callee)) {
+                    tasks[*callee].callers.Push(i);
+                    tasks[i].num_pending_callees++;
+                }
+            }
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    // Ready functions are analyzed in declaration order, so that a uniformity error is found as
+    // early as possible.
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+    size_t num_remaining = num_functions;
+    size_t first_failure = num_functions;
+    for (size_t i = 0; i < num_functions; i++) {
+        if (tasks[i].num_pending_callees == 0) {
+            ready.push(i);
+        }
+    }
+
+    std::mutex report_mutex;
+    auto worker = [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cv.wait(lock, [&] { return !ready.empty() || num_remaining == 0; });
+            if (ready.empty()) {
+                return;
+            }
+            size_t index = ready.top();
+            ready.pop();
+
+            // Functions declared after a function with an error are not analyzed, as
+            // their diagnostics are discarded. This includes all the callers of that function.
+            bool analyze = index < first_failure;
+            bool ok = true;
+            if (analyze) {
+                lock.unlock();
+                UniformityGraph graph(builder, infos, tasks[index].diagnostics, report_mutex);
+                ok = graph.Analyze(functions[index]);
+                lock.lock();
+            }
+
+            if (!ok) {
+                first_failure = std::min(first_failure, index);
+            }
+            for (size_t caller : tasks[index].callers) {
+                if (--tasks[caller].num_pending_callees == 0) {
+                    ready.push(caller);
+                }
+            }
+            num_remaining--;
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_threads; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < num_functions && i <= first_failure; i++) {
+        builder.Diagnostics().add(tasks[i].diagnostics);
+    }
+    return first_failure;
+}
+
 }  // namespace
 
-bool AnalyzeUniformity(ProgramBuilder& builder, const DependencyGraph& dependency_graph) {
-    UniformityGraph graph(builder);
-    return graph.Build(dependency_graph);
+bool AnalyzeUniformity(ProgramBuilder& builder,
+                       const DependencyGraph& dependency_graph,
+                       size_t max_threads) {
+    Instrumentation::PhaseScope phase("wgsl.uniformity");
+
+    // Create the information for every analyzed function up front, so that the map is not
+    // modified while functions are being analyzed.
+    auto functions = FunctionsToAnalyze(builder, dependency_graph);
+    FunctionInfoMap infos;
+    for (auto* func : functions) {
+        infos.Add(func, FunctionInfo(func, builder));
+    }
+
+#if TINT_DUMP_UNIFORMITY_GRAPH
+    // The graphs are dumped as the functions are analyzed, so keep them in order.
+    max_threads = 1;
+    std::cout << "digraph G {\n";
+    std::cout << "rankdir=BT\n";
+#endif
+
+    size_t num_threads = std::min(max_threads, functions.Length() / kMinFunctionsPerThread);
+    size_t first_failure = num_threads > 1
+                               ? AnalyzeConcurrently(builder, functions, infos, num_threads)
+                               : AnalyzeSequentially(builder, functions, infos);
+
+#if TINT_DUMP_UNIFORMITY_GRAPH
+    std::cout << "\n}\n";
+#endif
+
+    size_t num_nodes = 0;
+    for (auto it : infos) {
+        num_nodes += it.value.nodes.Count();
+    }
+    phase.SetNodeCount(num_nodes);
+
+    return first_failure == functions.Length();
 }
 
 }  // namespace tint::resolver
@@ -28,6 +28,8 @@
 #ifndef SRC_TINT_LANG_WGSL_RESOLVER_UNIFORMITY_H_
 #define SRC_TINT_LANG_WGSL_RESOLVER_UNIFORMITY_H_
 
+#include <cstddef>
+
 // Forward declarations.
 namespace tint::resolver {
 struct DependencyGraph;
@@ -44,8 +46,11 @@ constexpr bool kUniformityFailuresAsError = true;
 /// Analyze the uniformity of a program.
 /// @param builder the program to analyze
 /// @param dependency_graph the dependency-ordered module-scope declarations
+/// @param max_threads the maximum number of threads used to analyze functions concurrently
 /// @returns true if there are no uniformity issues, false otherwise
-bool AnalyzeUniformity(ProgramBuilder& builder, const resolver::DependencyGraph& dependency_graph);
+bool AnalyzeUniformity(ProgramBuilder& builder,
+                       const resolver::DependencyGraph& dependency_graph,
+                       size_t max_threads = 1);
 
 }  // namespace tint::resolver
 
@@ -27,11 +27,13 @@
 
 // GEN_BUILD:CONDITION(tint_build_wgsl_reader)
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
 
+#include "tint/api/common/instrumentation.h"
 #include "tint/lang/wgsl/program/program_builder.h"
 #include "tint/lang/wgsl/reader/reader.h"
 #include "tint/lang/wgsl/resolver/resolve.h"
@@ -9374,5 +9376,283 @@ test:11:7 note: reading from read_write storage buffer 'non_uniform' may result
 )");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Tests for the concurrent analysis of functions.
+////////////////////////////////////////////////////////////////////////////////
+
+class UniformityAnalysisConcurrencyTest : public UniformityAnalysisTestBase,
+                                          public ::testing::Test {
+  protected:
+    /// Generates a shader with `count` groups of functions, which is large enough for the analysis
+    /// to use multiple threads. Each group has a helper function that is called by two other
+    /// functions, which are both called by the entry point.
+    /// @param stage the entry point stage attribute
+    /// @param helper a function that returns the attributes and body of the helper of a group
+    /// @returns the WGSL source
+    std::string Generate(std::string stage,
+                         size_t count,
+                         std::function<std::string(size_t)> helper) {
+        StringStream ss;
+        ss << "@group(0) @binding(0) var<storage, read_write> non_uniform : i32;\n";
+        for (size_t i = 0; i < count; i++) {
+            ss << helper(i) << "\n";
+            ss << "fn a_" << i << "(v : i32) -> i32 { return helper_" << i << "(v) + 1; }\n";
+            ss << "fn b_" << i << "(v : i32) -> i32 { return helper_" << i << "(v) * 2; }\n";
+        }
+        ss << stage << " fn main() {\n";
+        ss << "  var x = 0;\n";
+        for (size_t i = 0; i < count; i++) {
+            ss << "  x += a_" << i << "(x) + b_" << i << "(x);\n";
+        }
+        ss << "}\n";
+        return ss.str();
+    }
+
+    /// Resolves a WGSL shader using multiple threads, and checks that the diagnostics match those
+    /// produced by resolving it on a single thread.
+    /// @param src the WGSL source code
+    /// @param should_pass true if `src` should pass the analysis, otherwise false
+    void RunConcurrentTest(std::string src, bool should_pass) {
+        auto file = std::make_unique<Source::File>("test", src);
+        Options options;
+        options.max_threads = 4;
+        auto program = wgsl::reader::Parse(file.get(), options);
+        auto expected = wgsl::reader::Parse(file.get());
+        EXPECT_EQ(program.Diagnostics().str(), expected.Diagnostics().str());
+        RunTest(std::move(program), should_pass);
+    }
+
+    /// @returns the number of times that `substr` appears in `str`
+    size_t Count(const std::string& str, const std::string& substr) {
+        size_t count = 0;
+        for (auto pos = str.find(substr); pos != std::string::npos;
+             pos = str.find(substr, pos + 1)) {
+            count++;
+        }
+        return count;
+    }
+};
+
+TEST_F(UniformityAnalysisConcurrencyTest, Pass) {
+    auto src = Generate("@compute @workgroup_size(64)", 32, [](size_t i) {
+        StringStream ss;
+        ss << "fn helper_" << i << "(v : i32) -> i32 {\n";
+        ss << "  if (v == " << i << ") {\n";
+        ss << "    workgroupBarrier();\n";
+        ss << "  }\n";
+        ss << "  return v;\n";
+        ss << "}";
+        return ss.str();
+    });
+
+    RunConcurrentTest(src, true);
+}
+
+TEST_F(UniformityAnalysisConcurrencyTest, FirstErrorIsReported) {
+    // Both helper_5 and helper_20 have uniformity errors. Only the error in the function that is
+    // declared first is reported, as with a sequential analysis.
+    auto src = Generate("@compute @workgroup_size(64)", 32, [](size_t i) {
+        StringStream ss;
+        ss << "fn helper_" << i << "(v : i32) -> i32 {\n";
+        if (i == 5 || i == 20) {
+            ss << "  if (non_uniform == " << i << ") {\n";
+        } else {
+            ss << "  if (v == " << i << ") {\n";
+        }
+        ss << "    workgroupBarrier();\n";
+        ss << "  }\n";
+        ss << "  return v;\n";
+        ss << "}";
+        return ss.str();
+    });
+
+    RunConcurrentTest(src, false);
+    EXPECT_EQ(Count(error_, "error:"), 1u) << error_;
+    EXPECT_NE(error_.find("if (non_uniform == 5)"), std::string::npos) << error_;
+    EXPECT_EQ(error_.find("if (non_uniform == 20)"), std::string::npos) << error_;
+}
+
+TEST_F(UniformityAnalysisConcurrencyTest, WarningsAreReportedInOrder) {
+    auto src = Generate("@fragment", 32, [](size_t i) {
+        StringStream ss;
+        ss << "fn helper_" << i << "(v : i32) -> i32 {\n";
+        ss << "  if (non_uniform == " << i << ") {\n";
+        ss << "    _ = dpdx(1.0);\n";
+        ss << "  }\n";
+        ss << "  return v;\n";
+        ss << "}";
+        return ss.str();
+    });
+
+    // Make the uniformity violations warnings, so that the analysis does not stop at the first one.
+    RunConcurrentTest("diagnostic(warning, derivative_uniformity);\n" + src, true);
+    EXPECT_EQ(Count(error_, "warning:"), 32u) << error_;
+    auto first = error_.find("if (non_uniform == 0)");
+    auto last = error_.find("if (non_uniform == 31)");
+    ASSERT_NE(first, std::string::npos) << error_;
+    ASSERT_NE(last, std::string::npos) << error_;
+    EXPECT_LT(first, last);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Tests for the functions that the analysis skips.
+////////////////////////////////////////////////////////////////////////////////
+
+class UniformityAnalysisSkipTest : public UniformityAnalysisTestBase, public ::testing::Test {
+  protected:
+    /// Resolves a WGSL shader, and returns the number of nodes built by the uniformity analysis.
+    /// @param src the WGSL source code
+    /// @param should_pass true if `src` should pass the analysis, otherwise false
+    /// @returns the node count of the uniformity analysis phase
+    size_t RunTestAndCountNodes(std::string src, bool should_pass) {
+        Instrumentation instrumentation;
+        {
+            Instrumentation::Scope scope(instrumentation);
+            RunTest(std::move(src), should_pass);
+        }
+        for (auto& phase : instrumentation.Phases()) {
+            if (std::string(phase.name) == "wgsl.uniformity") {
+                return phase.nodes;
+            }
+        }
+        ADD_FAILURE() << "uniformity analysis did not run";
+        return 0;
+    }
+};
+
+TEST_F(UniformityAnalysisSkipTest, NoUniformityRequirements) {
+    // No function calls a builtin that is required to be uniform, so no graph is built.
+    std::string src = R"(
+@group(0) @binding(0) var<storage, read_write> non_uniform : i32;
+
+fn helper(p : ptr<function, i32>) -> i32 {
+  if (non_uniform == 0) {
+    *p = non_uniform;
+  }
+  return *p;
+}
+
+@compute @workgroup_size(64)
+fn main() {
+  var v = 0;
+  if (helper(&v) == 0) {
+    non_uniform = v;
+  }
+}
+)";
+
+    EXPECT_EQ(RunTestAndCountNodes(src, true), 0u);
+}
+
+TEST_F(UniformityAnalysisSkipTest, UnrelatedFunctionsAreSkipped) {
+    std::string unrelated = R"(
+fn unrelated(v : i32) -> i32 {
+  var x = v;
+  for (var i = 0; i < v; i++) {
+    if (non_uniform == i) {
+      x += non_uniform;
+    }
+  }
+  return x;
+}
+)";
+    std::string src = R"(
+@group(0) @binding(0) var<storage, read_write> non_uniform : i32;
+
+fn foo(v : i32) {
+  if (v == 0) {
+    workgroupBarrier();
+  }
+}
+
+@compute @workgroup_size(64)
+fn main() {
+  foo(0);
+}
+)";
+
+    auto nodes = RunTestAndCountNodes(src, true);
+    EXPECT_NE(nodes, 0u);
+    EXPECT_EQ(RunTestAndCountNodes(src + unrelated, true), nodes);
+}
+
+TEST_F(UniformityAnalysisSkipTest, CalleeWithoutRequirementsIsAnalyzed) {
+    // `helper` does not require uniformity itself, but its effect on the pointer parameter is
+    // needed to analyze `main`.
+    std::string src = R"(
+@group(0) @binding(0) var<storage, read_write> non_uniform : i32;
+
+fn helper(p : ptr<function, i32>) {
+  *p = non_uniform;
+}
+
+@compute @workgroup_size(64)
+fn main() {
+  var v = 0;
+  helper(&v);
+  if (v == 0) {
+    workgroupBarrier();
+  }
+}
+)";
+
+    RunTest(src, false);
+    EXPECT_EQ(error_,
+              R"(test:13:5 error: 'workgroupBarrier' must only be called from uniform control flow
+    workgroupBarrier();
+    ^^^^^^^^^^^^^^^^
+
+test:12:3 note: control flow depends on possibly non-uniform value
+  if (v == 0) {
+  ^^
+
+test:11:10 note: contents of pointer may become non-uniform after calling 'helper'
+  helper(&v);
+         ^
+)");
+}
+
+TEST_F(UniformityAnalysisSkipTest, CallerOfRequiringFunctionIsAnalyzed) {
+    // `main` does not call a builtin that requires uniformity directly, but it calls a function
+    // that does.
+    std::string src = R"(
+@group(0) @binding(0) var<storage, read_write> non_uniform : i32;
+
+fn foo() {
+  workgroupBarrier();
+}
+
+fn bar() {
+  foo();
+}
+
+@compute @workgroup_size(64)
+fn main() {
+  if (non_uniform == 0) {
+    bar();
+  }
+}
+)";
+
+    RunTest(src, false);
+    EXPECT_EQ(error_,
+              R"(test:5:3 error: 'workgroupBarrier' must only be called from uniform control flow
+  workgroupBarrier();
+  ^^^^^^^^^^^^^^^^
+
+test:15:5 note: called indirectly by 'bar' from 'main'
+    bar();
+    ^^^
+
+test:14:3 note: control flow depends on possibly non-uniform value
+  if (non_uniform == 0) {
+  ^^
+
+test:14:7 note: reading from read_write storage buffer 'non_uniform' may result in a non-uniform value
+  if (non_uniform == 0) {
+      ^^^^^^^^^^^
+)");
+}
+
 }  // namespace
 }  // namespace tint::resolver
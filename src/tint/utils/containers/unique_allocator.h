@@ -89,6 +89,12 @@ class UniqueAllocator {
     /// @param o the immutable UniqueAlllocator to extend
     void Wrap(const UniqueAllocator<T, HASH, EQUAL>& o) { items = o.items; }
 
+    /// Destructs all the objects, but retains the allocator's memory for reuse.
+    void Clear() {
+        items.clear();
+        allocator.Clear();
+    }
+
     /// @returns an iterator to the beginning of the types
     Iterator begin() const { return allocator.Objects().begin(); }
     /// @returns an iterator to the end of the types
@@ -39,10 +39,11 @@
 # Kind:      lib
 ################################################################################
 tint_add_target(tint_utils_memory lib
+  utils/memory/allocation_stats.cc
+  utils/memory/allocation_stats.h
   utils/memory/bitcast.h
   utils/memory/block_allocator.h
   utils/memory/bump_allocator.h
-  utils/memory/memory.cc
 )
 
 tint_target_add_dependencies(tint_utils_memory lib
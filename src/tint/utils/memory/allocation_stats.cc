@@ -1,4 +1,4 @@
-// Copyright 2023 The Dawn & Tint Authors
+// Copyright 2024 The Dawn & Tint Authors
 //
 // Redistribution and use in source and binary forms, with or without
 // modification, are permitted provided that the following conditions are met:
@@ -25,9 +25,13 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-#if defined(__clang__)
-#pragma clang diagnostic ignored "-Wmissing-variable-declarations"
-#endif
+#include "tint/utils/memory/allocation_stats.h"
 
-// A placeholder symbol used to emit a symbol for this lib target.
-int tint_api_common_symbol = 1;
+namespace tint {
+
+AllocationStats& ThreadAllocationStats() {
+    thread_local AllocationStats stats;
+    return stats;
+}
+
+}  // namespace tint
@@ -0,0 +1,51 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_UTILS_MEMORY_ALLOCATION_STATS_H_
+#define SRC_TINT_UTILS_MEMORY_ALLOCATION_STATS_H_
+
+#include <cstddef>
+
+namespace tint {
+
+/// AllocationStats holds the number and size of the heap allocations made by the BlockAllocator
+/// and BumpAllocator on a single thread. The allocators only touch the heap when they need a new
+/// block, so the counters are updated once per block, not once per allocated object.
+struct AllocationStats {
+    /// The number of blocks allocated from the heap
+    size_t allocations = 0;
+    /// The total size in bytes of the blocks allocated from the heap
+    size_t bytes = 0;
+};
+
+/// @returns the allocation statistics of the calling thread. The counters are never reset, so
+/// callers interested in a span of work should take the difference of two snapshots.
+AllocationStats& ThreadAllocationStats();
+
+}  // namespace tint
+
+#endif  // SRC_TINT_UTILS_MEMORY_ALLOCATION_STATS_H_
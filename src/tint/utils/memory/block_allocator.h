@@ -33,6 +33,7 @@
 #include <utility>
 
 #include "tint/utils/math/math.h"
+#include "tint/utils/memory/allocation_stats.h"
 #include "tint/utils/memory/bitcast.h"
 
 namespace tint {
@@ -40,7 +41,7 @@ namespace tint {
 /// A container and allocator of objects of (or deriving from) the template type `T`.
 /// Objects are allocated by calling Create(), and are owned by the BlockAllocator.
 /// When the BlockAllocator is destructed, all constructed objects are automatically destructed and
-/// freed.
+/// freed. Clear() destructs the objects but keeps the memory, so that the allocator can be reused.
 ///
 /// Objects held by the BlockAllocator can be iterated over using a View.
 template <typename T, size_t BLOCK_SIZE = 64 * 1024, size_t BLOCK_ALIGNMENT = 16>
@@ -207,6 +208,19 @@ class BlockAllocator {
         return ptr;
     }
 
+    /// Destructs all the objects owned by the allocator, but retains the allocated blocks so that
+    /// their memory is reused by subsequent calls to Create(), instead of being returned to the
+    /// heap.
+    void Clear() {
+        for (auto ptr : Objects()) {
+            ptr->~T();
+        }
+        data.block.current = nullptr;
+        data.block.current_offset = BLOCK_SIZE;
+        data.pointers = {};
+        data.count = 0;
+    }
+
     /// Frees all allocations from the allocator.
     void Reset() {
         for (auto ptr : Objects()) {
@@ -240,19 +254,27 @@ class BlockAllocator {
 
         block.current_offset = tint::RoundUp(alignof(TYPE), block.current_offset);
         if (block.current_offset + sizeof(TYPE) > BLOCK_SIZE) {
-            // Allocate a new block from the heap
-            auto* prev_block = block.current;
-            block.current = new Block;
-            if (!block.current) {
-                return nullptr;  // out of memory
-            }
-            block.current->next = nullptr;
-            block.current_offset = 0;
-            if (prev_block) {
-                prev_block->next = block.current;
+            if (auto* next_block = block.current ? block.current->next : block.root) {
+                // Reuse a block retained by Clear()
+                block.current = next_block;
             } else {
-                block.root = block.current;
+                // Allocate a new block from the heap
+                auto* prev_block = block.current;
+                block.current = new Block;
+                if (!block.current) {
+                    return nullptr;  // out of memory
+                }
+                auto& stats = ThreadAllocationStats();
+                stats.allocations++;
+                stats.bytes += sizeof(Block);
+                block.current->next = nullptr;
+                if (prev_block) {
+                    prev_block->next = block.current;
+                } else {
+                    block.root = block.current;
+                }
             }
+            block.current_offset = 0;
         }
 
         auto* base = &block.current->data[0];
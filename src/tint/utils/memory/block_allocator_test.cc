@@ -93,6 +93,46 @@ TEST_F(BlockAllocatorTest, ObjectLifetime) {
     EXPECT_EQ(count, 0u);
 }
 
+TEST_F(BlockAllocatorTest, Clear) {
+    using Allocator = BlockAllocator<LifetimeCounter>;
+
+    size_t count = 0;
+    Allocator allocator;
+    for (size_t i = 0; i < 10000; i++) {
+        allocator.Create(&count);
+    }
+    EXPECT_EQ(count, 10000u);
+
+    allocator.Clear();
+    EXPECT_EQ(count, 0u);
+    EXPECT_EQ(allocator.Count(), 0u);
+    EXPECT_EQ(allocator.Objects().begin(), allocator.Objects().end());
+
+    // Creating the same number of objects again reuses the retained blocks.
+    auto before = ThreadAllocationStats();
+    for (size_t i = 0; i < 10000; i++) {
+        allocator.Create(&count);
+    }
+    auto after = ThreadAllocationStats();
+    EXPECT_EQ(after.allocations, before.allocations);
+    EXPECT_EQ(count, 10000u);
+    EXPECT_EQ(allocator.Count(), 10000u);
+
+    // Creating more objects than before allocates new blocks.
+    for (size_t i = 0; i < 10000; i++) {
+        allocator.Create(&count);
+    }
+    EXPECT_GT(ThreadAllocationStats().allocations, after.allocations);
+    EXPECT_EQ(count, 20000u);
+
+    size_t n = 0;
+    for (auto* obj : allocator.Objects()) {
+        EXPECT_EQ(obj->count_, &count);
+        n++;
+    }
+    EXPECT_EQ(n, 20000u);
+}
+
 TEST_F(BlockAllocatorTest, MoveConstruct) {
     using Allocator = BlockAllocator<LifetimeCounter>;
 
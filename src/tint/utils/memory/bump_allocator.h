@@ -36,6 +36,7 @@
 
 #include "tint/utils/macros/compiler.h"
 #include "tint/utils/math/math.h"
+#include "tint/utils/memory/allocation_stats.h"
 #include "tint/utils/memory/bitcast.h"
 
 namespace tint {
@@ -47,6 +48,8 @@ class BumpAllocator {
     /// Blocks are allocated out of heap memory.
     struct BlockHeader {
         BlockHeader* next;
+        /// The size of the block's data, excluding the header size
+        size_t data_size;
     };
 
   public:
@@ -84,22 +87,32 @@ class BumpAllocator {
             return nullptr;  // integer overflow
         }
         if (data.current_offset + size_in_bytes > data.current_data_size) {
-            // Allocate a new block from the heap
             auto* prev_block = data.current;
-            size_t data_size = std::max(size_in_bytes, kDefaultBlockDataSize);
-            data.current = Bitcast<BlockHeader*>(new (std::nothrow)
-                                                     std::byte[sizeof(BlockHeader) + data_size]);
-            if (TINT_UNLIKELY(!data.current)) {
-                return nullptr;  // out of memory
-            }
-            data.current->next = nullptr;
-            data.current_data_size = data_size;
-            data.current_offset = 0;
-            if (prev_block) {
-                prev_block->next = data.current;
+            auto* next_block = prev_block ? prev_block->next : data.root;
+            if (next_block && next_block->data_size >= size_in_bytes) {
+                // Reuse a block retained by Clear()
+                data.current = next_block;
             } else {
-                data.root = data.current;
+                // Allocate a new block from the heap, and insert it before any retained blocks
+                size_t data_size = std::max(size_in_bytes, kDefaultBlockDataSize);
+                data.current = Bitcast<BlockHeader*>(
+                    new (std::nothrow) std::byte[sizeof(BlockHeader) + data_size]);
+                if (TINT_UNLIKELY(!data.current)) {
+                    return nullptr;  // out of memory
+                }
+                auto& stats = ThreadAllocationStats();
+                stats.allocations++;
+                stats.bytes += sizeof(BlockHeader) + data_size;
+                data.current->next = next_block;
+                data.current->data_size = data_size;
+                if (prev_block) {
+                    prev_block->next = data.current;
+                } else {
+                    data.root = data.current;
+                }
             }
+            data.current_data_size = data.current->data_size;
+            data.current_offset = 0;
         }
 
         auto* base = Bitcast<std::byte*>(data.current) + sizeof(BlockHeader);
@@ -109,6 +122,15 @@ class BumpAllocator {
         return ptr;
     }
 
+    /// Discards all allocations from the allocator, but retains the allocated blocks so that their
+    /// memory is reused by subsequent calls to Allocate(), instead of being returned to the heap.
+    void Clear() {
+        data.current = nullptr;
+        data.current_offset = 0;
+        data.current_data_size = 0;
+        data.count = 0;
+    }
+
     /// Frees all allocations from the allocator.
     void Reset() {
         auto* block = data.root;
@@ -70,6 +70,44 @@ TEST_F(BumpAllocatorTest, Count) {
     }
 }
 
+TEST_F(BumpAllocatorTest, ThreadAllocationStats) {
+    auto before = ThreadAllocationStats();
+    {
+        BumpAllocator allocator;
+        allocator.Allocate(5);
+        allocator.Allocate(5);
+        allocator.Allocate(BumpAllocator::kDefaultBlockDataSize * 2);
+    }
+    auto after = ThreadAllocationStats();
+    EXPECT_EQ(after.allocations - before.allocations, 2u);
+    EXPECT_GE(after.bytes - before.bytes, BumpAllocator::kDefaultBlockDataSize * 3);
+}
+
+TEST_F(BumpAllocatorTest, Clear) {
+    BumpAllocator allocator;
+    auto* small = allocator.Allocate(5);
+    allocator.Allocate(BumpAllocator::kDefaultBlockDataSize);
+    EXPECT_EQ(allocator.Count(), 2u);
+
+    allocator.Clear();
+    EXPECT_EQ(allocator.Count(), 0u);
+
+    // The retained blocks are reused in order.
+    auto before = ThreadAllocationStats();
+    EXPECT_EQ(allocator.Allocate(5), small);
+    allocator.Allocate(BumpAllocator::kDefaultBlockDataSize);
+    EXPECT_EQ(ThreadAllocationStats().allocations, before.allocations);
+
+    // An allocation larger than the next retained block allocates a new block.
+    allocator.Clear();
+    allocator.Allocate(BumpAllocator::kDefaultBlockDataSize * 2);
+    EXPECT_EQ(ThreadAllocationStats().allocations, before.allocations + 1);
+    allocator.Allocate(BumpAllocator::kDefaultBlockDataSize);
+    allocator.Allocate(BumpAllocator::kDefaultBlockDataSize);
+    EXPECT_EQ(ThreadAllocationStats().allocations, before.allocations + 1);
+    EXPECT_EQ(allocator.Count(), 3u);
+}
+
 TEST_F(BumpAllocatorTest, MoveConstruct) {
     for (size_t n : {0u, 1u, 10u, 16u, 20u, 32u, 50u, 64u, 100u, 256u, 300u, 512u, 500u, 512u}) {
         BumpAllocator allocator_a;
@@ -39,6 +39,13 @@ SymbolTable::~SymbolTable() = default;
 
 SymbolTable& SymbolTable::operator=(SymbolTable&&) = default;
 
+void SymbolTable::Clear() {
+    next_symbol_ = 1;
+    name_to_symbol_.Clear();
+    last_prefix_to_index_.Clear();
+    name_allocator_.Clear();
+}
+
 Symbol SymbolTable::Register(std::string_view name) {
     TINT_ASSERT(!name.empty());
 
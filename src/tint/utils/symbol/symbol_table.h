@@ -66,6 +66,10 @@ class SymbolTable {
         generation_id_ = o.generation_id_;
     }
 
+    /// Removes all the symbols from the table, but retains the memory used to hold their names so
+    /// that it can be reused. Symbols created before the call must not be used after it.
+    void Clear();
+
     /// Registers a name into the symbol table, returning the Symbol.
     /// @param name the name to register
     /// @returns the symbol representing the given name
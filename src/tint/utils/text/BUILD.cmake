@@ -57,6 +57,29 @@ tint_target_add_dependencies(tint_utils_text lib
   tint_utils_traits
 )
 
+################################################################################
+# Target:    tint_utils_text_bench
+# Kind:      bench
+################################################################################
+tint_add_target(tint_utils_text_bench bench
+  utils/text/string_stream_bench.cc
+)
+
+tint_target_add_dependencies(tint_utils_text_bench bench
+  tint_utils_containers
+  tint_utils_ice
+  tint_utils_macros
+  tint_utils_math
+  tint_utils_memory
+  tint_utils_rtti
+  tint_utils_text
+  tint_utils_traits
+)
+
+tint_target_add_external_dependencies(tint_utils_text_bench bench
+  "google-benchmark"
+)
+
 ################################################################################
 # Target:    tint_utils_text_test
 # Kind:      test
@@ -29,14 +29,96 @@
 
 namespace tint {
 
-StringStream::StringStream() {
-    sstream_.flags(sstream_.flags() | std::ios_base::showpoint | std::ios_base::fixed);
-    sstream_.imbue(std::locale::classic());
-    sstream_.precision(9);
+namespace {
+
+#if TINT_STRING_STREAM_FLOAT_TO_CHARS
+/// Formats `value` with the same output as StringStream::EmitFloat() on a std::stringstream.
+/// @param value the value to format
+/// @param chars the output buffer
+/// @param size the size of `chars`
+/// @returns the number of characters written
+template <typename T>
+size_t FormatFloatToChars(T value, char* chars, size_t size) {
+    // Try printing the float in fixed point, with a smallish limit on the precision
+    auto fixed = std::to_chars(chars, chars + size, static_cast<double>(value),
+                               std::chars_format::fixed, 20);
+    size_t len = static_cast<size_t>(fixed.ptr - chars);
+
+    // If this string can be parsed without loss of information, use it.
+    // As with std::stringstream, a value that cannot be parsed reads back as zero.
+    double roundtripped = 0;
+    if (std::from_chars(chars, chars + len, roundtripped).ec != std::errc{}) {
+        roundtripped = 0;
+    }
+
+    // Strip trailing zeros from the number.
+    auto float_equal_no_warning = std::equal_to<T>();
+    if (float_equal_no_warning(value, static_cast<T>(roundtripped))) {
+        while (len >= 2 && chars[len - 1] == '0' && chars[len - 2] != '.') {
+            len--;
+        }
+        return len;
+    }
+
+    // Resort to scientific, with the minimum precision needed to preserve the whole float
+    auto sci = std::to_chars(chars, chars + size, static_cast<double>(value),
+                             std::chars_format::general, std::numeric_limits<T>::max_digits10);
+    return static_cast<size_t>(sci.ptr - chars);
 }
+#endif
+
+}  // namespace
+
+StringStream::StringStream() = default;
 
 StringStream::~StringStream() = default;
 
+#if TINT_STRING_STREAM_FLOAT_TO_CHARS
+size_t StringStream::FormatFloat(float value, char* chars) {
+    return FormatFloatToChars(value, chars, kMaxFloatChars);
+}
+
+size_t StringStream::FormatFloat(double value, char* chars) {
+    return FormatFloatToChars(value, chars, kMaxFloatChars);
+}
+#endif
+
+StringStream& StringStream::operator<<(StdEndl manipulator) {
+    // call the function, and append anything it wrote
+    auto& formatter = Formatter();
+    manipulator(formatter);
+    SyncFromFormatter();
+    buffer_.append(formatter.str());
+    return *this;
+}
+
+StringStream& StringStream::operator<<(decltype(std::hex) manipulator) {
+    // call the function, and update the format state
+    manipulator(Formatter());
+    SyncFromFormatter();
+    return *this;
+}
+
+std::ostringstream& StringStream::Formatter() {
+    if (!formatter_) {
+        formatter_ = std::make_unique<std::ostringstream>();
+        formatter_->imbue(std::locale::classic());
+    }
+    formatter_->str(std::string{});
+    formatter_->flags(flags_);
+    formatter_->width(width_);
+    formatter_->precision(precision_);
+    formatter_->fill(fill_);
+    return *formatter_;
+}
+
+void StringStream::SyncFromFormatter() {
+    flags_ = formatter_->flags();
+    width_ = formatter_->width();
+    precision_ = formatter_->precision();
+    fill_ = formatter_->fill();
+}
+
 StringStream& operator<<(StringStream& out, CodePoint code_point) {
     if (code_point < 0x7f) {
         // See https://en.cppreference.com/w/cpp/language/escape
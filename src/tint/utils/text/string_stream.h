@@ -28,20 +28,39 @@
 #ifndef SRC_TINT_UTILS_TEXT_STRING_STREAM_H_
 #define SRC_TINT_UTILS_TEXT_STRING_STREAM_H_
 
+#include <charconv>
+#include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
+#include "tint/utils/macros/compiler.h"
 #include "tint/utils/text/unicode.h"
 
+// Floating point std::to_chars() and std::from_chars() are not available in all standard library
+// implementations. Where they are not, floats are formatted with std::stringstream instead.
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define TINT_STRING_STREAM_FLOAT_TO_CHARS 1
+#else
+#define TINT_STRING_STREAM_FLOAT_TO_CHARS 0
+#endif
+
 namespace tint {
 
-/// Stringstream wrapper which automatically resets the locale and sets floating point emission
-/// settings needed for Tint.
+/// StringStream is an append-only text buffer with a std::ostream-like interface.
+/// Strings, characters, integers and floats are formatted directly into the buffer. A
+/// std::ostringstream, imbued with the classic locale, is only used to format values when the
+/// stream has non-default format flags or a field width, and for types without a fast path. The
+/// output is identical to that of a std::stringstream that has the classic locale and the
+/// `showpoint` and `fixed` flags. Floats are emitted with the minimal precision that preserves the
+/// value, in fixed point where possible.
 class StringStream {
     using SetWRetTy = decltype(std::setw(std::declval<int>()));
     using SetPrecisionRetTy = decltype(std::setprecision(std::declval<int>()));
@@ -53,6 +72,12 @@ class StringStream {
                                       std::is_same_v<SetPrecisionRetTy, std::decay_t<T>> ||
                                       std::is_same_v<SetFillRetTy, std::decay_t<T>>;
 
+    /// Evaluates to true if `T` is a character type that std::ostream emits as a character.
+    template <typename T>
+    static constexpr bool IsCharType = std::is_same_v<T, char> ||
+                                       std::is_same_v<T, signed char> ||
+                                       std::is_same_v<T, unsigned char>;
+
   public:
     /// @see tint::traits::IsOStream
     static constexpr bool IsStreamWriter = true;
@@ -63,11 +88,14 @@ class StringStream {
     ~StringStream();
 
     /// @returns the format flags for the stream
-    std::ios_base::fmtflags flags() const { return sstream_.flags(); }
+    std::ios_base::fmtflags flags() const { return flags_; }
 
     /// @param flags the flags to set
     /// @returns the original format flags
-    std::ios_base::fmtflags flags(std::ios_base::fmtflags flags) { return sstream_.flags(flags); }
+    std::ios_base::fmtflags flags(std::ios_base::fmtflags flags) {
+        std::swap(flags_, flags);
+        return flags;
+    }
 
     /// Emit `value` to the stream
     /// @param value the value to emit
@@ -110,7 +138,34 @@ class StringStream {
     /// @returns a reference to this
     template <typename T>
     StringStream& EmitValue(T&& value) {
-        sstream_ << std::forward<T>(value);
+        using U = std::decay_t<T>;
+        if constexpr (std::is_convertible_v<U, std::string_view>) {
+            EmitString(value);
+        } else if constexpr (IsCharType<U>) {
+            if (TINT_LIKELY(width_ == 0)) {
+                buffer_.push_back(static_cast<char>(value));
+            } else {
+                EmitFormatted(value);
+            }
+        } else if constexpr (std::is_same_v<U, bool>) {
+            if (TINT_LIKELY(width_ == 0 && !(flags_ & std::ios_base::boolalpha))) {
+                buffer_.push_back(value ? '1' : '0');
+            } else {
+                EmitFormatted(value);
+            }
+        } else if constexpr (std::is_integral_v<U>) {
+            if (TINT_LIKELY(width_ == 0 && flags_ == kDefaultFlags)) {
+                // Format the promoted type, as std::ostream does for char16_t and char32_t.
+                auto promoted = +value;
+                char chars[std::numeric_limits<decltype(promoted)>::digits10 + 3];
+                auto res = std::to_chars(chars, chars + sizeof(chars), promoted);
+                buffer_.append(chars, res.ptr);
+            } else {
+                EmitFormatted(value);
+            }
+        } else {
+            EmitFormatted(value);
+        }
         return *this;
     }
 
@@ -119,6 +174,90 @@ class StringStream {
     /// @returns a reference to this
     template <typename T>
     StringStream& EmitFloat(const T& value) {
+#if TINT_STRING_STREAM_FLOAT_TO_CHARS
+        if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+            char chars[kMaxFloatChars];
+            EmitString(std::string_view(chars, FormatFloat(value, chars)));
+        } else {
+            EmitFloatWithStream(value);
+        }
+#else
+        EmitFloatWithStream(value);
+#endif
+        return *this;
+    }
+
+    /// Swaps streams
+    /// @param other stream to swap too
+    void swap(StringStream& other) {
+        std::swap(buffer_, other.buffer_);
+        std::swap(flags_, other.flags_);
+        std::swap(width_, other.width_);
+        std::swap(precision_, other.precision_);
+        std::swap(fill_, other.fill_);
+        std::swap(formatter_, other.formatter_);
+    }
+
+    /// repeat queues the character c to be written to the printer n times.
+    /// @param c the character to print `n` times
+    /// @param n the number of times to print character `c`
+    void repeat(char c, size_t n) {
+        if (n > 0 && width_ != 0) {
+            // Only the first character is padded to the field width.
+            EmitFormatted(c);
+            n--;
+        }
+        buffer_.append(n, c);
+    }
+
+    /// The callback to emit a `endl` to the stream
+    using StdEndl = std::ostream& (*)(std::ostream&);
+
+    /// @param manipulator the callback to emit too
+    /// @returns a reference to this
+    StringStream& operator<<(StdEndl manipulator);
+
+    /// @param manipulator the callback to emit too
+    /// @returns a reference to this
+    StringStream& operator<<(decltype(std::hex) manipulator);
+
+    /// @param value the value to emit
+    /// @returns a reference to this
+    template <typename T, typename std::enable_if_t<IsSetType<T>, int> = 0>
+    StringStream& operator<<(T&& value) {
+        // call the function, and return it's value
+        Formatter() << std::forward<T>(value);
+        SyncFromFormatter();
+        return *this;
+    }
+
+    /// @returns the current location in the output stream
+    uint32_t tellp() { return static_cast<uint32_t>(buffer_.size()); }
+
+    /// @returns the string contents of the stream
+    std::string str() const { return buffer_; }
+
+  private:
+    /// The format flags of a new stream
+    static constexpr std::ios_base::fmtflags kDefaultFlags =
+        std::ios_base::skipws | std::ios_base::dec | std::ios_base::showpoint |
+        std::ios_base::fixed;
+
+    /// The maximum number of characters emitted by FormatFloat(). FLT_MAX and DBL_MAX printed in
+    /// fixed point with 20 decimal places, plus sign, are the longest outputs.
+    static constexpr size_t kMaxFloatChars = std::numeric_limits<double>::max_exponent10 + 32;
+
+    /// Formats `value` into `chars`, which must hold at least kMaxFloatChars characters.
+    /// @returns the number of characters written
+    static size_t FormatFloat(float value, char* chars);
+    /// Formats `value` into `chars`, which must hold at least kMaxFloatChars characters.
+    /// @returns the number of characters written
+    static size_t FormatFloat(double value, char* chars);
+
+    /// Emits `value` using the same algorithm as EmitFloat(), formatting with std::stringstream.
+    /// @param value the value to emit
+    template <typename T>
+    void EmitFloatWithStream(const T& value) {
         // Try printing the float in fixed point, with a smallish limit on the precision
         std::stringstream fixed;
         fixed.flags(fixed.flags() | std::ios_base::showpoint | std::ios_base::fixed);
@@ -141,8 +280,8 @@ class StringStream {
                 str.pop_back();
             }
 
-            sstream_ << str;
-            return *this;
+            EmitString(str);
+            return;
         }
 
         // Resort to scientific, with the minimum precision needed to preserve the whole float
@@ -150,56 +289,42 @@ class StringStream {
         sci.imbue(std::locale::classic());
         sci.precision(std::numeric_limits<T>::max_digits10);
         sci << value;
-        sstream_ << sci.str();
-
-        return *this;
+        EmitString(sci.str());
     }
 
-    /// Swaps streams
-    /// @param other stream to swap too
-    void swap(StringStream& other) { sstream_.swap(other.sstream_); }
-
-    /// repeat queues the character c to be written to the printer n times.
-    /// @param c the character to print `n` times
-    /// @param n the number of times to print character `c`
-    void repeat(char c, size_t n) { std::fill_n(std::ostream_iterator<char>(sstream_), n, c); }
-
-    /// The callback to emit a `endl` to the stream
-    using StdEndl = std::ostream& (*)(std::ostream&);
-
-    /// @param manipulator the callback to emit too
-    /// @returns a reference to this
-    StringStream& operator<<(StdEndl manipulator) {
-        // call the function, and return it's value
-        manipulator(sstream_);
-        return *this;
-    }
-
-    /// @param manipulator the callback to emit too
-    /// @returns a reference to this
-    StringStream& operator<<(decltype(std::hex) manipulator) {
-        // call the function, and return it's value
-        manipulator(sstream_);
-        return *this;
+    /// Emits a string, padded to the field width if it is set.
+    /// @param str the string to emit
+    void EmitString(std::string_view str) {
+        if (TINT_LIKELY(width_ == 0)) {
+            buffer_.append(str);
+        } else {
+            EmitFormatted(str);
+        }
     }
 
+    /// Emits `value` using a std::ostringstream with the current format state.
     /// @param value the value to emit
-    /// @returns a reference to this
-    template <typename T, typename std::enable_if_t<IsSetType<T>, int> = 0>
-    StringStream& operator<<(T&& value) {
-        // call the function, and return it's value
-        sstream_ << std::forward<T>(value);
-        return *this;
+    template <typename T>
+    void EmitFormatted(const T& value) {
+        auto& formatter = Formatter();
+        formatter << value;
+        SyncFromFormatter();
+        buffer_.append(formatter.str());
     }
 
-    /// @returns the current location in the output stream
-    uint32_t tellp() { return static_cast<uint32_t>(sstream_.tellp()); }
+    /// @returns the std::ostringstream used for formatting, cleared and with the current format
+    /// state
+    std::ostringstream& Formatter();
 
-    /// @returns the string contents of the stream
-    std::string str() const { return sstream_.str(); }
+    /// Copies the format state of the formatter back to this stream
+    void SyncFromFormatter();
 
-  private:
-    std::stringstream sstream_;
+    std::string buffer_;
+    std::ios_base::fmtflags flags_ = kDefaultFlags;
+    std::streamsize width_ = 0;
+    std::streamsize precision_ = 9;
+    char fill_ = ' ';
+    std::unique_ptr<std::ostringstream> formatter_;
 };
 
 /// Writes the CodePoint to the stream.
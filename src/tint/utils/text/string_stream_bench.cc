@@ -0,0 +1,76 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "tint/utils/text/string_stream.h"
+
+namespace tint {
+namespace {
+
+void StringStreamStrings(::benchmark::State& state) {
+    const std::string name = "an_identifier";
+    for (auto _ : state) {
+        StringStream s;
+        for (int i = 0; i < 1000; i++) {
+            s << "let " << name << " = " << name << ";\n";
+        }
+        benchmark::DoNotOptimize(s.str());
+    }
+}
+
+BENCHMARK(StringStreamStrings);
+
+void StringStreamIntegers(::benchmark::State& state) {
+    for (auto _ : state) {
+        StringStream s;
+        for (int i = 0; i < 1000; i++) {
+            s << i << "u, " << -i << "i, ";
+        }
+        benchmark::DoNotOptimize(s.str());
+    }
+}
+
+BENCHMARK(StringStreamIntegers);
+
+void StringStreamFloats(::benchmark::State& state) {
+    for (auto _ : state) {
+        StringStream s;
+        for (int i = 0; i < 1000; i++) {
+            s << static_cast<float>(i) * 0.25f << "f, " << static_cast<float>(i) / 3.0f << "f, ";
+        }
+        benchmark::DoNotOptimize(s.str());
+    }
+}
+
+BENCHMARK(StringStreamFloats);
+
+}  // namespace
+}  // namespace tint
@@ -29,7 +29,11 @@
 
 #include <math.h>
 #include <cstring>
+#include <functional>
+#include <iomanip>
 #include <limits>
+#include <sstream>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -124,5 +128,116 @@ TEST_F(StringStreamTest, Precision) {
     }
 }
 
+TEST_F(StringStreamTest, Integers) {
+    StringStream s;
+    s << 0 << " " << -1 << " " << 42u << " " << std::numeric_limits<int64_t>::min() << " "
+      << std::numeric_limits<uint64_t>::max() << " " << uint16_t{7};
+    EXPECT_EQ(s.str(), "0 -1 42 -9223372036854775808 18446744073709551615 7");
+}
+
+TEST_F(StringStreamTest, Chars) {
+    StringStream s;
+    s << 'a' << static_cast<unsigned char>('b') << true << false;
+    EXPECT_EQ(s.str(), "ab10");
+}
+
+TEST_F(StringStreamTest, Strings) {
+    StringStream s;
+    s << "abc" << std::string("def") << std::string_view("ghi");
+    EXPECT_EQ(s.str(), "abcdefghi");
+    EXPECT_EQ(s.tellp(), 9u);
+}
+
+TEST_F(StringStreamTest, Hex) {
+    StringStream s;
+    auto flags = s.flags();
+    s << std::hex << std::setfill('0') << std::setw(4) << 255 << " " << 16;
+    s.flags(flags);
+    s << " " << 16;
+    EXPECT_EQ(s.str(), "00ff 10 16");
+}
+
+TEST_F(StringStreamTest, Width) {
+    StringStream s;
+    s << std::setw(5) << "ab" << "|" << std::setw(3) << 'c' << "|" << std::setw(6) << 1.5f << "|";
+    s << std::setw(3);
+    s.repeat('x', 2);
+    EXPECT_EQ(s.str(), "   ab|  c|   1.5|  xx");
+}
+
+TEST_F(StringStreamTest, Endl) {
+    StringStream s;
+    s << "a" << std::endl << "b";
+    EXPECT_EQ(s.str(), "a\nb");
+}
+
+TEST_F(StringStreamTest, NonFinite) {
+    StringStream s;
+    s << std::numeric_limits<float>::infinity() << " " << -std::numeric_limits<double>::infinity()
+      << " " << std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(s.str(), "inf -inf nan");
+}
+
+TEST_F(StringStreamTest, Double) {
+    StringStream s;
+    s << 0.5 << " " << 0.1 << " " << 1e-300;
+    EXPECT_EQ(s.str(), "0.5 0.10000000000000000555 1e-300");
+}
+
+TEST_F(StringStreamTest, Swap) {
+    StringStream a;
+    StringStream b;
+    a << std::hex << "a";
+    b << "b";
+    a.swap(b);
+    a << 10;
+    b << 10;
+    EXPECT_EQ(a.str(), "b10");
+    EXPECT_EQ(b.str(), "aa");
+}
+
+/// @returns `value` formatted with the std::stringstream based algorithm that StringStream
+/// originally used for floats.
+template <typename T>
+std::string FormatWithStdStringStream(T value) {
+    std::stringstream fixed;
+    fixed.flags(fixed.flags() | std::ios_base::showpoint | std::ios_base::fixed);
+    fixed.imbue(std::locale::classic());
+    fixed.precision(20);
+    fixed << value;
+    std::string str = fixed.str();
+    double roundtripped;
+    fixed >> roundtripped;
+    if (std::equal_to<T>()(value, static_cast<T>(roundtripped))) {
+        while (str.length() >= 2 && str[str.size() - 1] == '0' && str[str.size() - 2] != '.') {
+            str.pop_back();
+        }
+        return str;
+    }
+    std::stringstream sci;
+    sci.imbue(std::locale::classic());
+    sci.precision(std::numeric_limits<T>::max_digits10);
+    sci << value;
+    return sci.str();
+}
+
+TEST_F(StringStreamTest, MatchesStdStringStream) {
+    const float floats[] = {0.0f,  -0.0f,  1.0f,  0.1f,  1.0f / 3.0f, 123456.789f,
+                            1e-5f, 1e-30f, 1e30f, 1e-45f, std::numeric_limits<float>::min()};
+    for (float f : floats) {
+        StringStream s;
+        s << f;
+        EXPECT_EQ(s.str(), FormatWithStdStringStream(f)) << f;
+    }
+
+    const double doubles[] = {0.0,    -0.0,    1.0,    0.1,    1.0 / 3.0, 123456.789,
+                              1e-300, 1e-320, 1e300, 1e-5, std::numeric_limits<double>::max()};
+    for (double d : doubles) {
+        StringStream s;
+        s << d;
+        EXPECT_EQ(s.str(), FormatWithStdStringStream(d)) << d;
+    }
+}
+
 }  // namespace
 }  // namespace tint::utils